@@ -0,0 +1,203 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestWebApplicationTiles.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the packets of vtkPVWebApplication::StillRenderToTiles(): only the
+// tiles covering the part of the view that changed are sent for the previous
+// frame, while all of them are sent when asking for time 0.
+
+#include "vtkByteSwap.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVWebApplication.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+const int Width = 200;
+const int Height = 150;
+const int TileSize = 16;
+const long NumberOfTiles =
+  ((Width + TileSize - 1) / TileSize) * ((Height + TileSize - 1) / TileSize);
+
+vtkTypeUInt32 ReadUInt32(const unsigned char*& cursor)
+{
+  vtkTypeUInt32 word;
+  std::memcpy(&word, cursor, sizeof(word));
+  vtkByteSwap::Swap4LE(&word);
+  cursor += sizeof(word);
+  return word;
+}
+
+// Validates the header and the tiles of a packet and returns the number of
+// tiles it holds, or -1 when it is malformed.
+long CountTiles(vtkUnsignedCharArray* packet)
+{
+  if (packet == nullptr || packet->GetNumberOfValues() < 4 * 4)
+  {
+    vtkLogF(ERROR, "Missing or truncated packet.");
+    return -1;
+  }
+  const unsigned char* cursor = packet->GetPointer(0);
+  const unsigned char* end = cursor + packet->GetNumberOfValues();
+  const vtkTypeUInt32 width = ReadUInt32(cursor);
+  const vtkTypeUInt32 height = ReadUInt32(cursor);
+  const vtkTypeUInt32 tileSize = ReadUInt32(cursor);
+  const vtkTypeUInt32 count = ReadUInt32(cursor);
+  if (width != Width || height != Height || tileSize != TileSize)
+  {
+    vtkLogF(ERROR, "Unexpected header: %ux%u image with %u pixels tiles.", width, height, tileSize);
+    return -1;
+  }
+  for (vtkTypeUInt32 cc = 0; cc < count; ++cc)
+  {
+    if (end - cursor < 5 * 4)
+    {
+      vtkLogF(ERROR, "Truncated header of tile %u.", cc);
+      return -1;
+    }
+    const vtkTypeUInt32 x = ReadUInt32(cursor);
+    const vtkTypeUInt32 y = ReadUInt32(cursor);
+    const vtkTypeUInt32 tileWidth = ReadUInt32(cursor);
+    const vtkTypeUInt32 tileHeight = ReadUInt32(cursor);
+    const vtkTypeUInt32 size = ReadUInt32(cursor);
+    if (x % TileSize != 0 || x + tileWidth > width || y + tileHeight > height ||
+      tileWidth == 0 || tileHeight == 0 || size == 0 ||
+      static_cast<vtkTypeUInt32>(end - cursor) < size)
+    {
+      vtkLogF(ERROR, "Invalid tile %u at (%u, %u) of %ux%u pixels and %u bytes.", cc, x, y,
+        tileWidth, tileHeight, size);
+      return -1;
+    }
+    // JPEG data starts with the SOI marker.
+    if (cursor[0] != 0xFF || cursor[1] != 0xD8)
+    {
+      vtkLogF(ERROR, "Tile %u does not hold JPEG data.", cc);
+      return -1;
+    }
+    cursor += size;
+  }
+  if (cursor != end)
+  {
+    vtkLogF(ERROR, "%ld trailing bytes after the last tile.", static_cast<long>(end - cursor));
+    return -1;
+  }
+  return static_cast<long>(count);
+}
+
+bool Run(vtkSMSession* session)
+{
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  int size[2] = { Width, Height };
+  vtkSMPropertyHelper(view, "ViewSize").Set(size, 2);
+  vtkSMPropertyHelper(view, "OrientationAxesVisibility").Set(0);
+  view->UpdateVTKObjects();
+  controller->RegisterViewProxy(view);
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  sphere->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(sphere);
+
+  vtkSMProxy* repr = controller->Show(sphere, 0, view);
+  view->ResetCamera();
+  // keep the sphere in the middle of the view, away from the corners.
+  vtkSMPropertyHelper(view, "CameraParallelScale").Set(2.0);
+  vtkSMPropertyHelper(view, "CameraParallelProjection").Set(1);
+  view->UpdateVTKObjects();
+
+  vtkNew<vtkPVWebApplication> app;
+  app->SetTileSize(TileSize);
+
+  // the first frame holds all tiles.
+  if (CountTiles(app->StillRenderToTiles(view)) != NumberOfTiles)
+  {
+    vtkLogF(ERROR, "The first frame does not hold all %ld tiles.", NumberOfTiles);
+    return false;
+  }
+  const vtkMTimeType first = app->GetLastStillRenderToMTime();
+
+  // rendering the same image again gives no new frame.
+  app->InvalidateCache(view);
+  if (app->StillRenderToTiles(view, first) != nullptr || app->GetLastStillRenderToMTime() != first)
+  {
+    vtkLogF(ERROR, "A frame was produced although nothing changed.");
+    return false;
+  }
+
+  // recoloring the sphere only changes the tiles it covers.
+  double red[3] = { 1, 0, 0 };
+  vtkSMPropertyHelper(repr, "DiffuseColor").Set(red, 3);
+  vtkSMPropertyHelper(repr, "AmbientColor").Set(red, 3);
+  repr->UpdateVTKObjects();
+  app->InvalidateCache(view);
+  const long changed = CountTiles(app->StillRenderToTiles(view, first));
+  if (changed <= 0 || changed >= NumberOfTiles)
+  {
+    vtkLogF(ERROR, "%ld of the %ld tiles changed, expected only some of them.", changed,
+      NumberOfTiles);
+    return false;
+  }
+  if (app->GetLastStillRenderToMTime() <= first)
+  {
+    vtkLogF(ERROR, "The frame time did not increase.");
+    return false;
+  }
+
+  // clients without any frame still get all tiles.
+  if (CountTiles(app->StillRenderToTiles(view, 0)) != NumberOfTiles)
+  {
+    vtkLogF(ERROR, "Time 0 does not give all %ld tiles.", NumberOfTiles);
+    return false;
+  }
+
+  controller->UnRegisterProxy(sphere);
+  controller->UnRegisterProxy(view);
+  return true;
+}
+}
+
+int TestWebApplicationTiles(int argc, char* argv[])
+{
+  (void)argc;
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session);
+  controller->InitializeSession(session);
+
+  const bool success = Run(session);
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
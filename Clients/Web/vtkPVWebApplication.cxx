@@ -15,6 +15,7 @@
 #include "vtkPVWebApplication.h"
 
 #include "vtkBase64Utilities.h"
+#include "vtkByteSwap.h"
 #include "vtkCamera.h"
 #include "vtkCommand.h"
 #include "vtkDataEncoder.h"
@@ -28,20 +29,25 @@
 #include "vtkRenderWindow.h"
 #include "vtkRenderWindowInteractor.h"
 #include "vtkRendererCollection.h"
+#include "vtkSMPTools.h"
 #include "vtkSMContextViewProxy.h"
 #include "vtkSMPropertyHelper.h"
 #include "vtkSMRenderViewProxy.h"
 #include "vtkSMViewProxy.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimeStamp.h"
 #include "vtkTimerLog.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkWebGLExporter.h"
 #include "vtkWebGLObject.h"
 #include "vtkWebInteractionEvent.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <map>
+#include <vector>
 
 class vtkPVWebApplication::vtkInternals
 {
@@ -97,6 +103,32 @@ public:
   typedef std::map<void*, ImageCacheValueType> ImageCacheType;
   ImageCacheType ImageCache;
 
+  // State used by StillRenderToTiles(). The pixels of the last capture are
+  // kept to detect changed tiles, and every tile keeps its JPEG encoding along
+  // with the frame it last changed in.
+  struct TileCacheValueType
+  {
+  public:
+    ImageCacheValueType State;
+    int Size[2] = { 0, 0 };
+    int NumberOfComponents = 0;
+    int Quality = -1;
+    int TileSize = 0;
+    std::vector<unsigned char> Pixels;
+    std::vector<vtkMTimeType> TileTimes;
+    std::vector<std::vector<unsigned char>> Tiles;
+    vtkTimeStamp Frame;
+    vtkNew<vtkUnsignedCharArray> Packet;
+    vtkMTimeType PacketFrame = 0;
+    vtkMTimeType PacketSince = 0;
+  };
+  typedef std::map<void*, TileCacheValueType> TileCacheType;
+  TileCacheType TileCache;
+
+  static void UpdateTiles(
+    TileCacheValueType& value, vtkImageData* image, int quality, int tileSize);
+  static void UpdatePacket(TileCacheValueType& value, vtkMTimeType since);
+
   typedef std::map<void*, unsigned int> ButtonStatesType;
   ButtonStatesType ButtonStates;
 
@@ -117,11 +149,172 @@ public:
   std::string LastAllWebGLBinaryObjects;
 };
 
+//----------------------------------------------------------------------------
+void vtkPVWebApplication::vtkInternals::UpdateTiles(
+  TileCacheValueType& value, vtkImageData* image, int quality, int tileSize)
+{
+  int dims[3];
+  image->GetDimensions(dims);
+  vtkUnsignedCharArray* scalars =
+    vtkArrayDownCast<vtkUnsignedCharArray>(image->GetPointData()->GetScalars());
+  if (!scalars || dims[0] <= 0 || dims[1] <= 0)
+  {
+    return;
+  }
+  const int width = dims[0];
+  const int height = dims[1];
+  const int numComps = scalars->GetNumberOfComponents();
+  const int tilesX = (width + tileSize - 1) / tileSize;
+  const int tilesY = (height + tileSize - 1) / tileSize;
+  const vtkIdType numberOfTiles = static_cast<vtkIdType>(tilesX) * tilesY;
+
+  // Any change in the layout or encoding of the tiles invalidates all of them.
+  const bool reset = value.Size[0] != width || value.Size[1] != height ||
+    value.NumberOfComponents != numComps || value.Quality != quality ||
+    value.TileSize != tileSize;
+  if (reset)
+  {
+    value.Size[0] = width;
+    value.Size[1] = height;
+    value.NumberOfComponents = numComps;
+    value.Quality = quality;
+    value.TileSize = tileSize;
+    value.Pixels.clear();
+    value.Tiles.assign(numberOfTiles, std::vector<unsigned char>());
+    value.TileTimes.assign(numberOfTiles, 0);
+  }
+
+  const unsigned char* pixels = scalars->GetPointer(0);
+  const unsigned char* previous = value.Pixels.empty() ? nullptr : value.Pixels.data();
+  std::vector<char> changed(numberOfTiles, 0);
+
+  // Compare and encode tiles concurrently. Each tile only touches its own
+  // slot in `changed` and `value.Tiles`.
+  vtkSMPTools::For(0, numberOfTiles, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType idx = begin; idx < end; ++idx)
+    {
+      const int x0 = static_cast<int>(idx % tilesX) * tileSize;
+      const int y0 = static_cast<int>(idx / tilesX) * tileSize;
+      const int tileWidth = std::min(tileSize, width - x0);
+      const int tileHeight = std::min(tileSize, height - y0);
+      const size_t rowBytes = static_cast<size_t>(tileWidth) * numComps;
+
+      bool differs = (previous == nullptr);
+      for (int row = 0; !differs && row < tileHeight; ++row)
+      {
+        const size_t offset = (static_cast<size_t>(y0 + row) * width + x0) * numComps;
+        differs = std::memcmp(pixels + offset, previous + offset, rowBytes) != 0;
+      }
+      if (!differs)
+      {
+        continue;
+      }
+
+      vtkNew<vtkImageData> tile;
+      tile->SetDimensions(tileWidth, tileHeight, 1);
+      tile->AllocateScalars(VTK_UNSIGNED_CHAR, numComps);
+      unsigned char* tilePixels = static_cast<unsigned char*>(tile->GetScalarPointer());
+      for (int row = 0; row < tileHeight; ++row)
+      {
+        const size_t offset = (static_cast<size_t>(y0 + row) * width + x0) * numComps;
+        std::memcpy(tilePixels + row * rowBytes, pixels + offset, rowBytes);
+      }
+
+      vtkNew<vtkJPEGWriter> writer;
+      writer->WriteToMemoryOn();
+      writer->SetInputData(tile);
+      writer->SetQuality(quality);
+      writer->Write();
+      vtkUnsignedCharArray* result = writer->GetResult();
+      const unsigned char* data = result->GetPointer(0);
+      value.Tiles[idx].assign(data, data + result->GetNumberOfValues());
+      changed[idx] = 1;
+    }
+  });
+
+  if (std::find(changed.begin(), changed.end(), 1) == changed.end())
+  {
+    return;
+  }
+  value.Frame.Modified();
+  for (vtkIdType idx = 0; idx < numberOfTiles; ++idx)
+  {
+    if (changed[idx])
+    {
+      value.TileTimes[idx] = value.Frame.GetMTime();
+    }
+  }
+  value.Pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * numComps);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVWebApplication::vtkInternals::UpdatePacket(
+  TileCacheValueType& value, vtkMTimeType since)
+{
+  if (value.PacketFrame == value.Frame.GetMTime() && value.PacketSince == since)
+  {
+    return;
+  }
+
+  const int tileSize = value.TileSize;
+  const int tilesX = (value.Size[0] + tileSize - 1) / tileSize;
+  const vtkIdType numberOfTiles = static_cast<vtkIdType>(value.Tiles.size());
+  vtkIdType numberOfChangedTiles = 0;
+  vtkIdType packetSize = 4 * sizeof(vtkTypeUInt32);
+  for (vtkIdType idx = 0; idx < numberOfTiles; ++idx)
+  {
+    if (value.TileTimes[idx] > since)
+    {
+      ++numberOfChangedTiles;
+      packetSize += 5 * sizeof(vtkTypeUInt32) + static_cast<vtkIdType>(value.Tiles[idx].size());
+    }
+  }
+
+  value.Packet->SetNumberOfValues(packetSize);
+  unsigned char* cursor = value.Packet->GetPointer(0);
+  auto write = [&cursor](vtkTypeUInt64 number) {
+    vtkTypeUInt32 word = static_cast<vtkTypeUInt32>(number);
+    vtkByteSwap::Swap4LE(&word);
+    std::memcpy(cursor, &word, sizeof(word));
+    cursor += sizeof(word);
+  };
+  write(value.Size[0]);
+  write(value.Size[1]);
+  write(tileSize);
+  write(numberOfChangedTiles);
+  for (vtkIdType idx = 0; idx < numberOfTiles; ++idx)
+  {
+    if (value.TileTimes[idx] <= since)
+    {
+      continue;
+    }
+    const int x0 = static_cast<int>(idx % tilesX) * tileSize;
+    const int y0 = static_cast<int>(idx / tilesX) * tileSize;
+    const int tileWidth = std::min(tileSize, value.Size[0] - x0);
+    const int tileHeight = std::min(tileSize, value.Size[1] - y0);
+    const std::vector<unsigned char>& data = value.Tiles[idx];
+    write(x0);
+    // VTK images start at the bottom, web images at the top.
+    write(value.Size[1] - y0 - tileHeight);
+    write(tileWidth);
+    write(tileHeight);
+    write(data.size());
+    if (!data.empty())
+    {
+      std::memcpy(cursor, data.data(), data.size());
+      cursor += data.size();
+    }
+  }
+  value.PacketFrame = value.Frame.GetMTime();
+  value.PacketSince = since;
+}
+
 vtkStandardNewMacro(vtkPVWebApplication);
 //----------------------------------------------------------------------------
 vtkPVWebApplication::vtkPVWebApplication()
   : ImageEncoding(ENCODING_BASE64)
   , ImageCompression(COMPRESSION_JPEG)
+  , TileSize(64)
   , Internals(new vtkPVWebApplication::vtkInternals())
 {
 }
@@ -151,6 +344,11 @@ vtkUnsignedCharArray* vtkPVWebApplication::InteractiveRender(vtkSMViewProxy* vie
 void vtkPVWebApplication::InvalidateCache(vtkSMViewProxy* view)
 {
   this->Internals->ImageCache[view].NeedsRender = true;
+  auto iter = this->Internals->TileCache.find(view);
+  if (iter != this->Internals->TileCache.end())
+  {
+    iter->second.State.NeedsRender = true;
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -254,6 +452,43 @@ vtkUnsignedCharArray* vtkPVWebApplication::StillRenderToBuffer(
   return nullptr;
 }
 
+//----------------------------------------------------------------------------
+vtkUnsignedCharArray* vtkPVWebApplication::StillRenderToTiles(
+  vtkSMViewProxy* view, unsigned long time, int quality)
+{
+  if (!view)
+  {
+    vtkErrorMacro("No view specified.");
+    return nullptr;
+  }
+
+  vtkInternals::TileCacheValueType& value = this->Internals->TileCache[view];
+  value.State.SetListener(view);
+
+  if (value.State.NeedsRender || value.Tiles.empty() || view->GetNeedsUpdate() ||
+    value.Quality != quality || value.TileSize != this->TileSize)
+  {
+    vtkSmartPointer<vtkImageData> image;
+    image.TakeReference(view->CaptureWindow(1));
+    if (!image)
+    {
+      vtkErrorMacro("Failed to capture view: " << view);
+      return nullptr;
+    }
+    image->GetDimensions(this->LastStillRenderImageSize);
+    vtkInternals::UpdateTiles(value, image, quality, this->TileSize);
+    value.State.NeedsRender = false;
+  }
+
+  this->LastStillRenderToMTime = value.Frame.GetMTime();
+  if (value.Tiles.empty() || this->LastStillRenderToMTime <= time)
+  {
+    return nullptr;
+  }
+  vtkInternals::UpdatePacket(value, time);
+  return value.Packet;
+}
+
 //----------------------------------------------------------------------------
 bool vtkPVWebApplication::HandleInteractionEvent(
   vtkSMViewProxy* view, vtkWebInteractionEvent* event)
@@ -322,6 +557,14 @@ bool vtkPVWebApplication::HandleInteractionEvent(
 
   bool needs_render = (changed_buttons != 0 || event->GetButtons());
   this->Internals->ImageCache[view].NeedsRender = needs_render;
+  if (needs_render)
+  {
+    auto iter = this->Internals->TileCache.find(view);
+    if (iter != this->Internals->TileCache.end())
+    {
+      iter->second.State.NeedsRender = true;
+    }
+  }
   return needs_render;
 }
 
@@ -435,4 +678,5 @@ void vtkPVWebApplication::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "ImageEncoding: " << this->ImageEncoding << endl;
   os << indent << "ImageCompression: " << this->ImageCompression << endl;
+  os << indent << "TileSize: " << this->TileSize << endl;
 }
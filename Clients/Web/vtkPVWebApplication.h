@@ -76,6 +76,34 @@ public:
     vtkSMViewProxy* view, unsigned long time = 0, int quality = 100);
   //@}
 
+  /**
+   * Render a view and obtain the JPEG encoded tiles of the image that changed
+   * since `time`, which is the value returned by GetLastStillRenderToMTime()
+   * for a previously obtained frame, or 0 to get all tiles. Only tiles whose
+   * pixels changed since the previous capture are re-encoded, concurrently,
+   * and the encoded tiles are kept so that any number of clients can be
+   * served from the same encoding, whatever frame they are at. Returns nullptr
+   * when no tile changed since `time`.
+   *
+   * The returned buffer is not affected by ImageEncoding. It starts with
+   * four little-endian unsigned 32-bit integers: image width, image height,
+   * tile size and number of tiles. Each tile follows as five little-endian
+   * unsigned 32-bit integers: x and y of the top-left corner of the tile, from
+   * the top-left corner of the image, tile width, tile height and number of
+   * bytes of the JPEG data, followed by the JPEG data itself.
+   */
+  vtkUnsignedCharArray* StillRenderToTiles(
+    vtkSMViewProxy* view, unsigned long time = 0, int quality = 100);
+
+  //@{
+  /**
+   * Size in pixels of the square tiles used by StillRenderToTiles().
+   * 64 by default.
+   */
+  vtkSetClampMacro(TileSize, int, 8, 1024);
+  vtkGetMacro(TileSize, int);
+  //@}
+
   /**
    * StillRenderToString() need not necessary returns the most recently rendered
    * image. Use this method to get whether there are any pending images being
@@ -96,7 +124,8 @@ public:
 
   //@{
   /**
-   * Return the MTime of the last array exported by StillRenderToString, StillRenderToBuffer.
+   * Return the MTime of the last array exported by StillRenderToString, StillRenderToBuffer,
+   * or of the last frame captured by StillRenderToTiles.
    */
   vtkGetMacro(LastStillRenderToMTime, vtkMTimeType);
   //@}
@@ -127,6 +156,7 @@ protected:
 
   int ImageEncoding;
   int ImageCompression;
+  int TileSize;
   vtkMTimeType LastStillRenderToMTime;
   int LastStillRenderImageSize[3];
 
@@ -0,0 +1,162 @@
+// Checks that moving the line of a ProbeLine filter interactively previews
+// the moved line with the interactive resolution without changing the applied
+// end points, and that the full sampling is computed once the change is
+// applied.
+
+#include <QApplication>
+#include <QEventLoop>
+#include <QTimer>
+#include <QtDebug>
+
+#include <pqActiveObjects.h>
+#include <pqApplicationCore.h>
+#include <pqLinePropertyWidget.h>
+#include <pqObjectBuilder.h>
+#include <pqPipelineSource.h>
+#include <pqRenderView.h>
+#include <pqServer.h>
+
+#include <vtkCommand.h>
+#include <vtkPVDataInformation.h>
+#include <vtkSMNewWidgetRepresentationProxy.h>
+#include <vtkSMPropertyGroup.h>
+#include <vtkSMPropertyHelper.h>
+#include <vtkSMSourceProxy.h>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+vtkSMPropertyGroup* FindLineGroup(vtkSMProxy* proxy)
+{
+  for (size_t cc = 0; cc < proxy->GetNumberOfPropertyGroups(); ++cc)
+  {
+    vtkSMPropertyGroup* group = proxy->GetPropertyGroup(cc);
+    if (group->GetPanelWidget() && strcmp(group->GetPanelWidget(), "InteractiveLine") == 0)
+    {
+      return group;
+    }
+  }
+  return nullptr;
+}
+
+vtkIdType NumberOfPoints(pqPipelineSource* source)
+{
+  return source->getSourceProxy()->GetDataInformation(0)->GetNumberOfPoints();
+}
+
+// Moves the second end point of the line like a drag of the 3D widget would.
+void Drag(pqLinePropertyWidget* widget, double x)
+{
+  vtkSMNewWidgetRepresentationProxy* wproxy = widget->widgetProxy();
+  const double point2[3] = { x, 10, 10 };
+  vtkSMPropertyHelper(wproxy, "Point2WorldPosition").Set(point2, 3);
+  wproxy->UpdateVTKObjects();
+  wproxy->InvokeEvent(vtkCommand::InteractionEvent);
+}
+
+// Lets the throttled preview update happen.
+void Wait()
+{
+  QEventLoop loop;
+  QTimer::singleShot(300, &loop, &QEventLoop::quit);
+  loop.exec();
+}
+}
+
+int LinePropertyWidgetInteraction(int argc, char* argv[])
+{
+  QApplication app(argc, argv);
+  pqApplicationCore appCore(argc, argv);
+
+  pqObjectBuilder* builder = appCore.getObjectBuilder();
+  pqServer* server = builder->createServer(pqServerResource("builtin:"));
+  pqActiveObjects::instance().setActiveServer(server);
+  pqView* view = builder->createView(pqRenderView::renderViewType(), server);
+
+  pqPipelineSource* wavelet = builder->createSource("sources", "RTAnalyticSource", server);
+  pqPipelineSource* probe = builder->createFilter("filters", "ProbeLine", wavelet);
+  vtkSMProxy* proxy = probe->getProxy();
+  vtkSMPropertyHelper(proxy, "SamplingPattern").Set(2);
+  vtkSMPropertyHelper(proxy, "LineResolution").Set(1000);
+  vtkSMPropertyHelper(proxy, "InteractiveResolution").Set(100);
+  const double point1[3] = { -10, -10, -10 };
+  const double point2[3] = { 10, 10, 10 };
+  vtkSMPropertyHelper(proxy, "Point1").Set(point1, 3);
+  vtkSMPropertyHelper(proxy, "Point2").Set(point2, 3);
+  proxy->UpdateVTKObjects();
+  probe->updatePipeline();
+  if (NumberOfPoints(probe) != 1001)
+  {
+    qCritical() << "ERROR! Expected 1001 samples, got" << NumberOfPoints(probe);
+    return EXIT_FAILURE;
+  }
+
+  vtkSMPropertyGroup* group = FindLineGroup(proxy);
+  if (!group)
+  {
+    qCritical() << "ERROR! Missing InteractiveLine property group.";
+    return EXIT_FAILURE;
+  }
+  pqLinePropertyWidget widget(proxy, group);
+  widget.setView(view);
+  widget.select();
+
+  bool finished = false;
+  QObject::connect(&widget, &pqLinePropertyWidget::changeFinished, [&]() { finished = true; });
+
+  // the filter previews the dragged line with the interactive resolution,
+  // the applied end points are left alone.
+  vtkSMNewWidgetRepresentationProxy* wproxy = widget.widgetProxy();
+  wproxy->InvokeEvent(vtkCommand::StartInteractionEvent);
+  Drag(&widget, 0);
+  Wait();
+  probe->updatePipeline();
+  if (vtkSMPropertyHelper(proxy, "Interacting").GetAsInt() != 1 || NumberOfPoints(probe) != 101)
+  {
+    qCritical() << "ERROR! Expected 101 samples while interacting, got" << NumberOfPoints(probe);
+    return EXIT_FAILURE;
+  }
+  double current[3];
+  vtkSMPropertyHelper(proxy, "PreviewPoint2").Get(current, 3);
+  if (current[0] != 0)
+  {
+    qCritical() << "ERROR! The preview was not updated while interacting.";
+    return EXIT_FAILURE;
+  }
+  vtkSMPropertyHelper(proxy, "Point2").Get(current, 3);
+  if (current[0] != 10)
+  {
+    qCritical() << "ERROR! The line was changed without being applied.";
+    return EXIT_FAILURE;
+  }
+
+  // the last position is previewed when the interaction ends, and applying
+  // it computes the full sampling.
+  Drag(&widget, 5);
+  wproxy->InvokeEvent(vtkCommand::EndInteractionEvent);
+  vtkSMPropertyHelper(proxy, "PreviewPoint2").Get(current, 3);
+  if (!finished || current[0] != 5)
+  {
+    qCritical() << "ERROR! The preview does not show where the line was released.";
+    return EXIT_FAILURE;
+  }
+  widget.apply();
+  proxy->UpdateVTKObjects();
+  probe->updatePipeline();
+  if (vtkSMPropertyHelper(proxy, "Interacting").GetAsInt() != 0 || NumberOfPoints(probe) != 1001)
+  {
+    qCritical() << "ERROR! Expected 1001 samples after the interaction, got"
+                << NumberOfPoints(probe);
+    return EXIT_FAILURE;
+  }
+  vtkSMPropertyHelper(proxy, "Point2").Get(current, 3);
+  if (current[0] != 5)
+  {
+    qCritical() << "ERROR! The line was not applied after the interaction.";
+    return EXIT_FAILURE;
+  }
+
+  return app.arguments().indexOf("--exit") == -1 ? app.exec() : EXIT_SUCCESS;
+}
@@ -692,9 +692,11 @@ bool pqColorAnnotationsWidget::addActiveAnnotations(bool force)
     return false;
   }
 
+  // When forced, large arrays are only sampled so that the values are
+  // counted with bounded memory, see vtkPVProminentValuesInformation.
   vtkPVProminentValuesInformation* info =
     vtkSMPVRepresentationProxy::GetProminentValuesInformationForColorArray(
-      repr->getProxy(), 1e-3, 1e-6, force);
+      repr->getProxy(), 1e-3, 1e-6, force, force);
   if (!info || !info->GetValid())
   {
     return false;
@@ -819,7 +821,7 @@ bool pqColorAnnotationsWidget::addActiveAnnotationsFromVisibleSources(bool force
 
     vtkPVProminentValuesInformation* info =
       vtkSMPVRepresentationProxy::GetProminentValuesInformationForColorArray(
-        representationProxy, 1e-3, 1e-6, force);
+        representationProxy, 1e-3, 1e-6, force, force);
     if (!info)
     {
       continue;
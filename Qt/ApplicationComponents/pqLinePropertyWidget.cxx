@@ -32,8 +32,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "pqLinePropertyWidget.h"
 #include "ui_pqLinePropertyWidget.h"
 
+#include "pqApplicationCore.h"
 #include "pqCoreUtilities.h"
 #include "pqPointPickingHelper.h"
+#include "pqTimer.h"
 #include "vtkBoundingBox.h"
 #include "vtkCommand.h"
 #include "vtkMath.h"
@@ -41,15 +43,25 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkSMProperty.h"
 #include "vtkSMPropertyGroup.h"
 #include "vtkSMPropertyHelper.h"
+#include "vtkWeakPointer.h"
 
 class pqLinePropertyWidget::pqInternals
 {
 public:
   Ui::LinePropertyWidget Ui;
   bool PickPoint1;
+  bool InInteraction;
+  vtkWeakPointer<vtkSMProperty> Interacting;
+  vtkWeakPointer<vtkSMProperty> PreviewPoint1;
+  vtkWeakPointer<vtkSMProperty> PreviewPoint2;
+  // limits the rate at which the preview is updated while dragging.
+  pqTimer PreviewTimer;
   pqInternals()
     : PickPoint1(true)
+    , InInteraction(false)
   {
+    this->PreviewTimer.setSingleShot(true);
+    this->PreviewTimer.setInterval(100);
   }
 };
 
@@ -92,6 +104,43 @@ pqLinePropertyWidget::pqLinePropertyWidget(
     qCritical("Missing required property for function 'Point2WorldPosition'.");
   }
 
+  // Proxies that can produce a cheaper result while the line is being moved
+  // expose "Interacting", "PreviewPoint1" and "PreviewPoint2" properties,
+  // which are not linked to the widget. While the line is dragged, its end
+  // points are pushed to the preview properties with "Interacting" set, at a
+  // limited rate, and the views are rendered to show the preview. The linked
+  // end points are only pushed on apply, along with "Interacting" cleared so
+  // that the full result is computed.
+  vtkSMProperty* interacting = smgroup->GetProperty("Interacting");
+  vtkSMProperty* previewPoint1 = smgroup->GetProperty("PreviewPoint1");
+  vtkSMProperty* previewPoint2 = smgroup->GetProperty("PreviewPoint2");
+  if (interacting && previewPoint1 && previewPoint2)
+  {
+    auto& internals = *this->Internals;
+    internals.Interacting = interacting;
+    internals.PreviewPoint1 = previewPoint1;
+    internals.PreviewPoint2 = previewPoint2;
+    QObject::connect(&internals.PreviewTimer, &pqTimer::timeout, this,
+      &pqLinePropertyWidget::updateInteractivePreview);
+    QObject::connect(this, &pqLinePropertyWidget::startInteraction, this,
+      [this]() { this->Internals->InInteraction = true; });
+    QObject::connect(this, &pqLinePropertyWidget::changeAvailable, this, [this]() {
+      if (this->Internals->InInteraction && !this->Internals->PreviewTimer.isActive())
+      {
+        this->Internals->PreviewTimer.start();
+      }
+    });
+    QObject::connect(this, &pqLinePropertyWidget::endInteraction, this, [this]() {
+      // the preview shows where the line was released until it is applied.
+      if (this->Internals->PreviewTimer.isActive())
+      {
+        this->Internals->PreviewTimer.stop();
+        this->updateInteractivePreview();
+      }
+      this->Internals->InInteraction = false;
+    });
+  }
+
   if (smgroup->GetProperty("Input"))
   {
     this->connect(ui.centerOnBounds, SIGNAL(clicked()), SLOT(centerOnBounds()));
@@ -164,6 +213,55 @@ void pqLinePropertyWidget::updateLengthLabel()
   ui.labelLength->setText(QString("<b>Length:</b> <i>%1</i> ").arg(distance));
 }
 
+//-----------------------------------------------------------------------------
+void pqLinePropertyWidget::updateInteractivePreview()
+{
+  auto& internals = *this->Internals;
+  if (!internals.InInteraction || !internals.Interacting || !internals.PreviewPoint1 ||
+    !internals.PreviewPoint2)
+  {
+    return;
+  }
+
+  vtkSMProxy* wproxy = this->widgetProxy();
+  double pt[3];
+  vtkSMPropertyHelper(wproxy, "Point1WorldPosition").Get(pt, 3);
+  vtkSMPropertyHelper(internals.PreviewPoint1).Set(pt, 3);
+  vtkSMPropertyHelper(wproxy, "Point2WorldPosition").Get(pt, 3);
+  vtkSMPropertyHelper(internals.PreviewPoint2).Set(pt, 3);
+  vtkSMPropertyHelper(internals.Interacting).Set(1);
+  this->proxy()->UpdateVTKObjects();
+
+  // views showing the proxy update it as they render.
+  pqApplicationCore::instance()->render();
+}
+
+//-----------------------------------------------------------------------------
+void pqLinePropertyWidget::apply()
+{
+  this->Superclass::apply();
+  // pushed along with the applied end points, so that the full result is
+  // computed for them.
+  if (this->Internals->Interacting)
+  {
+    vtkSMPropertyHelper(this->Internals->Interacting).Set(0);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void pqLinePropertyWidget::reset()
+{
+  this->Internals->PreviewTimer.stop();
+  // the preview of a discarded change goes away with it.
+  if (this->Internals->Interacting &&
+    vtkSMPropertyHelper(this->Internals->Interacting).GetAsInt() != 0)
+  {
+    vtkSMPropertyHelper(this->Internals->Interacting).Set(0);
+    this->proxy()->UpdateVTKObjects();
+  }
+  this->Superclass::reset();
+}
+
 //-----------------------------------------------------------------------------
 void pqLinePropertyWidget::placeWidget()
 {
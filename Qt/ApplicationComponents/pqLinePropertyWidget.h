@@ -54,6 +54,9 @@ class QColor;
  * linked to the other end point of the line.
  * \li \c Input: (optional) a vtkSMInputProperty that is used to get data
  * information for bounds when placing/resetting the widget.
+ * \li \c Interacting, \c PreviewPoint1 and \c PreviewPoint2: (optional) a
+ * vtkSMIntVectorProperty and two 3-tuple vtkSMDoubleVectorProperty that are
+ * set, without being applied, to preview the line while it is dragged.
  */
 class PQAPPLICATIONCOMPONENTS_EXPORT pqLinePropertyWidget : public pqInteractivePropertyWidget
 {
@@ -64,6 +67,17 @@ public:
   pqLinePropertyWidget(vtkSMProxy* proxy, vtkSMPropertyGroup* smgroup, QWidget* parent = nullptr);
   ~pqLinePropertyWidget() override;
 
+  /**
+   * Overridden to clear the "Interacting" property, if any, so that the
+   * applied line replaces the preview.
+   */
+  void apply() override;
+
+  /**
+   * Overridden to discard the preview, if any.
+   */
+  void reset() override;
+
 public Q_SLOTS: // NOLINT(readability-redundant-access-specifiers)
   void useXAxis() { this->useAxis(0); }
   void useYAxis() { this->useAxis(1); }
@@ -93,6 +107,13 @@ protected Q_SLOTS:
    */
   void updateLengthLabel();
 
+  /**
+   * While the line is being moved, pushes its end points to the proxy's
+   * "PreviewPoint1" and "PreviewPoint2" properties with "Interacting" set,
+   * and renders the views to show the preview.
+   */
+  void updateInteractivePreview();
+
 private:
   Q_DISABLE_COPY(pqLinePropertyWidget)
   class pqInternals;
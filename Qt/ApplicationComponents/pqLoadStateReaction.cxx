@@ -39,6 +39,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "pqProxyWidgetDialog.h"
 #include "pqServer.h"
 #include "pqServerManagerModel.h"
+#include "pqSettings.h"
 #include "pqStandardRecentlyUsedResourceLoaderImplementation.h"
 #include "vtkNew.h"
 #include "vtkPVXMLParser.h"
@@ -95,6 +96,13 @@ void pqLoadStateReaction::loadState(const QString& filename, bool dialogBlocked,
     {
       vtkNew<vtkSMParaViewPipelineController> controller;
       controller->InitializeProxy(proxy);
+      vtkSMPropertyHelper(proxy, "DeferPipelineUpdates")
+        .Set(pqApplicationCore::instance()
+               ->settings()
+               ->value("GeneralSettings.DeferPipelineUpdatesOnLoadState", false)
+               .toBool()
+            ? 1
+            : 0);
 
       if (proxy->HasDataFiles() && !dialogBlocked)
       {
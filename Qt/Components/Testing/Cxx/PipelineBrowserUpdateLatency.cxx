@@ -0,0 +1,133 @@
+// Measures how long the pipeline browser takes to catch up with sources and
+// filters being registered, for an increasing number of pipelines, with and
+// without batching the updates as done when loading a state or running a
+// script. The timings are reported, the test fails when the browser does not
+// show the expected items or loses the expanded items when a batch ends.
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QtDebug>
+
+#include <pqActiveObjects.h>
+#include <pqApplicationCore.h>
+#include <pqObjectBuilder.h>
+#include <pqPipelineBrowserWidget.h>
+#include <pqPipelineSource.h>
+#include <pqServer.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+// Creates 'count' sphere sources, each with a shrink filter, then waits for
+// the browser to be updated and painted. Returns the elapsed milliseconds.
+double CreatePipelines(pqServer* server, int count, bool batch)
+{
+  pqApplicationCore* core = pqApplicationCore::instance();
+  pqObjectBuilder* builder = core->getObjectBuilder();
+
+  QElapsedTimer timer;
+  timer.start();
+  if (batch)
+  {
+    core->beginBulkUpdate();
+  }
+  for (int cc = 0; cc < count; ++cc)
+  {
+    pqPipelineSource* sphere = builder->createSource("sources", "SphereSource", server);
+    builder->createFilter("filters", "ShrinkFilter", sphere);
+  }
+  if (batch)
+  {
+    core->endBulkUpdate();
+  }
+  QApplication::processEvents();
+  return timer.elapsed();
+}
+
+bool Validate(pqPipelineBrowserWidget* browser, int count)
+{
+  const QAbstractItemModel* model = browser->getModel();
+  const QModelIndex serverIndex = model->index(0, 0);
+  if (model->rowCount(serverIndex) != count)
+  {
+    qCritical() << "ERROR! Expected" << count << "sources, got" << model->rowCount(serverIndex);
+    return false;
+  }
+  for (int cc = 0; cc < count; ++cc)
+  {
+    if (model->rowCount(model->index(cc, 0, serverIndex)) != 1)
+    {
+      qCritical() << "ERROR! Missing filter under source" << cc;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Items expanded before a batch large enough to reset the model must remain
+// expanded after it.
+bool ValidateExpansionKept(pqPipelineBrowserWidget* browser, pqServer* server)
+{
+  pqObjectBuilder* builder = pqApplicationCore::instance()->getObjectBuilder();
+  pqPipelineSource* sphere = builder->createSource("sources", "SphereSource", server);
+  builder->createFilter("filters", "ShrinkFilter", sphere);
+  QApplication::processEvents();
+
+  const QAbstractItemModel* model = browser->getModel();
+  if (!browser->isIndexExpanded(model->index(0, 0, model->index(0, 0))))
+  {
+    qCritical() << "ERROR! The source was not expanded when its filter was added.";
+    return false;
+  }
+
+  CreatePipelines(server, 100, true);
+  const QModelIndex serverIndex = model->index(0, 0);
+  const bool expanded = browser->isIndexExpanded(serverIndex) &&
+    browser->isIndexExpanded(model->index(0, 0, serverIndex));
+  builder->destroySources(server);
+  QApplication::processEvents();
+  if (!expanded)
+  {
+    qCritical() << "ERROR! Expanded items were collapsed by a batch update.";
+  }
+  return expanded;
+}
+}
+
+int PipelineBrowserUpdateLatency(int argc, char* argv[])
+{
+  QApplication app(argc, argv);
+  pqApplicationCore appCore(argc, argv);
+
+  pqPipelineBrowserWidget browser;
+  browser.resize(300, 600);
+  browser.show();
+
+  pqObjectBuilder* builder = appCore.getObjectBuilder();
+  pqServer* server = builder->createServer(pqServerResource("builtin:"));
+  pqActiveObjects::instance().setActiveServer(server);
+  QApplication::processEvents();
+
+  bool success = true;
+  for (int count : { 100, 400, 1600 })
+  {
+    for (bool batch : { false, true })
+    {
+      const double elapsed = CreatePipelines(server, count, batch);
+      success = Validate(&browser, count) && success;
+      std::cout << "Pipelines: " << count << (batch ? " batched" : " incremental")
+                << " total: " << elapsed << " ms per pipeline: " << elapsed / count << " ms"
+                << std::endl;
+
+      builder->destroySources(server);
+      QApplication::processEvents();
+    }
+  }
+
+  success = ValidateExpansionKept(&browser, server) && success;
+
+  const int retval = app.arguments().indexOf("--exit") == -1 ? app.exec() : EXIT_SUCCESS;
+  return success ? retval : EXIT_FAILURE;
+}
@@ -94,6 +94,10 @@ pqPipelineBrowserWidget::~pqPipelineBrowserWidget() = default;
 //-----------------------------------------------------------------------------
 void pqPipelineBrowserWidget::configureModel()
 {
+  // The expanded items must be saved before the filter model forwards the
+  // reset to the view, so this is connected before setting the source model.
+  QObject::connect(
+    this->PipelineModel, SIGNAL(modelAboutToBeReset()), this, SLOT(saveExpandedItems()));
   this->FilteredPipelineModel->setSourceModel(this->PipelineModel);
 
   // Connect the model to the ServerManager model.
@@ -138,6 +142,19 @@ void pqPipelineBrowserWidget::configureModel()
   // are added.
   QObject::connect(this->PipelineModel, SIGNAL(firstChildAdded(const QModelIndex&)), this,
     SLOT(expandWithModelIndexTranslation(const QModelIndex&)));
+  QObject::connect(
+    this->FilteredPipelineModel, SIGNAL(modelReset()), this, SLOT(restoreExpandedItems()));
+
+  // Batch the model updates while a state or a script registers proxies.
+  pqApplicationCore* core = pqApplicationCore::instance();
+  QObject::connect(
+    core, SIGNAL(bulkUpdateStarted()), this->PipelineModel, SLOT(beginBatchUpdate()));
+  QObject::connect(
+    core, SIGNAL(bulkUpdateFinished()), this->PipelineModel, SLOT(endBatchUpdate()));
+  if (core->isBulkUpdating())
+  {
+    this->PipelineModel->beginBatchUpdate();
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -472,6 +489,45 @@ void pqPipelineBrowserWidget::expandWithModelIndexTranslation(const QModelIndex&
   this->expand(this->FilteredPipelineModel->mapFromSource(index));
 }
 
+//-----------------------------------------------------------------------------
+void pqPipelineBrowserWidget::saveExpandedItems()
+{
+  this->ExpandedItems.clear();
+  QModelIndexList parents;
+  parents.push_back(QModelIndex());
+  while (!parents.isEmpty())
+  {
+    const QModelIndex parentIndex = parents.takeFirst();
+    const int rows = this->FilteredPipelineModel->rowCount(parentIndex);
+    for (int row = 0; row < rows; ++row)
+    {
+      const QModelIndex index = this->FilteredPipelineModel->index(row, 0, parentIndex);
+      if (this->isIndexExpanded(index))
+      {
+        this->ExpandedItems.push_back(
+          this->PipelineModel->getItemFor(this->FilteredPipelineModel->mapToSource(index)));
+        parents.push_back(index);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void pqPipelineBrowserWidget::restoreExpandedItems()
+{
+  // Parents were saved before their children, so they are expanded first.
+  QList<QPointer<pqServerManagerModelItem>> items;
+  items.swap(this->ExpandedItems);
+  Q_FOREACH (pqServerManagerModelItem* item, items)
+  {
+    const QModelIndex index = item ? this->PipelineModel->getIndexFor(item) : QModelIndex();
+    if (index.isValid())
+    {
+      this->expand(this->FilteredPipelineModel->mapFromSource(index));
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqPipelineBrowserWidget::setModel(pqPipelineModel* model)
 {
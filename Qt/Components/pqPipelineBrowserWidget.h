@@ -41,6 +41,7 @@ class pqPipelineModel;
 class pqPipelineAnnotationFilterModel;
 class pqPipelineSource;
 class pqOutputPort;
+class pqServerManagerModelItem;
 class pqView;
 class QMenu;
 class vtkSession;
@@ -135,6 +136,14 @@ protected Q_SLOTS:
   void handleIndexClicked(const QModelIndex& index);
   void expandWithModelIndexTranslation(const QModelIndex&);
 
+  /**
+   * A model reset collapses every item of the view. These save the items
+   * expanded before the pqPipelineModel is reset, when a large batch of
+   * changes ends, and expand them again afterwards.
+   */
+  void saveExpandedItems();
+  void restoreExpandedItems();
+
 protected: // NOLINT(readability-redundant-access-specifiers)
   /**
    * sets the visibility for items in the indices list.
@@ -153,6 +162,8 @@ protected: // NOLINT(readability-redundant-access-specifiers)
   QPointer<QMenu> ContextMenu;
 
 private:
+  QList<QPointer<pqServerManagerModelItem>> ExpandedItems;
+
   /**
    * Set up the current pqPipelineModel.
    */
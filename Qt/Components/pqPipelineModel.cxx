@@ -59,6 +59,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <QApplication>
 #include <QFont>
+#include <QMultiHash>
 #include <QString>
 #include <QStyle>
 #include <QtDebug>
@@ -462,14 +463,93 @@ public:
   {
     this->ModifiedFont.setBold(true);
     this->DelayedUpdateVisibilityTimer.setSingleShot(true);
+    this->BatchDepth = 0;
+    this->BatchChanges = 0;
+    this->Resetting = false;
   }
 
+  // Adds the item and its descendants to the ItemsByObject index.
+  void addToIndex(pqPipelineModelDataItem* item)
+  {
+    if (item->Object && !this->ItemsByObject.contains(item->Object, item))
+    {
+      this->ItemsByObject.insert(item->Object, item);
+    }
+    Q_FOREACH (pqPipelineModelDataItem* child, item->Children)
+    {
+      this->addToIndex(child);
+    }
+  }
+
+  // Removes the item and its descendants from the ItemsByObject index.
+  void removeFromIndex(pqPipelineModelDataItem* item)
+  {
+    if (item->Object)
+    {
+      this->ItemsByObject.remove(item->Object, item);
+    }
+    Q_FOREACH (pqPipelineModelDataItem* child, item->Children)
+    {
+      this->removeFromIndex(child);
+    }
+  }
+
+  // Number of row changes in a batch after which the views are reset once the
+  // batch ends instead of being told about every change.
+  static const int ResetThreshold = 64;
+
   QFont ModifiedFont;
   pqPipelineModelDataItem Root;
   pqTimer DelayedUpdateVisibilityTimer;
   QList<QPointer<pqPipelineSource>> DelayedUpdateVisibilityItems;
+
+  // Items in the tree for each object, so that looking an object up does not
+  // walk the whole tree. An object may be represented by a proxy item and
+  // its link items.
+  QMultiHash<pqServerManagerModelItem*, pqPipelineModelDataItem*> ItemsByObject;
+
+  int BatchDepth;
+  int BatchChanges;
+  bool Resetting;
+  QList<QPointer<pqPipelineModelDataItem>> FirstChildParents;
 };
 
+namespace
+{
+// Walks the subtree in depth-first order, used when the index has several
+// candidates for an object.
+pqPipelineModelDataItem* findDataItem(pqServerManagerModelItem* item,
+  pqPipelineModelDataItem* parentItem, pqPipelineModel::ItemType type)
+{
+  if (parentItem->Object == item && (type == pqPipelineModel::Invalid || type == parentItem->Type))
+  {
+    return parentItem;
+  }
+
+  Q_FOREACH (pqPipelineModelDataItem* child, parentItem->Children)
+  {
+    pqPipelineModelDataItem* retVal = findDataItem(item, child, type);
+    if (retVal)
+    {
+      return retVal;
+    }
+  }
+  return nullptr;
+}
+
+bool isInSubtree(pqPipelineModelDataItem* item, pqPipelineModelDataItem* subtreeRoot)
+{
+  for (; item; item = item->Parent)
+  {
+    if (item == subtreeRoot)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+}
+
 //-----------------------------------------------------------------------------
 void pqPipelineModel::constructor()
 {
@@ -533,6 +613,7 @@ pqPipelineModel::pqPipelineModel(const pqPipelineModel& other, QObject* parentOb
 {
   this->constructor();
   this->Internal->Root = other.Internal->Root;
+  this->Internal->addToIndex(&this->Internal->Root);
   this->Internal->Root.updateLinks();
 }
 
@@ -975,20 +1056,21 @@ pqPipelineModelDataItem* pqPipelineModel::getDataItem(
     return nullptr;
   }
 
-  if (_parent->Object == item && (type == pqPipelineModel::Invalid || type == _parent->Type))
-  {
-    return _parent;
-  }
-
-  Q_FOREACH (pqPipelineModelDataItem* child, _parent->Children)
+  pqPipelineModelDataItem* found = nullptr;
+  Q_FOREACH (pqPipelineModelDataItem* candidate, this->Internal->ItemsByObject.values(item))
   {
-    pqPipelineModelDataItem* retVal = this->getDataItem(item, child, type);
-    if (retVal && (type == pqPipelineModel::Invalid || type == retVal->Type))
+    if ((type == pqPipelineModel::Invalid || type == candidate->Type) &&
+      isInSubtree(candidate, _parent))
     {
-      return retVal;
+      if (found)
+      {
+        // Return the first match in tree order, as the views would see it.
+        return findDataItem(item, _parent, type);
+      }
+      found = candidate;
     }
   }
-  return nullptr;
+  return found;
 }
 
 //-----------------------------------------------------------------------------
@@ -1016,12 +1098,18 @@ void pqPipelineModel::addChild(pqPipelineModelDataItem* _parent, pqPipelineModel
     return;
   }
 
-  QModelIndex parentIndex = this->getIndex(_parent);
   int row = _parent->Children.size();
-
-  this->beginInsertRows(parentIndex, row, row);
-  _parent->addChild(child);
-  this->endInsertRows();
+  if (this->trackRowChange())
+  {
+    this->beginInsertRows(this->getIndex(_parent), row, row);
+    _parent->addChild(child);
+    this->endInsertRows();
+  }
+  else
+  {
+    _parent->addChild(child);
+  }
+  this->Internal->addToIndex(child);
 
   // Make sure a pipeline icon exists for this item
   if (!this->checkAndLoadPipelinePixmap(child->getIconType()))
@@ -1031,7 +1119,14 @@ void pqPipelineModel::addChild(pqPipelineModelDataItem* _parent, pqPipelineModel
 
   if (row == 0)
   {
-    Q_EMIT this->firstChildAdded(parentIndex);
+    if (this->Internal->Resetting)
+    {
+      this->Internal->FirstChildParents.push_back(_parent);
+    }
+    else
+    {
+      Q_EMIT this->firstChildAdded(this->getIndex(_parent));
+    }
   }
 }
 
@@ -1051,12 +1146,75 @@ void pqPipelineModel::removeChildFromParent(pqPipelineModelDataItem* child)
     return;
   }
 
-  QModelIndex parentIndex = this->getIndex(_parent);
-  int row = child->getIndexInParent();
+  this->Internal->removeFromIndex(child);
+  if (this->trackRowChange())
+  {
+    int row = child->getIndexInParent();
+    this->beginRemoveRows(this->getIndex(_parent), row, row);
+    _parent->removeChild(child);
+    this->endRemoveRows();
+  }
+  else
+  {
+    _parent->removeChild(child);
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool pqPipelineModel::trackRowChange()
+{
+  pqPipelineModelInternal& internals = *this->Internal;
+  if (internals.BatchDepth > 0 && !internals.Resetting &&
+    ++internals.BatchChanges > pqPipelineModelInternal::ResetThreshold)
+  {
+    this->beginResetModel();
+    internals.Resetting = true;
+  }
+  return !internals.Resetting;
+}
+
+//-----------------------------------------------------------------------------
+void pqPipelineModel::beginBatchUpdate()
+{
+  this->Internal->BatchDepth++;
+}
+
+//-----------------------------------------------------------------------------
+void pqPipelineModel::endBatchUpdate()
+{
+  pqPipelineModelInternal& internals = *this->Internal;
+  if (internals.BatchDepth == 0)
+  {
+    qWarning() << "endBatchUpdate() called without beginBatchUpdate().";
+    return;
+  }
+  if (--internals.BatchDepth > 0)
+  {
+    return;
+  }
+
+  internals.BatchChanges = 0;
+  if (internals.Resetting)
+  {
+    internals.Resetting = false;
+    this->endResetModel();
 
-  this->beginRemoveRows(parentIndex, row, row);
-  _parent->removeChild(child);
-  this->endRemoveRows();
+    QList<QPointer<pqPipelineModelDataItem>> parents;
+    parents.swap(internals.FirstChildParents);
+    Q_FOREACH (pqPipelineModelDataItem* item, parents)
+    {
+      if (item && !item->Children.empty() && isInSubtree(item, &internals.Root))
+      {
+        Q_EMIT this->firstChildAdded(this->getIndex(item));
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool pqPipelineModel::isBatchUpdating() const
+{
+  return this->Internal->BatchDepth > 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -1064,6 +1222,10 @@ void pqPipelineModel::serverDataChanged()
 {
   // TODO: we should determine which server data actually chnaged
   // and invalidate only that one. FOr now, just invalidate all.
+  if (this->Internal->Resetting)
+  {
+    return;
+  }
 
   int max = this->Internal->Root.Children.size() - 1;
   if (max >= 0)
@@ -1077,6 +1239,11 @@ void pqPipelineModel::serverDataChanged()
 //-----------------------------------------------------------------------------
 void pqPipelineModel::itemDataChanged(pqPipelineModelDataItem* item)
 {
+  if (this->Internal->Resetting)
+  {
+    // the views get all the data once the batch ends.
+    return;
+  }
   QModelIndex idx = this->getIndex(item);
   Q_EMIT this->dataChanged(idx, idx);
 }
@@ -327,6 +327,12 @@ public:
    */
   void disableFilterSession();
 
+  /**
+   * Returns true between beginBatchUpdate() and the matching
+   * endBatchUpdate().
+   */
+  bool isBatchUpdating() const;
+
 public Q_SLOTS: // NOLINT(readability-redundant-access-specifiers)
   /**
    * Called when a new server connection is detected. Adds the connection to the
@@ -385,6 +391,16 @@ public Q_SLOTS: // NOLINT(readability-redundant-access-specifiers)
    */
   void setView(pqView* module);
 
+  /**
+   * Groups the changes made until the matching endBatchUpdate(), calls may
+   * be nested. Once a batch has inserted or removed many rows, the views are
+   * no longer told about each row: the model is reset once, when the
+   * outermost batch ends. Use this around bulk changes such as loading a
+   * state file or running a script. Small batches behave as usual.
+   */
+  void beginBatchUpdate();
+  void endBatchUpdate();
+
 Q_SIGNALS:
   void firstChildAdded(const QModelIndex& index);
 
@@ -426,6 +442,11 @@ private: // NOLINT(readability-redundant-access-specifiers)
   // has taken place.
   void removeChildFromParent(pqPipelineModelDataItem* child);
 
+  // Called before inserting or removing a row. Returns false when the views
+  // will be reset at the end of the current batch instead of being told
+  // about the change.
+  bool trackRowChange();
+
   // Returns the pqPipelineModelDataItem for the given pqServerManagerModelItem.
   pqPipelineModelDataItem* getDataItem(pqServerManagerModelItem* item,
     pqPipelineModelDataItem* subtreeRoot, ItemType type = Invalid) const;
@@ -56,6 +56,16 @@ pqSelectionAdaptor::pqSelectionAdaptor(QItemSelectionModel* _parent)
   QObject::connect(this->QSelectionModel,
     SIGNAL(currentChanged(const QModelIndex&, const QModelIndex&)), this, SLOT(selectionChanged()));
 
+  // A model reset silently clears the selection, restore it from the
+  // active objects.
+  if (this->QSelectionModel->model())
+  {
+    QObject::connect(this->QSelectionModel->model(), SIGNAL(modelReset()), this,
+      SLOT(proxySelectionChanged()));
+    QObject::connect(
+      this->QSelectionModel->model(), SIGNAL(modelReset()), this, SLOT(currentProxyChanged()));
+  }
+
   pqActiveObjects* ao = &pqActiveObjects::instance();
   QObject::connect(ao, SIGNAL(portChanged(pqOutputPort*)), this, SLOT(currentProxyChanged()));
   QObject::connect(
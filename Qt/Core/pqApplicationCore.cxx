@@ -210,6 +210,7 @@ void pqApplicationCore::constructor()
   this->LinksModel = new pqLinksModel(this);
 
   this->LoadingState = false;
+  this->BulkUpdateDepth = 0;
   QObject::connect(this->ServerManagerObserver,
     SIGNAL(stateLoaded(vtkPVXMLElement*, vtkSMProxyLocator*)), this,
     SLOT(onStateLoaded(vtkPVXMLElement*, vtkSMProxyLocator*)));
@@ -476,11 +477,36 @@ void pqApplicationCore::loadStateIncremental(
 
   // TODO: this->LoadingState cannot be relied upon.
   this->LoadingState = true;
+  this->beginBulkUpdate();
   vtkSMSessionProxyManager* pxm = server->proxyManager();
   pxm->LoadXMLState(rootElement, loader);
+  this->endBulkUpdate();
   this->LoadingState = false;
 }
 
+//-----------------------------------------------------------------------------
+void pqApplicationCore::beginBulkUpdate()
+{
+  if (this->BulkUpdateDepth++ == 0)
+  {
+    Q_EMIT this->bulkUpdateStarted();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void pqApplicationCore::endBulkUpdate()
+{
+  if (this->BulkUpdateDepth == 0)
+  {
+    qWarning() << "endBulkUpdate() called without beginBulkUpdate().";
+    return;
+  }
+  if (--this->BulkUpdateDepth == 0)
+  {
+    Q_EMIT this->bulkUpdateFinished();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqApplicationCore::onStateLoaded(vtkPVXMLElement* root, vtkSMProxyLocator* locator)
 {
@@ -313,6 +313,16 @@ public:
    */
   bool isLoadingState() { return this->LoadingState; };
 
+  /**
+   * Brackets changes that may register many proxies at once, such as loading
+   * a state or running a script. Calls may be nested, bulkUpdateStarted() and
+   * bulkUpdateFinished() are fired for the outermost pair only so that
+   * widgets can defer their updates until the end.
+   */
+  void beginBulkUpdate();
+  void endBulkUpdate();
+  bool isBulkUpdating() const { return this->BulkUpdateDepth > 0; }
+
   /**
    * returns the active server is any.
    */
@@ -378,6 +388,12 @@ Q_SIGNALS:
    */
   void stateLoaded(vtkPVXMLElement* root, vtkSMProxyLocator* locator);
 
+  /**
+   * Fired by the outermost beginBulkUpdate() and endBulkUpdate() calls.
+   */
+  void bulkUpdateStarted();
+  void bulkUpdateFinished();
+
   /**
    * Fired to save state xml. Components that need to save XML state should
    * listen to this signal and add their XML elements to the root. DO NOT MODIFY
@@ -426,6 +442,7 @@ private Q_SLOTS:
 
 protected:
   bool LoadingState;
+  int BulkUpdateDepth;
 
   PARAVIEW_DEPRECATED_IN_5_10_0("Replaced by `vtkCLIOptions` APIs")
   vtkSmartPointer<pqOptions> Options;
@@ -180,6 +180,13 @@ void pqPythonManager::executeCode(
   const bool prevCapture = vtkPythonInterpreter::GetCaptureStdin();
   vtkPythonInterpreter::SetCaptureStdin(true);
 
+  // scripts may create many proxies, let the GUI batch its updates.
+  pqApplicationCore* core = pqApplicationCore::instance();
+  if (core)
+  {
+    core->beginBulkUpdate();
+  }
+
   vtkNew<vtkPythonInteractiveInterpreter> interp;
   interp->AddObserver(vtkCommand::UpdateEvent, &helper, &pqPythonManagerRawInputHelper::rawInput);
   for (const auto& instr : pre_push)
@@ -191,6 +198,11 @@ void pqPythonManager::executeCode(
   {
     interp->Push(instr.data());
   }
+
+  if (core)
+  {
+    core->endBulkUpdate();
+  }
   vtkPythonInterpreter::SetCaptureStdin(prevCapture);
   vtkOutputWindow::SetInstance(old);
   interp->RemoveObservers(vtkCommand::UpdateEvent);
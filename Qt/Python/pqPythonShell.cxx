@@ -146,6 +146,12 @@ public:
       assert(this->OldInstance == nullptr);
       Q_EMIT this->Parent->executing(true);
 
+      // scripts may create many proxies, let the GUI batch its updates.
+      if (pqApplicationCore* core = pqApplicationCore::instance())
+      {
+        core->beginBulkUpdate();
+      }
+
       if (this->isInterpreterInitialized() == false)
       {
         this->initializeInterpreter();
@@ -173,6 +179,10 @@ public:
       this->OldCapture = false;
       vtkOutputWindow::SetInstance(this->OldInstance);
       this->OldInstance = nullptr;
+      if (pqApplicationCore* core = pqApplicationCore::instance())
+      {
+        core->endBulkUpdate();
+      }
       Q_EMIT this->Parent->executing(false);
     }
   }
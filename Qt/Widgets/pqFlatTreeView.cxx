@@ -160,6 +160,7 @@ pqFlatTreeView::pqFlatTreeView(QWidget* p)
   this->TextMargin = 4;
   this->DoubleTextMargin = 2 * this->TextMargin;
   this->FontChanged = false;
+  this->LayoutPending = false;
   this->ManageSizes = true;
   this->InUpdateWidth = false;
   this->HeaderOwned = false;
@@ -284,6 +285,7 @@ void pqFlatTreeView::setModel(QAbstractItemModel* model)
   if (this->Model)
   {
     // Listen for model changes.
+    this->connect(this->Model, SIGNAL(modelAboutToBeReset()), this, SLOT(startModelReset()));
     this->connect(this->Model, SIGNAL(modelReset()), this, SLOT(reset()));
     this->connect(this->Model, SIGNAL(layoutChanged()), this, SLOT(reset()));
     this->connect(this->Model, SIGNAL(rowsInserted(const QModelIndex&, int, int)), this,
@@ -603,6 +605,7 @@ bool pqFlatTreeView::isIndexHidden(const QModelIndex& index) const
 
 void pqFlatTreeView::getVisibleRect(const QModelIndex& index, QRect& area) const
 {
+  this->ensureLayout();
   if (!this->HeaderView)
   {
     return;
@@ -627,6 +630,7 @@ void pqFlatTreeView::getVisibleRect(const QModelIndex& index, QRect& area) const
 
 QModelIndex pqFlatTreeView::getIndexVisibleAt(const QPoint& point) const
 {
+  this->ensureLayout();
   if (!this->HeaderView)
   {
     return QModelIndex();
@@ -677,6 +681,7 @@ QModelIndex pqFlatTreeView::getIndexVisibleAt(const QPoint& point) const
 
 QModelIndex pqFlatTreeView::getIndexCellAt(const QPoint& point) const
 {
+  this->ensureLayout();
   if (!this->HeaderView)
   {
     return QModelIndex();
@@ -712,6 +717,7 @@ QModelIndex pqFlatTreeView::getIndexCellAt(const QPoint& point) const
 
 void pqFlatTreeView::getSelectionIn(const QRect& area, QItemSelection& items) const
 {
+  this->ensureLayout();
   if (!area.isValid())
   {
     return;
@@ -924,6 +930,7 @@ void pqFlatTreeView::getRelativeIndexId(
 
 bool pqFlatTreeView::startEditing(const QModelIndex& index)
 {
+  this->ensureLayout();
   if (this->Model->flags(index) & Qt::ItemIsEditable)
   {
     // The user might be editing another index.
@@ -1095,6 +1102,7 @@ void pqFlatTreeView::expand(const QModelIndex& index)
 
 void pqFlatTreeView::collapse(const QModelIndex& index)
 {
+  this->ensureLayout();
   pqFlatTreeViewItem* item = this->getItem(index);
   if (item && item->Expandable && item->Expanded)
   {
@@ -1188,6 +1196,7 @@ void pqFlatTreeView::collapse(const QModelIndex& index)
 
 void pqFlatTreeView::scrollTo(const QModelIndex& index)
 {
+  this->ensureLayout();
   if (!index.isValid() || index.model() != this->Model || !this->HeaderView)
   {
     return;
@@ -1239,6 +1248,16 @@ void pqFlatTreeView::scrollTo(const QModelIndex& index)
   }
 }
 
+void pqFlatTreeView::startModelReset()
+{
+  // The model may change any number of items before signaling the reset.
+  // Drop the view items now so they are not painted or used until then.
+  this->cancelEditing();
+  this->Internal->ShiftStart = QPersistentModelIndex();
+  this->resetRoot();
+  this->LayoutPending = true;
+}
+
 void pqFlatTreeView::insertRows(const QModelIndex& parentIndex, int start, int end)
 {
   // Get the view item for the parent index. If the view item
@@ -1292,46 +1311,14 @@ void pqFlatTreeView::insertRows(const QModelIndex& parentIndex, int start, int e
         item->Items.insert(start, *iter);
       }
 
-      // Layout the visible items following the changed item
-      // including the newly added items. Only layout the items
-      // if they are visible.
+      // The visible items following the changed item, including the newly
+      // added items, need to be laid out again. That is deferred until the
+      // layout is needed, e.g. to paint, so that adding many rows in a row
+      // only lays the items out once.
       if (this->HeaderView && (!item->Expandable || item->Expanded))
       {
-        int point = 0;
-        if (item != this->Root)
-        {
-          point = item->ContentsY + item->Height;
-        }
-        else if (!this->HeaderView->isHidden())
-        {
-          point = this->HeaderView->height();
-        }
-
-        QFontMetrics fm = this->fontMetrics();
-        pqFlatTreeViewItem* next = this->getNextVisibleItem(item);
-        while (next)
-        {
-          this->layoutItem(next, point, fm);
-          next = this->getNextVisibleItem(next);
-        }
-
-        // Update the contents size.
-        this->ContentsHeight = point;
-        bool widthChanged = this->updateContentsWidth();
-        this->updateScrollBars();
-
-        if (widthChanged)
-        {
-          this->viewport()->update();
-        }
-        else
-        {
-          // Repaint the area from the item to the end of the view.
-          QRect area(
-            0, item->ContentsY, this->ContentsWidth, this->ContentsHeight - item->ContentsY);
-          area.translate(-this->horizontalOffset(), -this->verticalOffset());
-          this->viewport()->update(area);
-        }
+        this->LayoutPending = true;
+        this->viewport()->update();
       }
     }
   }
@@ -1391,46 +1378,10 @@ void pqFlatTreeView::finishRowRemoval(const QModelIndex& parentIndex, int, int)
       this->resetPreferredSizes();
     }
 
-    // Layout the following items now that the model has finished
-    // removing the items.
-    int point = 0;
-    if (item != this->Root)
-    {
-      point = item->ContentsY + item->Height;
-    }
-    else if (!this->HeaderView->isHidden())
-    {
-      point = this->HeaderView->height();
-    }
-
-    QFontMetrics fm = this->fontMetrics();
-    pqFlatTreeViewItem* next = this->getNextVisibleItem(item);
-    while (next)
-    {
-      this->layoutItem(next, point, fm);
-      next = this->getNextVisibleItem(next);
-    }
-
-    // Update the contents size.
-    int oldHeight = this->ContentsHeight;
-    this->ContentsHeight = point;
-    bool widthChanged = this->updateContentsWidth();
-    this->updateScrollBars();
-
-    // If editing an index, update the editor geometry.
-    this->layoutEditor();
-
-    if (widthChanged)
-    {
-      this->viewport()->update();
-    }
-    else
-    {
-      // Repaint the area from the item to the end of the view.
-      QRect area(0, item->ContentsY, this->ContentsWidth, oldHeight - item->ContentsY);
-      area.translate(-this->horizontalOffset(), -this->verticalOffset());
-      this->viewport()->update(area);
-    }
+    // Layout the following items once needed, now that the model has
+    // finished removing the items.
+    this->LayoutPending = true;
+    this->viewport()->update();
   }
 }
 
@@ -1451,6 +1402,7 @@ void pqFlatTreeView::finishColumnRemoval(const QModelIndex&, int, int)
 
 void pqFlatTreeView::updateData(const QModelIndex& topLeft, const QModelIndex& bottomRight)
 {
+  this->ensureLayout();
   // The changed indexes must have the same parent.
   QModelIndex parentIndex = topLeft.parent();
   if (parentIndex != bottomRight.parent())
@@ -1543,6 +1495,7 @@ void pqFlatTreeView::updateData(const QModelIndex& topLeft, const QModelIndex& b
 
 void pqFlatTreeView::keyPressEvent(QKeyEvent* e)
 {
+  this->ensureLayout();
   if (!this->Model || e->key() == Qt::Key_Escape)
   {
     return;
@@ -2128,6 +2081,7 @@ void pqFlatTreeView::keyboardSearch(const QString& search)
 
 void pqFlatTreeView::mousePressEvent(QMouseEvent* e)
 {
+  this->ensureLayout();
   if (!this->HeaderView || !this->Model || e->button() == Qt::MiddleButton)
   {
     e->ignore();
@@ -2300,6 +2254,7 @@ void pqFlatTreeView::mouseReleaseEvent(QMouseEvent* e)
 
 void pqFlatTreeView::mouseDoubleClickEvent(QMouseEvent* e)
 {
+  this->ensureLayout();
   if (!this->HeaderView || e->button() != Qt::LeftButton)
   {
     e->ignore();
@@ -2438,6 +2393,7 @@ bool pqFlatTreeView::viewportEvent(QEvent* e)
 
 void pqFlatTreeView::paintEvent(QPaintEvent* e)
 {
+  this->ensureLayout();
   if (!e || !this->Root || !this->HeaderView || !this->Model)
   {
     return;
@@ -2689,6 +2645,7 @@ void pqFlatTreeView::handleSectionMoved(int, int, int)
 
 void pqFlatTreeView::changeCurrent(const QModelIndex& current, const QModelIndex& previous)
 {
+  this->ensureLayout();
   if (this->Behavior == pqFlatTreeView::SelectItems)
   {
     // If the last index is valid, add its row to the repaint region.
@@ -2724,6 +2681,7 @@ void pqFlatTreeView::changeCurrent(const QModelIndex& current, const QModelIndex
 
 void pqFlatTreeView::changeCurrentRow(const QModelIndex& current, const QModelIndex& previous)
 {
+  this->ensureLayout();
   if (this->Behavior == pqFlatTreeView::SelectRows)
   {
     // If the last index is valid, add its row to the repaint region.
@@ -2768,6 +2726,7 @@ void pqFlatTreeView::changeCurrentColumn(const QModelIndex&, const QModelIndex&)
 void pqFlatTreeView::changeSelection(
   const QItemSelection& selected, const QItemSelection& deselected)
 {
+  this->ensureLayout();
   if (!this->HeaderView)
   {
     return;
@@ -2986,8 +2945,22 @@ void pqFlatTreeView::layoutEditor()
   }
 }
 
+void pqFlatTreeView::ensureLayout() const
+{
+  if (this->LayoutPending)
+  {
+    // The layout is a cache of the item positions, update it on demand.
+    pqFlatTreeView* self = const_cast<pqFlatTreeView*>(this);
+    self->layoutItems();
+
+    // If editing an index, update the editor geometry.
+    self->layoutEditor();
+  }
+}
+
 void pqFlatTreeView::layoutItems()
 {
+  this->LayoutPending = false;
   if (this->HeaderView)
   {
     // Determine the item height based on the font and icon size.
@@ -3456,6 +3429,7 @@ pqFlatTreeViewItem* pqFlatTreeView::getLastVisibleItem() const
 
 void pqFlatTreeView::expandItem(pqFlatTreeViewItem* item)
 {
+  this->ensureLayout();
   item->Expanded = true;
 
   // An expandable item might not have the child items created
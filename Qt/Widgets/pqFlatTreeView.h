@@ -223,6 +223,7 @@ protected Q_SLOTS:
    * \name Model Change Handlers
    */
   //@{
+  void startModelReset();
   void insertRows(const QModelIndex& parent, int start, int end);
   void startRowRemoval(const QModelIndex& parent, int start, int end);
   void finishRowRemoval(const QModelIndex& parent, int start, int end);
@@ -295,6 +296,7 @@ private: // NOLINT(readability-redundant-access-specifiers)
   //@{
   void layoutEditor();
   void layoutItems();
+  void ensureLayout() const;
   void layoutItem(pqFlatTreeViewItem* item, int& point, const QFontMetrics& fm);
   int getDataWidth(const QModelIndex& index, const QFontMetrics& fm) const;
   int getWidthSum(pqFlatTreeViewItem* item, int column) const;
@@ -346,6 +348,7 @@ private: // NOLINT(readability-redundant-access-specifiers)
   int TextMargin;
   int DoubleTextMargin;
   bool FontChanged;
+  bool LayoutPending;
   bool ManageSizes;
   bool InUpdateWidth;
   bool HeaderOwned;
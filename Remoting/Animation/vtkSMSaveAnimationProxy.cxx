@@ -14,18 +14,24 @@
 =========================================================================*/
 #include "vtkSMSaveAnimationProxy.h"
 
+#include "vtkCommand.h"
 #include "vtkCompositeAnimationPlayer.h"
+#include "vtkDataArray.h"
 #include "vtkErrorCode.h"
+#include "vtkExecutive.h"
 #include "vtkGenericMovieWriter.h"
 #include "vtkImageData.h"
 #include "vtkImageWriter.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkOutputWindow.h"
 #include "vtkPVProgressHandler.h"
 #include "vtkPVRenderingCapabilitiesInformation.h"
 #include "vtkPVServerInformation.h"
 #include "vtkPVXMLElement.h"
+#include "vtkPointData.h"
+#include "vtkProcessModule.h"
 #include "vtkRenderWindow.h"
 #include "vtkSMAnimationScene.h"
 #include "vtkSMAnimationSceneWriter.h"
@@ -39,7 +45,16 @@
 #include "vtkSMViewLayoutProxy.h"
 #include "vtkSMViewProxy.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 namespace vtkSMSaveAnimationProxyNS
@@ -62,6 +77,143 @@ public:
   }
 };
 
+/**
+ * Bounded queue of frame encoding tasks executed by a pool of worker threads.
+ * Each task is given the index of the worker running it, so that tasks can use
+ * per-worker writers. With a single worker, tasks are executed in the order
+ * they were pushed. `Push` blocks while the queue is full so that rendering
+ * never gets too far ahead of encoding.
+ */
+class FrameEncodingQueue
+{
+public:
+  using TaskType = std::function<bool(int)>;
+
+  FrameEncodingQueue() = default;
+  ~FrameEncodingQueue() { this->Finish(); }
+
+  void Start(int numberOfWorkers, std::size_t capacity)
+  {
+    this->Finish();
+    this->Capacity = std::max<std::size_t>(capacity, 1);
+    this->Done = false;
+    this->Failed = false;
+    for (int cc = 0; cc < numberOfWorkers; ++cc)
+    {
+      this->Workers.emplace_back(&FrameEncodingQueue::Run, this, cc);
+    }
+  }
+
+  bool IsRunning() const { return !this->Workers.empty(); }
+
+  /**
+   * Queue a task, waiting for room if needed. Returns false if a previously
+   * queued task failed.
+   */
+  bool Push(TaskType task)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->NotFull.wait(
+      lock, [this]() { return this->Failed || this->Tasks.size() < this->Capacity; });
+    if (this->Failed)
+    {
+      return false;
+    }
+    this->Tasks.push_back(std::move(task));
+    this->NotEmpty.notify_one();
+    return true;
+  }
+
+  /**
+   * Wait for all queued tasks to complete and stop the workers. Returns false
+   * if any task failed.
+   */
+  bool Finish()
+  {
+    if (this->Workers.empty())
+    {
+      return !this->Failed;
+    }
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Done = true;
+    }
+    this->NotEmpty.notify_all();
+    for (auto& worker : this->Workers)
+    {
+      worker.join();
+    }
+    this->Workers.clear();
+    return !this->Failed;
+  }
+
+private:
+  void Run(int workerIndex)
+  {
+    while (true)
+    {
+      TaskType task;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->NotEmpty.wait(lock, [this]() { return this->Done || !this->Tasks.empty(); });
+        if (this->Tasks.empty())
+        {
+          return;
+        }
+        task = std::move(this->Tasks.front());
+        this->Tasks.pop_front();
+      }
+      this->NotFull.notify_one();
+
+      // once a task has failed, remaining tasks are dropped.
+      const bool status = !this->Failed && task(workerIndex);
+      if (!status)
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Failed = true;
+        this->NotFull.notify_all();
+      }
+    }
+  }
+
+  std::deque<TaskType> Tasks;
+  std::vector<std::thread> Workers;
+  std::mutex Mutex;
+  std::condition_variable NotEmpty;
+  std::condition_variable NotFull;
+  std::size_t Capacity = 1;
+  bool Done = false;
+  std::atomic<bool> Failed{ false };
+};
+
+/**
+ * Collects the errors reported by the writers, which may run on the encoding
+ * threads, so that they are displayed from the main thread instead.
+ */
+class FrameErrorCollector : public vtkCommand
+{
+public:
+  static FrameErrorCollector* New() { return new FrameErrorCollector; }
+
+  void Execute(vtkObject*, unsigned long, void* callData) override
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Messages.emplace_back(callData ? static_cast<const char*>(callData) : "");
+  }
+
+  std::vector<std::string> TakeMessages()
+  {
+    std::vector<std::string> messages;
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    messages.swap(this->Messages);
+    return messages;
+  }
+
+private:
+  std::mutex Mutex;
+  std::vector<std::string> Messages;
+};
+
 template <class T>
 class SceneImageWriter : public vtkSMAnimationSceneWriter
 {
@@ -74,7 +226,16 @@ public:
    */
   void SetHelper(vtkSMSaveAnimationProxy* helper) { this->Helper = helper; }
 
+  /**
+   * Number of threads encoding and writing frames while the next frames are
+   * being rendered. 0 (default) encodes and writes each frame before rendering
+   * the next one.
+   */
+  void SetNumberOfEncodingThreads(int count) { this->NumberOfEncodingThreads = count; }
+
 protected:
+  using FrameTask = FrameEncodingQueue::TaskType;
+
   SceneImageWriter() = default;
   ~SceneImageWriter() override = default;
   bool SaveInitialize(int vtkNotUsed(startCount)) override
@@ -83,6 +244,14 @@ protected:
     // since it's a waste of rendering, the code to save the images will call
     // render anyways.
     this->AnimationScene->SetOverrideStillRender(1);
+
+    const int numberOfWorkers = this->GetNumberOfEncodingWorkers();
+    if (numberOfWorkers > 0)
+    {
+      // allow a couple of frames per worker to be waiting, beyond that the
+      // rendering waits for the encoding to catch up.
+      this->Queue.Start(numberOfWorkers, 2 * static_cast<std::size_t>(numberOfWorkers));
+    }
     return true;
   }
 
@@ -95,31 +264,149 @@ protected:
     // Note, the call to CapturePreppedImage() still needs to happen on all
     // ranks, since otherwise we may get mismatched renders.
     vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
-    if (image_pair.first == nullptr || (controller && controller->GetLocalProcessId() != 0))
+    if (controller && controller->GetLocalProcessId() != 0)
     {
       // don't actually save anything on this rank.
       return true;
     }
 
-    return this->WriteFrameImage(time, image_pair.first, image_pair.second);
+    return this->SubmitFrame(time, image_pair.first, image_pair.second);
+  }
+
+  /**
+   * Writes the frame, or queues it when writing asynchronously. Frames
+   * without images are skipped.
+   */
+  virtual bool SubmitFrame(double time, vtkImageData* dataLeft, vtkImageData* dataRight)
+  {
+    if (dataLeft == nullptr)
+    {
+      return true;
+    }
+
+    bool status;
+    if (!this->Queue.IsRunning())
+    {
+      status = this->NewFrameTask(time, dataLeft, dataRight)(0);
+    }
+    else
+    {
+      status = this->Queue.Push(
+        this->NewFrameTask(time, TakeImage(dataLeft), TakeImage(dataRight)));
+    }
+    this->ReportErrors();
+    return status;
   }
 
   bool SaveFinalize() override
   {
     this->AnimationScene->SetOverrideStillRender(0);
-    return true;
+    const bool status = this->FinishEncoding();
+    this->StopObservingErrors();
+    return status;
+  }
+
+  /**
+   * Waits for all queued frames to be written. Returns false if any of them
+   * failed.
+   */
+  bool FinishEncoding()
+  {
+    const bool status = this->Queue.Finish();
+    this->ReportErrors();
+    return status;
+  }
+
+  /**
+   * Collects the errors of `algorithm` and of its executive while saving, to
+   * report them on the main thread. See `ReportErrors`.
+   */
+  void ObserveErrors(vtkAlgorithm* algorithm)
+  {
+    if (algorithm)
+    {
+      for (vtkObject* object : { static_cast<vtkObject*>(algorithm),
+             static_cast<vtkObject*>(algorithm->GetExecutive()) })
+      {
+        this->ObservedObjects.emplace_back(
+          object, object->AddObserver(vtkCommand::ErrorEvent, this->Errors));
+      }
+    }
+  }
+
+  /**
+   * Displays the errors collected since the last call. Must be called from the
+   * main thread.
+   */
+  void ReportErrors()
+  {
+    for (const auto& message : this->Errors->TakeMessages())
+    {
+      vtkOutputWindowDisplayErrorText(message.c_str());
+    }
+  }
+
+  void StopObservingErrors()
+  {
+    for (const auto& observed : this->ObservedObjects)
+    {
+      if (vtkObject* object = observed.first)
+      {
+        object->RemoveObserver(observed.second);
+      }
+    }
+    this->ObservedObjects.clear();
+    this->ReportErrors();
+  }
+
+  /**
+   * Returns an image that can be handed over to the encoding threads.
+   * Captured images are referenced by nobody else and are returned as is,
+   * images that are shared are copied.
+   */
+  static vtkSmartPointer<vtkImageData> TakeImage(vtkImageData* image)
+  {
+    if (image == nullptr)
+    {
+      return nullptr;
+    }
+    vtkDataArray* scalars = image->GetPointData()->GetScalars();
+    if (image->GetReferenceCount() == 1 && (!scalars || scalars->GetReferenceCount() == 1))
+    {
+      return image;
+    }
+    auto copy = vtkSmartPointer<vtkImageData>::New();
+    copy->DeepCopy(image);
+    return copy;
   }
 
-  virtual bool WriteFrameImage(double time, vtkImageData* dataLeft, vtkImageData* dataRight) = 0;
+  /**
+   * Number of worker threads to use, 0 to write frames synchronously.
+   */
+  virtual int GetNumberOfEncodingWorkers() { return 0; }
+
+  /**
+   * Returns a task that writes the given images. The task is passed the index
+   * of the worker executing it, 0 when writing synchronously. Any state that
+   * depends on the frame order must be updated here and not in the task.
+   */
+  virtual FrameTask NewFrameTask(double time, vtkSmartPointer<vtkImageData> dataLeft,
+    vtkSmartPointer<vtkImageData> dataRight) = 0;
 
   std::string GetStereoFileName(const std::string& filename, bool left)
   {
     return Friendship::GetStereoFileName(this->Helper, filename, left);
   }
 
+  int NumberOfEncodingThreads = 0;
+
 private:
   SceneImageWriter(const SceneImageWriter&) = delete;
   void operator=(const SceneImageWriter&) = delete;
+
+  FrameEncodingQueue Queue;
+  vtkNew<FrameErrorCollector> Errors;
+  std::vector<std::pair<vtkWeakPointer<vtkObject>, unsigned long>> ObservedObjects;
 };
 
 class SceneImageWriterMovie : public SceneImageWriter<vtkGenericMovieWriter>
@@ -135,6 +422,19 @@ public:
    */
   void SetWriter(int index, vtkGenericMovieWriter* writer) { this->Writers[index] = writer; }
 
+  /**
+   * When frames are rendered by several time compartments, frame `i` being
+   * rendered by compartment `i % N`, the first compartment receives the frames
+   * of the others and writes the movie. `controller` connects the first
+   * process of each compartment, `numberOfFrames` is the total number of
+   * frames in the movie.
+   */
+  void SetTimeCompartments(vtkMultiProcessController* controller, int numberOfFrames)
+  {
+    this->CompartmentsController = controller;
+    this->NumberOfFrames = numberOfFrames;
+  }
+
 protected:
   SceneImageWriterMovie()
     : Started(false)
@@ -154,35 +454,95 @@ protected:
     auto* writer = this->Writers[0];
     assert(writer != nullptr);
     writer->SetFileName(fname.c_str());
+    this->NumberOfFramesSubmitted = 0;
+    this->ObserveErrors(this->Writers[0]);
+    this->ObserveErrors(this->Writers[1]);
     return this->Superclass::SaveInitialize(startCount);
   }
 
-  bool WriteFrameImage(
-    double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
+  bool SubmitFrame(double time, vtkImageData* dataLeft, vtkImageData* dataRight) override
   {
-    vtkImageData* data[] = { dataLeft, dataRight };
-    bool status = true;
-    for (int cc = 0; cc < 2; ++cc)
+    auto controller = this->CompartmentsController.GetPointer();
+    if (controller == nullptr || controller->GetNumberOfProcesses() <= 1)
+    {
+      return this->Superclass::SubmitFrame(time, dataLeft, dataRight);
+    }
+
+    const int numberOfCompartments = controller->GetNumberOfProcesses();
+    if (controller->GetLocalProcessId() != 0)
     {
-      if (auto* writer = this->Writers[cc])
+      // the movie is written by the first compartment, send the frame there.
+      // an empty frame is still sent so that the receiver does not wait for it.
+      int count = dataLeft ? (dataRight ? 2 : 1) : 0;
+      controller->Send(&count, 1, 0, MOVIE_FRAME_TAG);
+      if (count > 0)
       {
-        assert(data[cc] != nullptr);
-        writer->SetInputData(data[cc]);
-        if (!this->Started)
-        {
-          writer->Start(); // start needs input data, hence we do it here.
-        }
-        writer->Write();
-        writer->SetInputData(nullptr);
-        status &= (writer->GetError() == 0 && writer->GetError() == vtkErrorCode::NoError);
+        controller->Send(dataLeft, 0, MOVIE_FRAME_TAG);
+      }
+      if (count > 1)
+      {
+        controller->Send(dataRight, 0, MOVIE_FRAME_TAG);
       }
+      return true;
+    }
+
+    bool status = this->Superclass::SubmitFrame(time, dataLeft, dataRight);
+
+    // write the frames rendered by the other compartments that come before
+    // the next frame of this one.
+    const int frame = this->NumberOfFramesSubmitted * numberOfCompartments;
+    for (int cc = 1; cc < numberOfCompartments && frame + cc < this->NumberOfFrames; ++cc)
+    {
+      int count = 0;
+      controller->Receive(&count, 1, cc, MOVIE_FRAME_TAG);
+      vtkSmartPointer<vtkImageData> images[2];
+      for (int ii = 0; ii < count && ii < 2; ++ii)
+      {
+        auto dobj = vtk::TakeSmartPointer(controller->ReceiveDataObject(cc, MOVIE_FRAME_TAG));
+        images[ii] = vtkImageData::SafeDownCast(dobj);
+      }
+      status = this->Superclass::SubmitFrame(time, images[0], images[1]) && status;
     }
-    this->Started = true;
+    ++this->NumberOfFramesSubmitted;
     return status;
   }
 
+  // movie frames must be written in order, hence a single worker at most.
+  int GetNumberOfEncodingWorkers() override
+  {
+    return this->NumberOfEncodingThreads > 0 ? 1 : 0;
+  }
+
+  FrameTask NewFrameTask(double vtkNotUsed(time), vtkSmartPointer<vtkImageData> dataLeft,
+    vtkSmartPointer<vtkImageData> dataRight) override
+  {
+    return [this, dataLeft, dataRight](int vtkNotUsed(workerIndex)) {
+      vtkImageData* data[] = { dataLeft, dataRight };
+      bool status = true;
+      for (int cc = 0; cc < 2; ++cc)
+      {
+        if (auto* writer = this->Writers[cc])
+        {
+          assert(data[cc] != nullptr);
+          writer->SetInputData(data[cc]);
+          if (!this->Started)
+          {
+            writer->Start(); // start needs input data, hence we do it here.
+          }
+          writer->Write();
+          writer->SetInputData(nullptr);
+          status &= (writer->GetError() == 0 && writer->GetError() == vtkErrorCode::NoError);
+        }
+      }
+      this->Started = true;
+      return status;
+    };
+  }
+
   bool SaveFinalize() override
   {
+    // all frames must be written before the movies are closed.
+    bool status = this->FinishEncoding();
     if (this->Started)
     {
       for (int cc = 0; cc < 2; ++cc)
@@ -194,19 +554,24 @@ protected:
       }
     }
     this->Started = false;
-    return this->Superclass::SaveFinalize();
+    return this->Superclass::SaveFinalize() && status;
   }
 
 private:
   SceneImageWriterMovie(const SceneImageWriterMovie&) = delete;
   void operator=(const SceneImageWriterMovie&) = delete;
   bool Started;
+
+  static constexpr int MOVIE_FRAME_TAG = 20871;
+  vtkSmartPointer<vtkMultiProcessController> CompartmentsController;
+  int NumberOfFrames = 0;
+  int NumberOfFramesSubmitted = 0;
 };
 vtkStandardNewMacro(SceneImageWriterMovie);
 
 class SceneImageWriterImageSeries : public SceneImageWriter<vtkImageWriter>
 {
-  vtkImageWriter* Writer;
+  std::vector<vtkImageWriter*> Writers;
 
 public:
   static SceneImageWriterImageSeries* New();
@@ -219,9 +584,11 @@ public:
   vtkGetStringMacro(SuffixFormat);
 
   /**
-   * Set the writer to use.
+   * Set the writers to use. When encoding asynchronously, each worker thread
+   * uses its own writer, so as many writers as threads should be provided.
    */
-  void SetWriter(vtkImageWriter* writer) { this->Writer = writer; }
+  void SetWriter(vtkImageWriter* writer) { this->Writers.assign(1, writer); }
+  void AddWriter(vtkImageWriter* writer) { this->Writers.push_back(writer); }
 
 protected:
   SceneImageWriterImageSeries()
@@ -238,18 +605,25 @@ protected:
     auto prefix = vtksys::SystemTools::GetFilenameWithoutLastExtension(this->FileName);
     this->Prefix = path.empty() ? prefix : path + "/" + prefix;
     this->Extension = vtksys::SystemTools::GetFilenameLastExtension(this->FileName);
+    for (auto writer : this->Writers)
+    {
+      this->ObserveErrors(writer);
+    }
     return this->Superclass::SaveInitialize(startCount);
   }
 
-  bool WriteFrameImage(
-    double vtkNotUsed(time), vtkImageData* dataLeft, vtkImageData* dataRight) override
+  int GetNumberOfEncodingWorkers() override
   {
-    bool success = true;
+    return this->NumberOfEncodingThreads > 0
+      ? std::min(this->NumberOfEncodingThreads, static_cast<int>(this->Writers.size()))
+      : 0;
+  }
 
-    auto writer = this->Writer;
+  FrameTask NewFrameTask(double vtkNotUsed(time), vtkSmartPointer<vtkImageData> dataLeft,
+    vtkSmartPointer<vtkImageData> dataRight) override
+  {
     assert(dataLeft);
     assert(this->SuffixFormat);
-    assert(writer);
 
     char buffer[1024];
     snprintf(buffer, 1024, this->SuffixFormat, this->Counter);
@@ -257,25 +631,37 @@ protected:
     std::ostringstream str;
     str << this->Prefix << buffer << this->Extension;
 
+    // file names are decided here since frames may be written out of order.
     std::string fname = str.str();
+    std::string rightFName;
     if (dataRight)
     {
-      writer->SetInputData(dataRight);
-      writer->SetFileName(this->GetStereoFileName(fname, /*left*/ false).c_str());
-      writer->Write();
-      success &= (writer->GetErrorCode() == vtkErrorCode::NoError);
-
+      rightFName = this->GetStereoFileName(fname, /*left*/ false);
       // update fname for left image.
       fname = this->GetStereoFileName(fname, /*left=*/true);
     }
-    writer->SetFileName(fname.c_str());
-    writer->SetInputData(dataLeft);
-    writer->Write();
-    writer->SetInputData(nullptr);
+    this->Counter += this->Stride;
+
+    return [this, dataLeft, dataRight, fname, rightFName](int workerIndex) {
+      bool success = true;
 
-    success &= writer->GetErrorCode() == vtkErrorCode::NoError;
-    this->Counter += success ? this->Stride : 0;
-    return success;
+      auto writer = this->Writers[workerIndex];
+      assert(writer);
+      if (dataRight)
+      {
+        writer->SetInputData(dataRight);
+        writer->SetFileName(rightFName.c_str());
+        writer->Write();
+        success &= (writer->GetErrorCode() == vtkErrorCode::NoError);
+      }
+      writer->SetFileName(fname.c_str());
+      writer->SetInputData(dataLeft);
+      writer->Write();
+      writer->SetInputData(nullptr);
+
+      success &= writer->GetErrorCode() == vtkErrorCode::NoError;
+      return success;
+    };
   }
 
 private:
@@ -390,6 +776,8 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
   }
 
   vtkSmartPointer<vtkSMAnimationSceneWriter> writer;
+  const int numberOfEncodingThreads =
+    vtkSMPropertyHelper(this, "NumberOfEncodingThreads", /*quiet*/ true).GetAsInt();
 
   vtkSMProxy* sceneProxy = this->GetAnimationScene();
   auto formatProxy = this->GetFormatProxy(filename);
@@ -409,6 +797,9 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
   // check if we're writing 2-stereo video streams at the same time.
   vtkSmartPointer<vtkSMProxy> otherFormatProxy;
 
+  // image writers used by the additional encoding threads.
+  std::vector<vtkSmartPointer<vtkSMProxy>> workerFormatProxies;
+
   // based on the format, we create an appropriate SceneImageWriter.
   auto formatObj = formatProxy->GetClientSideObject();
   if (auto imgWriter = vtkImageWriter::SafeDownCast(formatObj))
@@ -416,13 +807,30 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
     vtkNew<vtkSMSaveAnimationProxyNS::SceneImageWriterImageSeries> realWriter;
     realWriter->SetSuffixFormat(vtkSMPropertyHelper(formatProxy, "SuffixFormat").GetAsString());
     realWriter->SetHelper(this);
+    realWriter->SetNumberOfEncodingThreads(numberOfEncodingThreads);
     realWriter->SetWriter(imgWriter);
+
+    // writers are not shared between threads, each thread gets its own copy
+    // of the format.
+    auto pxm = this->GetSessionProxyManager();
+    for (int cc = 1; cc < numberOfEncodingThreads; ++cc)
+    {
+      vtkSmartPointer<vtkSMProxy> workerFormatProxy;
+      workerFormatProxy.TakeReference(
+        pxm->NewProxy(formatProxy->GetXMLGroup(), formatProxy->GetXMLName()));
+      workerFormatProxy->SetLocation(formatProxy->GetLocation());
+      workerFormatProxy->Copy(formatProxy);
+      workerFormatProxy->UpdateVTKObjects();
+      realWriter->AddWriter(vtkImageWriter::SafeDownCast(workerFormatProxy->GetClientSideObject()));
+      workerFormatProxies.push_back(workerFormatProxy);
+    }
     writer = realWriter;
   }
   else if (auto movieWriter = vtkGenericMovieWriter::SafeDownCast(formatObj))
   {
     vtkNew<vtkSMSaveAnimationProxyNS::SceneImageWriterMovie> realWriter;
     realWriter->SetHelper(this);
+    realWriter->SetNumberOfEncodingThreads(numberOfEncodingThreads);
     realWriter->SetWriter(0, movieWriter);
 
     // we need two movie writers when writing stereo videos
@@ -450,7 +858,6 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
 
   writer->SetAnimationScene(sceneProxy);
   writer->SetFileName(filename);
-  writer->SetStride(vtkSMPropertyHelper(this, "FrameStride").GetAsInt());
 
   // FIXME: we should consider cleaning up this API on vtkSMAnimationSceneWriter. For now,
   //        keeping it unchanged. This largely lifted from old code in
@@ -461,7 +868,7 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
   // values as animation time.
   int frameWindow[2] = { 0, 0 };
   vtkSMPropertyHelper(this, "FrameWindow").Get(frameWindow, 2);
-  double playbackTimeWindow[2] = { -1, 0 };
+  std::function<double(int)> frameToTime;
   switch (vtkSMPropertyHelper(sceneProxy, "PlayMode").GetAsInt())
   {
     case vtkCompositeAnimationPlayer::SEQUENCE:
@@ -471,10 +878,9 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
       double endTime = vtkSMPropertyHelper(sceneProxy, "EndTime").GetAsDouble();
       frameWindow[0] = frameWindow[0] < 0 ? 0 : frameWindow[0];
       frameWindow[1] = frameWindow[1] >= numFrames ? numFrames - 1 : frameWindow[1];
-      playbackTimeWindow[0] =
-        startTime + ((endTime - startTime) * frameWindow[0]) / (numFrames - 1);
-      playbackTimeWindow[1] =
-        startTime + ((endTime - startTime) * frameWindow[1]) / (numFrames - 1);
+      frameToTime = [=](int frame) {
+        return startTime + ((endTime - startTime) * frame) / (numFrames - 1);
+      };
     }
     break;
     case vtkCompositeAnimationPlayer::SNAP_TO_TIMESTEPS:
@@ -484,8 +890,10 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
       int numTS = tsValuesHelper.GetNumberOfElements();
       frameWindow[0] = frameWindow[0] < 0 ? 0 : frameWindow[0];
       frameWindow[1] = frameWindow[1] >= numTS ? numTS - 1 : frameWindow[1];
-      playbackTimeWindow[0] = tsValuesHelper.GetAsDouble(frameWindow[0]);
-      playbackTimeWindow[1] = tsValuesHelper.GetAsDouble(frameWindow[1]);
+      std::vector<double> timesteps = tsValuesHelper.GetDoubleArray();
+      frameToTime = [timesteps](int frame) {
+        return frame >= 0 && frame < static_cast<int>(timesteps.size()) ? timesteps[frame] : 0.0;
+      };
     }
 
     break;
@@ -494,15 +902,41 @@ bool vtkSMSaveAnimationProxy::WriteAnimationLocally(const char* filename)
       // changed the play mode to SEQUENCE or SNAP_TO_TIMESTEPS.
       abort();
   }
-  writer->SetStartFileCount(frameWindow[0]);
-  writer->SetPlaybackTimeWindow(playbackTimeWindow);
 
-  // register with progress handler so we monitor progress events.
-  this->GetSession()->GetProgressHandler()->RegisterProgressEvent(
-    writer.Get(), static_cast<int>(this->GetGlobalID()));
-  this->GetSession()->PrepareProgress();
-  bool status = writer->Save();
-  this->GetSession()->CleanupPendingProgress();
+  // When processes are split into time compartments, compartment `c` saves
+  // frames `c`, `c + N`, `c + 2N`... of the requested frames.
+  int stride = vtkSMPropertyHelper(this, "FrameStride").GetAsInt();
+  auto pm = vtkProcessModule::GetProcessModule();
+  const int numberOfCompartments = pm->GetNumberOfTimeCompartments();
+  bool hasFrames = true;
+  if (numberOfCompartments > 1)
+  {
+    const int numberOfFrames =
+      frameWindow[0] <= frameWindow[1] ? (frameWindow[1] - frameWindow[0]) / stride + 1 : 0;
+    if (auto movieWriter = vtkSMSaveAnimationProxyNS::SceneImageWriterMovie::SafeDownCast(writer))
+    {
+      movieWriter->SetTimeCompartments(pm->GetTimeCompartmentsController(), numberOfFrames);
+    }
+    frameWindow[0] += pm->GetTimeCompartmentIndex() * stride;
+    stride *= numberOfCompartments;
+    hasFrames = pm->GetTimeCompartmentIndex() < numberOfFrames;
+  }
+
+  bool status = true;
+  if (hasFrames)
+  {
+    double playbackTimeWindow[2] = { frameToTime(frameWindow[0]), frameToTime(frameWindow[1]) };
+    writer->SetStride(stride);
+    writer->SetStartFileCount(frameWindow[0]);
+    writer->SetPlaybackTimeWindow(playbackTimeWindow);
+
+    // register with progress handler so we monitor progress events.
+    this->GetSession()->GetProgressHandler()->RegisterProgressEvent(
+      writer.Get(), static_cast<int>(this->GetGlobalID()));
+    this->GetSession()->PrepareProgress();
+    status = writer->Save();
+    this->GetSession()->CleanupPendingProgress();
+  }
 
   this->Cleanup();
   return status;
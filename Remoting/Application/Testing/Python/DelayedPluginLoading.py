@@ -0,0 +1,66 @@
+# Registers the Moments plugin as delay-loaded and checks that its proxies are
+# known before the plugin gets loaded, and that looking one up loads it.
+
+from paraview.simple import *
+from paraview import servermanager
+from paraview.modules.vtkRemotingCore import vtkPVPluginTracker
+import sys
+
+tracker = vtkPVPluginTracker.GetInstance()
+
+def find_plugin(name):
+    for index in range(tracker.GetNumberOfPlugins()):
+        if tracker.GetPluginName(index) == name:
+            return index
+    return None
+
+index = find_plugin("Moments")
+if index is None:
+    print("Error: Moments plugin is not available")
+    sys.exit(1)
+if tracker.GetPluginLoaded(index):
+    print("Error: Moments plugin must not be loaded yet")
+    sys.exit(1)
+
+xml = """<Plugins>
+  <Plugin name="Moments" filename="%s" auto_load="1" delayed_load="1">
+    <Proxy group="filters" name="MomentVectors" label="Moment Vectors" />
+  </Plugin>
+</Plugins>""" % tracker.GetPluginFileName(index)
+
+session = servermanager.ActiveConnection.Session
+servermanager.vtkSMProxyManager.GetProxyManager().GetPluginManager() \
+    .LoadPluginConfigurationXMLFromString(xml, session, True)
+
+if tracker.GetPluginLoaded(index) or not tracker.GetPluginDelayedLoad(index):
+    print("Error: Moments plugin should have been delayed")
+    sys.exit(1)
+
+definitions = session.GetProxyDefinitionManager()
+if not definitions.HasDefinition("filters", "MomentVectors"):
+    print("Error: the definition of MomentVectors must be known before loading the plugin")
+    sys.exit(1)
+if tracker.GetPluginLoaded(index):
+    print("Error: looking a definition up must not load the plugin")
+    sys.exit(1)
+
+# Python lookups of other proxies of the group, and listing the group, must
+# not load the plugin either.
+if not servermanager.filters.Shrink or "MomentVectors" not in dir(servermanager.filters):
+    print("Error: MomentVectors must be listed in the filters module")
+    sys.exit(1)
+if tracker.GetPluginLoaded(index):
+    print("Error: looking other filters up must not load the plugin")
+    sys.exit(1)
+
+if not servermanager.filters.MomentVectors or not tracker.GetPluginLoaded(index):
+    print("Error: looking MomentVectors up should have loaded the plugin")
+    sys.exit(1)
+
+proxy = servermanager.ProxyManager().NewProxy("filters", "MomentVectors")
+if proxy is None:
+    print("Error: failed to create MomentVectors")
+    sys.exit(1)
+if tracker.GetPluginDelayedLoad(index):
+    print("Error: the plugin must not be delayed anymore once loaded")
+    sys.exit(1)
@@ -0,0 +1,75 @@
+# Test that the Python Calculator gives the same results whether expressions
+# are evaluated over chunks of the arrays, serially or on threads, or over the
+# whole arrays. Expressions reducing an array, such as `mean(RTData)`, cannot
+# be chunked and must fall back to the whole-array evaluation.
+
+from paraview.simple import *
+from paraview import smtesting
+from paraview.detail import calculator
+from vtkmodules.numpy_interface import dataset_adapter as dsa
+import numpy
+import sys
+
+smtesting.ProcessCommandLineArguments()
+
+wavelet = Wavelet(WholeExtent=[-20, 20, -20, 20, -20, 20])
+cells = PointDatatoCellData(Input=wavelet)
+
+def evaluate(source, expression, association, chunkSize=0, numberOfThreads=1):
+    calculator = PythonCalculator(Input=source, Expression=expression,
+                                  ArrayAssociation=association,
+                                  ChunkSize=chunkSize,
+                                  NumberOfThreads=numberOfThreads)
+    output = dsa.WrapDataObject(servermanager.Fetch(calculator))
+    Delete(calculator)
+    if association == 'Cell Data':
+        return output.CellData['result']
+    return output.PointData['result']
+
+elementwise = [
+    "RTData * 2 + sin(RTData)",
+    "sqrt(abs(RTData - 100))",
+    "points[:, 0] * RTData",
+    "make_vector(RTData, points[:, 1], points[:, 2])",
+    "mag(make_vector(RTData, RTData, RTData))",
+    ]
+reductions = [
+    "RTData - mean(RTData)",
+    "max(RTData) - RTData",
+    "RTData / sum(RTData)",
+    "RTData - RTData[0]",
+    ]
+
+failed = False
+
+# check which expressions take the chunked path at all.
+variables = {"RTData": dsa.VTKArray(numpy.arange(10.0)),
+             "points": dsa.VTKArray(numpy.zeros((10, 3)))}
+for expression in elementwise:
+    if not calculator.get_chunkable_arrays(expression, variables):
+        print("ERROR: '%s' is not evaluated in chunks" % expression)
+        failed = True
+for expression in reductions:
+    if calculator.get_chunkable_arrays(expression, variables) is not None:
+        print("ERROR: '%s' is evaluated in chunks" % expression)
+        failed = True
+for source, association in [(wavelet, 'Point Data'), (cells, 'Cell Data')]:
+    for expression in elementwise + reductions:
+        if association == 'Cell Data' and 'points' in expression:
+            continue
+        expected = evaluate(source, expression, association)
+        if expected is None or isinstance(expected, dsa.VTKNoneArray):
+            print("ERROR: '%s' gave no result on %s" % (expression, association))
+            failed = True
+            continue
+        for numberOfThreads in [1, 0, 3]:
+            result = evaluate(source, expression, association, 1000, numberOfThreads)
+            if result is None or isinstance(result, dsa.VTKNoneArray) or \
+                    result.shape != expected.shape or \
+                    not numpy.array_equal(numpy.asarray(result), numpy.asarray(expected)):
+                print("ERROR: '%s' on %s differs when chunked on %d threads" %
+                      (expression, association, numberOfThreads))
+                failed = True
+
+if failed:
+    sys.exit(1)
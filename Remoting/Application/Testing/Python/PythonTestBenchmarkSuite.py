@@ -0,0 +1,35 @@
+from paraview.simple import *
+
+import os
+import paraview.benchmark as pvb
+from paraview import smtesting
+smtesting.ProcessCommandLineArguments()
+
+tempdir = smtesting.GetUniqueTempDirectory("PythonTestBenchmarkSuite-")
+results = pvb.suite.run(scale=20, repeat=2, frames=2, view_size=(200, 200),
+                        workdir=tempdir)
+
+for name in pvb.suite.CASES:
+    result = results["results"][name]
+    if not 0 <= result["min"] <= result["median"] <= result["max"]:
+        raise RuntimeError("Invalid timings for %s: %s" % (name, result))
+if results["parameters"]["scale"] != 20 or not results["environment"]["paraview_version"]:
+    raise RuntimeError("Missing parameters or environment")
+
+filename = os.path.join(tempdir, "results.json")
+pvb.suite.save(results, filename)
+baseline = pvb.suite.load(filename)
+os.remove(filename)
+
+# same results, no regression.
+if pvb.suite.compare(results, baseline):
+    raise RuntimeError("Unexpected regression")
+
+# a baseline twice as fast reports all cases.
+for result in baseline["results"].values():
+    result["median"] /= 2.0
+regressions = pvb.suite.compare(results, baseline, tolerance=0.5)
+if len(regressions) != len(pvb.suite.CASES):
+    raise RuntimeError("Regressions not detected: %s" % regressions)
+
+print('SUCCESS')
@@ -0,0 +1,71 @@
+from paraview.simple import *
+
+import paraview.benchmark as pvb
+from paraview import smtesting
+smtesting.ProcessCommandLineArguments()
+
+# executions are not accounted for until tracking is enabled.
+sphere = Sphere()
+sphere.UpdatePipeline()
+if pvb.memory.get_memory_information(sphere)["executions"] != 0:
+    raise RuntimeError("Execution accounted for before tracking was enabled")
+Delete(sphere)
+del sphere
+pvb.memory.set_tracking(True)
+
+wavelet = Wavelet(WholeExtent=[-40, 40, -40, 40, -40, 40])
+contour = Contour(Input=wavelet, ContourBy=["POINTS", "RTData"], Isosurfaces=[150.0])
+view = CreateRenderView()
+Show(contour, view)
+Render(view)
+
+entries = dict((entry["name"], entry) for entry in pvb.memory.get_pipeline_memory())
+source = entries["Wavelet1"]
+# 81^3 points of a single float array, about 2 MiB.
+if source["output"] < 2000 or source["ranks"] < 1 or source["executions"] < 1:
+    raise RuntimeError("Invalid memory information for the wavelet: %s" % source)
+if source["max_rank"] > source["output"] + source["cached"] + source["delivered"]:
+    raise RuntimeError("Invalid maximum rank memory: %s" % source)
+
+representations = [e for e in entries.values() if e["kind"] == "representation"]
+if len(representations) != 1 or representations[0]["cached"] <= 0:
+    raise RuntimeError("Invalid memory information for the representation: %s" % representations)
+
+# no execution is accounted for while tracking is disabled.
+pvb.memory.set_tracking(False)
+wavelet.Maximum = 300.0
+contour.UpdatePipeline()
+if pvb.memory.get_memory_information(wavelet)["executions"] != source["executions"]:
+    raise RuntimeError("Execution accounted for while tracking is disabled")
+pvb.memory.set_tracking(True)
+
+# with a budget smaller than the wavelet, its output is released as it is
+# only consumed by the contour, and produced again when the contour executes.
+contour.UpdatePipeline()
+cells = contour.GetDataInformation().GetNumberOfCells()
+pvb.memory.get_budget_statistics(reset=True)
+pvb.memory.set_budget(1)
+stats = pvb.memory.get_budget_statistics()
+if stats["budget"] != 1 or stats["releases"] < 1 or stats["released"] < 2000:
+    raise RuntimeError("Wavelet output not released: %s" % stats)
+if pvb.memory.get_memory_information(wavelet)["output"] > 16:
+    raise RuntimeError("Wavelet output still allocated")
+
+# every proxy algorithm feeds a post filter, the visible contour is only
+# consumed by its representation through it and must not be released. The
+# post filter of the wavelet is released along with it, not accounted twice.
+if stats["releases"] != 1 or stats["released"] > 2 * source["output"]:
+    raise RuntimeError("Unexpected outputs released: %s" % stats)
+if pvb.memory.get_memory_information(contour)["output"] <= 0:
+    raise RuntimeError("Output of the visible contour released")
+
+contour.Isosurfaces = [160.0]
+contour.Isosurfaces = [150.0]
+Render(view)
+if pvb.memory.get_budget_statistics()["reexecutions"] < 1:
+    raise RuntimeError("Released output not produced again")
+if contour.GetDataInformation().GetNumberOfCells() != cells:
+    raise RuntimeError("Unexpected contour after the wavelet was released")
+pvb.memory.set_budget(0)
+
+print('SUCCESS')
@@ -0,0 +1,56 @@
+# Saves an image series with encoding threads and checks that the frames match
+# the ones written synchronously, and that a writer error fails the save and
+# is reported.
+
+from paraview.simple import *
+from paraview import smtesting
+from paraview.vtk.vtkCommonCore import vtkOutputWindow, vtkStringOutputWindow
+import os.path
+smtesting.ProcessCommandLineArguments()
+
+tempdir = smtesting.GetUniqueTempDirectory("SaveAnimationAsynchronous-")
+
+sphere = Sphere()
+shrink = Shrink(Input=sphere)
+Show(shrink)
+view = Render()
+
+scene = GetAnimationScene()
+scene.PlayMode = "Sequence"
+scene.NumberOfFrames = 8
+cue = GetAnimationTrack("ShrinkFactor", proxy=shrink)
+cue.KeyFrames = [CompositeKeyFrame(KeyTime=0.0, KeyValues=[0.2]),
+    CompositeKeyFrame(KeyTime=1.0, KeyValues=[1.0])]
+
+def read(filename):
+    with open(filename, "rb") as f:
+        return f.read()
+
+if not SaveAnimation(os.path.join(tempdir, "sync.png"), view, ImageResolution=[200, 200],
+        NumberOfEncodingThreads=0):
+    raise RuntimeError("Failed to save the animation synchronously")
+if not SaveAnimation(os.path.join(tempdir, "async.png"), view, ImageResolution=[200, 200],
+        NumberOfEncodingThreads=3):
+    raise RuntimeError("Failed to save the animation asynchronously")
+
+for frame in range(8):
+    sync = os.path.join(tempdir, "sync.%04d.png" % frame)
+    async_ = os.path.join(tempdir, "async.%04d.png" % frame)
+    if not os.path.exists(sync) or not os.path.exists(async_):
+        raise RuntimeError("Missing frame %d" % frame)
+    if read(sync) != read(async_):
+        raise RuntimeError("Frame %d differs when written asynchronously" % frame)
+
+# the writers fail to open files in a missing directory.
+messages = vtkStringOutputWindow()
+previous = vtkOutputWindow.GetInstance()
+vtkOutputWindow.SetInstance(messages)
+try:
+    status = SaveAnimation(os.path.join(tempdir, "missing", "frame.png"), view,
+        ImageResolution=[200, 200], NumberOfEncodingThreads=3)
+finally:
+    vtkOutputWindow.SetInstance(previous)
+if status:
+    raise RuntimeError("Saving to a missing directory did not fail")
+if not messages.GetOutput():
+    raise RuntimeError("The writer errors were not reported")
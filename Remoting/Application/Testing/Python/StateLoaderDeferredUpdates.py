@@ -0,0 +1,44 @@
+# Loads a state with deferred pipeline updates and checks that only the
+# pipeline shown in the view is updated, and that the timings are reported.
+
+from paraview.simple import *
+from paraview import smtesting
+import os.path
+smtesting.ProcessCommandLineArguments()
+
+sphere = Sphere()
+shrink = Shrink(Input=sphere)
+Show(shrink)
+elevation = Elevation(Input=sphere)
+Render()
+
+statefilename = os.path.join(smtesting.TempDir, "StateLoaderDeferredUpdates.pvsm")
+SaveState(statefilename)
+ResetSession()
+
+timings = LoadState(statefilename, defer_pipeline_updates=True)
+
+stages = {}
+for name, stage, seconds in timings:
+    if seconds < 0:
+        raise RuntimeError("Invalid duration for %s %s" % (name, stage))
+    stages.setdefault(stage, []).append(name)
+
+for stage in ("create", "information", "update"):
+    if stage not in stages:
+        raise RuntimeError("Missing '%s' timings: %s" % (stage, timings))
+if "Shrink1" not in stages["create"] or "Elevation1" not in stages["create"]:
+    raise RuntimeError("Missing proxies in 'create' timings: %s" % stages["create"])
+if stages["update"] != ["Shrink1"]:
+    raise RuntimeError("Only the shown pipeline should be updated: %s" % stages["update"])
+
+if FindSource("Shrink1").GetDataInformation().GetNumberOfPoints() == 0:
+    raise RuntimeError("The shown pipeline was not updated")
+
+# without deferral, the same state loads and reports no 'update' timings.
+ResetSession()
+timings = LoadState(statefilename)
+if not timings or any(stage == "update" for _, stage, _ in timings):
+    raise RuntimeError("Unexpected timings without deferred updates: %s" % timings)
+if not FindSource("Shrink1"):
+    raise RuntimeError("State was not loaded")
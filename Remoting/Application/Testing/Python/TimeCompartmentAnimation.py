@@ -0,0 +1,93 @@
+# Saves an animation with pvbatch split into time compartments, and checks that
+# the image series is complete with the frames in order, and that other outputs
+# are only written by the first compartment.
+from paraview.simple import *
+from paraview import smtesting
+from os.path import join, exists
+import os, shutil, sys
+
+from paraview.vtk.vtkIOImage import vtkPNGReader
+
+smtesting.ProcessCommandLineArguments()
+
+NumberOfFrames = 6
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+compartments = pm.GetTimeCompartmentsController()
+index = servermanager.GetTimeCompartmentIndex()
+
+def Barrier():
+    if compartments:
+        compartments.Barrier()
+
+def CountForegroundPixels(fname):
+    reader = vtkPNGReader()
+    reader.SetFileName(fname)
+    reader.Update()
+    scalars = reader.GetOutput().GetPointData().GetScalars()
+    count = 0
+    for i in range(scalars.GetNumberOfTuples()):
+        if scalars.GetTuple(i)[:3] != (0.0, 0.0, 0.0):
+            count += 1
+    return count
+
+if servermanager.GetNumberOfTimeCompartments() != 2:
+    print("Expected 2 time compartments, got %d." % servermanager.GetNumberOfTimeCompartments())
+    sys.exit(1)
+
+rootdir = join(smtesting.TempDir, "timecompartmentanimation")
+if index == 0:
+    shutil.rmtree(rootdir, ignore_errors=True)
+    os.makedirs(rootdir)
+Barrier()
+
+sphere = Sphere()
+view = CreateRenderView()
+view.ViewSize = [200, 200]
+view.Background = [0, 0, 0]
+view.OrientationAxesVisibility = 0
+display = Show(sphere, view)
+display.AmbientColor = display.DiffuseColor = [1, 1, 1]
+view.CameraPosition = [0, 0, 5]
+view.CameraFocalPoint = [0, 0, 0]
+view.CameraViewUp = [0, 1, 0]
+view.CameraParallelProjection = 1
+view.CameraParallelScale = 1
+
+# The radius grows with each frame, so frames in order cover more pixels.
+scene = GetAnimationScene()
+scene.PlayMode = "Sequence"
+scene.NumberOfFrames = NumberOfFrames
+track = GetAnimationTrack("Radius", proxy=sphere)
+track.KeyFrames = [CompositeKeyFrame(KeyTime=0, KeyValues=[0.2]),
+                   CompositeKeyFrame(KeyTime=1, KeyValues=[0.9])]
+
+SaveAnimation(join(rootdir, "frame.png"), view, ImageResolution=[200, 200])
+
+# Every compartment asks for these, only the first one writes them.
+SaveScreenshot(join(rootdir, "screenshot-%d.png" % index), view)
+SaveData(join(rootdir, "sphere-%d.vtp" % index), sphere)
+SaveState(join(rootdir, "state-%d.pvsm" % index))
+Barrier()
+
+if index == 0:
+    for fname in ["screenshot-0.png", "sphere-0.vtp", "state-0.pvsm"]:
+        if not exists(join(rootdir, fname)):
+            print("'%s' was not written by the first compartment." % fname)
+            sys.exit(1)
+    for fname in ["screenshot-1.png", "sphere-1.vtp", "state-1.pvsm"]:
+        if exists(join(rootdir, fname)):
+            print("'%s' was written by another compartment." % fname)
+            sys.exit(1)
+
+    counts = []
+    for frame in range(NumberOfFrames):
+        fname = join(rootdir, "frame.%04d.png" % frame)
+        if not exists(fname):
+            print("Frame '%s' is missing." % fname)
+            sys.exit(1)
+        counts.append(CountForegroundPixels(fname))
+    if any(a >= b for a, b in zip(counts, counts[1:])):
+        print("Frames are not in order, foreground pixels: %s" % counts)
+        sys.exit(1)
+Barrier()
@@ -0,0 +1,21 @@
+# Checks that paraview.benchmark.traceevents records events and gathers them
+# once in a builtin session, where the client and the servers are the same
+# process.
+import json
+
+from paraview.simple import *
+from paraview.benchmark import traceevents
+
+traceevents.start()
+sphere = Sphere()
+Show(sphere)
+Render()
+traceevents.stop()
+
+events = json.loads(traceevents.get_trace())["traceEvents"]
+if not events:
+    raise RuntimeError("No event was recorded.")
+
+keys = [json.dumps(event, sort_keys=True) for event in events]
+if len(set(keys)) != len(keys):
+    raise RuntimeError("Events were gathered more than once.")
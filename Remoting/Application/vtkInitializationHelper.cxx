@@ -276,6 +276,16 @@ bool vtkInitializationHelper::Initialize(
     return false;
   }
 
+  // split processes into time compartments, if requested. This must happen
+  // before any session is created.
+  if (!vtkProcessModule::InitializeTimeCompartments(
+        vtkProcessModuleConfiguration::GetInstance()->GetNumberOfTimeCompartments()))
+  {
+    vtkProcessModule::Finalize();
+    vtkInitializationHelper::ExitCode = EXIT_FAILURE;
+    return false;
+  }
+
   // this has to happen after process module is initialized and options have
   // been set.
   paraview_initialize();
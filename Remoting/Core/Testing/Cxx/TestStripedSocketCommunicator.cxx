@@ -0,0 +1,193 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestStripedSocketCommunicator.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks vtkPVStripedSocketCommunicator over a loopback connection and reports
+// the throughput of bulk transfers for several numbers of streams. Also checks
+// that sides requesting different numbers of streams still communicate.
+
+#include "vtkNew.h"
+#include "vtkPVStripedSocketCommunicator.h"
+#include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
+#include "vtkSocketCommunicator.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int BULK_TAG = 4242;
+
+// Either side may be a plain vtkSocketCommunicator, which does not stripe.
+// `numberOfStreams` is the number both sides agreed on, e.g. during the
+// vtkTCPNetworkAccessManager handshake; nothing is exchanged for a single one.
+bool Connect(
+  vtkSocketCommunicator* sender, vtkSocketCommunicator* receiver, int numberOfStreams)
+{
+  vtkNew<vtkServerSocket> server;
+  if (server->CreateServer(0) != 0)
+  {
+    std::cerr << "Failed to create server socket." << std::endl;
+    return false;
+  }
+  const int port = server->GetServerPort();
+
+  bool accepted = false;
+  std::thread listener([&]() {
+    if (receiver->WaitForConnection(server, 10000))
+    {
+      auto striped = vtkPVStripedSocketCommunicator::SafeDownCast(receiver);
+      accepted =
+        numberOfStreams <= 1 || (striped && striped->AcceptStreams(server, numberOfStreams));
+    }
+  });
+
+  bool connected = false;
+  if (sender->ConnectTo("localhost", port))
+  {
+    auto striped = vtkPVStripedSocketCommunicator::SafeDownCast(sender);
+    connected = numberOfStreams <= 1 ||
+      (striped && striped->ConnectStreams("localhost", port, numberOfStreams));
+  }
+  listener.join();
+
+  for (auto comm : { sender, receiver })
+  {
+    auto striped = vtkPVStripedSocketCommunicator::SafeDownCast(comm);
+    if (striped && striped->GetNumberOfStreams() != numberOfStreams)
+    {
+      return false;
+    }
+  }
+  return accepted && connected;
+}
+
+template <typename T>
+bool Transfer(
+  vtkSocketCommunicator* sender, vtkSocketCommunicator* receiver, vtkIdType length, double& seconds)
+{
+  std::vector<T> sent(length);
+  for (vtkIdType cc = 0; cc < length; ++cc)
+  {
+    sent[cc] = static_cast<T>(cc % 65521);
+  }
+  std::vector<T> received(length + 16, 0);
+
+  const auto start = std::chrono::steady_clock::now();
+  std::thread sending([&]() { sender->Send(sent.data(), length, 1, BULK_TAG); });
+  const int status =
+    receiver->Receive(received.data(), static_cast<vtkIdType>(received.size()), 1, BULK_TAG);
+  sending.join();
+  seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  if (!status || receiver->GetCount() != length)
+  {
+    std::cerr << "Received " << receiver->GetCount() << " values instead of " << length
+              << std::endl;
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < length; ++cc)
+  {
+    if (received[cc] != sent[cc])
+    {
+      std::cerr << "Mismatch at value " << cc << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// One side requested several streams while the other requested a single one,
+// or does not stripe at all, hence they agreed on a single stream. Messages
+// with striped tags must be exchanged as plain messages.
+bool TestMismatchedStreams(bool stripedReceiver)
+{
+  vtkNew<vtkPVStripedSocketCommunicator> sender;
+  vtkSmartPointer<vtkSocketCommunicator> receiver;
+  if (stripedReceiver)
+  {
+    receiver = vtkSmartPointer<vtkPVStripedSocketCommunicator>::New();
+  }
+  else
+  {
+    receiver = vtkSmartPointer<vtkSocketCommunicator>::New();
+  }
+  if (!Connect(sender, receiver, 1))
+  {
+    std::cerr << "Failed to connect a single stream." << std::endl;
+    return false;
+  }
+  sender->AddStripedTag(BULK_TAG);
+  vtkPVStripedSocketCommunicator::StripeTag(receiver, BULK_TAG);
+
+  double seconds;
+  const bool success = Transfer<int>(sender, receiver, 100, seconds) &&
+    Transfer<double>(sender, receiver, 1024 * 1024, seconds) &&
+    Transfer<double>(receiver, sender, 1024 * 1024, seconds);
+  sender->CloseConnection();
+  receiver->CloseConnection();
+  return success;
+}
+}
+
+int TestStripedSocketCommunicator(int, char*[])
+{
+  if (!TestMismatchedStreams(true) || !TestMismatchedStreams(false))
+  {
+    return EXIT_FAILURE;
+  }
+
+  for (int numberOfStreams : { 1, 2, 4 })
+  {
+    vtkNew<vtkPVStripedSocketCommunicator> sender;
+    vtkNew<vtkPVStripedSocketCommunicator> receiver;
+    if (!Connect(sender, receiver, numberOfStreams))
+    {
+      std::cerr << "Failed to connect " << numberOfStreams << " streams." << std::endl;
+      return EXIT_FAILURE;
+    }
+    sender->AddStripedTag(BULK_TAG);
+    receiver->AddStripedTag(BULK_TAG);
+
+    // A message smaller than the stripe threshold, then one whose size is not
+    // a multiple of the segment size.
+    double seconds;
+    if (!Transfer<int>(sender, receiver, 100, seconds) ||
+      !Transfer<char>(sender, receiver, 3 * 1024 * 1024 + 7, seconds))
+    {
+      return EXIT_FAILURE;
+    }
+
+    const vtkIdType length = 8 * 1024 * 1024;
+    double total = 0.0;
+    for (int iteration = 0; iteration < 3; ++iteration)
+    {
+      if (!Transfer<double>(sender, receiver, length, seconds))
+      {
+        return EXIT_FAILURE;
+      }
+      total += seconds;
+    }
+    const double megabytes = 3.0 * length * sizeof(double) / (1024.0 * 1024.0);
+    std::cout << "Streams: " << numberOfStreams << " throughput: " << megabytes / total
+              << " MiB/s" << std::endl;
+
+    sender->CloseConnection();
+    receiver->CloseConnection();
+  }
+  return EXIT_SUCCESS;
+}
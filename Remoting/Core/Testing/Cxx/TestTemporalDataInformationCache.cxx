@@ -0,0 +1,176 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestTemporalDataInformationCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPVTemporalDataInformation only executes the pipeline for
+// timesteps it has not seen since the pipeline was modified, that the cache
+// is bounded and that it drops the ports of deleted algorithms.
+
+#include "vtkDoubleArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVTemporalDataInformation.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+// Produces a single point with a "time" array holding the time, for
+// timesteps 0, 1, 2 and 3, and counts its executions.
+class TimeStepsSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TimeStepsSource* New();
+  vtkTypeMacro(TimeStepsSource, vtkPolyDataAlgorithm);
+
+  int NumberOfExecutions = 0;
+
+protected:
+  TimeStepsSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    const double timesteps[] = { 0, 1, 2, 3 };
+    const double range[] = { 0, 3 };
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), timesteps, 4);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    ++this->NumberOfExecutions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const double time = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      : 0.0;
+
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkNew<vtkPoints> points;
+    points->InsertNextPoint(0, 0, 0);
+    output->SetPoints(points);
+    vtkNew<vtkDoubleArray> array;
+    array->SetName("time");
+    array->InsertNextValue(time);
+    output->GetPointData()->AddArray(array);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TimeStepsSource);
+
+bool GetTimeRange(vtkAlgorithm* source, double range[2])
+{
+  vtkNew<vtkPVTemporalDataInformation> info;
+  info->CopyFromObject(source->GetOutputPort(0));
+  vtkPVArrayInformation* array = info->GetArrayInformation("time", vtkDataObject::POINT);
+  if (!array)
+  {
+    return false;
+  }
+  array->GetComponentRange(0, range);
+  return true;
+}
+}
+
+int TestTemporalDataInformationCache(int, char*[])
+{
+  vtkPVTemporalDataInformation::ClearCache();
+
+  auto source = vtkSmartPointer<TimeStepsSource>::New();
+  double range[2];
+  if (!GetTimeRange(source, range) || range[0] != 0 || range[1] != 3)
+  {
+    vtkLogF(ERROR, "Incorrect range over all timesteps.");
+    return EXIT_FAILURE;
+  }
+  if (source->NumberOfExecutions != 4)
+  {
+    vtkLogF(ERROR, "Expected 4 executions, got %d.", source->NumberOfExecutions);
+    return EXIT_FAILURE;
+  }
+
+  // Gathering again, after the last update changed the current time, is
+  // served from the cache.
+  if (!GetTimeRange(source, range) || range[0] != 0 || range[1] != 3 ||
+    source->NumberOfExecutions != 4)
+  {
+    vtkLogF(ERROR, "The cached timesteps were executed again.");
+    return EXIT_FAILURE;
+  }
+
+  // Modifying the pipeline invalidates the cache.
+  source->Modified();
+  if (!GetTimeRange(source, range) || source->NumberOfExecutions != 8)
+  {
+    vtkLogF(ERROR, "Expected all timesteps to be executed again after a modification, got %d.",
+      source->NumberOfExecutions - 4);
+    return EXIT_FAILURE;
+  }
+
+  if (vtkPVTemporalDataInformation::GetNumberOfCachedPorts() != 1)
+  {
+    vtkLogF(ERROR, "Expected a single cached port.");
+    return EXIT_FAILURE;
+  }
+  source = nullptr;
+  if (vtkPVTemporalDataInformation::GetNumberOfCachedPorts() != 0)
+  {
+    vtkLogF(ERROR, "The port of a deleted algorithm is still cached.");
+    return EXIT_FAILURE;
+  }
+
+  // The cache is bounded, the first source is dropped first.
+  std::vector<vtkSmartPointer<TimeStepsSource>> sources;
+  for (int cc = 0; cc < 40; ++cc)
+  {
+    sources.push_back(vtkSmartPointer<TimeStepsSource>::New());
+    GetTimeRange(sources.back(), range);
+  }
+  const size_t numberOfCachedPorts = vtkPVTemporalDataInformation::GetNumberOfCachedPorts();
+  if (numberOfCachedPorts == 0 || numberOfCachedPorts >= sources.size())
+  {
+    vtkLogF(ERROR, "Expected the cache to be bounded, %d ports are cached.",
+      static_cast<int>(numberOfCachedPorts));
+    return EXIT_FAILURE;
+  }
+  const int executions = sources.front()->NumberOfExecutions;
+  GetTimeRange(sources.front(), range);
+  if (sources.front()->NumberOfExecutions == executions)
+  {
+    vtkLogF(ERROR, "The least recently used port was not dropped.");
+    return EXIT_FAILURE;
+  }
+
+  vtkPVTemporalDataInformation::ClearCache();
+  if (vtkPVTemporalDataInformation::GetNumberOfCachedPorts() != 0)
+  {
+    vtkLogF(ERROR, "ClearCache() did not clear the cache.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
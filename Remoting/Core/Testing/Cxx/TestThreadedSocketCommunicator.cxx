@@ -0,0 +1,194 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestThreadedSocketCommunicator.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPVThreadedSocketCommunicator delivers messages in order over
+// a loopback connection, whether they are queued, wait for room in the queue
+// or are too large to be copied, that all of them are written by the I/O
+// thread, and that stopping the I/O thread sends the messages still queued.
+
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVThreadedSocketCommunicator.h"
+#include "vtkServerSocket.h"
+#include "vtkSocketCommunicator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int TAG = 4242;
+constexpr vtkTypeInt64 MAXIMUM_QUEUED_BYTES = 1024 * 1024;
+
+// Records whether messages are written to the socket by the thread that
+// created the communicator.
+class ThreadRecordingCommunicator : public vtkPVThreadedSocketCommunicator
+{
+public:
+  static ThreadRecordingCommunicator* New();
+  vtkTypeMacro(ThreadRecordingCommunicator, vtkPVThreadedSocketCommunicator);
+
+  std::atomic<bool> SentFromCallerThread{ false };
+
+protected:
+  ThreadRecordingCommunicator() = default;
+
+  int SendImmediately(
+    const void* data, vtkIdType length, int type, int remoteHandle, int tag) override
+  {
+    if (std::this_thread::get_id() == this->CallerThread)
+    {
+      this->SentFromCallerThread = true;
+    }
+    return this->Superclass::SendImmediately(data, length, type, remoteHandle, tag);
+  }
+
+private:
+  const std::thread::id CallerThread = std::this_thread::get_id();
+};
+vtkStandardNewMacro(ThreadRecordingCommunicator);
+
+bool Connect(vtkPVThreadedSocketCommunicator* sender, vtkSocketCommunicator* receiver)
+{
+  vtkNew<vtkServerSocket> server;
+  if (server->CreateServer(0) != 0)
+  {
+    std::cerr << "Failed to create server socket." << std::endl;
+    return false;
+  }
+  const int port = server->GetServerPort();
+
+  bool accepted = false;
+  std::thread listener([&]() { accepted = receiver->WaitForConnection(server, 10000) != 0; });
+  const bool connected = sender->ConnectTo("localhost", port) != 0;
+  listener.join();
+  return accepted && connected;
+}
+
+std::vector<double> MakeMessage(vtkIdType length, int seed)
+{
+  std::vector<double> message(length);
+  for (vtkIdType cc = 0; cc < length; ++cc)
+  {
+    message[cc] = seed + cc * 0.5;
+  }
+  return message;
+}
+
+// Sends the messages, then either flushes or stops the I/O thread, while the
+// receiver checks that they all arrive unchanged and in order.
+bool Exchange(vtkPVThreadedSocketCommunicator* sender, vtkSocketCommunicator* receiver,
+  const std::vector<std::vector<double>>& messages, bool stop)
+{
+  bool received = true;
+  std::thread receiving([&]() {
+    for (size_t cc = 0; cc < messages.size() && received; ++cc)
+    {
+      const auto& expected = messages[cc];
+      std::vector<double> buffer(expected.size() + 1, -1.0);
+      if (!receiver->Receive(buffer.data(), static_cast<vtkIdType>(buffer.size()), 1, TAG) ||
+        receiver->GetCount() != static_cast<vtkIdType>(expected.size()) ||
+        !std::equal(expected.begin(), expected.end(), buffer.begin()))
+      {
+        std::cerr << "Message " << cc << " was not received as sent." << std::endl;
+        received = false;
+      }
+    }
+  });
+
+  bool sent = true;
+  for (const auto& message : messages)
+  {
+    sent = sender->Send(message.data(), static_cast<vtkIdType>(message.size()), 1, TAG) && sent;
+  }
+  if (stop)
+  {
+    sender->StopIOThread();
+  }
+  else
+  {
+    sent = sender->Flush() && sent;
+  }
+  receiving.join();
+  if (!sent)
+  {
+    std::cerr << "Failed to send the messages." << std::endl;
+  }
+  return sent && received;
+}
+}
+
+int TestThreadedSocketCommunicator(int, char*[])
+{
+  vtkNew<ThreadRecordingCommunicator> sender;
+  vtkNew<vtkSocketCommunicator> receiver;
+  if (!Connect(sender, receiver))
+  {
+    std::cerr << "Failed to connect." << std::endl;
+    return EXIT_FAILURE;
+  }
+  sender->SetMaximumQueuedBytes(MAXIMUM_QUEUED_BYTES);
+  if (!sender->StartIOThread() || !sender->GetIOThreadRunning())
+  {
+    std::cerr << "Failed to start the I/O thread." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Many small messages, that are all queued.
+  std::vector<std::vector<double>> small;
+  for (int cc = 0; cc < 1000; ++cc)
+  {
+    small.push_back(MakeMessage(1 + cc % 7, cc));
+  }
+
+  // Messages that fit in the queue one at a time, then one too large to be
+  // copied, sent between queued messages.
+  const vtkIdType half = MAXIMUM_QUEUED_BYTES / sizeof(double) / 2 + 1;
+  const vtkIdType large = 4 * MAXIMUM_QUEUED_BYTES / sizeof(double) + 3;
+  const std::vector<std::vector<double>> mixed = { MakeMessage(half, 1), MakeMessage(half, 2),
+    MakeMessage(half, 3), MakeMessage(large, 4), MakeMessage(10, 5), MakeMessage(large, 6),
+    MakeMessage(half, 7) };
+
+  if (!Exchange(sender, receiver, small, false) || !Exchange(sender, receiver, mixed, false))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Stopping right after a burst must not drop the messages still queued.
+  std::vector<std::vector<double>> burst = small;
+  burst.insert(burst.end(), mixed.begin(), mixed.end());
+  if (!Exchange(sender, receiver, burst, true) || sender->GetIOThreadRunning())
+  {
+    return EXIT_FAILURE;
+  }
+  if (sender->SentFromCallerThread)
+  {
+    std::cerr << "Messages were sent from the caller's thread." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Without the I/O thread, messages are sent synchronously.
+  if (!Exchange(sender, receiver, mixed, false))
+  {
+    return EXIT_FAILURE;
+  }
+
+  sender->CloseConnection();
+  receiver->CloseConnection();
+  return EXIT_SUCCESS;
+}
@@ -18,6 +18,7 @@
 #include "vtkMPIMToNSocketConnectionPortInformation.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVStripedSocketCommunicator.h"
 #include "vtkProcessModule.h"
 #include "vtkRemotingCoreConfiguration.h"
 #include "vtkServerSocket.h"
@@ -55,6 +56,7 @@ vtkMPIMToNSocketConnection::vtkMPIMToNSocketConnection()
   this->NumberOfConnections = -1;
   this->ServerSocket = nullptr;
   this->IsWaiting = false;
+  this->NumberOfStreams = 1;
 }
 
 vtkMPIMToNSocketConnection::~vtkMPIMToNSocketConnection()
@@ -94,6 +96,7 @@ void vtkMPIMToNSocketConnection::PrintSelf(ostream& os, vtkIndent indent)
     os << i3 << "HostName: " << this->Internals->ServerInformation[i].HostName.c_str() << "\n";
   }
   os << indent << "PortNumber: " << this->PortNumber << endl;
+  os << indent << "NumberOfStreams: " << this->NumberOfStreams << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -136,7 +139,7 @@ void vtkMPIMToNSocketConnection::SetupWaitForConnection()
   {
     return;
   }
-  this->SocketCommunicator = vtkSocketCommunicator::New();
+  this->SocketCommunicator = vtkPVStripedSocketCommunicator::New();
   // open a socket on a random port
   vtkDebugMacro(<< "open with port " << this->PortNumber);
   this->ServerSocket = vtkServerSocket::New();
@@ -169,10 +172,10 @@ void vtkMPIMToNSocketConnection::WaitForConnection()
        << " port :" << this->PortNumber << "\n";
 
   vtkClientSocket* socket = this->ServerSocket->WaitForConnection();
-  this->ServerSocket->Delete();
-  this->ServerSocket = nullptr;
   if (!socket)
   {
+    this->ServerSocket->Delete();
+    this->ServerSocket = nullptr;
     vtkErrorMacro("Failed to get connection!");
     return;
   }
@@ -184,6 +187,15 @@ void vtkMPIMToNSocketConnection::WaitForConnection()
   this->SocketCommunicator->Receive(&data, 1, 1, 1238);
   cout << "Received Hello from process " << data << "\n";
   cout.flush();
+
+  // The additional streams connect to the same server socket.
+  auto comm = vtkPVStripedSocketCommunicator::SafeDownCast(this->SocketCommunicator);
+  if (this->NumberOfStreams > 1 && !comm->AcceptStreams(this->ServerSocket, this->NumberOfStreams))
+  {
+    vtkErrorMacro("Failed to accept " << this->NumberOfStreams << " streams.");
+  }
+  this->ServerSocket->Delete();
+  this->ServerSocket = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -200,7 +212,7 @@ void vtkMPIMToNSocketConnection::Connect()
     return;
   }
 
-  this->SocketCommunicator = vtkSocketCommunicator::New();
+  this->SocketCommunicator = vtkPVStripedSocketCommunicator::New();
 
   const vtkMPIMToNSocketConnectionInternals::NodeInformation& targetNode =
     this->Internals->ServerInformation[myId];
@@ -214,6 +226,14 @@ void vtkMPIMToNSocketConnection::Connect()
 
   int id = static_cast<int>(myId);
   this->SocketCommunicator->Send(&id, 1, 1, 1238);
+
+  auto comm = vtkPVStripedSocketCommunicator::SafeDownCast(this->SocketCommunicator);
+  if (this->NumberOfStreams > 1 &&
+    !comm->ConnectStreams(
+      targetNode.HostName.c_str(), targetNode.PortNumber, this->NumberOfStreams))
+  {
+    vtkErrorMacro("Failed to connect " << this->NumberOfStreams << " streams.");
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -245,6 +265,10 @@ void vtkMPIMToNSocketConnection::SetPortInformation(
 //------------------------------------------------------------------------------
 void vtkMPIMToNSocketConnection::GetPortInformation(vtkMPIMToNSocketConnectionPortInformation* info)
 {
+  // Every server reports the number of streams it requested, the client picks
+  // the number used by both.
+  info->SetNumberOfStreams(vtkRemotingCoreConfiguration::GetInstance()->GetSocketStreams());
+
   // This method must be called only on the "Waiting" process.
   if (this->NumberOfConnections == -1)
   {
@@ -28,6 +28,9 @@
  * number of rendering processors are call N.  This class is used to create N
  * vtkSocketCommunicator's that connect the first N of the M processes on the
  * data server to the N processes on the render server.
+ *
+ * Each of these connections may use several sockets to transfer large
+ * buffers, see `SetNumberOfStreams()`.
  */
 
 #ifndef vtkMPIMToNSocketConnection_h
@@ -87,6 +90,19 @@ public:
   vtkGetMacro(PortNumber, int);
   //@}
 
+  //@{
+  /**
+   * Number of sockets used for each connection. Large buffers are striped
+   * over these sockets, see vtkPVStripedSocketCommunicator. Both servers must
+   * use the same value, hence the client sets it before `ConnectMtoN()` to
+   * the smallest `--socket-streams` requested by the servers (see
+   * vtkMPIMToNSocketConnectionPortInformation) when both requested more than
+   * one. Defaults to 1.
+   */
+  vtkSetClampMacro(NumberOfStreams, int, 1, 64);
+  vtkGetMacro(NumberOfStreams, int);
+  //@}
+
 protected:
   vtkSetMacro(PortNumber, int);
 
@@ -117,6 +133,7 @@ private:
   int Socket;
   vtkServerSocket* ServerSocket;
   int NumberOfConnections;
+  int NumberOfStreams;
   vtkMPIMToNSocketConnectionInternals* Internals;
   vtkMultiProcessController* Controller;
   vtkSocketCommunicator* SocketCommunicator;
@@ -17,6 +17,8 @@
 #include "vtkClientServerStream.h"
 #include "vtkMPIMToNSocketConnection.h"
 #include "vtkObjectFactory.h"
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -37,6 +39,7 @@ vtkStandardNewMacro(vtkMPIMToNSocketConnectionPortInformation);
 vtkMPIMToNSocketConnectionPortInformation::vtkMPIMToNSocketConnectionPortInformation()
 {
   this->Internals = new vtkMPIMToNSocketConnectionPortInformationInternals;
+  this->NumberOfStreams = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -51,6 +54,7 @@ void vtkMPIMToNSocketConnectionPortInformation::PrintSelf(ostream& os, vtkIndent
 {
   this->Superclass::PrintSelf(os, indent);
   vtkIndent i2 = indent.GetNextIndent();
+  os << indent << "NumberOfStreams: " << this->NumberOfStreams << "\n";
   os << indent << "All Process Information:\n";
   for (unsigned int i = 0; i < this->Internals->Connections.size(); ++i)
   {
@@ -106,6 +110,7 @@ void vtkMPIMToNSocketConnectionPortInformation::AddInformation(vtkPVInformation*
   {
     this->Internals->Connections.resize(info->Internals->Connections.size());
   }
+  this->NumberOfStreams = std::max(this->NumberOfStreams, info->NumberOfStreams);
 
   for (size_t cc = 0; cc < info->Internals->Connections.size(); cc++)
   {
@@ -126,6 +131,10 @@ void vtkMPIMToNSocketConnectionPortInformation::CopyToStream(vtkClientServerStre
     *css << this->Internals->Connections[i].PortNumber
          << this->Internals->Connections[i].HostName.c_str();
   }
+  if (this->NumberOfStreams > 1)
+  {
+    *css << this->NumberOfStreams;
+  }
   *css << vtkClientServerStream::End;
 }
 
@@ -149,6 +158,12 @@ void vtkMPIMToNSocketConnectionPortInformation::CopyFromStream(const vtkClientSe
     this->Internals->Connections[j].PortNumber = port;
     this->Internals->Connections[j].HostName = hostname ? hostname : "";
   }
+
+  this->NumberOfStreams = 1;
+  if (css->GetNumberOfArguments(0) > pos)
+  {
+    css->GetArgument(0, pos, &this->NumberOfStreams);
+  }
 }
 
 //----------------------------------------------------------------------------
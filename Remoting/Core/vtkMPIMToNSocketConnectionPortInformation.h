@@ -54,6 +54,15 @@ public:
   const char* GetProcessHostName(unsigned int processNumber);
   //@}
 
+  //@{
+  /**
+   * Number of sockets the server requested for each connection with the
+   * `--socket-streams` command line option. Defaults to 1.
+   */
+  vtkSetClampMacro(NumberOfStreams, int, 1, 64);
+  vtkGetMacro(NumberOfStreams, int);
+  //@}
+
   /**
    * Transfer information about a single object into this object.
    */
@@ -77,6 +86,7 @@ protected:
   ~vtkMPIMToNSocketConnectionPortInformation() override;
 
   int NumberOfConnections;
+  int NumberOfStreams;
   vtkMPIMToNSocketConnectionPortInformationInternals* Internals;
 
 private:
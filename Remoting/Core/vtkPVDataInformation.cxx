@@ -51,6 +51,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVArrayInformation.h"
+#include "vtkPVCompositeDataPipeline.h"
 #include "vtkPVDataSetAttributesInformation.h"
 #include "vtkPVInformationKeys.h"
 #include "vtkPVLogger.h"
@@ -336,6 +337,50 @@ void vtkPVDataInformation::Initialize()
   this->DataAssembly->Initialize();
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Produces again the outputs of the algorithm providing `object` when the
+// output information is gathered from was emptied to meet the memory budget.
+void UpdateReleasedOutputs(vtkObject* object, int portNumber)
+{
+  vtkAlgorithm* producer = nullptr;
+  int port = portNumber;
+  if (auto algOutput = vtkAlgorithmOutput::SafeDownCast(object))
+  {
+    producer = algOutput->GetProducer();
+    port = algOutput->GetIndex();
+    if (producer && producer->IsA("vtkPVPostFilter"))
+    {
+      algOutput = producer->GetInputConnection(0, 0);
+      producer = algOutput ? algOutput->GetProducer() : nullptr;
+      port = algOutput ? algOutput->GetIndex() : 0;
+    }
+  }
+  else
+  {
+    producer = vtkAlgorithm::SafeDownCast(object);
+  }
+
+  auto executive =
+    vtkPVCompositeDataPipeline::SafeDownCast(producer ? producer->GetExecutive() : nullptr);
+  if (!executive || !executive->GetOutputsReleased() || port < 0 ||
+    port >= executive->GetNumberOfOutputPorts())
+  {
+    return;
+  }
+  // the outputs are released on all processes at once, hence this is
+  // consistent across processes.
+  vtkDataObject* output = executive->GetOutputData(port);
+  if (output && output->GetDataReleased())
+  {
+    vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), "updating released outputs of %s",
+      vtkLogIdentifier(producer).c_str());
+    executive->Update(port);
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyFromObject(vtkObject* object)
 {
@@ -346,6 +391,10 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
     return;
   }
 
+  // done on all processes, before skipping those not gathered from, since
+  // executing the pipeline may communicate.
+  ::UpdateReleasedOutputs(object, this->PortNumber);
+
   auto pm = vtkProcessModule::GetProcessModule();
   if (this->Rank != -1 && this->Rank != pm->GetPartitionId())
   {
@@ -0,0 +1,94 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVMemoryBudgetInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVMemoryBudgetInformation.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVCompositeDataPipeline.h"
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkPVMemoryBudgetInformation);
+//----------------------------------------------------------------------------
+vtkPVMemoryBudgetInformation::vtkPVMemoryBudgetInformation() = default;
+
+//----------------------------------------------------------------------------
+vtkPVMemoryBudgetInformation::~vtkPVMemoryBudgetInformation() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetInformation::CopyFromObject(vtkObject*)
+{
+  this->NumberOfProcesses = 1;
+  this->MemoryBudget = vtkPVCompositeDataPipeline::GetMemoryBudget();
+  this->BudgetedMemorySize = vtkPVCompositeDataPipeline::GetBudgetedMemorySize();
+  this->MaximumBudgetedMemorySize = vtkPVCompositeDataPipeline::GetMaximumBudgetedMemorySize();
+  this->NumberOfReleasedOutputs = vtkPVCompositeDataPipeline::GetNumberOfReleasedOutputs();
+  this->ReleasedMemorySize = vtkPVCompositeDataPipeline::GetReleasedMemorySize();
+  this->NumberOfReexecutions = vtkPVCompositeDataPipeline::GetNumberOfReexecutions();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetInformation::AddInformation(vtkPVInformation* info)
+{
+  auto other = vtkPVMemoryBudgetInformation::SafeDownCast(info);
+  if (!other)
+  {
+    return;
+  }
+
+  this->NumberOfProcesses += other->NumberOfProcesses;
+  this->MemoryBudget = std::max(this->MemoryBudget, other->MemoryBudget);
+  this->BudgetedMemorySize = std::max(this->BudgetedMemorySize, other->BudgetedMemorySize);
+  this->MaximumBudgetedMemorySize =
+    std::max(this->MaximumBudgetedMemorySize, other->MaximumBudgetedMemorySize);
+  this->NumberOfReleasedOutputs += other->NumberOfReleasedOutputs;
+  this->ReleasedMemorySize += other->ReleasedMemorySize;
+  this->NumberOfReexecutions += other->NumberOfReexecutions;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << this->NumberOfProcesses << this->MemoryBudget
+       << this->BudgetedMemorySize << this->MaximumBudgetedMemorySize
+       << this->NumberOfReleasedOutputs << this->ReleasedMemorySize << this->NumberOfReexecutions
+       << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  css->GetArgument(0, 0, &this->NumberOfProcesses);
+  css->GetArgument(0, 1, &this->MemoryBudget);
+  css->GetArgument(0, 2, &this->BudgetedMemorySize);
+  css->GetArgument(0, 3, &this->MaximumBudgetedMemorySize);
+  css->GetArgument(0, 4, &this->NumberOfReleasedOutputs);
+  css->GetArgument(0, 5, &this->ReleasedMemorySize);
+  css->GetArgument(0, 6, &this->NumberOfReexecutions);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryBudgetInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfProcesses: " << this->NumberOfProcesses << endl;
+  os << indent << "MemoryBudget: " << this->MemoryBudget << endl;
+  os << indent << "BudgetedMemorySize: " << this->BudgetedMemorySize << endl;
+  os << indent << "MaximumBudgetedMemorySize: " << this->MaximumBudgetedMemorySize << endl;
+  os << indent << "NumberOfReleasedOutputs: " << this->NumberOfReleasedOutputs << endl;
+  os << indent << "ReleasedMemorySize: " << this->ReleasedMemorySize << endl;
+  os << indent << "NumberOfReexecutions: " << this->NumberOfReexecutions << endl;
+}
@@ -0,0 +1,105 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVMemoryBudgetInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVMemoryBudgetInformation
+ * @brief   statistics of the pipeline memory budget across ranks.
+ *
+ * vtkPVMemoryBudgetInformation gathers the statistics of the memory budget
+ * enforced by vtkPVCompositeDataPipeline on each process. Sizes are in KiB.
+ * Counts and released sizes are summed over the ranks while the budget and
+ * the budgeted sizes are the largest of any rank.
+ *
+ * @sa vtkPVCompositeDataPipeline::SetMemoryBudget
+ */
+
+#ifndef vtkPVMemoryBudgetInformation_h
+#define vtkPVMemoryBudgetInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingCoreModule.h" //needed for exports
+
+class VTKREMOTINGCORE_EXPORT vtkPVMemoryBudgetInformation : public vtkPVInformation
+{
+public:
+  static vtkPVMemoryBudgetInformation* New();
+  vtkTypeMacro(vtkPVMemoryBudgetInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Transfer information about a single object into this object. The object
+   * is ignored, the statistics are global to the process.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  ///@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  ///@}
+
+  /**
+   * Returns the number of ranks the information was gathered from.
+   */
+  vtkGetMacro(NumberOfProcesses, int);
+
+  /**
+   * Returns the memory budget in MiB, 0 when disabled.
+   */
+  vtkGetMacro(MemoryBudget, int);
+
+  ///@{
+  /**
+   * Returns the largest size of the outputs on a rank the last time the
+   * budget was enforced, and over all times it was enforced.
+   */
+  vtkGetMacro(BudgetedMemorySize, vtkTypeInt64);
+  vtkGetMacro(MaximumBudgetedMemorySize, vtkTypeInt64);
+  ///@}
+
+  ///@{
+  /**
+   * Returns the number of outputs released, their size and the number of
+   * executions that produced them again, summed over all ranks.
+   */
+  vtkGetMacro(NumberOfReleasedOutputs, int);
+  vtkGetMacro(ReleasedMemorySize, vtkTypeInt64);
+  vtkGetMacro(NumberOfReexecutions, int);
+  ///@}
+
+protected:
+  vtkPVMemoryBudgetInformation();
+  ~vtkPVMemoryBudgetInformation() override;
+
+  int NumberOfProcesses = 0;
+  int MemoryBudget = 0;
+  vtkTypeInt64 BudgetedMemorySize = 0;
+  vtkTypeInt64 MaximumBudgetedMemorySize = 0;
+  int NumberOfReleasedOutputs = 0;
+  vtkTypeInt64 ReleasedMemorySize = 0;
+  int NumberOfReexecutions = 0;
+
+private:
+  vtkPVMemoryBudgetInformation(const vtkPVMemoryBudgetInformation&) = delete;
+  void operator=(const vtkPVMemoryBudgetInformation&) = delete;
+};
+
+#endif
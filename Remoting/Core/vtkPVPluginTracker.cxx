@@ -16,6 +16,7 @@
 
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkCommand.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPResourceFileLocator.h"
 #include "vtkPSystemTools.h"
@@ -30,12 +31,14 @@
 #include "vtkPVXMLParser.h"
 #include "vtkProcessModule.h"
 #include "vtkRemotingCoreConfiguration.h"
+#include "vtkStringList.h"
 #include "vtkVersion.h"
 
 #include "vtksys/FStream.hxx"
 #include "vtksys/String.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
@@ -59,13 +62,47 @@ public:
   std::string PluginName;
   vtkPVPlugin* Plugin;
   bool AutoLoad;
+  bool DelayedLoad;
+  // Manifest of a delay-loaded plugin: (group, name) of the proxies it
+  // provides, their labels and the extensions of the files its readers open.
+  std::vector<std::pair<std::string, std::string>> DelayedProxies;
+  std::vector<std::string> DelayedProxyLabels;
+  std::vector<std::string> DelayedExtensions;
   vtkItem()
   {
     this->Plugin = nullptr;
     this->AutoLoad = false;
+    this->DelayedLoad = false;
   }
 };
 
+/**
+ * The root rank of a server sends all proxy definitions to the client when it
+ * connects, and clients, i.e. the GUI and pvpython, list all definitions to
+ * populate menus, file dialogs and Python modules, hence they need their
+ * plugins loaded upfront. Other processes only look definitions up when
+ * proxies get created, so they can delay loading.
+ */
+bool vtkCanDelayPluginLoad()
+{
+  auto pm = vtkProcessModule::GetProcessModule();
+  if (pm == nullptr)
+  {
+    return false;
+  }
+  switch (vtkProcessModule::GetProcessType())
+  {
+    case vtkProcessModule::PROCESS_CLIENT:
+      return false;
+    case vtkProcessModule::PROCESS_SERVER:
+    case vtkProcessModule::PROCESS_DATA_SERVER:
+    case vtkProcessModule::PROCESS_RENDER_SERVER:
+      return pm->GetPartitionId() > 0;
+    default:
+      return true;
+  }
+}
+
 /**
  * Convert a plugin name to its library name i.e. add platform specific
  * library prefix and suffix.
@@ -486,7 +523,44 @@ void vtkPVPluginTracker::LoadPluginConfigurationXMLHinted(
       }
       vtkVLogF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), "found `%s`", plugin_filename.c_str());
       unsigned int index = this->RegisterAvailablePlugin(plugin_filename.c_str());
-      if ((auto_load || forceLoad) && !this->GetPluginLoaded(index))
+
+      int delayed_load = 0;
+      child->GetScalarAttribute("delayed_load", &delayed_load);
+      if (auto_load && delayed_load && !forceLoad && !this->GetPluginLoaded(index) &&
+        vtkCanDelayPluginLoad())
+      {
+        vtkItem& item = (*this->PluginsList)[index];
+        item.DelayedProxies.clear();
+        item.DelayedProxyLabels.clear();
+        item.DelayedExtensions.clear();
+        for (unsigned int kk = 0; kk < child->GetNumberOfNestedElements(); ++kk)
+        {
+          vtkPVXMLElement* proxyElem = child->GetNestedElement(kk);
+          if (strcmp(proxyElem->GetName(), "Proxy") != 0 || !proxyElem->GetAttribute("group") ||
+            !proxyElem->GetAttribute("name"))
+          {
+            continue;
+          }
+          item.DelayedProxies.emplace_back(
+            proxyElem->GetAttribute("group"), proxyElem->GetAttribute("name"));
+          item.DelayedProxyLabels.emplace_back(
+            proxyElem->GetAttributeOrDefault("label", proxyElem->GetAttribute("name")));
+          for (const auto& ext : tokenize(proxyElem->GetAttributeOrEmpty("extensions"), ' '))
+          {
+            if (!ext.empty())
+            {
+              item.DelayedExtensions.push_back(vtksys::SystemTools::LowerCase(ext));
+            }
+          }
+        }
+        item.DelayedLoad = !item.DelayedProxies.empty();
+        vtkVLogIfF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), item.DelayedLoad,
+          "delaying load of `%s` until one of its %d proxies is needed", name.c_str(),
+          static_cast<int>(item.DelayedProxies.size()));
+      }
+
+      if ((auto_load || forceLoad) && !this->GetPluginLoaded(index) &&
+        !(*this->PluginsList)[index].DelayedLoad)
       {
         // load the plugin.
         vtkPVPluginLoader* loader = vtkPVPluginLoader::New();
@@ -658,6 +732,133 @@ bool vtkPVPluginTracker::GetPluginAutoLoad(unsigned int index)
   return (*this->PluginsList)[index].AutoLoad;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVPluginTracker::GetPluginDelayedLoad(unsigned int index)
+{
+  if (index >= this->GetNumberOfPlugins())
+  {
+    vtkWarningMacro("Invalid index: " << index);
+    return false;
+  }
+  return (*this->PluginsList)[index].DelayedLoad;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVPluginTracker::LoadDelayedPluginForProxy(const char* group, const char* name)
+{
+  if (!group || !name)
+  {
+    return false;
+  }
+  for (unsigned int cc = 0; cc < this->GetNumberOfPlugins(); ++cc)
+  {
+    const vtkItem& item = (*this->PluginsList)[cc];
+    if (item.DelayedLoad &&
+      std::find(item.DelayedProxies.begin(), item.DelayedProxies.end(),
+        std::make_pair(std::string(group), std::string(name))) != item.DelayedProxies.end())
+    {
+      return this->LoadDelayedPlugin(cc);
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVPluginTracker::HasDelayedProxy(const char* group, const char* name)
+{
+  if (!group || !name)
+  {
+    return false;
+  }
+  const auto proxy = std::make_pair(std::string(group), std::string(name));
+  return std::any_of(
+    this->PluginsList->begin(), this->PluginsList->end(), [&](const vtkItem& item) {
+      return item.DelayedLoad &&
+        std::find(item.DelayedProxies.begin(), item.DelayedProxies.end(), proxy) !=
+        item.DelayedProxies.end();
+    });
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPluginTracker::GetDelayedProxies(
+  const char* group, vtkStringList* names, vtkStringList* labels)
+{
+  if (!group || !names || !labels)
+  {
+    return;
+  }
+  for (const vtkItem& item : *this->PluginsList)
+  {
+    for (size_t cc = 0; item.DelayedLoad && cc < item.DelayedProxies.size(); ++cc)
+    {
+      if (item.DelayedProxies[cc].first == group)
+      {
+        names->AddString(item.DelayedProxies[cc].second.c_str());
+        labels->AddString(item.DelayedProxyLabels[cc].c_str());
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVPluginTracker::LoadDelayedPluginsForGroup(const char* group)
+{
+  bool loaded = false;
+  for (unsigned int cc = 0; cc < this->GetNumberOfPlugins(); ++cc)
+  {
+    const vtkItem& item = (*this->PluginsList)[cc];
+    if (item.DelayedLoad &&
+      (!group ||
+        std::any_of(item.DelayedProxies.begin(), item.DelayedProxies.end(),
+          [group](const std::pair<std::string, std::string>& proxy) {
+            return proxy.first == group;
+          })))
+    {
+      loaded = this->LoadDelayedPlugin(cc) || loaded;
+    }
+  }
+  return loaded;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVPluginTracker::LoadDelayedPluginsForFile(const char* filename)
+{
+  if (!filename || !*filename)
+  {
+    return false;
+  }
+  const std::string lfilename =
+    vtksys::SystemTools::LowerCase(vtksys::SystemTools::GetFilenameName(filename));
+  bool loaded = false;
+  for (unsigned int cc = 0; cc < this->GetNumberOfPlugins(); ++cc)
+  {
+    const vtkItem& item = (*this->PluginsList)[cc];
+    if (item.DelayedLoad &&
+      std::any_of(item.DelayedExtensions.begin(), item.DelayedExtensions.end(),
+        [&lfilename](const std::string& ext) {
+          return vtksys::SystemTools::StringEndsWith(lfilename, ("." + ext).c_str());
+        }))
+    {
+      loaded = this->LoadDelayedPlugin(cc) || loaded;
+    }
+  }
+  return loaded;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVPluginTracker::LoadDelayedPlugin(unsigned int index)
+{
+  // Clear the flag first so that lookups triggered while the plugin gets
+  // registered do not try to load it again.
+  vtkItem& item = (*this->PluginsList)[index];
+  item.DelayedLoad = false;
+  const std::string filename = item.FileName;
+  vtkVLogScopeF(PARAVIEW_LOG_PLUGIN_VERBOSITY(), "loading delayed plugin `%s`", filename.c_str());
+
+  vtkNew<vtkPVPluginLoader> loader;
+  return loader->LoadPlugin(filename.c_str());
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVPluginTracker::RegisterStaticPluginSearchFunction(vtkPluginSearchFunction function)
 {
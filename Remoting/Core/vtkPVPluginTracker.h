@@ -23,6 +23,12 @@
  * the  on every process that it is loaded.
  * Whenever a plugin is registered, this class fires a vtkCommand::RegisterEvent
  * that handlers can listen to, to process the plugin.
+ *
+ * Plugins listed in a plugin configuration XML can be delay-loaded: instead of
+ * loading the library at startup, only a manifest of the proxies the plugin
+ * provides is recorded, and the plugin is loaded the first time one of these
+ * proxies is needed (see LoadDelayedPluginForProxy()) or a file with one of
+ * the listed extensions is opened (see LoadDelayedPluginsForFile()).
  */
 
 #ifndef vtkPVPluginTracker_h
@@ -37,6 +43,7 @@
 
 class vtkPVPlugin;
 class vtkPVXMLElement;
+class vtkStringList;
 
 typedef bool (*vtkPluginSearchFunction)(const char*);
 typedef void (*vtkPluginListFunction)(const char* appname, std::vector<std::string>& names);
@@ -82,6 +89,11 @@ public:
    * @code
    * <Plugins>
    * <Plugin name="[plugin name]" filename="[optional file name]" auto_load="[bool]" />
+   * <Plugin name="[plugin name]" auto_load="1" delayed_load="1">
+   *   <Proxy group="[proxy group]" name="[proxy name]" label="[optional label]"
+   *          extensions="[optional extensions]" />
+   *   ...
+   * </Plugin>
    * ...
    * </Plugins>
    * @endcode
@@ -91,6 +103,14 @@ public:
    * filename is also optional, if not provided this method will look in
    * different place to find the plugin, eg. paraview lib dir. It will NOT look
    * in PV_PLUGIN_PATH.
+   *
+   * When both auto_load and delayed_load are set, the nested `Proxy` elements
+   * are recorded as the plugin manifest and loading is postponed until one of
+   * the proxies is requested or a file matching one of the space separated
+   * `extensions` is opened. delayed_load is ignored, i.e. the plugin is loaded
+   * right away, when no proxies are listed, on the root rank of a server, which
+   * sends all proxy definitions to the client on connection, and on clients,
+   * which list all proxy definitions to populate menus and Python modules.
    */
   void LoadPluginConfigurationXMLs(const char* appname);
   void LoadPluginConfigurationXML(const char* filename, bool forceLoad = false);
@@ -119,8 +139,42 @@ public:
   const char* GetPluginFileName(unsigned int index);
   bool GetPluginLoaded(unsigned int index);
   bool GetPluginAutoLoad(unsigned int index);
+  bool GetPluginDelayedLoad(unsigned int index);
   //@}
 
+  /**
+   * Loads the delay-loaded plugin whose manifest lists the proxy, if any.
+   * Returns true if a plugin was loaded.
+   */
+  bool LoadDelayedPluginForProxy(const char* group, const char* name);
+
+  /**
+   * Returns true when the manifest of a delay-loaded plugin, not loaded yet,
+   * lists the proxy. Does not load the plugin.
+   */
+  bool HasDelayedProxy(const char* group, const char* name);
+
+  /**
+   * Appends the names and labels of the proxies of the group listed by the
+   * manifests of delay-loaded plugins not loaded yet. Labels default to the
+   * names unless the manifest provides a `label` attribute. Does not load the
+   * plugins.
+   */
+  void GetDelayedProxies(const char* group, vtkStringList* names, vtkStringList* labels);
+
+  /**
+   * Loads the delay-loaded plugins whose manifest lists proxies in the group,
+   * or all delay-loaded plugins when `group` is nullptr. Returns true if any
+   * plugin was loaded.
+   */
+  bool LoadDelayedPluginsForGroup(const char* group);
+
+  /**
+   * Loads the delay-loaded plugins whose manifest lists an extension matching
+   * the filename. Returns true if any plugin was loaded.
+   */
+  bool LoadDelayedPluginsForFile(const char* filename);
+
   //@{
   /**
    * Sets the function used to load static plugins.
@@ -146,6 +200,7 @@ private:
   vtkPluginsList* PluginsList;
 
   void LoadPluginConfigurationXMLConf(std::string const& exe_dir, std::string const& conf);
+  bool LoadDelayedPlugin(unsigned int index);
   void LoadPluginConfigurationXMLHinted(vtkPVXMLElement*, const char* hint, bool forceLoad);
 };
 
@@ -0,0 +1,532 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVStripedSocketCommunicator.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVStripedSocketCommunicator.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkByteSwap.h"
+#include "vtkClientSocket.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Tag of the message used to set up the streams.
+constexpr int STREAMS_COOKIE_TAG = 99993;
+
+// Largest amount of bytes passed to a single vtkSocket::Send/Receive call.
+constexpr vtkTypeInt64 MAXIMUM_SOCKET_CHUNK = 1 << 30;
+
+// Raw values exchanged on the streams are little-endian.
+bool SendRawValues(vtkSocket* socket, vtkTypeInt64 value0, vtkTypeInt64 value1)
+{
+  vtkTypeInt64 values[2] = { value0, value1 };
+  vtkByteSwap::SwapLE(&values[0]);
+  vtkByteSwap::SwapLE(&values[1]);
+  return socket->Send(values, sizeof(values)) != 0;
+}
+
+bool ReceiveRawValues(vtkSocket* socket, vtkTypeInt64& value0, vtkTypeInt64& value1)
+{
+  vtkTypeInt64 values[2];
+  if (socket->Receive(values, sizeof(values)) != static_cast<int>(sizeof(values)))
+  {
+    return false;
+  }
+  vtkByteSwap::SwapLE(&values[0]);
+  vtkByteSwap::SwapLE(&values[1]);
+  value0 = values[0];
+  value1 = values[1];
+  return true;
+}
+
+bool SendRaw(vtkSocket* socket, const char* data, vtkTypeInt64 size)
+{
+  while (size > 0)
+  {
+    const int chunk = static_cast<int>(std::min(size, MAXIMUM_SOCKET_CHUNK));
+    if (!socket->Send(data, chunk))
+    {
+      return false;
+    }
+    data += chunk;
+    size -= chunk;
+  }
+  return true;
+}
+
+bool ReceiveRaw(vtkSocket* socket, char* data, vtkTypeInt64 size)
+{
+  while (size > 0)
+  {
+    const int chunk = static_cast<int>(std::min(size, MAXIMUM_SOCKET_CHUNK));
+    if (socket->Receive(data, chunk) != chunk)
+    {
+      return false;
+    }
+    data += chunk;
+    size -= chunk;
+  }
+  return true;
+}
+
+/**
+ * Threads serving the additional streams of a communicator in one direction.
+ * They are started by the first transfer and wait for the next one in
+ * between, the first stream being served by the calling thread.
+ */
+class SegmentWorkers
+{
+public:
+  ~SegmentWorkers() { this->Stop(); }
+
+  using Transfer = std::function<bool(vtkSocket*)>;
+
+  // Runs `transfer` on every stream and returns whether it succeeded on all.
+  bool Run(const std::vector<vtkSocket*>& streams, const Transfer& transfer)
+  {
+    std::lock_guard<std::mutex> runLock(this->RunMutex);
+    if (this->Threads.size() + 1 != streams.size())
+    {
+      this->StopThreads();
+      for (size_t cc = 1; cc < streams.size(); ++cc)
+      {
+        this->Threads.emplace_back(&SegmentWorkers::Serve, this, cc, this->Generation);
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Job = &transfer;
+    this->Streams = streams;
+    this->Pending = streams.size() - 1;
+    this->Failed = false;
+    ++this->Generation;
+    lock.unlock();
+    this->JobPosted.notify_all();
+
+    const bool success = transfer(streams[0]);
+    lock.lock();
+    this->JobDone.wait(lock, [this]() { return this->Pending == 0; });
+    this->Job = nullptr;
+    return success && !this->Failed;
+  }
+
+  void Stop()
+  {
+    std::lock_guard<std::mutex> runLock(this->RunMutex);
+    this->StopThreads();
+  }
+
+private:
+  void StopThreads()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stopping = true;
+    }
+    this->JobPosted.notify_all();
+    for (auto& thread : this->Threads)
+    {
+      thread.join();
+    }
+    this->Threads.clear();
+    this->Stopping = false;
+  }
+
+  // `generation` is the last job posted before the thread was started.
+  void Serve(size_t streamIndex, unsigned long generation)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->JobPosted.wait(
+        lock, [&]() { return this->Stopping || this->Generation != generation; });
+      if (this->Stopping)
+      {
+        return;
+      }
+      generation = this->Generation;
+      const Transfer& transfer = *this->Job;
+      vtkSocket* stream = this->Streams[streamIndex];
+      lock.unlock();
+      const bool success = transfer(stream);
+      lock.lock();
+      this->Failed = this->Failed || !success;
+      if (--this->Pending == 0)
+      {
+        this->JobDone.notify_all();
+      }
+    }
+  }
+
+  std::mutex RunMutex;
+  std::mutex Mutex;
+  std::condition_variable JobPosted;
+  std::condition_variable JobDone;
+  std::vector<std::thread> Threads;
+  const Transfer* Job = nullptr;
+  std::vector<vtkSocket*> Streams;
+  size_t Pending = 0;
+  unsigned long Generation = 0;
+  bool Failed = false;
+  bool Stopping = false;
+};
+
+/**
+ * Sends or receives the segments of a striped message. Each stream is served
+ * by its own worker. A sending stream picks the next unsent segment as soon
+ * as its previous segment is written, so that faster streams carry more
+ * segments. Each segment is preceded by its offset and size, and each stream
+ * ends with an offset of -1.
+ */
+bool TransferSegments(SegmentWorkers& workers, const std::vector<vtkSocket*>& streams,
+  char* buffer, vtkTypeInt64 size, vtkTypeInt64 segmentSize, bool sending)
+{
+  std::atomic<vtkTypeInt64> nextOffset(0);
+  std::atomic<bool> failed(false);
+
+  auto send = [&](vtkSocket* stream) {
+    while (!failed)
+    {
+      const vtkTypeInt64 offset = nextOffset.fetch_add(segmentSize);
+      if (offset >= size)
+      {
+        break;
+      }
+      const vtkTypeInt64 length = std::min(segmentSize, size - offset);
+      if (!SendRawValues(stream, offset, length) || !SendRaw(stream, buffer + offset, length))
+      {
+        failed = true;
+        return false;
+      }
+    }
+    if (!SendRawValues(stream, -1, 0))
+    {
+      failed = true;
+    }
+    return !failed;
+  };
+
+  auto receive = [&](vtkSocket* stream) {
+    while (true)
+    {
+      vtkTypeInt64 offset, length;
+      if (!ReceiveRawValues(stream, offset, length))
+      {
+        failed = true;
+        return false;
+      }
+      if (offset < 0)
+      {
+        return true;
+      }
+      if (length < 0 || offset + length > size ||
+        !ReceiveRaw(stream, buffer + offset, length))
+      {
+        failed = true;
+        return false;
+      }
+    }
+  };
+
+  if (sending)
+  {
+    return workers.Run(streams, send);
+  }
+  return workers.Run(streams, receive);
+}
+}
+
+class vtkPVStripedSocketCommunicator::vtkInternals
+{
+public:
+  // Additional streams, the socket of the connection being the first stream.
+  std::vector<vtkSmartPointer<vtkClientSocket>> Streams;
+
+  mutable std::mutex TagsMutex;
+  std::set<int> StripedTags;
+
+  // Sends and receives may happen at the same time from different threads,
+  // each direction has its own workers.
+  SegmentWorkers Senders;
+  SegmentWorkers Receivers;
+
+  std::vector<vtkSocket*> GetStreams(vtkSocket* socket) const
+  {
+    std::vector<vtkSocket*> streams;
+    streams.reserve(this->Streams.size() + 1);
+    streams.push_back(socket);
+    for (const auto& stream : this->Streams)
+    {
+      streams.push_back(stream);
+    }
+    return streams;
+  }
+};
+
+vtkStandardNewMacro(vtkPVStripedSocketCommunicator);
+
+//----------------------------------------------------------------------------
+vtkPVStripedSocketCommunicator::vtkPVStripedSocketCommunicator()
+  : Internals(new vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVStripedSocketCommunicator::~vtkPVStripedSocketCommunicator()
+{
+  // Queued messages must be sent while this class can still stripe them.
+  this->StopIOThread();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVStripedSocketCommunicator::AcceptStreams(
+  vtkServerSocket* serverSocket, int numberOfStreams, unsigned long msec)
+{
+  if (numberOfStreams <= 1)
+  {
+    return true;
+  }
+  if (!serverSocket || !this->GetSocket())
+  {
+    vtkErrorMacro("Streams can only be accepted on a connected communicator.");
+    return false;
+  }
+
+  // The connecting side sends this cookie back on each stream, so that
+  // unrelated connections accepted meanwhile are rejected.
+  std::random_device device;
+  std::uniform_int_distribution<vtkTypeInt64> distribution(1, VTK_TYPE_INT64_MAX);
+  vtkTypeInt64 cookie = distribution(device);
+  if (!this->Send(&cookie, 1, 1, STREAMS_COOKIE_TAG))
+  {
+    return false;
+  }
+
+  auto& streams = this->Internals->Streams;
+  streams.clear();
+  streams.resize(numberOfStreams - 1);
+  int accepted = 0;
+  while (accepted < numberOfStreams - 1)
+  {
+    vtkSmartPointer<vtkClientSocket> socket;
+    socket.TakeReference(serverSocket->WaitForConnection(msec));
+    if (!socket)
+    {
+      vtkErrorMacro("Timed out waiting for stream connections.");
+      streams.clear();
+      return false;
+    }
+    vtkTypeInt64 receivedCookie, index;
+    if (!ReceiveRawValues(socket, receivedCookie, index) || receivedCookie != cookie ||
+      index < 1 || index >= numberOfStreams || streams[index - 1].GetPointer() != nullptr)
+    {
+      vtkWarningMacro("Rejecting a connection that is not a stream of this communicator.");
+      socket->CloseSocket();
+      continue;
+    }
+    streams[index - 1] = socket;
+    ++accepted;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVStripedSocketCommunicator::ConnectStreams(
+  const char* hostname, int port, int numberOfStreams)
+{
+  if (numberOfStreams <= 1)
+  {
+    return true;
+  }
+  if (!hostname || !this->GetSocket())
+  {
+    vtkErrorMacro("Streams can only be connected from a connected communicator.");
+    return false;
+  }
+
+  vtkTypeInt64 cookie = 0;
+  if (!this->Receive(&cookie, 1, 1, STREAMS_COOKIE_TAG))
+  {
+    return false;
+  }
+
+  auto& streams = this->Internals->Streams;
+  streams.clear();
+  for (int cc = 1; cc < numberOfStreams; ++cc)
+  {
+    vtkNew<vtkClientSocket> socket;
+    if (socket->ConnectToServer(hostname, port) != 0 || !SendRawValues(socket, cookie, cc))
+    {
+      vtkErrorMacro("Failed to connect stream " << cc << " to " << hostname << ":" << port);
+      streams.clear();
+      return false;
+    }
+    streams.push_back(socket.GetPointer());
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVStripedSocketCommunicator::GetNumberOfStreams() const
+{
+  return static_cast<int>(this->Internals->Streams.size()) + 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVStripedSocketCommunicator::AddStripedTag(int tag)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->TagsMutex);
+  this->Internals->StripedTags.insert(tag);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVStripedSocketCommunicator::IsStripedTag(int tag) const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->TagsMutex);
+  return this->Internals->StripedTags.find(tag) != this->Internals->StripedTags.end();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVStripedSocketCommunicator::RemoveAllStripedTags()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->TagsMutex);
+  this->Internals->StripedTags.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVStripedSocketCommunicator::StripeTag(vtkCommunicator* comm, int tag)
+{
+  if (auto self = vtkPVStripedSocketCommunicator::SafeDownCast(comm))
+  {
+    self->AddStripedTag(tag);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVStripedSocketCommunicator::SendImmediately(
+  const void* data, vtkIdType length, int type, int remoteHandle, int tag)
+{
+  // the number of streams is the same on both sides, hence so is the presence
+  // of the header. The other side may not even be striping when there is a
+  // single stream.
+  if (!this->IsStripedTag(tag) || this->GetNumberOfStreams() <= 1)
+  {
+    return this->Superclass::SendImmediately(data, length, type, remoteHandle, tag);
+  }
+
+  // vtkIdType values may need to be converted by the receiver, which
+  // vtkSocketCommunicator takes care of.
+  const vtkTypeInt64 size = static_cast<vtkTypeInt64>(length) *
+    static_cast<vtkTypeInt64>(vtkAbstractArray::GetDataTypeSize(type));
+  const bool stripe = type != VTK_ID_TYPE && size >= this->StripeThreshold && size > 0;
+
+  vtkTypeInt64 header[2] = { size, stripe ? this->GetNumberOfStreams() : 0 };
+  if (!this->Superclass::SendImmediately(header, 2, VTK_TYPE_INT64, remoteHandle, tag))
+  {
+    return 0;
+  }
+  if (!stripe)
+  {
+    return this->Superclass::SendImmediately(data, length, type, remoteHandle, tag);
+  }
+
+  if (!TransferSegments(this->Internals->Senders, this->Internals->GetStreams(this->GetSocket()),
+        static_cast<char*>(const_cast<void*>(data)), size, this->SegmentSize, true))
+  {
+    vtkErrorMacro("Could not send striped message with tag " << tag);
+    return 0;
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVStripedSocketCommunicator::ReceiveVoidArray(
+  void* data, vtkIdType maxlength, int type, int remoteHandle, int tag)
+{
+  if (!this->IsStripedTag(tag) || this->GetNumberOfStreams() <= 1)
+  {
+    return this->Superclass::ReceiveVoidArray(data, maxlength, type, remoteHandle, tag);
+  }
+
+  vtkTypeInt64 header[2] = { 0, 0 };
+  if (!this->Superclass::ReceiveVoidArray(header, 2, VTK_TYPE_INT64, remoteHandle, tag))
+  {
+    return 0;
+  }
+  if (header[1] == 0)
+  {
+    return this->Superclass::ReceiveVoidArray(data, maxlength, type, remoteHandle, tag);
+  }
+
+  const int typeSize = vtkAbstractArray::GetDataTypeSize(type);
+  const vtkTypeInt64 size = header[0];
+  if (header[1] != this->GetNumberOfStreams() || typeSize == 0 || size % typeSize != 0 ||
+    size > static_cast<vtkTypeInt64>(maxlength) * typeSize)
+  {
+    vtkErrorMacro("Unexpected striped message with tag " << tag);
+    return 0;
+  }
+
+  if (!TransferSegments(this->Internals->Receivers,
+        this->Internals->GetStreams(this->GetSocket()), static_cast<char*>(data), size,
+        this->SegmentSize, false))
+  {
+    vtkErrorMacro("Could not receive striped message with tag " << tag);
+    return 0;
+  }
+
+  const vtkIdType count = static_cast<vtkIdType>(size / typeSize);
+  if (typeSize > 1 && this->SwapBytesInReceivedData == vtkSocketCommunicator::SwapOn)
+  {
+    vtkByteSwap::SwapVoidRange(data, count, typeSize);
+  }
+  this->Count = count;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVStripedSocketCommunicator::CloseConnection()
+{
+  this->StopIOThread();
+  this->Internals->Senders.Stop();
+  this->Internals->Receivers.Stop();
+  for (auto& stream : this->Internals->Streams)
+  {
+    stream->CloseSocket();
+  }
+  this->Internals->Streams.clear();
+  this->Superclass::CloseConnection();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVStripedSocketCommunicator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfStreams: " << this->GetNumberOfStreams() << endl;
+  os << indent << "StripeThreshold: " << this->StripeThreshold << endl;
+  os << indent << "SegmentSize: " << this->SegmentSize << endl;
+}
@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVStripedSocketCommunicator.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVStripedSocketCommunicator
+ * @brief   socket communicator spreading bulk transfers over several sockets.
+ *
+ * A single TCP stream rarely saturates high bandwidth, high latency links.
+ * vtkPVStripedSocketCommunicator opens additional sockets, called streams,
+ * next to the socket of the connection. Large messages sent with one of the
+ * tags registered with `AddStripedTag()` are split into segments of
+ * `SegmentSize` bytes. Each stream sends segments from its own thread,
+ * picking the next unsent segment when done with the previous one. A
+ * congested stream hence carries less of the message instead of stalling the
+ * transfer. These threads are started by the first striped transfer and are
+ * reused by the following ones.
+ *
+ * When there is more than one stream, every message sent with a striped tag
+ * is preceded by a small header on the connection's socket telling whether
+ * the message is striped. Both sides must therefore register the same tags
+ * before exchanging messages with them. Since both sides agree on the number
+ * of streams, a side using a single stream can talk to any
+ * vtkSocketCommunicator.
+ * Messages with other tags, including RMIs, are sent as by
+ * vtkSocketCommunicator.
+ *
+ * Streams are set up after the connection's handshake, once both sides
+ * agreed on the number of streams, e.g. with the handshake of
+ * vtkTCPNetworkAccessManager. The listening side calls `AcceptStreams()`
+ * while the connecting side calls `ConnectStreams()`. Nothing is exchanged
+ * when a single stream is used, so that the messages are the same as with a
+ * vtkSocketCommunicator.
+ *
+ * @sa vtkPVThreadedSocketCommunicator, vtkMPIMToNSocketConnection,
+ * vtkTCPNetworkAccessManager
+ */
+
+#ifndef vtkPVStripedSocketCommunicator_h
+#define vtkPVStripedSocketCommunicator_h
+
+#include "vtkPVThreadedSocketCommunicator.h"
+#include "vtkRemotingCoreModule.h" //needed for exports
+
+#include <memory> // for std::unique_ptr
+
+class vtkServerSocket;
+
+class VTKREMOTINGCORE_EXPORT vtkPVStripedSocketCommunicator
+  : public vtkPVThreadedSocketCommunicator
+{
+public:
+  static vtkPVStripedSocketCommunicator* New();
+  vtkTypeMacro(vtkPVStripedSocketCommunicator, vtkPVThreadedSocketCommunicator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Called on the side that listens for connections. Accepts
+   * `numberOfStreams - 1` additional connections on `serverSocket`, waiting
+   * at most `msec` milliseconds for each of them. Connections that do not
+   * belong to this communicator are closed.
+   */
+  bool AcceptStreams(vtkServerSocket* serverSocket, int numberOfStreams, unsigned long msec = 5000);
+
+  /**
+   * Called on the side that initiated the connection. Opens
+   * `numberOfStreams - 1` additional connections to `hostname`:`port`.
+   */
+  bool ConnectStreams(const char* hostname, int port, int numberOfStreams);
+
+  /**
+   * Returns the number of sockets used for striped messages, including the
+   * socket of the connection.
+   */
+  int GetNumberOfStreams() const;
+
+  ///@{
+  /**
+   * Manage the tags of messages that may be striped.
+   */
+  void AddStripedTag(int tag);
+  bool IsStripedTag(int tag) const;
+  void RemoveAllStripedTags();
+  ///@}
+
+  /**
+   * Convenience method registering `tag` when `comm` is a
+   * vtkPVStripedSocketCommunicator. Does nothing otherwise.
+   */
+  static void StripeTag(vtkCommunicator* comm, int tag);
+
+  ///@{
+  /**
+   * Messages smaller than this number of bytes are not striped. 1 MiB by
+   * default.
+   */
+  vtkSetClampMacro(StripeThreshold, vtkTypeInt64, 0, VTK_TYPE_INT64_MAX);
+  vtkGetMacro(StripeThreshold, vtkTypeInt64);
+  ///@}
+
+  ///@{
+  /**
+   * Size in bytes of the segments striped messages are split into. 4 MiB by
+   * default.
+   */
+  vtkSetClampMacro(SegmentSize, vtkTypeInt64, 1024, VTK_INT_MAX);
+  vtkGetMacro(SegmentSize, vtkTypeInt64);
+  ///@}
+
+  /**
+   * Receives striped messages from all streams.
+   */
+  int ReceiveVoidArray(
+    void* data, vtkIdType maxlength, int type, int remoteHandle, int tag) override;
+
+  /**
+   * Closes the additional streams too.
+   */
+  void CloseConnection() override;
+
+protected:
+  vtkPVStripedSocketCommunicator();
+  ~vtkPVStripedSocketCommunicator() override;
+
+  int SendImmediately(
+    const void* data, vtkIdType length, int type, int remoteHandle, int tag) override;
+
+  vtkTypeInt64 StripeThreshold = 1024 * 1024;
+  vtkTypeInt64 SegmentSize = 4 * 1024 * 1024;
+
+private:
+  vtkPVStripedSocketCommunicator(const vtkPVStripedSocketCommunicator&) = delete;
+  void operator=(const vtkPVStripedSocketCommunicator&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
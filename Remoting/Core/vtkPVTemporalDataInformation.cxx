@@ -16,14 +16,124 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkCallbackCommand.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
+namespace
+{
+/**
+ * Data information of each timestep of an output port, valid as long as the
+ * pipeline is not modified and the information is gathered with the same
+ * parameters.
+ */
+struct vtkTemporalCacheEntry
+{
+  vtkWeakPointer<vtkAlgorithm> Producer;
+  unsigned long ObserverId = 0;
+  vtkMTimeType PipelineMTime = 0;
+  std::string Parameters;
+  std::map<double, vtkSmartPointer<vtkPVDataInformation>> TimeSteps;
+  vtkTypeUInt64 LastUsed = 0;
+};
+
+// Number of output ports whose information is cached. The least recently used
+// one is dropped first.
+constexpr size_t MaximumNumberOfCachedPorts = 32;
+
+using vtkTemporalCache = std::map<std::pair<vtkAlgorithm*, int>, vtkTemporalCacheEntry>;
+
+vtkTemporalCache& GetTemporalCache()
+{
+  static vtkTemporalCache cache;
+  return cache;
+}
+
+// Entries are dropped when their producer is deleted, its address may be
+// reused.
+void OnProducerDeleted(vtkObject* caller, unsigned long, void*, void*)
+{
+  auto& cache = GetTemporalCache();
+  for (auto iter = cache.begin(); iter != cache.end();)
+  {
+    iter = iter->first.first == caller ? cache.erase(iter) : std::next(iter);
+  }
+}
+
+void StopObservingProducer(const vtkTemporalCacheEntry& entry)
+{
+  if (vtkAlgorithm* producer = entry.Producer)
+  {
+    producer->RemoveObserver(entry.ObserverId);
+  }
+}
+
+vtkTemporalCacheEntry& GetTemporalCacheEntry(
+  vtkAlgorithm* producer, int index, vtkMTimeType pipelineMTime, const std::string& parameters)
+{
+  static vtkTypeUInt64 counter = 0;
+  auto& cache = GetTemporalCache();
+  auto iter = cache.find(std::make_pair(producer, index));
+  if (iter == cache.end())
+  {
+    if (cache.size() >= MaximumNumberOfCachedPorts)
+    {
+      auto oldest = std::min_element(cache.begin(), cache.end(),
+        [](const vtkTemporalCache::value_type& a, const vtkTemporalCache::value_type& b) {
+          return a.second.LastUsed < b.second.LastUsed;
+        });
+      StopObservingProducer(oldest->second);
+      cache.erase(oldest);
+    }
+    iter = cache.emplace(std::make_pair(producer, index), vtkTemporalCacheEntry()).first;
+    vtkNew<vtkCallbackCommand> observer;
+    observer->SetCallback(&OnProducerDeleted);
+    iter->second.Producer = producer;
+    iter->second.ObserverId = producer->AddObserver(vtkCommand::DeleteEvent, observer);
+  }
+
+  auto& entry = iter->second;
+  entry.LastUsed = ++counter;
+  if (entry.PipelineMTime != pipelineMTime || entry.Parameters != parameters)
+  {
+    entry.PipelineMTime = pipelineMTime;
+    entry.Parameters = parameters;
+    entry.TimeSteps.clear();
+  }
+  return entry;
+}
+
+// Timesteps can only be split among ranks when updating the whole dataset
+// does not communicate between ranks, since each rank executes the pipeline
+// for different timesteps. This is assumed for sources without inputs, such
+// as readers, followed by the post filters converting their arrays, but not
+// for any other filter.
+bool CanSplitTimeSteps(vtkAlgorithm* producer)
+{
+  vtkAlgorithm* algorithm = producer;
+  while (algorithm->IsA("vtkPVPostFilter") && algorithm->GetTotalNumberOfInputConnections() == 1)
+  {
+    algorithm = algorithm->GetInputAlgorithm();
+  }
+  return algorithm->GetTotalNumberOfInputConnections() == 0;
+}
+}
+
 vtkStandardNewMacro(vtkPVTemporalDataInformation);
 //----------------------------------------------------------------------------
 vtkPVTemporalDataInformation::vtkPVTemporalDataInformation() = default;
@@ -31,6 +141,23 @@ vtkPVTemporalDataInformation::vtkPVTemporalDataInformation() = default;
 //----------------------------------------------------------------------------
 vtkPVTemporalDataInformation::~vtkPVTemporalDataInformation() = default;
 
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::ClearCache()
+{
+  auto& cache = GetTemporalCache();
+  for (const auto& item : cache)
+  {
+    StopObservingProducer(item.second);
+  }
+  cache.clear();
+}
+
+//----------------------------------------------------------------------------
+size_t vtkPVTemporalDataInformation::GetNumberOfCachedPorts()
+{
+  return GetTemporalCache().size();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
 {
@@ -90,27 +217,106 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
     return;
   }
 
+  // In time-parallel mode, each rank updates the whole dataset for a subset of
+  // the timesteps on its own. The information gathered by all ranks is merged
+  // as usual.
+  auto pm = vtkProcessModule::GetProcessModule();
+  const int numberOfRanks = pm ? pm->GetNumberOfLocalPartitions() : 1;
+  const int rank = pm ? pm->GetPartitionId() : 0;
+  const bool timeParallel = this->TimeParallel && numberOfRanks > 1 && this->GetRank() == -1 &&
+    ::CanSplitTimeSteps(port->GetProducer());
+
+  std::ostringstream parameters;
+  parameters << this->GetRank() << ";"
+             << (this->GetSubsetSelector() ? this->GetSubsetSelector() : "") << ";"
+             << (this->GetSubsetAssemblyName() ? this->GetSubsetAssemblyName() : "") << ";"
+             << (timeParallel ? numberOfRanks : 0);
+  auto& cache = GetTemporalCacheEntry(
+    port->GetProducer(), port->GetIndex(), sddp->GetPipelineMTime(), parameters.str());
+
   double current_time = this->GetTime();
-  for (auto time : timesteps)
+  if (!timeParallel && cache.TimeSteps.find(current_time) == cache.TimeSteps.end())
+  {
+    vtkNew<vtkPVDataInformation> dinfo;
+    dinfo->CopyFromObject(dobj);
+    cache.TimeSteps[current_time] = dinfo.GetPointer();
+  }
+
+  int savedPiece = 0, savedNumberOfPieces = 1, savedGhostLevels = 0;
+  if (timeParallel)
+  {
+    savedPiece = pipelineInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    savedNumberOfPieces =
+      pipelineInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    savedGhostLevels =
+      pipelineInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS());
+  }
+
+  bool updated = false;
+  for (size_t cc = 0; cc < timesteps.size(); ++cc)
   {
-    if (time == current_time)
+    const double time = timesteps[cc];
+    if (timeParallel ? (static_cast<int>(cc % numberOfRanks) != rank) : (time == current_time))
     {
-      // skip the timestep already seen.
+      // skip the timestep already seen, or handled by another rank.
       continue;
     }
-    pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), time);
-    sddp->Update(port->GetIndex());
 
-    dobj = port->GetProducer()->GetOutputDataObject(port->GetIndex());
+    auto iter = cache.TimeSteps.find(time);
+    if (iter == cache.TimeSteps.end())
+    {
+      pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), time);
+      if (timeParallel)
+      {
+        pipelineInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), 0);
+        pipelineInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 1);
+        pipelineInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), 0);
+      }
+      sddp->Update(port->GetIndex());
+      updated = true;
 
-    vtkNew<vtkPVDataInformation> dinfo;
-    dinfo->CopyFromObject(dobj);
-    this->AddInformation(dinfo);
+      dobj = port->GetProducer()->GetOutputDataObject(port->GetIndex());
+
+      vtkNew<vtkPVDataInformation> dinfo;
+      dinfo->CopyFromObject(dobj);
+      iter = cache.TimeSteps.emplace(time, dinfo.GetPointer()).first;
+    }
+    this->AddInformation(iter->second);
+  }
+
+  if (timeParallel && updated)
+  {
+    pipelineInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(), savedPiece);
+    pipelineInfo->Set(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), savedNumberOfPieces);
+    pipelineInfo->Set(
+      vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS(), savedGhostLevels);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  this->Superclass::CopyParametersToStream(str);
+  str << 828793 << (this->TimeParallel ? 1 : 0);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  this->Superclass::CopyParametersFromStream(str);
+  int magic_number, timeParallel;
+  str >> magic_number >> timeParallel;
+  if (magic_number != 828793)
+  {
+    vtkErrorMacro("Magic number mismatch.");
   }
+  this->TimeParallel = (timeParallel != 0);
 }
 
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "TimeParallel: " << this->TimeParallel << endl;
 }
@@ -19,6 +19,13 @@
  * vtkPVTemporalDataInformation is used to gather data information over time.
  * It simply overrides `vtkPVDataInformation::CopyFromObject` to ensure that the
  * data information is collected from all timesteps and not just 1.
+ *
+ * The information of each timestep is cached on each process, for all arrays
+ * at once, until the upstream pipeline is modified. Gathering the information
+ * again, for instance to rescale a color map for another array or after the
+ * current time changed, hence does not execute the pipeline for timesteps seen
+ * before. The cache holds a limited number of output ports, the least recently
+ * used being dropped first, and drops the ports of deleted algorithms.
  */
 
 #ifndef vtkPVTemporalDataInformation_h
@@ -43,10 +50,46 @@ public:
    */
   void CopyFromObject(vtkObject* object) override;
 
+  //@{
+  /**
+   * When set, timesteps are distributed among the ranks instead of being
+   * processed by all ranks one after another. Each rank then updates the
+   * whole dataset for its timesteps, independently of the other ranks, which
+   * needs as much memory as the whole dataset on each rank. Since the
+   * pipeline must not communicate between ranks while executing, this is
+   * only done for the outputs of sources without inputs, such as readers,
+   * and ignored for the outputs of filters. Off by default.
+   */
+  vtkSetMacro(TimeParallel, bool);
+  vtkGetMacro(TimeParallel, bool);
+  vtkBooleanMacro(TimeParallel, bool);
+  //@}
+
+  //@{
+  /**
+   * vtkPVInformation API implementation.
+   */
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  //@}
+
+  /**
+   * Releases the information cached for all timesteps on this process.
+   */
+  static void ClearCache();
+
+  /**
+   * Returns the number of output ports whose information is cached on this
+   * process.
+   */
+  static size_t GetNumberOfCachedPorts();
+
 protected:
   vtkPVTemporalDataInformation();
   ~vtkPVTemporalDataInformation() override;
 
+  bool TimeParallel = false;
+
 private:
   vtkPVTemporalDataInformation(const vtkPVTemporalDataInformation&) = delete;
   void operator=(const vtkPVTemporalDataInformation&) = delete;
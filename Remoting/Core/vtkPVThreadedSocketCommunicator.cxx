@@ -0,0 +1,325 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVThreadedSocketCommunicator.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVThreadedSocketCommunicator.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkClientSocket.h"
+#include "vtkCommand.h"
+#include "vtkObjectFactory.h"
+#include "vtkOutputWindow.h"
+#include "vtkWeakPointer.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Set on the I/O threads, whose errors must not be displayed from there.
+thread_local bool InIOThread = false;
+}
+
+class vtkPVThreadedSocketCommunicator::vtkInternals
+{
+public:
+  struct Message
+  {
+    // Copy of the message, or nullptr when the message is sent from the
+    // caller's buffer. The caller then waits for Status to be set.
+    std::unique_ptr<char[]> Data;
+    const void* CallerData;
+    int* Status;
+    vtkTypeInt64 Size;
+    vtkIdType Length;
+    int Type;
+    int RemoteHandle;
+    int Tag;
+  };
+
+  // Errors raised while the I/O thread sends are kept to be displayed by the
+  // next call from the caller's thread. Others are displayed right away.
+  void OnErrorEvent(vtkObject*, unsigned long, void* callData)
+  {
+    const char* text = callData ? static_cast<const char*>(callData) : "";
+    if (InIOThread)
+    {
+      std::lock_guard<std::mutex> lock(this->ErrorsMutex);
+      this->Errors.emplace_back(text);
+    }
+    else
+    {
+      vtkOutputWindowDisplayErrorText(text);
+    }
+  }
+
+  void ReportErrors()
+  {
+    std::vector<std::string> errors;
+    {
+      std::lock_guard<std::mutex> lock(this->ErrorsMutex);
+      errors.swap(this->Errors);
+    }
+    for (const auto& text : errors)
+    {
+      vtkOutputWindowDisplayErrorText(text.c_str());
+    }
+  }
+
+  void ObserveErrors(vtkObject* object)
+  {
+    if (object)
+    {
+      this->ObservedObjects.emplace_back(object,
+        object->AddObserver(vtkCommand::ErrorEvent, this, &vtkInternals::OnErrorEvent));
+    }
+  }
+
+  void StopObservingErrors()
+  {
+    for (const auto& observed : this->ObservedObjects)
+    {
+      if (vtkObject* object = observed.first)
+      {
+        object->RemoveObserver(observed.second);
+      }
+    }
+    this->ObservedObjects.clear();
+  }
+
+  std::thread Thread;
+  std::mutex Mutex;
+  std::condition_variable MessageQueued;
+  std::condition_variable MessageSent;
+  std::deque<Message> Queue;
+  vtkTypeInt64 QueuedBytes = 0;
+  bool Running = false;
+  bool Stopping = false;
+  bool Failed = false;
+
+  std::mutex ErrorsMutex;
+  std::vector<std::string> Errors;
+  std::vector<std::pair<vtkWeakPointer<vtkObject>, unsigned long>> ObservedObjects;
+};
+
+vtkStandardNewMacro(vtkPVThreadedSocketCommunicator);
+
+//----------------------------------------------------------------------------
+vtkPVThreadedSocketCommunicator::vtkPVThreadedSocketCommunicator()
+  : Internals(new vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVThreadedSocketCommunicator::~vtkPVThreadedSocketCommunicator()
+{
+  this->StopIOThread();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVThreadedSocketCommunicator::StartIOThread()
+{
+  auto& internals = *this->Internals;
+  if (internals.Running)
+  {
+    return true;
+  }
+  if (this->GetLogStream() != nullptr)
+  {
+    // logging is not thread-safe.
+    return false;
+  }
+
+  internals.Running = true;
+  internals.Stopping = false;
+  internals.Failed = false;
+  internals.ObserveErrors(this);
+  internals.ObserveErrors(this->GetSocket());
+  internals.Thread = std::thread([this]() {
+    InIOThread = true;
+    auto& state = *this->Internals;
+    std::unique_lock<std::mutex> lock(state.Mutex);
+    while (true)
+    {
+      state.MessageQueued.wait(lock, [&state]() { return state.Stopping || !state.Queue.empty(); });
+      if (state.Queue.empty())
+      {
+        break;
+      }
+      // The message stays in the queue while it is sent so that `Flush()`
+      // waits for it.
+      auto& message = state.Queue.front();
+      lock.unlock();
+      const void* data = message.Data ? message.Data.get() : message.CallerData;
+      const int status = this->SendImmediately(
+        data, message.Length, message.Type, message.RemoteHandle, message.Tag);
+      lock.lock();
+      if (message.Status)
+      {
+        *message.Status = status;
+      }
+      state.QueuedBytes -= message.Data ? message.Size : 0;
+      state.Queue.pop_front();
+      if (!status)
+      {
+        state.Failed = true;
+        // Remaining messages cannot be delivered in order anymore.
+        for (const auto& dropped : state.Queue)
+        {
+          if (dropped.Status)
+          {
+            *dropped.Status = 0;
+          }
+        }
+        state.Queue.clear();
+        state.QueuedBytes = 0;
+      }
+      state.MessageSent.notify_all();
+    }
+  });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVThreadedSocketCommunicator::StopIOThread()
+{
+  auto& internals = *this->Internals;
+  if (!internals.Running)
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    internals.Stopping = true;
+  }
+  internals.MessageQueued.notify_all();
+  internals.Thread.join();
+  internals.Running = false;
+  internals.StopObservingErrors();
+  internals.ReportErrors();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVThreadedSocketCommunicator::GetIOThreadRunning() const
+{
+  return this->Internals->Running;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVThreadedSocketCommunicator::Flush()
+{
+  auto& internals = *this->Internals;
+  std::unique_lock<std::mutex> lock(internals.Mutex);
+  internals.MessageSent.wait(lock, [&internals]() { return internals.Queue.empty(); });
+  internals.ReportErrors();
+  const bool success = !internals.Failed;
+  internals.Failed = false;
+  return success;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVThreadedSocketCommunicator::SendVoidArray(
+  const void* data, vtkIdType length, int type, int remoteHandle, int tag)
+{
+  auto& internals = *this->Internals;
+  if (!internals.Running)
+  {
+    return this->SendImmediately(data, length, type, remoteHandle, tag);
+  }
+
+  const vtkTypeInt64 size =
+    static_cast<vtkTypeInt64>(length) * vtkAbstractArray::GetDataTypeSize(type);
+
+  // A message that does not fit in the budget, even alone, is not copied. It
+  // is sent by the I/O thread from the caller's buffer, after the pending
+  // messages, and this call waits for it to be sent. The socket communicator
+  // writes each message from a contiguous buffer, it cannot be streamed from
+  // smaller copies.
+  const bool copy = size <= this->MaximumQueuedBytes;
+  std::unique_lock<std::mutex> lock(internals.Mutex);
+  internals.MessageSent.wait(lock, [&]() {
+    return !copy || internals.Queue.empty() ||
+      internals.QueuedBytes + size <= this->MaximumQueuedBytes;
+  });
+  internals.ReportErrors();
+  if (internals.Failed)
+  {
+    internals.Failed = false;
+    vtkErrorMacro("Could not send a previous message.");
+    return 0;
+  }
+
+  int status = -1;
+  vtkInternals::Message message;
+  message.CallerData = data;
+  message.Status = copy ? nullptr : &status;
+  if (copy)
+  {
+    message.Data.reset(new char[size > 0 ? static_cast<size_t>(size) : 1]);
+    if (size > 0)
+    {
+      std::memcpy(message.Data.get(), data, static_cast<size_t>(size));
+    }
+    internals.QueuedBytes += size;
+  }
+  message.Size = size;
+  message.Length = length;
+  message.Type = type;
+  message.RemoteHandle = remoteHandle;
+  message.Tag = tag;
+  internals.Queue.push_back(std::move(message));
+  internals.MessageQueued.notify_one();
+  if (copy)
+  {
+    return 1;
+  }
+
+  // the lock is released while waiting, so other threads can queue messages.
+  internals.MessageSent.wait(lock, [&status]() { return status >= 0; });
+  internals.ReportErrors();
+  if (!status)
+  {
+    // the failure is reported here rather than by the next send.
+    internals.Failed = false;
+    vtkErrorMacro("Could not send the message.");
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVThreadedSocketCommunicator::SendImmediately(
+  const void* data, vtkIdType length, int type, int remoteHandle, int tag)
+{
+  return this->Superclass::SendVoidArray(data, length, type, remoteHandle, tag);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVThreadedSocketCommunicator::CloseConnection()
+{
+  this->StopIOThread();
+  this->Superclass::CloseConnection();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVThreadedSocketCommunicator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumQueuedBytes: " << this->MaximumQueuedBytes << endl;
+  os << indent << "IOThreadRunning: " << this->Internals->Running << endl;
+}
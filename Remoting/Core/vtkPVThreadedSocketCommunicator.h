@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVThreadedSocketCommunicator.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVThreadedSocketCommunicator
+ * @brief   socket communicator sending messages from a dedicated thread.
+ *
+ * vtkPVThreadedSocketCommunicator is a vtkSocketCommunicator that, once
+ * `StartIOThread()` has been called, copies outgoing messages into a queue and
+ * returns immediately. A thread owned by the communicator writes queued
+ * messages to the socket in order, so that the process can keep working, for
+ * instance rendering the next frame, while large payloads such as geometry or
+ * images are being transferred.
+ *
+ * Receiving is not affected and happens on the calling thread, concurrently
+ * with the sends of the I/O thread. The amount of memory used by the copies
+ * of pending messages is bounded by `MaximumQueuedBytes`; sends block while
+ * that limit is exceeded. Larger messages are not copied: they are sent by the
+ * I/O thread from the caller's buffer, in order, and the send waits for them.
+ * Since other sends complete asynchronously, a failure is only reported by the
+ * next send or by `Flush()`. Errors raised on the I/O thread are displayed
+ * from the caller's thread by the next send, `Flush()` or `StopIOThread()`.
+ *
+ * The I/O thread should only be started once the connection handshake is
+ * complete, and is not started when a log stream is set.
+ *
+ * @sa vtkTCPNetworkAccessManager
+ */
+
+#ifndef vtkPVThreadedSocketCommunicator_h
+#define vtkPVThreadedSocketCommunicator_h
+
+#include "vtkRemotingCoreModule.h" //needed for exports
+#include "vtkSocketCommunicator.h"
+
+#include <memory> // for std::unique_ptr
+
+class VTKREMOTINGCORE_EXPORT vtkPVThreadedSocketCommunicator : public vtkSocketCommunicator
+{
+public:
+  static vtkPVThreadedSocketCommunicator* New();
+  vtkTypeMacro(vtkPVThreadedSocketCommunicator, vtkSocketCommunicator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Starts the thread sending queued messages. Returns false if the thread
+   * could not be started, in which case messages are sent synchronously.
+   */
+  bool StartIOThread();
+
+  /**
+   * Sends all pending messages and stops the I/O thread.
+   */
+  void StopIOThread();
+
+  /**
+   * Returns true when messages are sent by the I/O thread.
+   */
+  bool GetIOThreadRunning() const;
+
+  /**
+   * Blocks until all queued messages have been sent. Returns false if any of
+   * them could not be sent.
+   */
+  bool Flush();
+
+  ///@{
+  /**
+   * Maximum number of bytes held by queued messages. A send blocks until
+   * enough queued messages have been sent. A message larger than this is
+   * not copied and its send blocks until the I/O thread has sent it; 0 hence
+   * makes every send wait. 256 MiB by default.
+   */
+  vtkSetClampMacro(MaximumQueuedBytes, vtkTypeInt64, 0, VTK_TYPE_INT64_MAX);
+  vtkGetMacro(MaximumQueuedBytes, vtkTypeInt64);
+  ///@}
+
+  /**
+   * Queues the message when the I/O thread is running, otherwise sends it
+   * immediately.
+   */
+  int SendVoidArray(
+    const void* data, vtkIdType length, int type, int remoteHandle, int tag) override;
+
+  /**
+   * Stops the I/O thread before closing the connection.
+   */
+  void CloseConnection() override;
+
+protected:
+  vtkPVThreadedSocketCommunicator();
+  ~vtkPVThreadedSocketCommunicator() override;
+
+  /**
+   * Writes a message to the connection. This is called by the I/O thread for
+   * queued messages, or directly by `SendVoidArray()` when the thread is not
+   * running.
+   */
+  virtual int SendImmediately(
+    const void* data, vtkIdType length, int type, int remoteHandle, int tag);
+
+  vtkTypeInt64 MaximumQueuedBytes = 256 * 1024 * 1024;
+
+private:
+  vtkPVThreadedSocketCommunicator(const vtkPVThreadedSocketCommunicator&) = delete;
+  void operator=(const vtkPVThreadedSocketCommunicator&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
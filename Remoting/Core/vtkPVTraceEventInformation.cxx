@@ -0,0 +1,71 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceEventInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVTraceEventInformation.h"
+
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVTraceEventLog.h"
+
+vtkStandardNewMacro(vtkPVTraceEventInformation);
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Events: " << this->Events.size() << " bytes" << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventInformation::CopyFromObject(vtkObject*)
+{
+  this->Events = vtkPVTraceEventLog::GetEvents();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventInformation::AddInformation(vtkPVInformation* info)
+{
+  auto other = vtkPVTraceEventInformation::SafeDownCast(info);
+  if (other == nullptr || other->Events.empty())
+  {
+    return;
+  }
+  if (!this->Events.empty())
+  {
+    this->Events += ",\n";
+  }
+  this->Events += other->Events;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVTraceEventInformation::GetTrace() const
+{
+  return "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" + this->Events + "\n]}\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << this->Events << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  if (!css->GetArgument(0, 0, &this->Events))
+  {
+    vtkErrorMacro("Error parsing events from message.");
+  }
+}
@@ -0,0 +1,84 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceEventInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVTraceEventInformation
+ * @brief   gathers trace events recorded by all processes.
+ *
+ * vtkPVTraceEventInformation collects the events recorded by
+ * vtkPVTraceEventLog on every rank it is gathered from. Events gathered from
+ * several sessions components, e.g. the client and the servers, can be
+ * combined with `AddInformation()` and saved as a single trace with
+ * `GetTrace()`.
+ *
+ * @sa vtkPVTraceEventLog
+ */
+
+#ifndef vtkPVTraceEventInformation_h
+#define vtkPVTraceEventInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingCoreModule.h" //needed for exports
+
+#include <string> // for std::string
+
+class VTKREMOTINGCORE_EXPORT vtkPVTraceEventInformation : public vtkPVInformation
+{
+public:
+  static vtkPVTraceEventInformation* New();
+  vtkTypeMacro(vtkPVTraceEventInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Transfer the events recorded by this process. The object is ignored.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  //@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  //@}
+
+  /**
+   * Returns the gathered events as comma separated Trace Event Format
+   * objects.
+   */
+  vtkGetMacro(Events, const std::string&);
+
+  /**
+   * Returns the gathered events as a JSON trace that can be loaded in
+   * Chrome's trace viewer (chrome://tracing) or in Perfetto.
+   */
+  std::string GetTrace() const;
+
+protected:
+  vtkPVTraceEventInformation() = default;
+  ~vtkPVTraceEventInformation() override = default;
+
+  std::string Events;
+
+private:
+  vtkPVTraceEventInformation(const vtkPVTraceEventInformation&) = delete;
+  void operator=(const vtkPVTraceEventInformation&) = delete;
+};
+
+#endif
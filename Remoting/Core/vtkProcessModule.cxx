@@ -27,12 +27,14 @@
 #include "vtkInformation.h"
 #include "vtkLegacy.h"
 #include "vtkLogger.h"
+#include "vtkMultiProcessController.h"
 #include "vtkMultiThreader.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutputWindow.h"
 #include "vtkPSystemTools.h"
 #include "vtkPVOptions.h"
+#include "vtkPVTraceEventLog.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModuleConfiguration.h"
 #include "vtkSessionIterator.h"
@@ -93,26 +95,33 @@ static void UpdateThreadName(
   {
     tname_suffix = "." + std::to_string(controller->GetLocalProcessId());
   }
+  const char* name = nullptr;
   switch (type)
   {
     case vtkProcessModule::PROCESS_CLIENT:
-      vtkLogger::SetThreadName("paraview" + tname_suffix);
+      name = "paraview";
       break;
     case vtkProcessModule::PROCESS_SERVER:
-      vtkLogger::SetThreadName("pvserver" + tname_suffix);
+      name = "pvserver";
       break;
     case vtkProcessModule::PROCESS_DATA_SERVER:
-      vtkLogger::SetThreadName("pvdatserver" + tname_suffix);
+      name = "pvdatserver";
       break;
     case vtkProcessModule::PROCESS_RENDER_SERVER:
-      vtkLogger::SetThreadName("pvrenderserver" + tname_suffix);
+      name = "pvrenderserver";
       break;
     case vtkProcessModule::PROCESS_BATCH:
-      vtkLogger::SetThreadName("pvbatch" + tname_suffix);
+      name = "pvbatch";
       break;
     default:
       break;
   }
+  if (name)
+  {
+    vtkLogger::SetThreadName(name + tname_suffix);
+    vtkPVTraceEventLog::SetProcessName(name);
+    vtkPVTraceEventLog::SetProcessRole(type);
+  }
 }
 
 void HandleDisplay(int& argc, char**& argv)
@@ -155,6 +164,10 @@ bool vtkProcessModule::FinalizePython = false;
 
 vtkSmartPointer<vtkProcessModule> vtkProcessModule::Singleton;
 vtkSmartPointer<vtkMultiProcessController> vtkProcessModule::GlobalController;
+vtkSmartPointer<vtkMultiProcessController> vtkProcessModule::TimeCompartmentController;
+vtkSmartPointer<vtkMultiProcessController> vtkProcessModule::TimeCompartmentsController;
+int vtkProcessModule::NumberOfTimeCompartments = 1;
+int vtkProcessModule::TimeCompartmentIndex = 0;
 
 int vtkProcessModule::DefaultMinimumGhostLevelsToRequestForUnstructuredPipelines = 1;
 int vtkProcessModule::DefaultMinimumGhostLevelsToRequestForStructuredPipelines = 0;
@@ -367,6 +380,10 @@ bool vtkProcessModule::Finalize()
   // it's really stored with a weak pointer.  We set it to nullptr anyways
   // in case it gets changed later to reference counting the pointer
   vtkMultiProcessController::SetGlobalController(nullptr);
+  vtkProcessModule::TimeCompartmentsController = nullptr;
+  vtkProcessModule::TimeCompartmentController = nullptr;
+  vtkProcessModule::NumberOfTimeCompartments = 1;
+  vtkProcessModule::TimeCompartmentIndex = 0;
   vtkProcessModule::GlobalController->Finalize(/*finalizedExternally*/ 1);
   vtkProcessModule::GlobalController = nullptr;
 
@@ -549,6 +566,72 @@ bool vtkProcessModule::IsMPIInitialized()
   return (this->GetGlobalController() && this->GetGlobalController()->IsA("vtkMPIController") != 0);
 }
 
+//----------------------------------------------------------------------------
+bool vtkProcessModule::InitializeTimeCompartments(int count)
+{
+  auto controller = vtkProcessModule::GlobalController.GetPointer();
+  if (count <= 1 || controller == nullptr || controller->GetNumberOfProcesses() <= 1)
+  {
+    return true;
+  }
+  if (vtkProcessModule::TimeCompartmentController != nullptr)
+  {
+    vtkLogF(ERROR, "Time compartments have already been initialized.");
+    return false;
+  }
+
+  const int numRanks = controller->GetNumberOfProcesses();
+  const int rank = controller->GetLocalProcessId();
+  if (count > numRanks)
+  {
+    vtkLogF(WARNING, "Cannot split %d processes into %d time compartments, using %d instead.",
+      numRanks, count, numRanks);
+    count = numRanks;
+  }
+
+  // consecutive ranks are grouped together, groups differ in size by 1 at most.
+  const int index = static_cast<int>((static_cast<vtkTypeInt64>(rank) * count) / numRanks);
+  auto compartment = vtk::TakeSmartPointer(controller->PartitionController(index, rank));
+  if (compartment == nullptr)
+  {
+    vtkLogF(ERROR, "Failed to split processes into time compartments.");
+    return false;
+  }
+
+  // the first process of each compartment is connected to the others.
+  const bool isFirst = compartment->GetLocalProcessId() == 0;
+  auto firsts = vtk::TakeSmartPointer(controller->PartitionController(isFirst ? 0 : 1, index));
+
+  vtkProcessModule::NumberOfTimeCompartments = count;
+  vtkProcessModule::TimeCompartmentIndex = index;
+  vtkProcessModule::TimeCompartmentController = compartment;
+  vtkProcessModule::TimeCompartmentsController = isFirst ? firsts : nullptr;
+
+  compartment->BroadcastTriggerRMIOn();
+  vtkMultiProcessController::SetGlobalController(compartment);
+  vtkLogF(TRACE, "Process %d is in time compartment %d of %d (process %d of %d).", rank, index,
+    count, compartment->GetLocalProcessId(), compartment->GetNumberOfProcesses());
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkProcessModule::GetNumberOfTimeCompartments()
+{
+  return vtkProcessModule::NumberOfTimeCompartments;
+}
+
+//----------------------------------------------------------------------------
+int vtkProcessModule::GetTimeCompartmentIndex()
+{
+  return vtkProcessModule::TimeCompartmentIndex;
+}
+
+//----------------------------------------------------------------------------
+vtkMultiProcessController* vtkProcessModule::GetTimeCompartmentsController()
+{
+  return vtkProcessModule::TimeCompartmentsController;
+}
+
 //----------------------------------------------------------------------------
 void vtkProcessModule::PushActiveSession(vtkSession* session)
 {
@@ -240,6 +240,31 @@ public:
    */
   bool IsMPIInitialized();
 
+  /**
+   * Splits the processes into `count` groups of consecutive ranks, called time
+   * compartments. The controller of the group this process belongs to becomes
+   * the global controller, so that each group acts as an independent process
+   * group. This is a collective operation and must be called before any
+   * session is created. Returns false on failure.
+   */
+  static bool InitializeTimeCompartments(int count);
+
+  //@{
+  /**
+   * Returns the number of time compartments and the index of the compartment
+   * this process belongs to. Without time compartments, there is a single one.
+   */
+  int GetNumberOfTimeCompartments();
+  int GetTimeCompartmentIndex();
+  //@}
+
+  /**
+   * Returns a controller connecting the first process of each time
+   * compartment, where the process id is the compartment index. Returns
+   * nullptr on other processes or without time compartments.
+   */
+  vtkMultiProcessController* GetTimeCompartmentsController();
+
   //@{
   /**
    * Set/Get whether to report errors from the Interpreter.
@@ -352,6 +377,10 @@ private:
 
   static vtkSmartPointer<vtkProcessModule> Singleton;
   static vtkSmartPointer<vtkMultiProcessController> GlobalController;
+  static vtkSmartPointer<vtkMultiProcessController> TimeCompartmentController;
+  static vtkSmartPointer<vtkMultiProcessController> TimeCompartmentsController;
+  static int NumberOfTimeCompartments;
+  static int TimeCompartmentIndex;
 
   bool MultipleSessionsSupport;
 
@@ -123,6 +123,11 @@ bool vtkProcessModuleConfiguration::PopulateOptions(
   {
     app->add_flag("-s,--sym,--symmetric", this->SymmetricMPIMode,
       "When specified, the python script is processed symmetrically on all processes.");
+    group
+      ->add_option("--time-compartments", this->NumberOfTimeCompartments,
+        "Split processes into the given number of groups, each executing the python script "
+        "independently. Animations are saved with each group rendering a subset of the frames.")
+      ->check(CLI::PositiveNumber);
   }
 
   return true;
@@ -155,6 +160,7 @@ void vtkProcessModuleConfiguration::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ForceMPIInit: " << this->ForceMPIInit << endl;
   os << indent << "ForceNoMPIInit: " << this->ForceNoMPIInit << endl;
   os << indent << "SymmetricMPIMode: " << this->SymmetricMPIMode << endl;
+  os << indent << "NumberOfTimeCompartments: " << this->NumberOfTimeCompartments << endl;
   os << indent << "EnableStackTrace: " << this->EnableStackTrace << endl;
   os << indent << "LogStdErrVerbosity: " << this->LogStdErrVerbosity << endl;
   os << indent << "CSLogFileName: " << this->CSLogFileName.c_str() << endl;
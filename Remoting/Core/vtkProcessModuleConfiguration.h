@@ -75,6 +75,15 @@ public:
    */
   vtkSetMacro(SymmetricMPIMode, bool);
 
+  /**
+   * Get the number of time compartments to split the processes into. Each
+   * compartment is a group of processes that executes the Python script
+   * independently of the others, with spatial parallelism inside the group.
+   * Saving an animation then splits the frames between the compartments.
+   * This is only supported in "batch". Default is 1.
+   */
+  vtkGetMacro(NumberOfTimeCompartments, int);
+
   /**
    * Get the verbosity level to use for reporting log messages on `stderr`.
    * In other words, all messages at the chosen level and higher are posted to
@@ -129,6 +138,7 @@ private:
   bool ForceNoMPIInit = false;
   bool UseMPISSend = false;
   bool SymmetricMPIMode = false;
+  int NumberOfTimeCompartments = 1;
   bool EnableStackTrace = false;
   vtkLogger::Verbosity LogStdErrVerbosity = vtkLogger::VERBOSITY_INVALID;
   std::string CSLogFileName;
@@ -534,6 +534,17 @@ bool vtkRemotingCoreConfiguration::PopulateMiscellaneousOptions(
       "Enable the client to connect to multiple independent servers at the same time.");
   }
 
+  group->add_flag("--network-io-threads", this->NetworkIOThreads,
+    "Send messages over client/server connections from a dedicated thread for each "
+    "connection, so that large transfers overlap with other work.");
+
+  group
+    ->add_option("--socket-streams", this->SocketStreams,
+      "Number of sockets used to send bulk data over client/server and M-to-N connections. "
+      "The smallest number requested by both sides of a connection is used.")
+    ->check(CLI::Range(1, 64))
+    ->default_val(1);
+
   return true;
 }
 
@@ -566,6 +577,8 @@ void vtkRemotingCoreConfiguration::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "MultiServerMode: " << this->MultiServerMode << endl;
   os << indent << "MultiClientMode: " << this->MultiClientMode << endl;
   os << indent << "DisableFurtherConnections: " << this->DisableFurtherConnections << endl;
+  os << indent << "NetworkIOThreads: " << this->NetworkIOThreads << endl;
+  os << indent << "SocketStreams: " << this->SocketStreams << endl;
 
   os << indent << "ServerConfigurationsFiles (count=" << this->ServerConfigurationsFiles.size()
      << "):" << endl;
@@ -272,6 +272,18 @@ public:
    */
   vtkGetMacro(DisableFurtherConnections, bool);
 
+  /**
+   * Returns true if messages sent over client/server connections should be
+   * sent from a dedicated thread, see vtkPVThreadedSocketCommunicator.
+   */
+  vtkGetMacro(NetworkIOThreads, bool);
+
+  /**
+   * Returns the number of sockets requested for bulk data transfers over
+   * client/server and M-to-N connections, see vtkPVStripedSocketCommunicator.
+   */
+  vtkGetMacro(SocketStreams, int);
+
   //---------------------------------------------------------------------------
   /**
    * Populates vtkCLIOptions with available command line options.
@@ -327,6 +339,8 @@ private:
   bool MultiServerMode = false;
   bool MultiClientMode = false;
   bool DisableFurtherConnections = false;
+  bool NetworkIOThreads = false;
+  int SocketStreams = 1;
   bool PrintMonitors = false;
 
   std::vector<std::string> Displays;
@@ -16,7 +16,11 @@
 
 #include "vtkClientSocket.h"
 #include "vtkCommand.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVStripedSocketCommunicator.h"
+#include "vtkPVThreadedSocketCommunicator.h"
+#include "vtkRemotingCoreConfiguration.h"
 #include "vtkServerSocket.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
@@ -28,6 +32,7 @@
 #include <vtksys/SystemInformation.hxx>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <sstream>
@@ -47,8 +52,35 @@ public:
   VectorOfControllers Controllers;
   typedef std::map<int, vtkSmartPointer<vtkServerSocket>> MapToServerSockets;
   MapToServerSockets ServerSockets;
+
+  // Whether the connection being created uses an I/O thread.
+  bool PendingConnectionUsesIOThread = false;
+  // Number of streams requested for the connection being created.
+  int PendingConnectionNumberOfStreams = 1;
 };
 
+namespace
+{
+// Appended to the handshake of a side requesting several streams, followed by
+// their number. Nothing is appended for a single stream so that such
+// connections are unchanged.
+const char* STREAMS_HANDSHAKE_SUFFIX = ".streams.";
+
+// Removes the streams suffix from a handshake and returns the number of
+// streams it requested.
+int SplitNumberOfStreams(std::string& handshake)
+{
+  vtksys::RegularExpression re("\\.streams\\.([0-9]+)$");
+  if (!re.find(handshake))
+  {
+    return 1;
+  }
+  const int numberOfStreams = std::max(1, atoi(re.match(1).c_str()));
+  handshake.erase(re.start(0));
+  return numberOfStreams;
+}
+}
+
 vtkStandardNewMacro(vtkTCPNetworkAccessManager);
 //----------------------------------------------------------------------------
 vtkTCPNetworkAccessManager::vtkTCPNetworkAccessManager()
@@ -110,6 +142,20 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::NewConnection(
 
     this->WrongConnectID = false;
 
+    this->Internals->PendingConnectionUsesIOThread = this->UseIOThreads ||
+      vtkRemotingCoreConfiguration::GetInstance()->GetNetworkIOThreads();
+    if (parameters.find("iothread") != parameters.end())
+    {
+      this->Internals->PendingConnectionUsesIOThread = parameters["iothread"] == "true";
+    }
+    this->Internals->PendingConnectionNumberOfStreams =
+      vtkRemotingCoreConfiguration::GetInstance()->GetSocketStreams();
+    if (parameters.find("streams") != parameters.end())
+    {
+      this->Internals->PendingConnectionNumberOfStreams =
+        std::max(1, atoi(parameters["streams"].c_str()));
+    }
+
     if (parameters["listen"] == "true")
     {
       return this->WaitForConnection(port, !(parameters["multiple"] == "true"), handshake,
@@ -361,6 +407,13 @@ void vtkTCPNetworkAccessManager::PrintHandshakeError(int errorcode, bool server_
         "Connection failed during handshake.  Unknown error parsing the handshake string\n"
         "************************************************************************\n");
       break;
+    case HANDSHAKE_STREAMS_FAILED:
+      vtkErrorMacro("\n"
+                    "**********************************************************************\n"
+                    " Connection failed during handshake.  The additional sockets requested\n"
+                    " with --socket-streams could not be connected.\n"
+                    "**********************************************************************\n");
+      break;
   }
 }
 
@@ -413,7 +466,7 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::ConnectToRemote(const cha
     vtksys::SystemTools::Delay(1000);
   }
 
-  vtkSocketController* controller = vtkSocketController::New();
+  vtkSocketController* controller = this->NewSocketController();
   vtkSocketCommunicator* comm = vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator());
 #if GENERATE_DEBUG_LOG
   std::ostringstream mystr;
@@ -422,7 +475,10 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::ConnectToRemote(const cha
 #endif
   comm->SetSocket(cs);
   int errorcode = HANDSHAKE_SOCKET_COMMUNICATOR_DIFFERENT;
-  if (!comm->Handshake() || (errorcode = this->ParaViewHandshake(controller, false, handshake)))
+  int numberOfStreams = this->Internals->PendingConnectionNumberOfStreams;
+  if (!comm->Handshake() ||
+    (errorcode = this->ParaViewHandshake(controller, false, handshake, numberOfStreams)) ||
+    (errorcode = this->SetupStreams(controller, nullptr, hostname, port, numberOfStreams)))
   {
     controller->Delete();
     // handshake failed, must be bogus client, continue waiting (unless
@@ -431,6 +487,7 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::ConnectToRemote(const cha
     result = vtkNetworkAccessManager::ConnectionResult::CONNECTION_HANDSHAKE_ERROR;
     return nullptr;
   }
+  this->StartIOThread(controller);
   this->Internals->Controllers.push_back(controller);
   result = vtkNetworkAccessManager::ConnectionResult::CONNECTION_SUCCESS;
   return controller;
@@ -492,14 +549,16 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::WaitForConnection(int por
       return nullptr;
     }
 
-    controller = vtkSocketController::New();
+    controller = this->NewSocketController();
     vtkSocketCommunicator* comm =
       vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator());
     comm->SetSocket(client_socket);
     client_socket->FastDelete();
     int errorcode = HANDSHAKE_SOCKET_COMMUNICATOR_DIFFERENT;
+    int numberOfStreams = this->Internals->PendingConnectionNumberOfStreams;
     if (comm->Handshake() == 0 ||
-      (errorcode = this->ParaViewHandshake(controller, true, handshake)))
+      (errorcode = this->ParaViewHandshake(controller, true, handshake, numberOfStreams)) ||
+      (errorcode = this->SetupStreams(controller, server_socket, nullptr, 0, numberOfStreams)))
     {
       controller->Delete();
       controller = nullptr;
@@ -514,6 +573,7 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::WaitForConnection(int por
 
   if (controller)
   {
+    this->StartIOThread(controller);
     this->Internals->Controllers.push_back(controller);
     result = vtkNetworkAccessManager::ConnectionResult::CONNECTION_SUCCESS;
   }
@@ -531,6 +591,55 @@ vtkMultiProcessController* vtkTCPNetworkAccessManager::WaitForConnection(int por
   return controller;
 }
 
+//----------------------------------------------------------------------------
+vtkSocketController* vtkTCPNetworkAccessManager::NewSocketController()
+{
+  vtkSocketController* controller = vtkSocketController::New();
+  if (this->Internals->PendingConnectionNumberOfStreams > 1)
+  {
+    vtkNew<vtkPVStripedSocketCommunicator> comm;
+    controller->SetCommunicator(comm);
+  }
+  else if (this->Internals->PendingConnectionUsesIOThread)
+  {
+    vtkNew<vtkPVThreadedSocketCommunicator> comm;
+    controller->SetCommunicator(comm);
+  }
+  return controller;
+}
+
+//----------------------------------------------------------------------------
+int vtkTCPNetworkAccessManager::SetupStreams(vtkSocketController* controller,
+  vtkServerSocket* server_socket, const char* hostname, int port, int numberOfStreams)
+{
+  if (numberOfStreams <= 1)
+  {
+    return HANDSHAKE_NO_ERROR;
+  }
+
+  // Both sides requested more than one stream, hence use a
+  // vtkPVStripedSocketCommunicator.
+  auto striped = vtkPVStripedSocketCommunicator::SafeDownCast(controller->GetCommunicator());
+  const bool success = server_socket ? striped->AcceptStreams(server_socket, numberOfStreams)
+                                     : striped->ConnectStreams(hostname, port, numberOfStreams);
+  return success ? HANDSHAKE_NO_ERROR : HANDSHAKE_STREAMS_FAILED;
+}
+
+//----------------------------------------------------------------------------
+void vtkTCPNetworkAccessManager::StartIOThread(vtkSocketController* controller)
+{
+  auto comm = vtkPVThreadedSocketCommunicator::SafeDownCast(controller->GetCommunicator());
+  if (!this->Internals->PendingConnectionUsesIOThread)
+  {
+    return;
+  }
+  if (comm && !comm->StartIOThread())
+  {
+    vtkWarningMacro("Could not start the I/O thread, messages will be sent synchronously.");
+  }
+}
+
+//----------------------------------------------------------------------------
 int vtkTCPNetworkAccessManager::AnalyzeHandshakeAndGetErrorCode(
   const char* clientHS, const char* serverHS)
 {
@@ -588,11 +697,12 @@ int vtkTCPNetworkAccessManager::AnalyzeHandshakeAndGetErrorCode(
 }
 
 //----------------------------------------------------------------------------
-int vtkTCPNetworkAccessManager::ParaViewHandshake(
-  vtkMultiProcessController* controller, bool server_side, const char* _handshake)
+int vtkTCPNetworkAccessManager::ParaViewHandshake(vtkMultiProcessController* controller,
+  bool server_side, const char* _handshake, int& numberOfStreams)
 {
-  const std::string handshake = _handshake ? _handshake : "";
-  int size = static_cast<int>(handshake.size() + 1);
+  const int requestedNumberOfStreams = numberOfStreams;
+  numberOfStreams = 1;
+  std::string handshake = _handshake ? _handshake : "";
   if (server_side)
   {
     std::string other_handshake;
@@ -605,16 +715,28 @@ int vtkTCPNetworkAccessManager::ParaViewHandshake(
       other_handshake = _other_handshake;
       delete[] _other_handshake;
     }
+    const int otherNumberOfStreams = ::SplitNumberOfStreams(other_handshake);
     int errorCode = HANDSHAKE_NO_ERROR;
     if (handshake != other_handshake)
     {
       errorCode = this->AnalyzeHandshakeAndGetErrorCode(other_handshake.c_str(), handshake.c_str());
     }
     controller->Send(&errorCode, 1, 1, 99990);
+    if (errorCode == HANDSHAKE_NO_ERROR && otherNumberOfStreams > 1)
+    {
+      // only a client requesting several streams expects this reply.
+      controller->Send(&requestedNumberOfStreams, 1, 1, 99990);
+      numberOfStreams = std::max(1, std::min(requestedNumberOfStreams, otherNumberOfStreams));
+    }
     return errorCode;
   }
   else
   {
+    if (requestedNumberOfStreams > 1)
+    {
+      handshake += STREAMS_HANDSHAKE_SUFFIX + std::to_string(requestedNumberOfStreams);
+    }
+    int size = static_cast<int>(handshake.size() + 1);
     controller->Send(&size, 1, 1, 99991);
     if (size > 0)
     {
@@ -622,6 +744,12 @@ int vtkTCPNetworkAccessManager::ParaViewHandshake(
     }
     int errorCode;
     controller->Receive(&errorCode, 1, 1, 99990);
+    if (errorCode == HANDSHAKE_NO_ERROR && requestedNumberOfStreams > 1)
+    {
+      int otherNumberOfStreams = 1;
+      controller->Receive(&otherNumberOfStreams, 1, 1, 99990);
+      numberOfStreams = std::max(1, std::min(requestedNumberOfStreams, otherNumberOfStreams));
+    }
     return errorCode;
   }
 }
@@ -630,4 +758,5 @@ int vtkTCPNetworkAccessManager::ParaViewHandshake(
 void vtkTCPNetworkAccessManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseIOThreads: " << this->UseIOThreads << endl;
 }
@@ -27,6 +27,8 @@
 #include "vtkRemotingCoreModule.h" //needed for exports
 
 class vtkMultiProcessController;
+class vtkServerSocket;
+class vtkSocketController;
 
 class VTKREMOTINGCORE_EXPORT vtkTCPNetworkAccessManager : public vtkNetworkAccessManager
 {
@@ -73,6 +75,10 @@ public:
    * (in seconds) for which this call blocks to retry attempts to
    * connect to the host/port. If absent, default is 60s. 0 implies no retry attempts.
    * A negative value implies an infinite number of retries.
+   * iothread  :- "true" or "false" to override `UseIOThreads` for this
+   * connection.
+   * streams   :- number of sockets requested to transfer bulk data, overriding
+   * the `--socket-streams` command line option for this connection.
    */
   using vtkNetworkAccessManager::NewConnection;
   vtkMultiProcessController* NewConnection(
@@ -112,6 +118,18 @@ public:
    */
   bool GetWrongConnectID() override;
 
+  ///@{
+  /**
+   * When set, messages sent over new connections are queued and written to the
+   * socket by a thread dedicated to each connection, see
+   * vtkPVThreadedSocketCommunicator. Off by default, unless the
+   * `--network-io-threads` command line option is used.
+   */
+  vtkSetMacro(UseIOThreads, bool);
+  vtkGetMacro(UseIOThreads, bool);
+  vtkBooleanMacro(UseIOThreads, bool);
+  ///@}
+
 protected:
   vtkTCPNetworkAccessManager();
   ~vtkTCPNetworkAccessManager() override;
@@ -138,16 +156,48 @@ protected:
     HANDSHAKE_DIFFERENT_PV_VERSIONS,
     HANDSHAKE_DIFFERENT_CONNECTION_IDS,
     HANDSHAKE_DIFFERENT_RENDERING_BACKENDS,
-    HANDSHAKE_UNKNOWN_ERROR
+    HANDSHAKE_UNKNOWN_ERROR,
+    HANDSHAKE_STREAMS_FAILED
   };
 
-  int ParaViewHandshake(
-    vtkMultiProcessController* controller, bool server_side, const char* handshake);
+  /**
+   * Creates the controller for a new connection, using a
+   * vtkPVStripedSocketCommunicator when the pending connection requests
+   * several streams, or a vtkPVThreadedSocketCommunicator when it uses an
+   * I/O thread.
+   */
+  vtkSocketController* NewSocketController();
+
+  /**
+   * Opens the additional sockets used for bulk data when both sides agreed on
+   * more than one stream during the handshake, see
+   * vtkPVStripedSocketCommunicator. `server_socket` is the socket the
+   * connection was accepted on, or nullptr on the side that connected to
+   * `hostname`:`port`. Returns a handshake error code.
+   */
+  int SetupStreams(vtkSocketController* controller, vtkServerSocket* server_socket,
+    const char* hostname, int port, int numberOfStreams);
+
+  /**
+   * Starts the I/O thread of a connection once the handshake succeeded, if
+   * requested.
+   */
+  void StartIOThread(vtkSocketController* controller);
+
+  /**
+   * Exchanges the handshake strings. `numberOfStreams` is the number of
+   * streams requested on this side on input and the number agreed on with the
+   * other side on output. It is only sent along when larger than one, so that
+   * single stream connections are unchanged.
+   */
+  int ParaViewHandshake(vtkMultiProcessController* controller, bool server_side,
+    const char* handshake, int& numberOfStreams);
   void PrintHandshakeError(int errorcode, bool server_side);
   int AnalyzeHandshakeAndGetErrorCode(const char* clientHS, const char* serverHS);
 
   bool AbortPendingConnectionFlag;
   bool WrongConnectID;
+  bool UseIOThreads = false;
 
 private:
   vtkTCPNetworkAccessManager(const vtkTCPNetworkAccessManager&) = delete;
@@ -520,6 +520,13 @@ vtkPVXMLElement* vtkSIProxyDefinitionManager::GetProxyDefinition(
   const char* groupName, const char* proxyName, const bool throwError)
 {
   vtkPVXMLElement* element = this->Internals->GetProxyElement(groupName, proxyName);
+  if (!element && groupName && proxyName &&
+    vtkPVPluginTracker::GetInstance()->LoadDelayedPluginForProxy(groupName, proxyName))
+  {
+    // The definition is provided by a delay-loaded plugin. Loading it
+    // registered its definitions through HandlePlugin(), try again.
+    element = this->Internals->GetProxyElement(groupName, proxyName);
+  }
   if (!throwError || element)
   {
     return element;
@@ -1216,8 +1223,11 @@ void vtkSIProxyDefinitionManager::HandlePlugin(vtkPVPlugin* plugin)
 //---------------------------------------------------------------------------
 bool vtkSIProxyDefinitionManager::HasDefinition(const char* groupName, const char* proxyName)
 {
+  // definitions of delay-loaded plugins are available too, they get loaded
+  // when the definition itself is requested.
   return this->Internals->HasCustomDefinition(groupName, proxyName) ||
-    this->Internals->HasCoreDefinition(groupName, proxyName);
+    this->Internals->HasCoreDefinition(groupName, proxyName) ||
+    vtkPVPluginTracker::GetInstance()->HasDelayedProxy(groupName, proxyName);
 }
 
 //---------------------------------------------------------------------------
@@ -84,7 +84,8 @@ public:
   //@}
 
   /**
-   * Return true if the XML Definition was found
+   * Return true if the XML Definition was found, or if it is provided by a
+   * delay-loaded plugin that is not loaded yet.
    */
   bool HasDefinition(const char* groupName, const char* proxyName);
 
@@ -186,6 +187,8 @@ public:
    * ALL_DEFINITIONS=0 / CORE_DEFINITIONS=1 / CUSTOM_DEFINITIONS=2
    * Some extra restriction can be set directly on the iterator itself
    * by setting a set of GroupName...
+   * Definitions of delay-loaded plugins that are not loaded yet are not
+   * traversed, see vtkPVPluginTracker::GetDelayedProxies().
    */
   VTK_NEWINSTANCE
   vtkPVProxyDefinitionIterator* NewIterator(int scope = ALL_DEFINITIONS);
@@ -195,6 +198,8 @@ public:
    * for only one GroupName.
    * Possible scope defined as enum inside vtkSIProxyDefinitionManager:
    * ALL_DEFINITIONS=0 / CORE_DEFINITIONS=1 / CUSTOM_DEFINITIONS=2
+   * Definitions of delay-loaded plugins that are not loaded yet are not
+   * traversed, see vtkPVPluginTracker::GetDelayedProxies().
    */
   vtkPVProxyDefinitionIterator* NewSingleGroupIterator(
     const char* groupName, int scope = ALL_DEFINITIONS);
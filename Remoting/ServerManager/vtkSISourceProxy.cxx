@@ -98,6 +98,10 @@ bool vtkSISourceProxy::CreateVTKObjects()
   // local timer-log.
   algorithm->AddObserver(vtkCommand::StartEvent, this, &vtkSISourceProxy::MarkStartEvent);
   algorithm->AddObserver(vtkCommand::EndEvent, this, &vtkSISourceProxy::MarkEndEvent);
+
+  // identifies the algorithm on all processes for the memory budget.
+  algorithm->GetInformation()->Set(
+    vtkPVCompositeDataPipeline::GLOBAL_ID(), static_cast<int>(this->GetGlobalID()));
   return true;
 }
 
@@ -253,6 +257,12 @@ void vtkSISourceProxy::UpdatePipeline(int port, double time, bool doTime)
     outInfo->Set(sddp->UPDATE_TIME_STEP(), time);
   }
   sddp->Update(real_port);
+
+  // all processes update the pipeline, decide together which outputs to
+  // release, keeping the one just updated.
+  vtkAlgorithm* proxyAlgorithm = vtkAlgorithm::SafeDownCast(this->GetVTKObject());
+  vtkPVCompositeDataPipeline::EnforceMemoryBudget(
+    proxyAlgorithm ? proxyAlgorithm->GetExecutive() : nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -30,6 +30,7 @@
 #include "vtkSMPropertyIterator.h"
 #include "vtkSMProxyManager.h"
 #include "vtkSMSessionProxyManager.h"
+#include "vtkSMStateLoader.h"
 #include "vtkSMTrace.h"
 
 #include <vtk_pugixml.h>
@@ -134,6 +135,9 @@ public:
   // The XML Document.
   pugi::xml_document StateXML;
 
+  // The loader used by the last Load().
+  vtkSmartPointer<vtkSMStateLoader> StateLoader;
+
   std::string GetExposedPropertyName(int id, const std::string& pname) const
   {
     for (auto pair : this->ExposedPropertyNameMap)
@@ -629,10 +633,20 @@ bool vtkSMLoadStateOptionsProxy::Load()
   internals.UpdateStateXML();
 
   auto pxm = this->GetSessionProxyManager();
-  pxm->LoadXMLState(vtkInternals::ConvertXML(internals.StateXML));
+  internals.StateLoader = vtkSmartPointer<vtkSMStateLoader>::New();
+  internals.StateLoader->SetSessionProxyManager(pxm);
+  internals.StateLoader->SetDeferPipelineUpdates(
+    vtkSMPropertyHelper(this, "DeferPipelineUpdates", /*quiet*/ true).GetAsInt() == 1);
+  pxm->LoadXMLState(vtkInternals::ConvertXML(internals.StateXML), internals.StateLoader);
   return true;
 }
 
+//----------------------------------------------------------------------------
+vtkSMStateLoader* vtkSMLoadStateOptionsProxy::GetStateLoader()
+{
+  return this->Internals->StateLoader;
+}
+
 //----------------------------------------------------------------------------
 vtkSMProperty* vtkSMLoadStateOptionsProxy::FindProperty(const char* name, int id, const char* pname)
 {
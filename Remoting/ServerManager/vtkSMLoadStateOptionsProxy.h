@@ -42,6 +42,8 @@
 #include "vtkSMProxy.h"
 #include <vector> // needed for std::vector
 
+class vtkSMStateLoader;
+
 class VTKREMOTINGSERVERMANAGER_EXPORT vtkSMLoadStateOptionsProxy : public vtkSMProxy
 {
 public:
@@ -67,6 +69,13 @@ public:
    */
   virtual bool Load();
 
+  /**
+   * Returns the loader used by the last call to Load(), or nullptr. It can be
+   * used to query the time spent on each proxy, see
+   * vtkSMStateLoader::GetNumberOfTimings().
+   */
+  vtkSMStateLoader* GetStateLoader();
+
   enum
   {
     USE_FILES_FROM_STATE = 0,
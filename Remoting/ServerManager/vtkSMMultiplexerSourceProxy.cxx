@@ -17,6 +17,7 @@
 #include "vtkClientServerStream.h"
 #include "vtkLogger.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVPluginTracker.h"
 #include "vtkPVProxyDefinitionIterator.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSMDomain.h"
@@ -186,6 +187,9 @@ int vtkSMMultiplexerSourceProxy::CreateSubProxiesAndProperties(
 
   // TODO: make this fast. We should update vtkSIProxyDefinitionManager to give
   // api to get this with ease.
+  // Hints of proxies provided by delay-loaded plugins are only known once the
+  // plugins are loaded.
+  vtkPVPluginTracker::GetInstance()->LoadDelayedPluginsForGroup(nullptr);
   auto iter = pxm->GetProxyDefinitionManager()->NewIterator();
   for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
   {
@@ -34,6 +34,11 @@
 
 #include <sstream>
 
+namespace
+{
+bool TimeParallelTemporalDataInformation = false;
+}
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSMOutputPort);
 
@@ -247,6 +252,7 @@ void vtkSMOutputPort::GatherTemporalDataInformation()
   this->SourceProxy->GetSession()->PrepareProgress();
   this->TemporalDataInformation->Initialize();
   this->TemporalDataInformation->SetPortNumber(this->PortIndex);
+  this->TemporalDataInformation->SetTimeParallel(TimeParallelTemporalDataInformation);
   this->SourceProxy->GatherInformation(this->TemporalDataInformation);
   this->TemporalDataInformation->Modified();
 
@@ -254,6 +260,18 @@ void vtkSMOutputPort::GatherTemporalDataInformation()
   this->SourceProxy->GetSession()->CleanupPendingProgress();
 }
 
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::SetTimeParallelTemporalDataInformation(bool value)
+{
+  TimeParallelTemporalDataInformation = value;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMOutputPort::GetTimeParallelTemporalDataInformation()
+{
+  return TimeParallelTemporalDataInformation;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMOutputPort::GatherClassNameInformation()
 {
@@ -94,6 +94,16 @@ public:
    */
   virtual vtkPVTemporalDataInformation* GetTemporalDataInformation();
 
+  //@{
+  /**
+   * When set, temporal data information is gathered by distributing the
+   * timesteps among the server ranks, see
+   * `vtkPVTemporalDataInformation::SetTimeParallel`. Off by default.
+   */
+  static void SetTimeParallelTemporalDataInformation(bool);
+  static bool GetTimeParallelTemporalDataInformation();
+  //@}
+
   /**
    * Returns the classname of the data object on this output port.
    */
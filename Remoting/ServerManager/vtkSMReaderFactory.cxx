@@ -17,6 +17,7 @@
 #include "vtkClientServerStream.h"
 #include "vtkCollection.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVPluginTracker.h"
 #include "vtkPVProxyDefinitionIterator.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
@@ -432,6 +433,8 @@ vtkStringList* vtkSMReaderFactory::GetReaders(const char* filename, vtkSMSession
     return this->Readers;
   }
 
+  this->LoadDelayedPluginsForFile(filename);
+
   std::vector<std::string> extensions;
   this->Internals->BuildExtensions(filename, extensions);
 
@@ -495,6 +498,8 @@ bool vtkSMReaderFactory::CanReadFile(const char* filename, vtkSMSession* session
     return false;
   }
 
+  this->LoadDelayedPluginsForFile(filename);
+
   const bool is_dir = vtkSMReaderFactory::GetFilenameIsDirectory(filename, session);
 
   std::vector<std::string> extensions;
@@ -516,6 +521,17 @@ bool vtkSMReaderFactory::CanReadFile(const char* filename, vtkSMSession* session
   return false;
 }
 
+//----------------------------------------------------------------------------
+void vtkSMReaderFactory::LoadDelayedPluginsForFile(const char* filename)
+{
+  // Readers provided by delay-loaded plugins are not registered until the
+  // plugin is loaded. Load the plugins that handle this file type first.
+  if (vtkPVPluginTracker::GetInstance()->LoadDelayedPluginsForFile(filename))
+  {
+    this->UpdateAvailableReaders();
+  }
+}
+
 //----------------------------------------------------------------------------
 static std::string vtkJoin(
   const std::vector<std::string>& exts, const char* prefix, const char* separator)
@@ -216,6 +216,12 @@ protected:
    */
   static bool GetFilenameIsDirectory(const char* fname, vtkSMSession* session);
 
+  /**
+   * Loads delay-loaded plugins providing readers for the file, if any, and
+   * updates the available readers accordingly.
+   */
+  void LoadDelayedPluginsForFile(const char* filename);
+
   vtkSetStringMacro(ReaderName);
   vtkSetStringMacro(ReaderGroup);
 
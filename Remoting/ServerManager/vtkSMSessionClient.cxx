@@ -47,6 +47,7 @@
 #include <string>
 #include <vtksys/RegularExpression.hxx>
 
+#include <algorithm>
 #include <cassert>
 #include <set>
 
@@ -446,10 +447,25 @@ void vtkSMSessionClient::SetupDataServerRenderServerConnection()
     helper.Set(3 * cc + 2, info->GetProcessHostName(cc));
   }
   mpiMToN->UpdateVTKObjects();
+
+  // Large buffers are striped over several sockets only when both servers
+  // requested more than one, see vtkPVStripedSocketCommunicator.
+  int numberOfStreams = info->GetNumberOfStreams();
   info->Delete();
   info = nullptr;
+  if (numberOfStreams > 1)
+  {
+    vtkNew<vtkMPIMToNSocketConnectionPortInformation> dsInfo;
+    this->GatherInformation(DATA_SERVER, dsInfo, mpiMToN->GetGlobalID());
+    numberOfStreams = std::min(numberOfStreams, dsInfo->GetNumberOfStreams());
+  }
 
   vtkClientServerStream stream;
+  if (numberOfStreams > 1)
+  {
+    stream << vtkClientServerStream::Invoke << VTKOBJECT(mpiMToN) << "SetNumberOfStreams"
+           << numberOfStreams << vtkClientServerStream::End;
+  }
   stream << vtkClientServerStream::Invoke << vtkClientServerID(1) // ID for vtkSMSessionCore helper.
          << "SetMPIMToNSocketConnection" << VTKOBJECT(mpiMToN) << vtkClientServerStream::End;
   this->ExecuteStream(vtkPVSession::SERVERS, stream);
@@ -16,8 +16,11 @@
 
 #include "vtkClientServerStreamInstantiator.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
 #include "vtkPVXMLElement.h"
+#include "vtkSMInputProperty.h"
 #include "vtkSMProperty.h"
+#include "vtkSMPropertyHelper.h"
 #include "vtkSMPropertyLink.h"
 #include "vtkSMProxyIterator.h"
 #include "vtkSMProxyLink.h"
@@ -29,9 +32,11 @@
 #include "vtkSMSourceProxy.h"
 #include "vtkSMStateVersionController.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
 
 #include <cassert>
 #include <cstdlib>
+#include <set>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkSMStateLoader);
@@ -44,6 +49,13 @@ struct vtkSMStateLoaderRegistrationInfo
   std::string LogName;
 };
 
+struct vtkSMStateLoaderTiming
+{
+  std::string ProxyName;
+  std::string Stage;
+  double Duration;
+};
+
 struct vtkSMStateLoaderInternals
 {
   bool KeepOriginalId;
@@ -59,6 +71,22 @@ struct vtkSMStateLoaderInternals
   ProxyCreationOrderType ProxyCreationOrder;
   bool DeferProxyRegistration;
 
+  /// Used when DeferPipelineUpdates is set. Sources whose pipeline
+  /// information update is pending and all proxies created by the loader, in
+  /// creation order.
+  std::vector<vtkWeakPointer<vtkSMSourceProxy>> PendingInformationUpdates;
+  std::vector<vtkWeakPointer<vtkSMProxy>> CreatedProxies;
+  std::vector<vtkSMStateLoaderTiming> Timings;
+
+  void AddTiming(vtkSMProxy* proxy, const char* stage, double start)
+  {
+    const double duration = vtkTimerLog::GetUniversalTime() - start;
+    this->Timings.push_back(
+      vtkSMStateLoaderTiming{ proxy->GetLogNameOrDefault(), stage, duration });
+    vtkVLogF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "state loading: %s %s took %fs",
+      proxy->GetLogNameOrDefault(), stage, duration);
+  }
+
   vtkSMStateLoaderInternals()
     : KeepOriginalId(false)
     , DeferProxyRegistration(false)
@@ -72,6 +100,7 @@ vtkSMStateLoader::vtkSMStateLoader()
   this->Internal = new vtkSMStateLoaderInternals;
   this->ServerManagerStateElement = nullptr;
   this->KeepIdMapping = 0;
+  this->DeferPipelineUpdates = false;
   this->ProxyLocator = vtkSMProxyLocator::New();
 }
 
@@ -220,11 +249,28 @@ void vtkSMStateLoader::CreatedNewProxy(vtkTypeUInt32 id, vtkSMProxy* proxy)
     proxy->SetGlobalID(id);
   }
 
+  const double start = vtkTimerLog::GetUniversalTime();
+
   // Calling UpdateVTKObjects() will assign the proxy a GlobalId, if needed.
   proxy->UpdateVTKObjects();
-  if (proxy->IsA("vtkSMSourceProxy"))
+
+  this->Internal->AddTiming(proxy, "create", start);
+
+  auto source = vtkSMSourceProxy::SafeDownCast(proxy);
+  if (this->DeferPipelineUpdates)
+  {
+    this->Internal->CreatedProxies.push_back(proxy);
+  }
+  if (source && this->DeferPipelineUpdates && this->Internal->DeferProxyRegistration)
+  {
+    // Postponed until all proxies are created, see LoadStateInternal().
+    this->Internal->PendingInformationUpdates.push_back(source);
+  }
+  else if (source)
   {
-    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
+    const double informationStart = vtkTimerLog::GetUniversalTime();
+    source->UpdatePipelineInformation();
+    this->Internal->AddTiming(source, "information", informationStart);
   }
   if (this->Internal->DeferProxyRegistration)
   {
@@ -520,6 +566,7 @@ bool vtkSMStateLoader::VerifyXMLVersion(vtkPVXMLElement* rootElement)
 int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem, bool keepOriginalId)
 {
   this->Internal->KeepOriginalId = keepOriginalId;
+  this->Internal->Timings.clear();
   if (!elem)
   {
     vtkErrorMacro("Cannot load state from (null) root element.");
@@ -648,6 +695,19 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
     }
   }
 
+  // Update pipeline information that was deferred, before registering the
+  // proxies since registration may look it up.
+  for (const auto& source : this->Internal->PendingInformationUpdates)
+  {
+    if (source)
+    {
+      const double start = vtkTimerLog::GetUniversalTime();
+      source->UpdatePipelineInformation();
+      this->Internal->AddTiming(source, "information", start);
+    }
+  }
+  this->Internal->PendingInformationUpdates.clear();
+
   // Register proxies in order they were created (as that's a good dependency
   // order).
   for (vtkSMStateLoaderInternals::ProxyCreationOrderType::const_iterator iter =
@@ -724,17 +784,101 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
     }
   }
 
+  if (this->DeferPipelineUpdates)
+  {
+    this->UpdateVisiblePipelines();
+  }
+
   // Clear internal data structures.
+  this->Internal->CreatedProxies.clear();
   this->Internal->ProxyCreationOrder.clear();
   this->Internal->RegistrationInformation.clear();
   this->ServerManagerStateElement = nullptr;
   return 1;
 }
 
+//---------------------------------------------------------------------------
+void vtkSMStateLoader::UpdateVisiblePipelines()
+{
+  auto pxm = this->GetSessionProxyManager();
+  vtkSMProxy* timekeeper = pxm->GetProxy("timekeeper", "TimeKeeper");
+  const bool useTime = timekeeper && timekeeper->GetProperty("Time");
+  const double time = useTime ? vtkSMPropertyHelper(timekeeper, "Time").GetAsDouble() : 0.0;
+
+  // Collect the inputs of visible representations.
+  std::set<vtkSMProxy*> visibleInputs;
+  for (const auto& proxy : this->Internal->CreatedProxies)
+  {
+    if (proxy && proxy->GetProperty("Visibility") &&
+      vtkSMInputProperty::SafeDownCast(proxy->GetProperty("Input")) &&
+      vtkSMPropertyHelper(proxy, "Visibility").GetAsInt() != 0)
+    {
+      vtkSMPropertyHelper helper(proxy, "Input");
+      for (unsigned int cc = 0; cc < helper.GetNumberOfElements(); ++cc)
+      {
+        if (auto input = helper.GetAsProxy(cc))
+        {
+          visibleInputs.insert(input);
+        }
+      }
+    }
+  }
+
+  // Creation order is a dependency order: update upstream branches first so
+  // that shared inputs execute once.
+  for (const auto& proxy : this->Internal->CreatedProxies)
+  {
+    auto source = vtkSMSourceProxy::SafeDownCast(proxy);
+    if (source && visibleInputs.find(source) != visibleInputs.end())
+    {
+      const double start = vtkTimerLog::GetUniversalTime();
+      if (useTime)
+      {
+        source->UpdatePipeline(time);
+      }
+      else
+      {
+        source->UpdatePipeline();
+      }
+      this->Internal->AddTiming(source, "update", start);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+int vtkSMStateLoader::GetNumberOfTimings()
+{
+  return static_cast<int>(this->Internal->Timings.size());
+}
+
+//---------------------------------------------------------------------------
+const char* vtkSMStateLoader::GetTimingProxyName(int index)
+{
+  return index >= 0 && index < this->GetNumberOfTimings()
+    ? this->Internal->Timings[index].ProxyName.c_str()
+    : nullptr;
+}
+
+//---------------------------------------------------------------------------
+const char* vtkSMStateLoader::GetTimingStage(int index)
+{
+  return index >= 0 && index < this->GetNumberOfTimings()
+    ? this->Internal->Timings[index].Stage.c_str()
+    : nullptr;
+}
+
+//---------------------------------------------------------------------------
+double vtkSMStateLoader::GetTimingDuration(int index)
+{
+  return index >= 0 && index < this->GetNumberOfTimings() ? this->Internal->Timings[index].Duration
+                                                          : 0.0;
+}
+
 //---------------------------------------------------------------------------
 void vtkSMStateLoader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DeferPipelineUpdates: " << this->DeferPipelineUpdates << endl;
 }
 
 //---------------------------------------------------------------------------
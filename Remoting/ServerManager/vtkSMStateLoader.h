@@ -18,6 +18,15 @@
  *
  * vtkSMStateLoader can load server manager state from a given
  * vtkPVXMLElement. This element is usually populated by a vtkPVXMLParser.
+ *
+ * By default, the pipeline information of each source is updated as soon as the
+ * source is created. When DeferPipelineUpdates is enabled, all proxies are
+ * created and their properties pushed first; pipeline information is then
+ * updated in a single pass in dependency order and, once the state is fully
+ * applied, only the pipelines feeding visible representations are updated.
+ * The time spent on each proxy is recorded in both cases, see
+ * GetNumberOfTimings(). vtkSMLoadStateOptionsProxy enables the option through
+ * its DeferPipelineUpdates property.
  * @sa
  * vtkPVXMLParser vtkPVXMLElement
  */
@@ -76,11 +85,36 @@ public:
    * The array is kept internally using a std::vector
    */
   vtkTypeUInt32* GetMappingArray(int& size);
+  //@}
+
+  //@{
+  /**
+   * When set, pipeline information updates are deferred until all proxies
+   * have been created and, after the state is loaded, only the sources
+   * connected to visible representations are updated, in dependency order,
+   * at the time of the time keeper. Default is false.
+   */
+  vtkSetMacro(DeferPipelineUpdates, bool);
+  vtkGetMacro(DeferPipelineUpdates, bool);
+  vtkBooleanMacro(DeferPipelineUpdates, bool);
+  //@}
+
+  //@{
+  /**
+   * Provides access to the time spent on each proxy during the last
+   * LoadState() call. Each entry is identified by the log name of the proxy
+   * and the stage, one of "create", "information" or, only when
+   * DeferPipelineUpdates is enabled, "update".
+   */
+  int GetNumberOfTimings();
+  const char* GetTimingProxyName(int index);
+  const char* GetTimingStage(int index);
+  double GetTimingDuration(int index);
+  //@}
 
 protected:
   vtkSMStateLoader();
   ~vtkSMStateLoader() override;
-  //@}
 
   /**
    * The rootElement must be the \c \<ServerManagerState/\> xml element.
@@ -162,9 +196,18 @@ protected:
    */
   vtkSMProxy* LocateExistingProxyUsingRegistrationName(vtkTypeUInt32 id);
 
+  /**
+   * Called at the end of LoadStateInternal() when DeferPipelineUpdates is
+   * enabled. Updates the sources, created by this loader, that are the input
+   * of a visible representation. Sources are updated in creation order which
+   * is also a dependency order.
+   */
+  virtual void UpdateVisiblePipelines();
+
   vtkPVXMLElement* ServerManagerStateElement;
   vtkSMProxyLocator* ProxyLocator;
   int KeepIdMapping;
+  bool DeferPipelineUpdates;
 
 private:
   vtkSMStateLoader(const vtkSMStateLoader&) = delete;
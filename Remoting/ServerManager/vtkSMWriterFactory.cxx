@@ -16,6 +16,7 @@
 
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVPluginTracker.h"
 #include "vtkPVProxyDefinitionIterator.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
@@ -275,10 +276,27 @@ void vtkSMWriterFactory::UpdateAvailableWriters()
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMWriterFactory::LoadDelayedWriters()
+{
+  // Writers provided by delay-loaded plugins are not registered until the
+  // plugin is loaded, and their file types are only known from their hints.
+  bool loaded = false;
+  for (const auto& group : this->Internals->Groups)
+  {
+    loaded = vtkPVPluginTracker::GetInstance()->LoadDelayedPluginsForGroup(group.c_str()) || loaded;
+  }
+  if (loaded)
+  {
+    this->UpdateAvailableWriters();
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkSMProxy* vtkSMWriterFactory::CreateWriter(
   const char* filename, vtkSMSourceProxy* source, unsigned int outputport, bool proxybyname)
 {
+  this->LoadDelayedWriters();
   if (!filename || filename[0] == 0)
   {
     vtkErrorMacro("No filename. Cannot create any writer.");
@@ -361,6 +379,7 @@ static std::string vtkJoin(const std::set<std::string> exts, const char* prefix,
 const char* vtkSMWriterFactory::GetSupportedFileTypes(
   vtkSMSourceProxy* source, unsigned int outputport)
 {
+  this->LoadDelayedWriters();
   auto case_insensitive_comp = [](const std::string& s1, const std::string& s2) {
     return vtksys::SystemTools::Strucmp(s1.c_str(), s2.c_str()) < 0;
   };
@@ -401,6 +420,7 @@ const char* vtkSMWriterFactory::GetSupportedFileTypes(
 const char* vtkSMWriterFactory::GetSupportedWriterProxies(
   vtkSMSourceProxy* source, unsigned int outputport)
 {
+  this->LoadDelayedWriters();
   std::set<std::string> sorted_types;
 
   vtkInternals::PrototypesType::iterator iter;
@@ -440,6 +460,7 @@ bool vtkSMWriterFactory::CanWrite(vtkSMSourceProxy* source, unsigned int outputp
   {
     return false;
   }
+  this->LoadDelayedWriters();
 
   vtkInternals::PrototypesType::iterator iter;
   for (iter = this->Internals->Prototypes.begin(); iter != this->Internals->Prototypes.end();
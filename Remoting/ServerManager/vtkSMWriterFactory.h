@@ -137,6 +137,12 @@ private:
   vtkSMWriterFactory(const vtkSMWriterFactory&) = delete;
   void operator=(const vtkSMWriterFactory&) = delete;
 
+  /**
+   * Loads delay-loaded plugins providing proxies in the writer groups, if any,
+   * and updates the available writers accordingly.
+   */
+  void LoadDelayedWriters();
+
   class vtkInternals;
   vtkInternals* Internals;
 };
@@ -25,6 +25,7 @@
 #include "vtkSISourceProxy.h"
 #include "vtkSMArraySelectionDomain.h"
 #include "vtkSMInputArrayDomain.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMTrace.h"
 
 #if VTK_MODULE_ENABLE_ParaView_RemotingAnimation
@@ -252,6 +253,22 @@ bool vtkPVGeneralSettings::GetLoadAllVariables()
   return vtkSMArraySelectionDomain::GetLoadAllVariables();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetTimeParallelTemporalRanges(bool val)
+{
+  if (val != vtkSMOutputPort::GetTimeParallelTemporalDataInformation())
+  {
+    vtkSMOutputPort::SetTimeParallelTemporalDataInformation(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVGeneralSettings::GetTimeParallelTemporalRanges()
+{
+  return vtkSMOutputPort::GetTimeParallelTemporalDataInformation();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::SetLoadNoChartVariables(bool val)
 {
@@ -322,6 +339,8 @@ void vtkPVGeneralSettings::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "AutoApplyActiveOnly: " << this->AutoApplyActiveOnly << "\n";
   os << indent << "DefaultViewType: " << this->DefaultViewType << "\n";
   os << indent << "ScalarBarMode: " << this->ScalarBarMode << "\n";
+  os << indent << "TimeParallelTemporalRanges: "
+     << vtkSMOutputPort::GetTimeParallelTemporalDataInformation() << "\n";
   os << indent << "CacheGeometryForAnimation: " << this->CacheGeometryForAnimation << "\n";
   os << indent << "AnimationGeometryCacheLimit: " << this->AnimationGeometryCacheLimit << "\n";
   os << indent << "PropertiesPanelMode: " << this->PropertiesPanelMode << "\n";
@@ -139,6 +139,16 @@ public:
   void SetScalarBarMode(int);
   //@}
 
+  //@{
+  /**
+   * When set, the data ranges over all timesteps are gathered by distributing
+   * the timesteps among the server ranks. Only valid for pipelines that do not
+   * communicate between ranks, see vtkPVTemporalDataInformation.
+   */
+  void SetTimeParallelTemporalRanges(bool val);
+  bool GetTimeParallelTemporalRanges();
+  //@}
+
   //@{
   /**
    * Set when animation geometry caching is enabled.
@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestProminentValuesInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that categories making up a tiny part of a large array are reported
+// by vtkPVProminentValuesInformation, with and without Force, as categorical
+// annotations need, and that sampling remains available on demand.
+
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVProminentValuesInformation.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkTrivialProducer.h"
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NumberOfTuples = 1000000;
+constexpr int RareCategory = 1000;
+
+// 'numberOfCategories' common categories, plus a rare one occurring 5 times.
+vtkSmartPointer<vtkPolyData> MakeData(int numberOfCategories)
+{
+  vtkNew<vtkIntArray> categories;
+  categories->SetName("categories");
+  categories->SetNumberOfTuples(NumberOfTuples);
+  for (vtkIdType cc = 0; cc < NumberOfTuples; ++cc)
+  {
+    categories->SetValue(cc, static_cast<int>(cc % numberOfCategories));
+  }
+  for (vtkIdType cc = 0; cc < 5; ++cc)
+  {
+    categories->SetValue(NumberOfTuples / 5 * cc + 7, RareCategory);
+  }
+
+  auto data = vtkSmartPointer<vtkPolyData>::New();
+  data->GetPointData()->AddArray(categories);
+  return data;
+}
+
+// A "categories" array repeating 'values'.
+template <typename ArrayT>
+vtkSmartPointer<vtkPolyData> MakeTypedData(const std::vector<typename ArrayT::ValueType>& values)
+{
+  vtkNew<ArrayT> categories;
+  categories->SetName("categories");
+  categories->SetNumberOfTuples(1000);
+  for (vtkIdType cc = 0; cc < 1000; ++cc)
+  {
+    categories->SetValue(cc, values[cc % values.size()]);
+  }
+
+  auto data = vtkSmartPointer<vtkPolyData>::New();
+  data->GetPointData()->AddArray(categories);
+  return data;
+}
+
+bool HasValue(vtkAbstractArray* values, int value)
+{
+  for (vtkIdType cc = 0; values && cc < values->GetNumberOfValues(); ++cc)
+  {
+    if (values->GetVariantValue(cc).ToInt() == value)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the number of prominent values found, or -1 when the information is
+// invalid. 'rare' tells whether the rare category was among them.
+vtkIdType GetProminentValues(vtkDataObject* data, bool force, bool sample, bool& rare)
+{
+  vtkNew<vtkTrivialProducer> producer;
+  producer->SetOutput(data);
+  producer->Update();
+
+  vtkNew<vtkPVProminentValuesInformation> info;
+  info->SetFieldAssociation("POINTS");
+  info->SetFieldName("categories");
+  info->SetNumberOfComponents(1);
+  info->SetFraction(1e-3);
+  info->SetUncertainty(1e-6);
+  info->SetForce(force);
+  info->SetSample(sample);
+  info->CopyFromObject(producer);
+
+  vtkSmartPointer<vtkAbstractArray> values;
+  values.TakeReference(info->GetProminentComponentValues(0));
+  rare = HasValue(values, RareCategory);
+  return info->GetValid() && values ? values->GetNumberOfValues() : -1;
+}
+}
+
+int TestProminentValuesInformation(int, char*[])
+{
+  bool rare = false;
+
+  // few categories: all of them are reported, including the rare one.
+  auto few = MakeData(4);
+  vtkIdType count = GetProminentValues(few, false, false, rare);
+  if (count != 5 || !rare)
+  {
+    vtkLogF(ERROR, "Expected 5 values including the rare one, got %d.", static_cast<int>(count));
+    return EXIT_FAILURE;
+  }
+
+  // too many categories for the array to be considered discrete, unless forced.
+  auto many = MakeData(100);
+  if (GetProminentValues(many, false, false, rare) != -1)
+  {
+    vtkLogF(ERROR, "An array with 101 values should not be considered discrete.");
+    return EXIT_FAILURE;
+  }
+  count = GetProminentValues(many, true, false, rare);
+  if (count != 101 || !rare)
+  {
+    vtkLogF(ERROR, "Expected 101 forced values including the rare one, got %d.",
+      static_cast<int>(count));
+    return EXIT_FAILURE;
+  }
+
+  // sampling still reports the common categories.
+  if (GetProminentValues(few, false, true, rare) < 4 ||
+    GetProminentValues(many, true, true, rare) < 100)
+  {
+    vtkLogF(ERROR, "Sampling missed common categories.");
+    return EXIT_FAILURE;
+  }
+
+  // values are counted using the array's own type, 0 and -0 being the same.
+  auto reals = MakeTypedData<vtkDoubleArray>({ 0.5, -0.0, 0.0, 2.0 });
+  auto strings = MakeTypedData<vtkStringArray>({ "a", "b", "a", "c" });
+  if (GetProminentValues(reals, false, false, rare) != 3 ||
+    GetProminentValues(strings, false, false, rare) != 3)
+  {
+    vtkLogF(ERROR, "Incorrect number of distinct real or string values.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
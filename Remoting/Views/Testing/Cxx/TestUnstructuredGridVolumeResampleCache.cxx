@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestUnstructuredGridVolumeResampleCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that the "Resample To Image" mode of
+// vtkUnstructuredGridVolumeRepresentation reuses its resampled image across
+// updates that change neither the input nor the sampling dimensions, and that
+// all ranks resample again when the piece of a single rank is modified.
+
+#include "vtkCellType.h"
+#include "vtkCommunicator.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkSmartVolumeMapper.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridVolumeRepresentation.h"
+
+#include <cstdlib>
+
+namespace
+{
+// Hexahedra filling [0, 5]^3, shifted along x by 5 per rank, with the x
+// coordinate as point scalars.
+vtkSmartPointer<vtkUnstructuredGrid> MakePiece(int rank)
+{
+  const int dim = 6;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        points->InsertNextPoint(5.0 * rank + i, j, k);
+        values->InsertNextValue(5.0 * rank + i);
+      }
+    }
+  }
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->GetPointData()->SetScalars(values);
+  grid->Allocate((dim - 1) * (dim - 1) * (dim - 1));
+  auto id = [dim](int i, int j, int k) -> vtkIdType { return i + dim * (j + dim * k); };
+  for (int k = 0; k + 1 < dim; ++k)
+  {
+    for (int j = 0; j + 1 < dim; ++j)
+    {
+      for (int i = 0; i + 1 < dim; ++i)
+      {
+        const vtkIdType hexahedron[8] = { id(i, j, k), id(i + 1, j, k), id(i + 1, j + 1, k),
+          id(i, j + 1, k), id(i, j, k + 1), id(i + 1, j, k + 1), id(i + 1, j + 1, k + 1),
+          id(i, j + 1, k + 1) };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hexahedron);
+      }
+    }
+  }
+  return grid;
+}
+
+// Updates the representation as the view would after any property change and
+// returns the image given to the volume mapper.
+vtkSmartPointer<vtkDataObject> Update(vtkUnstructuredGridVolumeRepresentation* repr)
+{
+  repr->MarkModified();
+  repr->Update();
+  return repr->GetActiveVolumeMapper()->GetInputDataObject(0, 0);
+}
+
+bool Run(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  auto piece = MakePiece(rank);
+
+  vtkNew<vtkSmartVolumeMapper> mapper;
+  vtkNew<vtkUnstructuredGridVolumeRepresentation> repr;
+  repr->AddVolumeMapper("Resample To Image", mapper);
+  repr->SetActiveVolumeMapper("Resample To Image");
+  repr->SetSamplingDimensions(16, 16, 16);
+  repr->SetInputDataObject(piece);
+
+  auto first = Update(repr);
+  if (first == nullptr)
+  {
+    vtkLogF(ERROR, "No image was given to the volume mapper.");
+    return false;
+  }
+
+  // the second update does not resample.
+  if (Update(repr) != first)
+  {
+    vtkLogF(ERROR, "The input was resampled again although it did not change.");
+    return false;
+  }
+
+  // modifying the piece of the first rank makes all ranks resample, since
+  // the resample filter needs all of them to participate.
+  if (rank == 0)
+  {
+    piece->Modified();
+  }
+  auto second = Update(repr);
+  if (second == nullptr || second == first)
+  {
+    vtkLogF(ERROR, "The input was not resampled after a piece was modified.");
+    return false;
+  }
+
+  // so do new sampling dimensions.
+  repr->SetSamplingDimensions(8, 8, 8);
+  auto third = Update(repr);
+  if (third == nullptr || third == second || Update(repr) != third)
+  {
+    vtkLogF(ERROR, "The input was not resampled once, after the sampling dimensions changed.");
+    return false;
+  }
+  return true;
+}
+}
+
+int TestUnstructuredGridVolumeResampleCache(int argc, char* argv[])
+{
+  vtkMPIController* controller = vtkMPIController::New();
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int success = Run(controller) ? 1 : 0;
+  int allSuccess;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  controller->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -57,6 +57,17 @@ unsigned long vtkPVDataDeliveryManager::GetVisibleDataSize(bool low_res)
   return this->Internals->GetVisibleDataSize(low_res, this);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::GetMemorySizes(
+  vtkPVDataRepresentation* repr, unsigned long& cached, unsigned long& delivered)
+{
+  cached = delivered = 0;
+  if (repr)
+  {
+    this->Internals->GetMemorySizes(repr->GetUniqueIdentifier(), cached, delivered);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::RegisterRepresentation(vtkPVDataRepresentation* repr)
 {
@@ -140,6 +140,15 @@ public:
    */
   unsigned long GetVisibleDataSize(bool low_res);
 
+  /**
+   * Returns the sizes, in KiB, of the data held for a representation: the
+   * data it prepared for rendering for all its ports, levels of detail and
+   * cache keys (e.g. cached timesteps) in `cached`, and the data delivered
+   * to this process for rendering in `delivered`.
+   */
+  void GetMemorySizes(
+    vtkPVDataRepresentation* repr, unsigned long& cached, unsigned long& delivered);
+
   /**
    * Internal method used to determine the list of representations that need
    * their geometry delivered. This is done on the "client" side, with the
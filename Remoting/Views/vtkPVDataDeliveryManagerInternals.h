@@ -135,6 +135,24 @@ public:
       return iter != this->Data.end() ? iter->second.ActualMemorySize : 0;
     }
 
+    // Accumulates the sizes of the data stored for all cache keys, in KiB.
+    // Delivered data that is the representation's data itself, as happens
+    // when no data needs to be moved, is not counted twice.
+    void GetMemorySizes(unsigned long& cached, unsigned long& delivered) const
+    {
+      for (const auto& data : this->Data)
+      {
+        cached += data.second.ActualMemorySize;
+        for (const auto& dpair : data.second.DeliveredDataObjects)
+        {
+          if (dpair.second != nullptr && dpair.second != data.second.DataObject)
+          {
+            delivered += dpair.second->GetActualMemorySize();
+          }
+        }
+      }
+    }
+
     vtkDataObject* GetDeliveredDataObject(int dataKey, double cacheKey) const
     {
       try
@@ -268,6 +286,18 @@ public:
     return size;
   }
 
+  void GetMemorySizes(unsigned int id, unsigned long& cached, unsigned long& delivered) const
+  {
+    for (const auto& ipair : this->ItemsMap)
+    {
+      if (ipair.first.first == id)
+      {
+        ipair.second.first.GetMemorySizes(cached, delivered);
+        ipair.second.second.GetMemorySizes(cached, delivered);
+      }
+    }
+  }
+
   bool IsRepresentationVisible(unsigned int id) const
   {
     RepresentationsMapType::const_iterator riter = this->RepresentationsMap.find(id);
@@ -35,6 +35,7 @@
 vtkPVDataRepresentation::vtkPVDataRepresentation()
 {
   this->Visibility = true;
+  this->GetInformation()->Set(vtkPVCompositeDataPipeline::RETAIN_INPUTS(), 1);
   vtkExecutive* exec = this->CreateDefaultExecutive();
   this->SetExecutive(exec);
   exec->Delete();
@@ -54,6 +55,15 @@ vtkPVDataRepresentation::vtkPVDataRepresentation()
 //----------------------------------------------------------------------------
 vtkPVDataRepresentation::~vtkPVDataRepresentation() = default;
 
+//----------------------------------------------------------------------------
+void vtkPVDataRepresentation::SetVisibility(bool val)
+{
+  this->Visibility = val;
+  // hidden representations don't update, the memory budget may release the
+  // outputs they consume.
+  this->GetInformation()->Set(vtkPVCompositeDataPipeline::RETAIN_INPUTS(), val ? 1 : 0);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataRepresentation::SetInputConnection(int port, vtkAlgorithmOutput* input)
 {
@@ -96,9 +96,11 @@ public:
 
   /**
    * Get/Set the visibility for this representation. When the visibility of
-   * representation of false, all view passes are ignored.
+   * representation of false, all view passes are ignored. Visible
+   * representations retain their inputs, see
+   * vtkPVCompositeDataPipeline::RETAIN_INPUTS.
    */
-  virtual void SetVisibility(bool val) { this->Visibility = val; }
+  virtual void SetVisibility(bool val);
   vtkGetMacro(Visibility, bool);
 
   /**
@@ -0,0 +1,155 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVPipelineMemoryInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVPipelineMemoryInformation.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkClientServerStream.h"
+#include "vtkCompositeRepresentation.h"
+#include "vtkDataObject.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVCompositeDataPipeline.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVView.h"
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkPVPipelineMemoryInformation);
+//----------------------------------------------------------------------------
+vtkPVPipelineMemoryInformation::vtkPVPipelineMemoryInformation() = default;
+
+//----------------------------------------------------------------------------
+vtkPVPipelineMemoryInformation::~vtkPVPipelineMemoryInformation() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVPipelineMemoryInformation::CopyFromObject(vtkObject* object)
+{
+  auto algorithm = vtkAlgorithm::SafeDownCast(object);
+  if (!algorithm)
+  {
+    vtkErrorMacro("Incorrect object: " << (object ? object->GetClassName() : "(null)"));
+    return;
+  }
+
+  this->NumberOfProcesses = 1;
+  this->OutputMemorySize = 0;
+  this->CachedMemorySize = 0;
+  this->DeliveredMemorySize = 0;
+  for (int port = 0; port < algorithm->GetNumberOfOutputPorts(); ++port)
+  {
+    // don't use GetOutputDataObject(), it would create missing outputs.
+    auto executive = algorithm->GetExecutive();
+    if (auto output = executive ? executive->GetOutputData(port) : nullptr)
+    {
+      this->OutputMemorySize += output->GetActualMemorySize();
+    }
+  }
+
+  // the data of a composite representation is held by its active
+  // representation.
+  auto repr = vtkPVDataRepresentation::SafeDownCast(algorithm);
+  if (auto composite = vtkCompositeRepresentation::SafeDownCast(repr))
+  {
+    repr = composite->GetActiveRepresentation();
+  }
+  auto view = repr ? vtkPVView::SafeDownCast(repr->GetView()) : nullptr;
+  if (auto dmgr = view ? view->GetDeliveryManager() : nullptr)
+  {
+    unsigned long cached, delivered;
+    dmgr->GetMemorySizes(repr, cached, delivered);
+    this->CachedMemorySize = cached;
+    this->DeliveredMemorySize = delivered;
+  }
+  this->MaximumRankMemorySize =
+    this->OutputMemorySize + this->CachedMemorySize + this->DeliveredMemorySize;
+
+  if (auto executive = vtkPVCompositeDataPipeline::SafeDownCast(algorithm->GetExecutive()))
+  {
+    this->LastExecutionMemoryIncrease = executive->GetLastExecutionMemoryIncrease();
+    this->LastExecutionPeakMemoryIncrease = executive->GetLastExecutionPeakMemoryIncrease();
+    this->MaximumPeakMemoryIncrease = executive->GetMaximumPeakMemoryIncrease();
+    this->NumberOfExecutions = executive->GetNumberOfExecutions();
+  }
+  else
+  {
+    this->LastExecutionMemoryIncrease = 0;
+    this->LastExecutionPeakMemoryIncrease = 0;
+    this->MaximumPeakMemoryIncrease = 0;
+    this->NumberOfExecutions = 0;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPipelineMemoryInformation::AddInformation(vtkPVInformation* info)
+{
+  auto other = vtkPVPipelineMemoryInformation::SafeDownCast(info);
+  if (!other)
+  {
+    return;
+  }
+
+  this->NumberOfProcesses += other->NumberOfProcesses;
+  this->OutputMemorySize += other->OutputMemorySize;
+  this->CachedMemorySize += other->CachedMemorySize;
+  this->DeliveredMemorySize += other->DeliveredMemorySize;
+  this->MaximumRankMemorySize = std::max(this->MaximumRankMemorySize, other->MaximumRankMemorySize);
+  this->LastExecutionMemoryIncrease += other->LastExecutionMemoryIncrease;
+  this->LastExecutionPeakMemoryIncrease =
+    std::max(this->LastExecutionPeakMemoryIncrease, other->LastExecutionPeakMemoryIncrease);
+  this->MaximumPeakMemoryIncrease =
+    std::max(this->MaximumPeakMemoryIncrease, other->MaximumPeakMemoryIncrease);
+  this->NumberOfExecutions = std::max(this->NumberOfExecutions, other->NumberOfExecutions);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPipelineMemoryInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << this->NumberOfProcesses << this->OutputMemorySize
+       << this->CachedMemorySize << this->DeliveredMemorySize << this->MaximumRankMemorySize
+       << this->LastExecutionMemoryIncrease << this->LastExecutionPeakMemoryIncrease
+       << this->MaximumPeakMemoryIncrease << this->NumberOfExecutions
+       << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPipelineMemoryInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  css->GetArgument(0, 0, &this->NumberOfProcesses);
+  css->GetArgument(0, 1, &this->OutputMemorySize);
+  css->GetArgument(0, 2, &this->CachedMemorySize);
+  css->GetArgument(0, 3, &this->DeliveredMemorySize);
+  css->GetArgument(0, 4, &this->MaximumRankMemorySize);
+  css->GetArgument(0, 5, &this->LastExecutionMemoryIncrease);
+  css->GetArgument(0, 6, &this->LastExecutionPeakMemoryIncrease);
+  css->GetArgument(0, 7, &this->MaximumPeakMemoryIncrease);
+  css->GetArgument(0, 8, &this->NumberOfExecutions);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPipelineMemoryInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfProcesses: " << this->NumberOfProcesses << endl;
+  os << indent << "OutputMemorySize: " << this->OutputMemorySize << endl;
+  os << indent << "CachedMemorySize: " << this->CachedMemorySize << endl;
+  os << indent << "DeliveredMemorySize: " << this->DeliveredMemorySize << endl;
+  os << indent << "MaximumRankMemorySize: " << this->MaximumRankMemorySize << endl;
+  os << indent << "LastExecutionMemoryIncrease: " << this->LastExecutionMemoryIncrease << endl;
+  os << indent << "LastExecutionPeakMemoryIncrease: " << this->LastExecutionPeakMemoryIncrease
+     << endl;
+  os << indent << "MaximumPeakMemoryIncrease: " << this->MaximumPeakMemoryIncrease << endl;
+  os << indent << "NumberOfExecutions: " << this->NumberOfExecutions << endl;
+}
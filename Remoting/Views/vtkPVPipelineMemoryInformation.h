@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVPipelineMemoryInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVPipelineMemoryInformation
+ * @brief   memory held and used by a pipeline object across ranks.
+ *
+ * vtkPVPipelineMemoryInformation reports the memory used by an algorithm,
+ * i.e. a source, a filter or a representation, summed or maximized over all
+ * ranks it was gathered from. All sizes are in KiB.
+ *
+ * \li The output memory size is the sum of `vtkDataObject::GetActualMemorySize`
+ *     over the algorithm's outputs. Arrays shared between the output and the
+ *     input, as filters passing data through do, are counted for both.
+ * \li For a representation, the cached memory size is the size of the data it
+ *     prepared for rendering and keeps in its view's vtkPVDataDeliveryManager,
+ *     for all levels of detail and cached timesteps. The delivered memory size
+ *     is the size of the data moved to the rendering ranks.
+ * \li The execution statistics are recorded by vtkPVCompositeDataPipeline, see
+ *     vtkPVCompositeDataPipeline::SetMemoryTracking. They are 0 for algorithms
+ *     using another executive, e.g. representations.
+ *
+ * @sa vtkPVMemoryUseInformation, vtkPVCompositeDataPipeline
+ */
+
+#ifndef vtkPVPipelineMemoryInformation_h
+#define vtkPVPipelineMemoryInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingViewsModule.h" //needed for exports
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVPipelineMemoryInformation : public vtkPVInformation
+{
+public:
+  static vtkPVPipelineMemoryInformation* New();
+  vtkTypeMacro(vtkPVPipelineMemoryInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Transfer information about a single object into this object.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  ///@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  ///@}
+
+  /**
+   * Returns the number of ranks the information was gathered from.
+   */
+  vtkGetMacro(NumberOfProcesses, int);
+
+  ///@{
+  /**
+   * Sizes of the outputs, of the data cached for rendering and of the data
+   * delivered for rendering, summed over all ranks.
+   */
+  vtkGetMacro(OutputMemorySize, vtkTypeInt64);
+  vtkGetMacro(CachedMemorySize, vtkTypeInt64);
+  vtkGetMacro(DeliveredMemorySize, vtkTypeInt64);
+  ///@}
+
+  /**
+   * Returns the largest sum of the output, cached and delivered sizes on a
+   * single rank. Compared to the total, tells how evenly the memory is spread.
+   */
+  vtkGetMacro(MaximumRankMemorySize, vtkTypeInt64);
+
+  /**
+   * Returns the change of the resident memory over the last execution, summed
+   * over all ranks.
+   */
+  vtkGetMacro(LastExecutionMemoryIncrease, vtkTypeInt64);
+
+  ///@{
+  /**
+   * Returns the largest rise of the resident memory of a rank during the last
+   * execution, and during any execution.
+   */
+  vtkGetMacro(LastExecutionPeakMemoryIncrease, vtkTypeInt64);
+  vtkGetMacro(MaximumPeakMemoryIncrease, vtkTypeInt64);
+  ///@}
+
+  /**
+   * Returns the number of times the algorithm executed on the rank where it
+   * executed most.
+   */
+  vtkGetMacro(NumberOfExecutions, int);
+
+protected:
+  vtkPVPipelineMemoryInformation();
+  ~vtkPVPipelineMemoryInformation() override;
+
+  int NumberOfProcesses = 0;
+  vtkTypeInt64 OutputMemorySize = 0;
+  vtkTypeInt64 CachedMemorySize = 0;
+  vtkTypeInt64 DeliveredMemorySize = 0;
+  vtkTypeInt64 MaximumRankMemorySize = 0;
+  vtkTypeInt64 LastExecutionMemoryIncrease = 0;
+  vtkTypeInt64 LastExecutionPeakMemoryIncrease = 0;
+  vtkTypeInt64 MaximumPeakMemoryIncrease = 0;
+  int NumberOfExecutions = 0;
+
+private:
+  vtkPVPipelineMemoryInformation(const vtkPVPipelineMemoryInformation&) = delete;
+  void operator=(const vtkPVPipelineMemoryInformation&) = delete;
+};
+
+#endif
@@ -16,11 +16,13 @@
 
 #include "vtkAbstractArray.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkClientServerStream.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkExecutive.h"
@@ -34,14 +36,24 @@
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
 #include <map>
 #include <set>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #define VTK_MAX_CATEGORICAL_VALS (32)
@@ -49,6 +61,335 @@
 namespace
 {
 typedef std::map<int, std::set<std::vector<vtkVariant>>> vtkInternalDistinctValuesBase;
+
+//----------------------------------------------------------------------------
+// Hashing and comparison of the values of an array. Floating point values are
+// compared as numbers, except that all NaN values are considered equal.
+template <typename ValueType, bool IsReal = std::is_floating_point<ValueType>::value>
+struct vtkValueTraits
+{
+  static bool Equal(const ValueType& a, const ValueType& b) { return a == b; }
+  static size_t Hash(const ValueType& value) { return std::hash<ValueType>()(value); }
+};
+
+template <typename ValueType>
+struct vtkValueTraits<ValueType, true>
+{
+  static bool Equal(ValueType a, ValueType b)
+  {
+    return a == b || (std::isnan(a) && std::isnan(b));
+  }
+  static size_t Hash(ValueType value)
+  {
+    // 0 and -0 compare equal, hence hash alike.
+    return std::isnan(value) ? 0 : std::hash<ValueType>()(value == 0 ? ValueType(0) : value);
+  }
+};
+
+template <>
+struct vtkValueTraits<vtkStdString, false>
+{
+  static bool Equal(const vtkStdString& a, const vtkStdString& b) { return a == b; }
+  static size_t Hash(const vtkStdString& value) { return std::hash<std::string>()(value); }
+};
+
+template <typename ValueType>
+struct vtkTupleHash
+{
+  size_t operator()(const std::vector<ValueType>& tuple) const
+  {
+    size_t hash = tuple.size();
+    for (const auto& value : tuple)
+    {
+      hash ^= vtkValueTraits<ValueType>::Hash(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+};
+
+template <typename ValueType>
+struct vtkTupleEqual
+{
+  bool operator()(const std::vector<ValueType>& a, const std::vector<ValueType>& b) const
+  {
+    return a.size() == b.size() &&
+      std::equal(a.begin(), a.end(), b.begin(), &vtkValueTraits<ValueType>::Equal);
+  }
+};
+
+// Values are counted in a hash table keyed by tuples of the array's own value
+// type. Arrays whose values are only available as variants, which cannot be
+// hashed consistently with their comparison, use an ordered map.
+template <typename ValueType>
+struct vtkValueCounts
+{
+  using type = std::unordered_map<std::vector<ValueType>, vtkIdType, vtkTupleHash<ValueType>,
+    vtkTupleEqual<ValueType>>;
+};
+
+template <>
+struct vtkValueCounts<vtkVariant>
+{
+  using type = std::map<std::vector<vtkVariant>, vtkIdType>;
+};
+
+//----------------------------------------------------------------------------
+// Bounded summary of the distinct values taken by an array component, or by
+// whole tuples. A Capacity of 0 means unbounded. When Evict is false, the
+// summary stops collecting and flags an overflow once more than Capacity
+// distinct values have been seen. Otherwise, it behaves as a Misra-Gries
+// heavy-hitter sketch: out of N insertions, every value occurring more than
+// N / (Capacity + 1) times is guaranteed to be kept.
+template <typename ValueType>
+class vtkValueSummary
+{
+public:
+  using KeyType = std::vector<ValueType>;
+
+  typename vtkValueCounts<ValueType>::type Counts;
+  size_t Capacity = 0;
+  bool Evict = false;
+  bool Overflow = false;
+
+  void Insert(const KeyType& key)
+  {
+    if (this->Overflow)
+    {
+      return;
+    }
+    auto iter = this->Counts.find(key);
+    if (iter != this->Counts.end())
+    {
+      ++iter->second;
+      return;
+    }
+    this->Counts.emplace(key, 1);
+    this->Shrink();
+  }
+
+  void Merge(const vtkValueSummary& other)
+  {
+    this->Overflow = this->Overflow || other.Overflow;
+    if (this->Overflow)
+    {
+      this->Counts.clear();
+      return;
+    }
+    for (const auto& pair : other.Counts)
+    {
+      this->Counts[pair.first] += pair.second;
+    }
+    this->Shrink();
+  }
+
+private:
+  void Shrink()
+  {
+    if (this->Capacity == 0 || this->Counts.size() <= this->Capacity)
+    {
+      return;
+    }
+    if (!this->Evict)
+    {
+      this->Overflow = true;
+      this->Counts.clear();
+      return;
+    }
+
+    // Subtract the (Capacity + 1)-th largest count from every entry and
+    // drop the entries that reach zero.
+    std::vector<vtkIdType> counts;
+    counts.reserve(this->Counts.size());
+    for (const auto& pair : this->Counts)
+    {
+      counts.push_back(pair.second);
+    }
+    std::nth_element(counts.begin(), counts.begin() + this->Capacity, counts.end(),
+      std::greater<vtkIdType>());
+    const vtkIdType threshold = counts[this->Capacity];
+    for (auto iter = this->Counts.begin(); iter != this->Counts.end();)
+    {
+      iter->second -= threshold;
+      iter = iter->second <= 0 ? this->Counts.erase(iter) : std::next(iter);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Distinct values found for a component, or for whole tuples.
+struct vtkDistinctValues
+{
+  bool Overflow = false;
+  std::set<std::vector<vtkVariant>> Values;
+};
+
+//----------------------------------------------------------------------------
+// Picks the sample-th of numberOfSamples tuples. Each sample is drawn at a
+// pseudo-random position within its own stratum of the array, so that the
+// result does not depend on how the samples are split among threads.
+vtkIdType GetSampledTuple(vtkIdType sample, vtkIdType numberOfSamples, vtkIdType numberOfTuples)
+{
+  vtkTypeUInt64 hash = static_cast<vtkTypeUInt64>(sample) * 0x9E3779B97F4A7C15ull;
+  hash ^= hash >> 29;
+  const double scale = static_cast<double>(numberOfTuples) / numberOfSamples;
+  const vtkIdType first = static_cast<vtkIdType>(sample * scale);
+  const vtkIdType width =
+    std::max<vtkIdType>(1, static_cast<vtkIdType>((sample + 1) * scale) - first);
+  return std::min(first + static_cast<vtkIdType>(hash % width), numberOfTuples - 1);
+}
+
+//----------------------------------------------------------------------------
+// Values of the arrays vtkArrayDispatch does not handle, indexed like
+// vtk::DataArrayValueRange.
+struct vtkStringValues
+{
+  using value_type = vtkStdString;
+  vtkStringArray* Array;
+  const vtkStdString& operator[](vtkIdType idx) const { return this->Array->GetValue(idx); }
+};
+
+struct vtkVariantValues
+{
+  using value_type = vtkVariant;
+  vtkAbstractArray* Array;
+  vtkVariant operator[](vtkIdType idx) const { return this->Array->GetVariantValue(idx); }
+};
+
+//----------------------------------------------------------------------------
+// Fills one summary per component, plus one for whole tuples when the array
+// has more than one component (stored first, for component -1).
+template <typename ValuesT>
+class vtkCollectDistinctValues
+{
+public:
+  using ValueType = typename std::decay<typename ValuesT::value_type>::type;
+  using SummaryType = vtkValueSummary<ValueType>;
+
+  vtkCollectDistinctValues(vtkAbstractArray* array, const ValuesT& values,
+    vtkIdType numberOfSamples, size_t capacity, bool evict)
+    : Values(values)
+    , NumberOfComponents(array->GetNumberOfComponents())
+    , NumberOfTuples(array->GetNumberOfTuples())
+    , NumberOfSamples(numberOfSamples)
+    , Capacity(capacity)
+    , Evict(evict)
+  {
+    this->Offset = this->NumberOfComponents > 1 ? 1 : 0;
+  }
+
+  void Initialize()
+  {
+    auto& summaries = this->Summaries.Local();
+    summaries.resize(this->NumberOfComponents + this->Offset);
+    for (auto& summary : summaries)
+    {
+      summary.Capacity = this->Capacity;
+      summary.Evict = this->Evict;
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& summaries = this->Summaries.Local();
+    const int nc = this->NumberOfComponents;
+    typename SummaryType::KeyType tuple(nc);
+    typename SummaryType::KeyType value(1);
+    for (vtkIdType cc = begin; cc < end && !this->Overflow; ++cc)
+    {
+      const vtkIdType tupleIdx = this->NumberOfSamples < this->NumberOfTuples
+        ? ::GetSampledTuple(cc, this->NumberOfSamples, this->NumberOfTuples)
+        : cc;
+      for (int comp = 0; comp < nc; ++comp)
+      {
+        tuple[comp] = this->Values[tupleIdx * nc + comp];
+        value[0] = tuple[comp];
+        summaries[comp + this->Offset].Insert(value);
+      }
+      if (this->Offset)
+      {
+        summaries[0].Insert(tuple);
+      }
+    }
+
+    // Once every summary has overflowed on one thread, merging will not
+    // change that, so there is no need for the other threads to go on.
+    if (std::all_of(summaries.begin(), summaries.end(),
+          [](const SummaryType& summary) { return summary.Overflow; }))
+    {
+      this->Overflow = true;
+    }
+  }
+
+  // Merges the per-thread summaries, then converts the few values kept to
+  // variants.
+  void Reduce()
+  {
+    std::vector<SummaryType> merged(this->NumberOfComponents + this->Offset);
+    for (auto& summary : merged)
+    {
+      summary.Capacity = this->Capacity;
+      summary.Evict = this->Evict;
+    }
+    for (const auto& summaries : this->Summaries)
+    {
+      for (size_t cc = 0; cc < summaries.size(); ++cc)
+      {
+        merged[cc].Merge(summaries[cc]);
+      }
+    }
+
+    this->Result.clear();
+    this->Result.resize(merged.size());
+    for (size_t cc = 0; cc < merged.size(); ++cc)
+    {
+      this->Result[cc].Overflow = merged[cc].Overflow;
+      for (const auto& pair : merged[cc].Counts)
+      {
+        this->Result[cc].Values.emplace(pair.first.begin(), pair.first.end());
+      }
+    }
+  }
+
+  std::vector<vtkDistinctValues>& GetResult() { return this->Result; }
+
+private:
+  ValuesT Values;
+  int NumberOfComponents;
+  int Offset;
+  vtkIdType NumberOfTuples;
+  vtkIdType NumberOfSamples;
+  size_t Capacity;
+  bool Evict;
+  std::atomic<bool> Overflow{ false };
+  vtkSMPThreadLocal<std::vector<SummaryType>> Summaries;
+  std::vector<vtkDistinctValues> Result;
+};
+
+//----------------------------------------------------------------------------
+// Collects the distinct values of an array using its own value type, see
+// vtkCollectDistinctValues.
+struct vtkCollectDistinctValuesWorker
+{
+  vtkIdType NumberOfSamples;
+  size_t Capacity;
+  bool Evict;
+  std::vector<vtkDistinctValues> Result;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    this->Collect(array, vtk::DataArrayValueRange(array));
+  }
+
+  template <typename ValuesT>
+  void Collect(vtkAbstractArray* array, const ValuesT& values)
+  {
+    vtkCollectDistinctValues<ValuesT> collector(
+      array, values, this->NumberOfSamples, this->Capacity, this->Evict);
+    vtkSMPTools::For(0, this->NumberOfSamples, collector);
+    this->Result = std::move(collector.GetResult());
+  }
+};
 }
 
 class vtkPVProminentValuesInformation::vtkInternalDistinctValues
@@ -68,6 +409,7 @@ vtkPVProminentValuesInformation::vtkPVProminentValuesInformation()
   this->InitializeParameters();
   this->Initialize();
   this->Force = false;
+  this->Sample = false;
   this->Valid = true;
 }
 
@@ -141,6 +483,8 @@ void vtkPVProminentValuesInformation::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << "Fraction: " << this->Fraction << endl;
   os << "Uncertainty: " << this->Uncertainty << endl;
+  os << "Force: " << this->Force << endl;
+  os << "Sample: " << this->Sample << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -249,6 +593,7 @@ void vtkPVProminentValuesInformation::DeepCopyParameters(vtkPVProminentValuesInf
   this->Fraction = other->Fraction;
   this->Uncertainty = other->Uncertainty;
   this->Force = other->Force;
+  this->Sample = other->Sample;
   this->Valid = other->Valid;
 }
 
@@ -331,50 +676,74 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
     this->DistinctValues = new vtkInternalDistinctValues;
   }
   int nc = this->GetNumberOfComponents();
-  vtkNew<vtkVariantArray> cvalues;
-  std::vector<vtkVariant> tuple;
-  // bool tooManyValues;
-  for (int c = (nc > 1 ? -1 : 0); c < nc; ++c)
-  {
-    int tupleSize = c < 0 ? nc : 1;
-    tuple.resize(tupleSize);
-    std::set<std::vector<vtkVariant>>& compDistincts((*this->DistinctValues)[c]);
-    cvalues->Initialize();
-    unsigned int maxDiscreteValues = array->GetMaxDiscreteValues();
-    if (this->Force)
+  if (nc <= 0)
+  {
+    return;
+  }
+  if (nc != array->GetNumberOfComponents())
+  {
+    this->Valid = false;
+    return;
+  }
+
+  // When sampling, number of samples needed for a value making up at least
+  // Fraction of the array to go undetected with a probability lower than
+  // Uncertainty. Otherwise, every tuple is inspected.
+  const vtkIdType numberOfTuples = array->GetNumberOfTuples();
+  vtkIdType numberOfSamples = numberOfTuples;
+  if (this->Sample && this->Uncertainty > 0. && this->Fraction > 0. && this->Fraction < 1.)
+  {
+    const double samples = std::ceil(std::log(this->Uncertainty) / std::log1p(-this->Fraction));
+    if (samples < numberOfTuples)
     {
-      array->SetMaxDiscreteValues(VTK_UNSIGNED_INT_MAX);
+      numberOfSamples = std::max<vtkIdType>(1, static_cast<vtkIdType>(samples));
     }
-    array->GetProminentComponentValues(c, cvalues.GetPointer(), 0., 0.);
-    array->SetMaxDiscreteValues(maxDiscreteValues);
-    vtkIdType nt = cvalues->GetNumberOfTuples();
-    if (nt > 0)
+  }
+  const bool sampled = numberOfSamples < numberOfTuples;
+
+  // Unless forced, an array taking on more than GetMaxDiscreteValues() values
+  // is not considered discrete. When forced, keep all values of an exact scan
+  // but only the heavy hitters of a sampled one, to bound memory usage.
+  size_t capacity = array->GetMaxDiscreteValues();
+  bool evict = false;
+  if (this->Force)
+  {
+    evict = true;
+    capacity = sampled ? static_cast<size_t>(std::ceil(1. / this->Fraction)) : 0;
+  }
+
+  // Values are hashed using the array's own value type, and only converted to
+  // variants once the distinct ones are known.
+  ::vtkCollectDistinctValuesWorker worker{ numberOfSamples, capacity, evict, {} };
+  if (auto dataArray = vtkDataArray::SafeDownCast(array))
+  {
+    if (!vtkArrayDispatch::Dispatch::Execute(dataArray, worker))
     {
-      for (vtkIdType t = 0; t < nt; ++t)
-      {
-        for (int i = 0; i < tupleSize; ++i)
-        {
-          tuple[i] = cvalues->GetValue(i + t * tupleSize);
-        }
-        compDistincts.insert(tuple);
-        /*
-        if (compDistincts.insert(tuple).second)
-          {
-          if ((tooManyValues =
-            compDistincts.size() > vtkAbstractArray::MAX_DISCRETE_VALUES))
-            break;
-          }
-          */
-      }
-      this->Valid = true;
+      worker(dataArray);
     }
-    else
+  }
+  else if (auto stringArray = vtkStringArray::SafeDownCast(array))
+  {
+    worker.Collect(array, ::vtkStringValues{ stringArray });
+  }
+  else
+  {
+    worker.Collect(array, ::vtkVariantValues{ array });
+  }
+
+  this->Valid = numberOfTuples > 0;
+  const int offset = nc > 1 ? 1 : 0;
+  for (int c = -offset; c < nc; ++c)
+  {
+    auto& result = worker.Result[c + offset];
+    if (result.Overflow || result.Values.empty())
     {
-      // if there is no tuples provided, it means we were unable
-      // to determine the prominent values and this information
-      // is invalid
-      this->Valid = false;
+      // we were unable to determine the prominent values of this component,
+      // in which case the information is invalid
+      this->Valid = this->Valid && c < 0;
+      continue;
     }
+    (*this->DistinctValues)[c] = std::move(result.Values);
   }
 }
 
@@ -414,7 +783,7 @@ void vtkPVProminentValuesInformation::CopyToStream(vtkClientServerStream* css)
   // Copy parameter values to stream.
   *css << this->PortNumber << std::string(this->FieldAssociation) << std::string(this->FieldName)
        << this->NumberOfComponents << this->Fraction << this->Uncertainty << this->Force
-       << this->Valid;
+       << this->Sample << this->Valid;
 
   // Now copy results to stream.
   int numberOfDistinctValueComponents =
@@ -493,6 +862,12 @@ void vtkPVProminentValuesInformation::CopyFromStream(const vtkClientServerStream
     return;
   }
 
+  if (!css->GetArgument(0, pos++, &this->Sample))
+  {
+    vtkErrorMacro("Error parsing sample flag from message.");
+    return;
+  }
+
   if (!css->GetArgument(0, pos++, &this->Valid))
   {
     vtkErrorMacro("Error parsing valid flag from message.");
@@ -561,7 +936,7 @@ void vtkPVProminentValuesInformation::CopyParametersToStream(vtkMultiProcessStre
   vtkTypeUInt32 magic_number = VTK_PROMINENT_MAGIC_NUMBER;
   mps << magic_number << this->PortNumber << std::string(this->FieldAssociation)
       << std::string(this->FieldName) << this->NumberOfComponents << this->Fraction
-      << this->Uncertainty << this->Force << this->Valid;
+      << this->Uncertainty << this->Force << this->Sample << this->Valid;
 }
 
 //-----------------------------------------------------------------------------
@@ -572,7 +947,7 @@ void vtkPVProminentValuesInformation::CopyParametersFromStream(vtkMultiProcessSt
   std::string fieldAssoc;
   std::string fieldName;
   mps >> magic_number >> this->PortNumber >> fieldAssoc >> fieldName >> this->NumberOfComponents >>
-    this->Fraction >> this->Uncertainty >> this->Force >> this->Valid;
+    this->Fraction >> this->Uncertainty >> this->Force >> this->Sample >> this->Valid;
   if (magic_number != VTK_PROMINENT_MAGIC_NUMBER)
   {
     vtkErrorMacro("Magic number mismatch.");
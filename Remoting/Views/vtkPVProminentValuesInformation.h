@@ -26,7 +26,13 @@
  * given confidence that dictates the number of samples required), then
  * the prominent values are also made available.
  *
- * This class uses vtkAbstractArray::GetProminentComponentValues().
+ * By default, every tuple is inspected so that rare values are reported too,
+ * as categorical annotations need. When Sample is set, the number of tuples
+ * inspected is derived from the Fraction and Uncertainty parameters instead,
+ * so that large arrays are only sampled, and when Force is also set, values
+ * are counted using a heavy-hitter sketch with a memory footprint bounded by
+ * 1 / Fraction entries. In all cases, tuples are processed using vtkSMPTools
+ * and the per-thread results are merged at the end.
  */
 
 #ifndef vtkPVProminentValuesInformation_h
@@ -97,6 +103,9 @@ public:
    * Set/get the maximum uncertainty allowed in the detection of prominent values.
    * The uncertainty is the probability of prominent values going undetected.
    * Setting this to zero forces the entire array to be inspected.
+   *
+   * When Sample is set, this determines together with Fraction the number of
+   * tuples sampled: log(Uncertainty) / log(1 - Fraction).
    */
   vtkSetClampMacro(Uncertainty, double, 0., 1.);
   vtkGetMacro(Uncertainty, double);
@@ -114,6 +123,19 @@ public:
   vtkSetMacro(Force, bool);
   vtkGetMacro(Force, bool);
 
+  //@{
+  /**
+   * Set/get whether large arrays are only sampled, as dictated by Fraction
+   * and Uncertainty, rather than inspected entirely. Sampling is faster but
+   * values making up less than Fraction of the array may go unreported, and
+   * when Force is set, so may values that are not heavy hitters. Off by
+   * default.
+   */
+  vtkSetMacro(Sample, bool);
+  vtkGetMacro(Sample, bool);
+  vtkBooleanMacro(Sample, bool);
+  //@}
+
   //@{
   /**
    * Get the validity of the information. The flag has a meaning after trying to recover
@@ -212,6 +234,7 @@ protected:
   double Fraction;
   double Uncertainty;
   bool Force;
+  bool Sample;
   bool Valid;
   //@}
 
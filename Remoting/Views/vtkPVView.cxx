@@ -27,6 +27,7 @@
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLState.h"
+#include "vtkPVCompositeDataPipeline.h"
 #include "vtkPVDataDeliveryManager.h"
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVLogger.h"
@@ -468,6 +469,9 @@ void vtkPVView::Update()
     vtkPVView::REQUEST_UPDATE(), this->RequestInformation, this->ReplyInformationVector);
   vtkTimerLog::MarkEndEvent("vtkPVView::Update");
 
+  // all processes update the view, decide together which outputs to release.
+  vtkPVCompositeDataPipeline::EnforceMemoryBudget();
+
   // exchange information about representations that are time-dependent.
   // this goes from data-server-root to client and render-server.
   if (count)
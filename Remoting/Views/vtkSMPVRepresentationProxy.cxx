@@ -1070,7 +1070,7 @@ vtkPVArrayInformation* vtkSMPVRepresentationProxy::GetArrayInformationForColorAr
 //----------------------------------------------------------------------------
 vtkPVProminentValuesInformation*
 vtkSMPVRepresentationProxy::GetProminentValuesInformationForColorArray(
-  double uncertaintyAllowed, double fraction, bool force)
+  double uncertaintyAllowed, double fraction, bool force, bool sample)
 {
   if (!this->GetUsingScalarColoring())
   {
@@ -1086,7 +1086,7 @@ vtkSMPVRepresentationProxy::GetProminentValuesInformationForColorArray(
   vtkSMPropertyHelper colorArrayHelper(this, "ColorArrayName");
   return this->GetProminentValuesInformation(arrayInfo->GetName(),
     colorArrayHelper.GetInputArrayAssociation(), arrayInfo->GetNumberOfComponents(),
-    uncertaintyAllowed, fraction, force);
+    uncertaintyAllowed, fraction, force, sample);
 }
 
 //----------------------------------------------------------------------------
@@ -310,14 +310,16 @@ public:
    * array used for scalar color, if any. Otherwise returns nullptr.
    */
   virtual vtkPVProminentValuesInformation* GetProminentValuesInformationForColorArray(
-    double uncertaintyAllowed = 1e-6, double fraction = 1e-3, bool force = false);
+    double uncertaintyAllowed = 1e-6, double fraction = 1e-3, bool force = false,
+    bool sample = false);
   static vtkPVProminentValuesInformation* GetProminentValuesInformationForColorArray(
-    vtkSMProxy* proxy, double uncertaintyAllowed = 1e-6, double fraction = 1e-3, bool force = false)
+    vtkSMProxy* proxy, double uncertaintyAllowed = 1e-6, double fraction = 1e-3, bool force = false,
+    bool sample = false)
   {
     vtkSMPVRepresentationProxy* self = vtkSMPVRepresentationProxy::SafeDownCast(proxy);
-    return self
-      ? self->GetProminentValuesInformationForColorArray(uncertaintyAllowed, fraction, force)
-      : nullptr;
+    return self ? self->GetProminentValuesInformationForColorArray(
+                    uncertaintyAllowed, fraction, force, sample)
+                : nullptr;
   }
   //@}
 
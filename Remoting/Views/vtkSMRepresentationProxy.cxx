@@ -330,7 +330,7 @@ vtkPVDataInformation* vtkSMRepresentationProxy::GetRepresentedDataInformation()
 //----------------------------------------------------------------------------
 vtkPVProminentValuesInformation* vtkSMRepresentationProxy::GetProminentValuesInformation(
   std::string name, int fieldAssoc, int numComponents, double uncertaintyAllowed, double fraction,
-  bool force)
+  bool force, bool sample)
 {
   bool differentAttribute =
     this->ProminentValuesInformation->GetNumberOfComponents() != numComponents ||
@@ -342,7 +342,8 @@ vtkPVProminentValuesInformation* vtkSMRepresentationProxy::GetProminentValuesInf
   bool largerFractionOrLessCertain = this->ProminentValuesFraction < fraction ||
     this->ProminentValuesUncertainty > uncertaintyAllowed;
   if (!this->ProminentValuesInformationValid || differentAttribute || invalid ||
-    largerFractionOrLessCertain || this->ProminentValuesInformation->GetForce() != force)
+    largerFractionOrLessCertain || this->ProminentValuesInformation->GetForce() != force ||
+    this->ProminentValuesInformation->GetSample() != sample)
   {
     vtkTimerLog::MarkStartEvent("vtkSMRepresentationProxy::GetProminentValues");
     this->CreateVTKObjects();
@@ -356,6 +357,7 @@ vtkPVProminentValuesInformation* vtkSMRepresentationProxy::GetProminentValuesInf
     this->ProminentValuesInformation->SetUncertainty(uncertaintyAllowed);
     this->ProminentValuesInformation->SetFraction(fraction);
     this->ProminentValuesInformation->SetForce(force);
+    this->ProminentValuesInformation->SetSample(sample);
 
     // Ask the server to fill out the rest of the information:
 
@@ -111,11 +111,12 @@ public:
    * components for any array.
 
    * See vtkAbstractArray::GetProminentComponentValues for more information
-   * about the \a uncertaintyAllowed and \a fraction arguments.
+   * about the \a uncertaintyAllowed and \a fraction arguments, and
+   * vtkPVProminentValuesInformation for the \a force and \a sample ones.
    */
   virtual vtkPVProminentValuesInformation* GetProminentValuesInformation(std::string name,
     int fieldAssoc, int numComponents, double uncertaintyAllowed = 1e-6, double fraction = 1e-3,
-    bool force = false);
+    bool force = false, bool sample = false);
 
   /**
    * Calls Update() on all sources. It also creates output ports if
@@ -15,10 +15,17 @@
 #include "vtkUnstructuredGridVolumeRepresentation.h"
 
 #include "vtkAlgorithmOutput.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
 #include "vtkColorTransferFunction.h"
 #include "vtkCommand.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -29,6 +36,8 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPVGeometryFilter.h"
 #include "vtkPVLODVolume.h"
 #include "vtkPVRenderView.h"
@@ -36,16 +45,109 @@
 #include "vtkProjectedTetrahedraMapper.h"
 #include "vtkRenderer.h"
 #include "vtkResampleToImage.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSmartVolumeMapper.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVolumeProperty.h"
 #include "vtkVolumeRepresentationPreprocessor.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Returns a time stamp that changes only when the geometry or topology of the
+// dataset changes, ignoring changes to its attributes.
+vtkMTimeType GetMeshMTime(vtkDataSet* ds)
+{
+  if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    vtkMTimeType mtime = ug->GetPoints() ? ug->GetPoints()->GetMTime() : 0;
+    if (ug->GetCells())
+    {
+      mtime = std::max(mtime, ug->GetCells()->GetMTime());
+    }
+    return mtime;
+  }
+  return ds->GetMTime();
+}
+
+//----------------------------------------------------------------------------
+// Probes the input dataset at every point of the output image. Cell lookups
+// go through a prebuilt locator, which is safe to query concurrently.
+class ResampleFunctor
+{
+public:
+  ResampleFunctor(vtkDataSet* input, vtkImageData* output, vtkAbstractCellLocator* locator,
+    vtkPointData* outPD, vtkPointData* outCD, char* mask, unsigned char* ghosts)
+    : Input(input)
+    , Output(output)
+    , Locator(locator)
+    , OutPD(outPD)
+    , OutCD(outCD)
+    , Mask(mask)
+    , Ghosts(ghosts)
+  {
+    const double length = input->GetLength();
+    this->Tol2 = length > 0 ? (length * 1e-6) * (length * 1e-6) : 1e-12;
+    this->MaxCellSize = std::max(input->GetMaxCellSize(), 1);
+  }
+
+  void Initialize() { this->Weights.Local().resize(this->MaxCellSize); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double* weights = this->Weights.Local().data();
+    vtkPointData* inPD = this->Input->GetPointData();
+    vtkCellData* inCD = this->Input->GetCellData();
+    double x[3], pcoords[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->Output->GetPoint(ptId, x);
+      const vtkIdType cellId = this->Locator->FindCell(x, this->Tol2, cell, pcoords, weights);
+      if (cellId >= 0)
+      {
+        this->OutPD->InterpolatePoint(inPD, ptId, cell->PointIds, weights);
+        this->OutCD->CopyData(inCD, cellId, ptId);
+        this->Mask[ptId] = 1;
+        this->Ghosts[ptId] = 0;
+      }
+      else
+      {
+        this->OutPD->NullPoint(ptId);
+        this->OutCD->NullPoint(ptId);
+        this->Mask[ptId] = 0;
+        this->Ghosts[ptId] = vtkDataSetAttributes::HIDDENPOINT;
+      }
+    }
+  }
+
+  void Reduce() {}
+
+private:
+  vtkDataSet* Input;
+  vtkImageData* Output;
+  vtkAbstractCellLocator* Locator;
+  vtkPointData* OutPD;
+  vtkPointData* OutCD;
+  char* Mask;
+  unsigned char* Ghosts;
+  double Tol2;
+  int MaxCellSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+};
+}
 
 class vtkUnstructuredGridVolumeRepresentation::vtkInternals
 {
@@ -53,6 +155,53 @@ public:
   typedef std::map<std::string, vtkSmartPointer<vtkAbstractVolumeMapper>> MapOfMappers;
   MapOfMappers Mappers;
   std::string ActiveVolumeMapper;
+
+  // Cell locator for the "Resample To Image" mapper. It is only rebuilt when
+  // the mesh changes.
+  vtkSmartPointer<vtkStaticCellLocator> Locator;
+  vtkMTimeType LocatorMeshMTime = 0;
+
+  // Resampled images, reused as long as neither the input nor the sampling
+  // dimensions change.
+  vtkSmartPointer<vtkImageData> Image;
+  vtkSmartPointer<vtkImageData> InteractiveImage;
+  int ImageDimensions[3] = { 0, 0, 0 };
+  int InteractiveImageDimensions[3] = { 0, 0, 0 };
+  vtkDataObject* ResampledInput = nullptr;
+  vtkMTimeType ResampledInputMTime = 0;
+
+  // Images passed to the volume mapper, with the opacity component appended
+  // when needed.
+  vtkSmartPointer<vtkDataSet> RenderedImage;
+  vtkSmartPointer<vtkDataSet> RenderedInteractiveImage;
+
+  bool UseInteractiveImage(const int fullDims[3], const int interactiveDims[3]) const
+  {
+    bool coarser = false;
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      if (interactiveDims[cc] < 1 || interactiveDims[cc] > fullDims[cc])
+      {
+        return false;
+      }
+      coarser = coarser || interactiveDims[cc] < fullDims[cc];
+    }
+    return coarser;
+  }
+
+  void UpdateLocator(vtkDataSet* ds)
+  {
+    // Rebuild the locator only when the mesh itself has changed.
+    const vtkMTimeType meshMTime = ::GetMeshMTime(ds);
+    if (this->Locator == nullptr || this->Locator->GetDataSet() != ds ||
+      this->LocatorMeshMTime != meshMTime)
+    {
+      this->Locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+      this->Locator->SetDataSet(ds);
+      this->Locator->BuildLocator();
+      this->LocatorMeshMTime = meshMTime;
+    }
+  }
 };
 
 vtkStandardNewMacro(vtkUnstructuredGridVolumeRepresentation);
@@ -64,6 +213,8 @@ vtkUnstructuredGridVolumeRepresentation::vtkUnstructuredGridVolumeRepresentation
   this->Preprocessor->SetTetrahedraOnly(1);
 
   this->ResampleToImageFilter->SetSamplingDimensions(128, 128, 128);
+  this->InteractiveResampleToImageFilter->SetSamplingDimensions(
+    this->InteractiveSamplingDimensions);
 
   this->LODGeometryFilter->SetUseOutline(0);
 
@@ -392,6 +543,10 @@ void vtkUnstructuredGridVolumeRepresentation::UpdateMapperParameters()
 void vtkUnstructuredGridVolumeRepresentation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseDataPartitions: " << this->UseDataPartitions << endl;
+  os << indent << "InteractiveSamplingDimensions: " << this->InteractiveSamplingDimensions[0]
+     << ", " << this->InteractiveSamplingDimensions[1] << ", "
+     << this->InteractiveSamplingDimensions[2] << endl;
 }
 
 //***************************************************************************
@@ -425,6 +580,104 @@ void vtkUnstructuredGridVolumeRepresentation::RemoveAllBlockSelectors()
 void vtkUnstructuredGridVolumeRepresentation::SetSamplingDimensions(int xdim, int ydim, int zdim)
 {
   this->ResampleToImageFilter->SetSamplingDimensions(xdim, ydim, zdim);
+  this->MarkModified();
+}
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGridVolumeRepresentation::SetInteractiveSamplingDimensions(
+  int xdim, int ydim, int zdim)
+{
+  if (this->InteractiveSamplingDimensions[0] != xdim ||
+    this->InteractiveSamplingDimensions[1] != ydim ||
+    this->InteractiveSamplingDimensions[2] != zdim)
+  {
+    this->InteractiveSamplingDimensions[0] = xdim;
+    this->InteractiveSamplingDimensions[1] = ydim;
+    this->InteractiveSamplingDimensions[2] = zdim;
+    this->MarkModified();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> vtkUnstructuredGridVolumeRepresentation::ResampleInput(
+  vtkDataObject* input, const int dims[3], vtkResampleToImage* resampler)
+{
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  vtkDataSet* ds = vtkDataSet::SafeDownCast(input);
+  if (ds == nullptr || ds->GetNumberOfCells() == 0 ||
+    (controller && controller->GetNumberOfProcesses() > 1))
+  {
+    // Composite and distributed inputs go through vtkResampleToImage, which
+    // takes care of combining blocks and of the data exchange between ranks.
+    resampler->SetSamplingDimensions(dims[0], dims[1], dims[2]);
+    resampler->SetInputDataObject(input);
+    resampler->Update();
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->ShallowCopy(resampler->GetOutput());
+    return image;
+  }
+
+  this->Internals->UpdateLocator(ds);
+
+  double bounds[6];
+  ds->GetBounds(bounds);
+  double spacing[3];
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    spacing[cc] = dims[cc] > 1 ? (bounds[2 * cc + 1] - bounds[2 * cc]) / (dims[cc] - 1) : 1.0;
+  }
+
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(dims[0], dims[1], dims[2]);
+  image->SetOrigin(bounds[0], bounds[2], bounds[4]);
+  image->SetSpacing(spacing);
+  const vtkIdType numPts = image->GetNumberOfPoints();
+
+  // Point arrays are interpolated, cell arrays are copied from the cell
+  // containing the sample. Both end up as point arrays on the image, matching
+  // what vtkResampleToImage produces.
+  vtkPointData* outPD = image->GetPointData();
+  outPD->CopyFieldOff(vtkDataSetAttributes::GhostArrayName());
+  outPD->InterpolateAllocate(ds->GetPointData(), numPts);
+  vtkNew<vtkPointData> outCD;
+  outCD->CopyFieldOff(vtkDataSetAttributes::GhostArrayName());
+  outCD->CopyAllocate(ds->GetCellData(), numPts);
+  for (vtkDataSetAttributes* attributes : { static_cast<vtkDataSetAttributes*>(outPD),
+         static_cast<vtkDataSetAttributes*>(outCD.GetPointer()) })
+  {
+    for (int cc = 0; cc < attributes->GetNumberOfArrays(); ++cc)
+    {
+      attributes->GetAbstractArray(cc)->SetNumberOfTuples(numPts);
+    }
+  }
+
+  vtkNew<vtkCharArray> mask;
+  mask->SetName("vtkValidPointMask");
+  mask->SetNumberOfTuples(numPts);
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  ghosts->SetNumberOfTuples(numPts);
+
+  // Make sure lazily built structures of the input are in place before the
+  // cells get accessed from several threads.
+  vtkNew<vtkGenericCell> cell;
+  ds->GetCell(0, cell);
+
+  ::ResampleFunctor functor(ds, image, this->Internals->Locator, outPD, outCD,
+    mask->GetPointer(0), ghosts->GetPointer(0));
+  vtkSMPTools::For(0, numPts, functor);
+
+  for (int cc = 0; cc < outCD->GetNumberOfArrays(); ++cc)
+  {
+    vtkAbstractArray* array = outCD->GetAbstractArray(cc);
+    if (array->GetName() == nullptr || !outPD->HasArray(array->GetName()))
+    {
+      outPD->AddArray(array);
+    }
+  }
+  outPD->AddArray(mask);
+  outPD->AddArray(ghosts);
+  return image;
 }
 
 //***************************************************************************
@@ -460,6 +713,18 @@ int vtkUnstructuredGridVolumeRepresentation::ProcessViewRequestResampleToImage(
   {
     this->UpdateMapperParameters();
 
+    // Render the coarser image while interacting, when one is available.
+    auto& internals = *this->Internals;
+    vtkDataSet* image =
+      inInfo->Has(vtkPVRenderView::USE_LOD()) && internals.RenderedInteractiveImage != nullptr
+      ? internals.RenderedInteractiveImage.GetPointer()
+      : internals.RenderedImage.GetPointer();
+    vtkAbstractVolumeMapper* volumeMapper = this->GetActiveVolumeMapper();
+    if (image && volumeMapper->GetInputDataObject(0, 0) != image)
+    {
+      volumeMapper->SetInputDataObject(image);
+    }
+
     vtkAlgorithmOutput* producerPort = vtkPVRenderView::GetPieceProducer(inInfo, this);
     if (producerPort)
     {
@@ -476,38 +741,87 @@ int vtkUnstructuredGridVolumeRepresentation::RequestDataResampleToImage(
   vtkMath::UninitializeBounds(this->DataBounds);
   this->DataSize = 0;
 
+  auto& internals = *this->Internals;
   vtkAbstractVolumeMapper* volumeMapper = this->GetActiveVolumeMapper();
   if (inputVector[0]->GetNumberOfInformationObjects() == 1)
   {
     vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
-    this->ResampleToImageFilter->SetInputDataObject(input);
-    this->ResampleToImageFilter->Update();
 
-    this->Actor->SetEnableLOD(0);
+    // The representation gets updated for changes that do not affect the
+    // samples, e.g. array selection. Reuse the resampled images unless the
+    // input or the sampling dimensions have changed.
+    const bool inputChanged =
+      internals.ResampledInput != input || internals.ResampledInputMTime != input->GetMTime();
+    const int* dims = this->ResampleToImageFilter->GetSamplingDimensions();
+    const int* interactiveDims = this->InteractiveSamplingDimensions;
+    const bool useInteractiveImage = internals.UseInteractiveImage(dims, interactiveDims);
+    int resample[2] = { inputChanged || internals.Image == nullptr ||
+          !std::equal(dims, dims + 3, internals.ImageDimensions),
+      useInteractiveImage &&
+        (inputChanged || internals.InteractiveImage == nullptr ||
+          !std::equal(interactiveDims, interactiveDims + 3, internals.InteractiveImageDimensions)) };
+
+    // In parallel, the resample filters need all ranks to participate, hence
+    // all ranks resample as soon as one of them has to.
+    vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+    if (controller && controller->GetNumberOfProcesses() > 1)
+    {
+      int anyResample[2];
+      controller->AllReduce(resample, anyResample, 2, vtkCommunicator::MAX_OP);
+      std::copy(anyResample, anyResample + 2, resample);
+    }
 
-    auto resampleOutput = this->ResampleToImageFilter->GetOutput();
-    vtkSmartPointer<vtkDataSet> ds;
-    ds.TakeReference(resampleOutput->NewInstance());
-    ds->ShallowCopy(resampleOutput);
-    if (this->UseSeparateOpacityArray)
+    if (resample[0])
     {
-      this->AppendOpacityComponent(ds);
+      internals.Image = this->ResampleInput(input, dims, this->ResampleToImageFilter);
+      std::copy(dims, dims + 3, internals.ImageDimensions);
     }
 
-    volumeMapper->SetInputDataObject(ds);
+    if (!useInteractiveImage)
+    {
+      internals.InteractiveImage = nullptr;
+    }
+    else if (resample[1])
+    {
+      internals.InteractiveImage =
+        this->ResampleInput(input, interactiveDims, this->InteractiveResampleToImageFilter);
+      std::copy(interactiveDims, interactiveDims + 3, internals.InteractiveImageDimensions);
+    }
+
+    internals.ResampledInput = input;
+    internals.ResampledInputMTime = input->GetMTime();
+
+    auto prepareForRendering = [this](vtkImageData* image) -> vtkSmartPointer<vtkDataSet> {
+      if (image == nullptr || !this->UseSeparateOpacityArray)
+      {
+        return image;
+      }
+      vtkSmartPointer<vtkDataSet> ds;
+      ds.TakeReference(image->NewInstance());
+      ds->ShallowCopy(image);
+      this->AppendOpacityComponent(ds);
+      return ds;
+    };
+    internals.RenderedImage = prepareForRendering(internals.Image);
+    internals.RenderedInteractiveImage = prepareForRendering(internals.InteractiveImage);
+
+    this->Actor->SetEnableLOD(0);
+
+    volumeMapper->SetInputDataObject(internals.RenderedImage);
 
-    vtkImageData* output = vtkImageData::SafeDownCast(resampleOutput);
-    this->OutlineSource->SetBounds(output->GetBounds());
+    this->OutlineSource->SetBounds(internals.Image->GetBounds());
     this->OutlineSource->GetBounds(this->DataBounds);
     this->OutlineSource->Update();
 
-    this->DataSize = output->GetActualMemorySize();
+    this->DataSize = internals.Image->GetActualMemorySize();
   }
   else
   {
     // when no input is present, it implies that this processes is on a node
     // without the data input i.e. either client or render-server, in which case
     // we show only the outline.
+    internals.RenderedImage = nullptr;
+    internals.RenderedInteractiveImage = nullptr;
     volumeMapper->RemoveAllInputs();
     this->Actor->SetEnableLOD(1);
   }
@@ -20,17 +20,27 @@
  * vtkUnstructuredGridVolumeRepresentation is a representation for volume
  * rendering vtkUnstructuredGrid datasets. It simply renders a translucent
  * surface for LOD i.e. interactive rendering.
+ *
+ * When the "Resample To Image" mapper is selected, the input is resampled to
+ * a vtkImageData. The resampled image is cached and reused until the input
+ * or the sampling dimensions change, so that edits to the transfer functions
+ * do not trigger a new resampling. For a non-distributed vtkDataSet input,
+ * the resampling is done using vtkSMPTools with a cell locator that is built
+ * once per mesh and reused for all subsequent resamplings. A coarser image,
+ * controlled by InteractiveSamplingDimensions, is rendered during interaction.
  */
 
 #ifndef vtkUnstructuredGridVolumeRepresentation_h
 #define vtkUnstructuredGridVolumeRepresentation_h
 
 #include "vtkRemotingViewsModule.h" //needed for exports
+#include "vtkSmartPointer.h"           // needed for vtkSmartPointer
 #include "vtkVolumeRepresentation.h"
 
 class vtkAbstractVolumeMapper;
 class vtkColorTransferFunction;
 class vtkDataSet;
+class vtkImageData;
 class vtkOutlineSource;
 class vtkPiecewiseFunction;
 class vtkPolyDataMapper;
@@ -90,6 +100,22 @@ public:
   }
   void SetSamplingDimensions(int xdim, int ydim, int zdim);
 
+  //@{
+  /**
+   * Sampling dimensions of the image rendered during interaction when the
+   * "Resample To Image" mapper is used. The full resolution image, set using
+   * SetSamplingDimensions(), is used for still renders. The interactive image
+   * is skipped when it would not be coarser than the full resolution one or
+   * when any of the dimensions is less than 1. Default is (64, 64, 64).
+   */
+  void SetInteractiveSamplingDimensions(int dims[3])
+  {
+    this->SetInteractiveSamplingDimensions(dims[0], dims[1], dims[2]);
+  }
+  void SetInteractiveSamplingDimensions(int xdim, int ydim, int zdim);
+  vtkGetVector3Macro(InteractiveSamplingDimensions, int);
+  //@}
+
   //@{
   /**
    * Specify whether or not to redistribute the data. The default is false
@@ -136,15 +162,25 @@ protected:
   int RequestDataResampleToImage(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector);
 
+  /**
+   * Resamples the input to an image with the given dimensions. Uses the
+   * threaded, locator caching code path when possible and falls back to
+   * `resampler` otherwise.
+   */
+  vtkSmartPointer<vtkImageData> ResampleInput(
+    vtkDataObject* input, const int dims[3], vtkResampleToImage* resampler);
+
   vtkNew<vtkVolumeRepresentationPreprocessor> Preprocessor;
   vtkNew<vtkProjectedTetrahedraMapper> DefaultMapper;
 
   vtkNew<vtkResampleToImage> ResampleToImageFilter;
+  vtkNew<vtkResampleToImage> InteractiveResampleToImageFilter;
 
   vtkNew<vtkPVGeometryFilter> LODGeometryFilter;
   vtkNew<vtkPolyDataMapper> LODMapper;
 
   bool UseDataPartitions = false;
+  int InteractiveSamplingDimensions[3] = { 64, 64, 64 };
 
 private:
   vtkUnstructuredGridVolumeRepresentation(const vtkUnstructuredGridVolumeRepresentation&) = delete;
@@ -0,0 +1,151 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestAMRDualThreaded.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPVAMRDualContour and vtkPVAMRDualClip generate the same
+// cells on a multi-level AMR dataset whether the blocks are processed
+// concurrently or by a single thread.
+
+#include "vtkCell.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkDummyController.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPVAMRDualClip.h"
+#include "vtkPVAMRDualContour.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpyPlotReader.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+const char* ArrayName = "Material volume fraction - 2";
+
+using Cell = std::vector<std::array<double, 3>>;
+
+// The cells of all leaves, each as its sorted point coordinates, sorted.
+// Point and cell ids depend on the order blocks are processed in, the
+// geometry does not.
+std::vector<Cell> GetCells(vtkDataObject* output)
+{
+  std::vector<Cell> cells;
+  auto composite = vtkCompositeDataSet::SafeDownCast(output);
+  if (!composite)
+  {
+    return cells;
+  }
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(composite->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    auto dataset = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    for (vtkIdType cellId = 0; dataset && cellId < dataset->GetNumberOfCells(); ++cellId)
+    {
+      vtkCell* cell = dataset->GetCell(cellId);
+      Cell points(cell->GetNumberOfPoints());
+      for (vtkIdType cc = 0; cc < cell->GetNumberOfPoints(); ++cc)
+      {
+        dataset->GetPoint(cell->GetPointId(cc), points[cc].data());
+      }
+      std::sort(points.begin(), points.end());
+      cells.push_back(std::move(points));
+    }
+  }
+  std::sort(cells.begin(), cells.end());
+  return cells;
+}
+
+// Runs the filter with the default number of threads, then with a single one.
+bool CompareThreadedToSerial(vtkAlgorithm* filter, const char* name)
+{
+  filter->Update();
+  const std::vector<Cell> threaded = GetCells(filter->GetOutputDataObject(0));
+
+  vtkSMPTools::Initialize(1);
+  filter->Modified();
+  filter->Update();
+  const std::vector<Cell> serial = GetCells(filter->GetOutputDataObject(0));
+  vtkSMPTools::Initialize();
+
+  if (serial.empty())
+  {
+    std::cerr << name << ": no cells were generated." << std::endl;
+    return false;
+  }
+  if (threaded != serial)
+  {
+    std::cerr << name << ": " << threaded.size() << " cells were generated by "
+              << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads and " << serial.size()
+              << " by a single one, or they differ." << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestAMRDualThreaded(int argc, char* argv[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Testing/Data/SPCTH/Dave_Karelitz_Small/spcth.0");
+  vtkNew<vtkSpyPlotReader> reader;
+  reader->SetFileName(fname);
+  delete[] fname;
+  reader->SetGlobalController(controller);
+  reader->MergeXYZComponentsOn();
+  reader->DownConvertVolumeFractionOn();
+  reader->DistributeFilesOn();
+  reader->SetCellArrayStatus(ArrayName, 1);
+  reader->Update();
+
+  auto amr = vtkNonOverlappingAMR::SafeDownCast(reader->GetOutputDataObject(0));
+  if (!amr || amr->GetNumberOfLevels() < 2)
+  {
+    std::cerr << "Expected a multi-level AMR dataset." << std::endl;
+    vtkMultiProcessController::SetGlobalController(nullptr);
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPVAMRDualContour> contour;
+  contour->SetInputConnection(reader->GetOutputPort(0));
+  contour->SetVolumeFractionSurfaceValue(0.1);
+  contour->SetEnableMergePoints(1);
+  contour->SetEnableDegenerateCells(1);
+  contour->SetEnableMultiProcessCommunication(1);
+  contour->AddInputCellArrayToProcess(ArrayName);
+
+  vtkNew<vtkPVAMRDualClip> clip;
+  clip->SetInputConnection(reader->GetOutputPort(0));
+  clip->SetVolumeFractionSurfaceValue(0.1);
+  clip->SetEnableMergePoints(1);
+  clip->SetEnableDegenerateCells(1);
+  clip->SetEnableMultiProcessCommunication(1);
+  clip->AddInputCellArrayToProcess(ArrayName);
+
+  const bool success = CompareThreadedToSerial(contour, "vtkPVAMRDualContour") &&
+    CompareThreadedToSerial(clip, "vtkPVAMRDualClip");
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
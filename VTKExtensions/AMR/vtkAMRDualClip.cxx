@@ -15,6 +15,8 @@
 #include "vtkAMRDualClip.h"
 #include "vtkAMRDualGridHelper.h"
 
+#include <memory>
+#include <mutex>
 #include <vector>
 
 // Pipeline & VTK
@@ -24,6 +26,9 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
 #include "vtkCallbackCommand.h"
@@ -39,8 +44,10 @@
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -170,6 +177,122 @@ private:
   unsigned char CenterLevelMaskComputed;
 };
 
+//============================================================================
+// Piece of the mesh generated by one thread. Locators are shared between
+// blocks processed by different threads so, they store encoded point ids made
+// of the index of the piece in the high bits and of the id of the point in
+// the piece in the low bits. Cells are created with encoded ids and decoded
+// when the pieces are appended.
+#if VTK_SIZEOF_ID_TYPE == 8
+static const int vtkAMRDualClipPieceIdShift = 40;
+#else
+// Blocks are processed serially, there is only one piece.
+static const int vtkAMRDualClipPieceIdShift = 0;
+#endif
+
+class vtkAMRDualClipOutput
+{
+public:
+  vtkAMRDualClipOutput(int index)
+    : Index(index)
+  {
+    this->Mesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    this->Points = vtkSmartPointer<vtkPoints>::New();
+    this->Cells = vtkSmartPointer<vtkCellArray>::New();
+    this->BlockIds = vtkSmartPointer<vtkIntArray>::New();
+    this->BlockIds->SetName("BlockIds");
+    this->LevelMask = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    this->LevelMask->SetName("LevelMask");
+    this->Mesh->SetPoints(this->Points);
+    this->Mesh->GetCellData()->AddArray(this->BlockIds);
+    this->Mesh->GetPointData()->AddArray(this->LevelMask);
+  }
+
+  // Adds a point to the piece and returns its encoded id.
+  vtkIdType InsertNextPoint(const double pt[3], vtkIdType& localId)
+  {
+    localId = this->Points->InsertNextPoint(pt);
+    return (static_cast<vtkIdType>(this->Index) << vtkAMRDualClipPieceIdShift) | localId;
+  }
+
+  int Index;
+  vtkSmartPointer<vtkUnstructuredGrid> Mesh;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Cells;
+  vtkSmartPointer<vtkIntArray> BlockIds;
+  vtkSmartPointer<vtkUnsignedCharArray> LevelMask;
+
+  // Locator of the block being processed.
+  vtkAMRDualClipLocator* BlockLocator = nullptr;
+  // Locator reused for all blocks when points are not merged between blocks.
+  std::unique_ptr<vtkAMRDualClipLocator> ReusedLocator;
+};
+
+//----------------------------------------------------------------------------
+// Appends the pieces and decodes the point ids of their cells.
+static vtkSmartPointer<vtkUnstructuredGrid> vtkAMRDualClipAppendOutputs(
+  const std::vector<std::unique_ptr<vtkAMRDualClipOutput>>& outputs)
+{
+  if (outputs.size() == 1)
+  { // Encoded ids are the point ids.
+    outputs[0]->Mesh->SetCells(VTK_TETRA, outputs[0]->Cells);
+    return outputs[0]->Mesh;
+  }
+
+  std::vector<vtkIdType> pointOffsets(outputs.size() + 1, 0);
+  vtkIdType numCells = 0;
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+  {
+    pointOffsets[ii + 1] = pointOffsets[ii] + outputs[ii]->Points->GetNumberOfPoints();
+    numCells += outputs[ii]->Cells->GetNumberOfCells();
+  }
+  vtkIdType numPoints = pointOffsets.back();
+
+  vtkSmartPointer<vtkUnstructuredGrid> mesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(outputs[0]->Points->GetDataType());
+  points->SetNumberOfPoints(numPoints);
+  vtkNew<vtkCellArray> cells;
+  cells->AllocateEstimate(numCells, 4);
+  mesh->SetPoints(points);
+  mesh->GetPointData()->CopyAllocate(outputs[0]->Mesh->GetPointData(), numPoints);
+  mesh->GetCellData()->CopyAllocate(outputs[0]->Mesh->GetCellData(), numCells);
+
+  const vtkIdType localIdMask = (static_cast<vtkIdType>(1) << vtkAMRDualClipPieceIdShift) - 1;
+  vtkIdType ids[4];
+  vtkIdType cellOffset = 0;
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+  {
+    vtkAMRDualClipOutput* output = outputs[ii].get();
+    vtkIdType numOutputPoints = output->Points->GetNumberOfPoints();
+    vtkIdType numOutputCells = output->Cells->GetNumberOfCells();
+    if (numOutputPoints > 0)
+    {
+      points->InsertPoints(pointOffsets[ii], numOutputPoints, 0, output->Points);
+      mesh->GetPointData()->CopyData(
+        output->Mesh->GetPointData(), pointOffsets[ii], numOutputPoints, 0);
+    }
+    if (numOutputCells > 0)
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      output->Cells->InitTraversal();
+      while (output->Cells->GetNextCell(npts, pts))
+      { // Only tetrahedra are generated.
+        for (vtkIdType jj = 0; jj < 4; ++jj)
+        {
+          ids[jj] = pointOffsets[pts[jj] >> vtkAMRDualClipPieceIdShift] + (pts[jj] & localIdMask);
+        }
+        cells->InsertNextCell(4, ids);
+      }
+      mesh->GetCellData()->CopyData(output->Mesh->GetCellData(), cellOffset, numOutputCells, 0);
+      cellOffset += numOutputCells;
+    }
+  }
+  mesh->SetCells(VTK_TETRA, cells);
+  return mesh;
+}
+
 //----------------------------------------------------------------------------
 unsigned char* vtkAMRDualClipLocator::GetLevelMaskPointer()
 {
@@ -181,8 +304,13 @@ unsigned char* vtkAMRDualClipLocator::GetLevelMaskPointer()
 }
 
 //----------------------------------------------------------------------------
+// Neighbor blocks processed by different threads create each other's locator
+// and level mask.
+static std::recursive_mutex vtkAMRDualClipBlockLocatorMutex;
+
 vtkAMRDualClipLocator* vtkAMRDualClipGetBlockLocator(vtkAMRDualGridHelperBlock* block)
 {
+  std::lock_guard<std::recursive_mutex> lock(vtkAMRDualClipBlockLocatorMutex);
   if (block->UserData == nullptr)
   {
     vtkImageData* image = block->Image;
@@ -1035,21 +1163,12 @@ vtkAMRDualClip::vtkAMRDualClip()
   // Pipeline
   this->SetNumberOfOutputPorts(1);
 
-  this->LevelMaskPointArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualClip::~vtkAMRDualClip()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -1183,52 +1302,70 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
     this->DistributeLevelMasks();
   }
 
-  vtkUnstructuredGrid* mesh = vtkUnstructuredGrid::New();
-  this->Points = vtkPoints::New();
-  this->Cells = vtkCellArray::New();
-  mesh->SetPoints(this->Points);
-  mpds->SetPiece(0, mesh);
-
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  mesh->GetCellData()->AddArray(this->BlockIdCellArray);
-
-  this->LevelMaskPointArray = vtkUnsignedCharArray::New();
-  this->LevelMaskPointArray->SetName("LevelMask");
-  mesh->GetPointData()->AddArray(this->LevelMaskPointArray);
-
-  this->Mesh = mesh;
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
+  // Each thread generates its own piece of the mesh.
+  std::vector<std::unique_ptr<vtkAMRDualClipOutput>> outputs;
+  std::mutex outputsMutex;
+  vtkSMPThreadLocal<vtkAMRDualClipOutput*> threadOutput(nullptr);
+  auto getOutput = [&]() {
+    vtkAMRDualClipOutput*& output = threadOutput.Local();
+    if (output == nullptr)
+    {
+      std::lock_guard<std::mutex> lock(outputsMutex);
+      outputs.emplace_back(new vtkAMRDualClipOutput(static_cast<int>(outputs.size())));
+      output = outputs.back().get();
+      this->InitializeCopyAttributes(hbdsInput, output->Mesh);
+    }
+    return output;
+  };
 
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
-  int numBlocks;
-  int blockId;
 
-  // Add each block.
+  // Add each block.  Levels are processed in order because locators and
+  // level masks are only shared with blocks of the same or higher levels.
   for (int level = 0; level < numLevels; ++level)
   {
-    numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (blockId = 0; blockId < numBlocks; ++blockId)
+    std::vector<std::vector<int>> groups;
+    if (this->EnableMergePoints)
+    { // Neighbors share locators, they are processed in different groups.
+      this->Helper->GetIndependentBlockGroups(level, groups);
+    }
+    else
+    {
+      groups.resize(1);
+      int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (int blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        if (this->Helper->GetBlock(level, blockId)->Image)
+        {
+          groups[0].push_back(blockId);
+        }
+      }
+    }
+
+    for (const auto& group : groups)
     {
-      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      auto processRange = [&](vtkIdType begin, vtkIdType end) {
+        vtkAMRDualClipOutput* output = getOutput();
+        for (vtkIdType ii = begin; ii < end; ++ii)
+        {
+          vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, group[ii]);
+          this->ProcessBlock(block, group[ii], arrayNameToProcess, output);
+        }
+      };
+#if VTK_SIZEOF_ID_TYPE == 8
+      vtkSMPTools::For(0, static_cast<vtkIdType>(group.size()), 1, processRange);
+#else
+      processRange(0, static_cast<vtkIdType>(group.size()));
+#endif
     }
   }
 
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
-  this->LevelMaskPointArray->Delete();
-  this->LevelMaskPointArray = nullptr;
-
-  mesh->SetCells(VTK_TETRA, this->Cells);
-
-  mesh->Delete();
-  this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Cells->Delete();
-  this->Cells = nullptr;
+  if (outputs.empty())
+  { // No local blocks.
+    getOutput();
+  }
+  mpds->SetPiece(0, vtkAMRDualClipAppendOutputs(outputs));
 
   mpds->Delete();
   this->Helper->Delete();
@@ -1310,6 +1447,8 @@ void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualGridHelperBlock* block)
   { // Remote blocks are only to setup local block bit flags.
     return;
   }
+  // Blocks processed concurrently may compute the mask of the same neighbor.
+  std::lock_guard<std::recursive_mutex> lock(vtkAMRDualClipBlockLocatorMutex);
   vtkDataArray* volumeFractionArray = image->GetCellData()->GetArray(this->Helper->GetArrayName());
 
   vtkAMRDualClipLocator* locator = vtkAMRDualClipGetBlockLocator(block);
@@ -1404,6 +1543,7 @@ void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualGridHelperBlock* block)
 // level mask with neighbors before we delete the locator.
 void vtkAMRDualClip::ShareLevelMask(vtkAMRDualGridHelperBlock* block)
 {
+  std::lock_guard<std::recursive_mutex> lock(vtkAMRDualClipBlockLocatorMutex);
   vtkAMRDualGridHelperBlock* neighbor;
   vtkAMRDualClipLocator* neighborLocator;
   int numLevels = this->Helper->GetNumberOfLevels();
@@ -1454,8 +1594,8 @@ void vtkAMRDualClip::ShareLevelMask(vtkAMRDualGridHelperBlock* block)
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualClip::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+void vtkAMRDualClip::ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId,
+  const char* arrayNameToProcess, vtkAMRDualClipOutput* output)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
@@ -1488,17 +1628,18 @@ void vtkAMRDualClip::ProcessBlock(
   if (this->EnableMergePoints)
   {
     this->InitializeLevelMask(block);
-    this->BlockLocator = vtkAMRDualClipGetBlockLocator(block);
+    output->BlockLocator = vtkAMRDualClipGetBlockLocator(block);
   }
   else
   { // Shared locator.
-    if (this->BlockLocator == nullptr)
+    if (!output->ReusedLocator)
     {
-      this->BlockLocator = new vtkAMRDualClipLocator;
+      output->ReusedLocator.reset(new vtkAMRDualClipLocator);
     }
-    this->BlockLocator->Initialize(
+    output->BlockLocator = output->ReusedLocator.get();
+    output->BlockLocator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    // this->BlockLocator->CopyRegionLevelDifferences(block);
+    // output->BlockLocator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -1574,7 +1715,8 @@ void vtkAMRDualClip::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + yInc + zInc;
           cornerOffsets[7] = xOffset + 1 + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(
+            block, blockId, x, y, z, cornerOffsets, volumeFractionArray, output);
         }
         xOffset += 1; // xInc
       }
@@ -1589,8 +1731,8 @@ void vtkAMRDualClip::ProcessBlock(
     // Copy point ids into neighbor locators.
     this->ShareBlockLocatorWithNeighbors(block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
+    delete output->BlockLocator;
+    output->BlockLocator = nullptr;
     block->UserData = nullptr;
     // Lets use this unused flag (owner of center region/block) to indicate
     // that the block is already processes.
@@ -1606,7 +1748,8 @@ void vtkAMRDualClip::ProcessBlock(
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
 void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray,
+  vtkAMRDualClipOutput* output)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1834,8 +1977,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
       // convert from VTK corner ids to bit (x,y,z) corner ids.
       if (casePtId < 8)
       { // Corner (internal point)
-        ptIdPtr = this->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
-        levelMaskValue = this->BlockLocator->GetLevelMaskValue(
+        ptIdPtr = output->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
+        levelMaskValue = output->BlockLocator->GetLevelMaskValue(
           x + ((casePtId & 1) ? 1 : 0), y + ((casePtId & 2) ? 1 : 0), z + ((casePtId & 4) ? 1 : 0));
         if (levelMaskValue == 0)
         { // bug !!!!! trying to figure out what is going on.
@@ -1887,7 +2030,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           pt[0] = origin[0] + spacing[0] * (double)(1 << levelDiff) * ((double)(px) + dx);
           pt[1] = origin[1] + spacing[1] * (double)(1 << levelDiff) * ((double)(py) + dy);
           pt[2] = origin[2] + spacing[2] * (double)(1 << levelDiff) * ((double)(pz) + dz);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          vtkIdType localId;
+          *ptIdPtr = output->InsertNextPoint(pt, localId);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1901,14 +2045,14 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Averaging could be a pre processing step but we would have to modify input attributes
           // .......
           vtkIdType offset = cornerOffsets[casePtId];
-          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
+          output->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, localId);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          output->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       else
       { // Edge (clipped cell, point on iso surface)
-        ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
+        ptIdPtr = output->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
         if (*ptIdPtr == -1)
         {
           int edge = casePtId - 8;
@@ -1925,7 +2069,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
             cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
           pt[2] =
             cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          vtkIdType localId;
+          *ptIdPtr = output->InsertNextPoint(pt, localId);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1935,10 +2080,10 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Find the offsets of the two attributes to interpolate
           vtkIdType offset0 = cornerOffsets[pt1Idx >> 2];
           vtkIdType offset1 = cornerOffsets[pt2Idx >> 2];
-          this->Mesh->GetPointData()->InterpolateEdge(
-            block->Image->GetCellData(), *ptIdPtr, offset0, offset1, k);
+          output->Mesh->GetPointData()->InterpolateEdge(
+            block->Image->GetCellData(), localId, offset0, offset1, k);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          output->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       pointIds[ii] = *ptIdPtr;
@@ -1946,8 +2091,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
       pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
     {
-      this->Cells->InsertNextCell(4, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      output->Cells->InsertNextCell(4, pointIds);
+      output->BlockIds->InsertNextValue(blockId);
     }
   }
 }
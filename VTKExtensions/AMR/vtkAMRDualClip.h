@@ -21,6 +21,10 @@
  * transitions are handled correctly, and second is that internal
  * cells are decimated.  I use a variation of degenerate points/cells
  * used for level transitions.
+ *
+ * Blocks that are not neighbors are processed concurrently using vtkSMPTools,
+ * each thread generating its own piece of the mesh. The pieces are appended
+ * once all blocks are processed. Concurrent processing requires 64 bit ids.
  */
 
 #ifndef vtkAMRDualClip_h
@@ -47,6 +51,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualClipLocator;
+class vtkAMRDualClipOutput;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualClip : public vtkMultiBlockDataSetAlgorithm
 {
@@ -100,9 +105,6 @@ protected:
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
 
-  // Needed for copying cell data to point data.
-  vtkUnstructuredGrid* Mesh;
-
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
@@ -118,10 +120,11 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName,
+    vtkAMRDualClipOutput* output);
 
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray, vtkAMRDualClipOutput* output);
 
   void InitializeLevelMask(vtkAMRDualGridHelperBlock* block);
   void ShareLevelMask(vtkAMRDualGridHelperBlock* block);
@@ -132,14 +135,8 @@ protected:
   // void MirrorCases();
   // void AddGlyph(double x, double y, double z);
 
-  // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
-  vtkUnsignedCharArray* LevelMaskPointArray;
-
   // Ivars used to reduce method parrameters.
   vtkAMRDualGridHelper* Helper;
-  vtkPoints* Points;
-  vtkCellArray* Cells;
 
   vtkMultiProcessController* Controller;
 
@@ -148,8 +145,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualClipLocator* BlockLocator;
-
 private:
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
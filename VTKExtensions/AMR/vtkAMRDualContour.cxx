@@ -14,6 +14,8 @@
 =========================================================================*/
 #include "vtkAMRDualContour.h"
 #include "vtkAMRDualGridHelper.h"
+#include <memory>
+#include <mutex>
 #include <vector>
 
 // Pipeline & VTK
@@ -23,6 +25,9 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
 #include "vtkCallbackCommand.h"
@@ -36,10 +41,13 @@
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -117,6 +125,126 @@ private:
 
   int RegionLevelDifference[3][3][3];
 };
+
+//============================================================================
+// Piece of the surface generated by one thread. Locators are shared between
+// blocks processed by different threads so, they store encoded point ids made
+// of the index of the piece in the high bits and of the id of the point in
+// the piece in the low bits. Cells are created with encoded ids and decoded
+// when the pieces are appended.
+#if VTK_SIZEOF_ID_TYPE == 8
+static const int vtkAMRDualContourPieceIdShift = 40;
+#else
+// Blocks are processed serially, there is only one piece.
+static const int vtkAMRDualContourPieceIdShift = 0;
+#endif
+
+class vtkAMRDualContourOutput
+{
+public:
+  vtkAMRDualContourOutput(int index)
+    : Index(index)
+  {
+    this->Mesh = vtkSmartPointer<vtkPolyData>::New();
+    this->Points = vtkSmartPointer<vtkPoints>::New();
+    this->Faces = vtkSmartPointer<vtkCellArray>::New();
+    this->BlockIds = vtkSmartPointer<vtkIntArray>::New();
+    this->BlockIds->SetName("BlockIds");
+    this->Mesh->SetPoints(this->Points);
+    this->Mesh->SetPolys(this->Faces);
+    this->Mesh->GetCellData()->AddArray(this->BlockIds);
+  }
+
+  // Adds a point to the piece and returns its encoded id.
+  vtkIdType InsertNextPoint(const double pt[3], vtkIdType& localId)
+  {
+    localId = this->Points->InsertNextPoint(pt);
+    return (static_cast<vtkIdType>(this->Index) << vtkAMRDualContourPieceIdShift) | localId;
+  }
+
+  void InsertNextCell(vtkIdType npts, const vtkIdType* pts, int blockId)
+  {
+    this->Faces->InsertNextCell(npts, pts);
+    this->BlockIds->InsertNextValue(blockId);
+  }
+
+  int Index;
+  vtkSmartPointer<vtkPolyData> Mesh;
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Faces;
+  vtkSmartPointer<vtkIntArray> BlockIds;
+
+  // Locator of the block being processed.
+  vtkAMRDualContourEdgeLocator* BlockLocator = nullptr;
+  // Locator reused for all blocks when points are not merged between blocks.
+  std::unique_ptr<vtkAMRDualContourEdgeLocator> ReusedLocator;
+};
+
+//----------------------------------------------------------------------------
+// Appends the pieces and decodes the point ids of their cells.
+static vtkSmartPointer<vtkPolyData> vtkAMRDualContourAppendOutputs(
+  const std::vector<std::unique_ptr<vtkAMRDualContourOutput>>& outputs)
+{
+  if (outputs.size() == 1)
+  { // Encoded ids are the point ids.
+    return outputs[0]->Mesh;
+  }
+
+  std::vector<vtkIdType> pointOffsets(outputs.size() + 1, 0);
+  vtkIdType numCells = 0;
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+  {
+    pointOffsets[ii + 1] = pointOffsets[ii] + outputs[ii]->Points->GetNumberOfPoints();
+    numCells += outputs[ii]->Faces->GetNumberOfCells();
+  }
+  vtkIdType numPoints = pointOffsets.back();
+
+  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(outputs[0]->Points->GetDataType());
+  points->SetNumberOfPoints(numPoints);
+  vtkNew<vtkCellArray> faces;
+  faces->AllocateEstimate(numCells, 3);
+  mesh->SetPoints(points);
+  mesh->SetPolys(faces);
+  mesh->GetPointData()->CopyAllocate(outputs[0]->Mesh->GetPointData(), numPoints);
+  mesh->GetCellData()->CopyAllocate(outputs[0]->Mesh->GetCellData(), numCells);
+
+  const vtkIdType localIdMask = (static_cast<vtkIdType>(1) << vtkAMRDualContourPieceIdShift) - 1;
+  std::vector<vtkIdType> ids;
+  vtkIdType cellOffset = 0;
+  for (size_t ii = 0; ii < outputs.size(); ++ii)
+  {
+    vtkAMRDualContourOutput* output = outputs[ii].get();
+    vtkIdType numOutputPoints = output->Points->GetNumberOfPoints();
+    vtkIdType numOutputCells = output->Faces->GetNumberOfCells();
+    if (numOutputPoints > 0)
+    {
+      points->InsertPoints(pointOffsets[ii], numOutputPoints, 0, output->Points);
+      mesh->GetPointData()->CopyData(
+        output->Mesh->GetPointData(), pointOffsets[ii], numOutputPoints, 0);
+    }
+    if (numOutputCells > 0)
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      output->Faces->InitTraversal();
+      while (output->Faces->GetNextCell(npts, pts))
+      {
+        ids.resize(npts);
+        for (vtkIdType jj = 0; jj < npts; ++jj)
+        {
+          ids[jj] = pointOffsets[pts[jj] >> vtkAMRDualContourPieceIdShift] + (pts[jj] & localIdMask);
+        }
+        faces->InsertNextCell(npts, ids.data());
+      }
+      mesh->GetCellData()->CopyData(output->Mesh->GetCellData(), cellOffset, numOutputCells, 0);
+      cellOffset += numOutputCells;
+    }
+  }
+  return mesh;
+}
+
 //----------------------------------------------------------------------------
 void vtkAMRDualContourEdgeLocator::CopyRegionLevelDifferences(vtkAMRDualGridHelperBlock* block)
 {
@@ -432,8 +560,12 @@ vtkIdType* vtkAMRDualContourEdgeLocator::GetCornerPointer(
 }
 
 //----------------------------------------------------------------------------
+// Neighbor blocks processed by different threads create each other's locator.
+static std::mutex vtkAMRDualContourBlockLocatorMutex;
+
 vtkAMRDualContourEdgeLocator* vtkAMRDualContourGetBlockLocator(vtkAMRDualGridHelperBlock* block)
 {
+  std::lock_guard<std::mutex> lock(vtkAMRDualContourBlockLocatorMutex);
   if (block->UserData == nullptr)
   {
     vtkImageData* image = block->Image;
@@ -631,20 +763,12 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->SetNumberOfOutputPorts(1);
 
   this->TemperatureArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualContour::~vtkAMRDualContour()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -783,7 +907,10 @@ void vtkAMRDualContour::FinalizeRequest()
 vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   vtkNonOverlappingAMR* hbdsInput, const char* arrayNameToProcess)
 {
-  this->Helper->SetupData(hbdsInput, arrayNameToProcess);
+  // Ghost values sent by other processes are received while blocks
+  // that do not need them are processed.
+  this->Helper->BeginSetupData(hbdsInput, arrayNameToProcess);
+  bool setupFinished = false;
 
   vtkMultiBlockDataSet* mbdsOutput0 = vtkMultiBlockDataSet::New();
   mbdsOutput0->SetNumberOfBlocks(1);
@@ -792,44 +919,115 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
 
   mpds->SetNumberOfPieces(0);
 
-  this->Mesh = vtkPolyData::New();
-  this->Points = vtkPoints::New();
-  this->Faces = vtkCellArray::New();
-  this->Mesh->SetPoints(this->Points);
-  this->Mesh->SetPolys(this->Faces);
-  mpds->SetPiece(0, this->Mesh);
-
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
-
-  // For debugging.
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  this->Mesh->GetCellData()->AddArray(this->BlockIdCellArray);
+  // Each thread generates its own piece of the surface.
+  std::vector<std::unique_ptr<vtkAMRDualContourOutput>> outputs;
+  std::mutex outputsMutex;
+  vtkSMPThreadLocal<vtkAMRDualContourOutput*> threadOutput(nullptr);
+  auto getOutput = [&]() {
+    vtkAMRDualContourOutput*& output = threadOutput.Local();
+    if (output == nullptr)
+    {
+      std::lock_guard<std::mutex> lock(outputsMutex);
+      outputs.emplace_back(new vtkAMRDualContourOutput(static_cast<int>(outputs.size())));
+      output = outputs.back().get();
+      this->InitializeCopyAttributes(hbdsInput, output->Mesh);
+    }
+    return output;
+  };
+  auto processBlocks = [&](int level, const std::vector<int>& blockIds) {
+    auto processRange = [&](vtkIdType begin, vtkIdType end) {
+      vtkAMRDualContourOutput* output = getOutput();
+      for (vtkIdType ii = begin; ii < end; ++ii)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockIds[ii]);
+        this->ProcessBlock(block, blockIds[ii], arrayNameToProcess, output);
+      }
+    };
+#if VTK_SIZEOF_ID_TYPE == 8
+    vtkSMPTools::For(0, static_cast<vtkIdType>(blockIds.size()), 1, processRange);
+#else
+    processRange(0, static_cast<vtkIdType>(blockIds.size()));
+#endif
+  };
 
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
 
-  // Add each block.
+  // Add each block.  Levels are processed in order because locators are only
+  // shared with blocks of the same or higher levels.
   for (int level = 0; level < numLevels; ++level)
   {
-    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    std::vector<std::vector<int>> groups;
+    if (this->EnableMergePoints)
+    { // Neighbors share locators, they are processed in different groups.
+      this->Helper->GetIndependentBlockGroups(level, groups);
+    }
+    else
+    {
+      groups.resize(1);
+      int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (int blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        if (this->Helper->GetBlock(level, blockId)->Image)
+        {
+          groups[0].push_back(blockId);
+        }
+      }
+    }
+
+    // Blocks waiting for remote ghost values are processed last.
+    std::vector<std::vector<int>> waitingGroups(groups.size());
+    if (!setupFinished)
+    {
+      for (size_t ii = 0; ii < groups.size(); ++ii)
+      {
+        std::vector<int> readyGroup;
+        for (int blockId : groups[ii])
+        {
+          if (this->Helper->IsBlockWaitingForRemoteRegions(this->Helper->GetBlock(level, blockId)))
+          {
+            waitingGroups[ii].push_back(blockId);
+          }
+          else
+          {
+            readyGroup.push_back(blockId);
+          }
+        }
+        groups[ii].swap(readyGroup);
+      }
+    }
+
+    for (const auto& group : groups)
     {
-      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      processBlocks(level, group);
+    }
+    for (const auto& group : waitingGroups)
+    {
+      if (group.empty())
+      {
+        continue;
+      }
+      if (!setupFinished)
+      {
+        this->Helper->FinishSetupData();
+        setupFinished = true;
+      }
+      processBlocks(level, group);
     }
   }
 
-  this->FinalizeCopyAttributes(this->Mesh);
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
+  if (!setupFinished)
+  {
+    this->Helper->FinishSetupData();
+  }
 
-  this->Mesh->Delete();
-  this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Faces->Delete();
-  this->Faces = nullptr;
+  if (outputs.empty())
+  { // No local blocks.
+    getOutput();
+  }
+  vtkSmartPointer<vtkPolyData> mesh = vtkAMRDualContourAppendOutputs(outputs);
+  this->FinalizeCopyAttributes(mesh);
+  mpds->SetPiece(0, mesh);
 
   mpds->Delete();
 
@@ -884,8 +1082,8 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+void vtkAMRDualContour::ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId,
+  const char* arrayNameToProcess, vtkAMRDualContourOutput* output)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
@@ -916,17 +1114,18 @@ void vtkAMRDualContour::ProcessBlock(
   // Input the dimensions of the dual cells with ghosts.
   if (this->EnableMergePoints)
   {
-    this->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
+    output->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
   }
   else
   { // Shared locator.
-    if (this->BlockLocator == nullptr)
+    if (!output->ReusedLocator)
     {
-      this->BlockLocator = new vtkAMRDualContourEdgeLocator;
+      output->ReusedLocator.reset(new vtkAMRDualContourEdgeLocator);
     }
-    this->BlockLocator->Initialize(
+    output->BlockLocator = output->ReusedLocator.get();
+    output->BlockLocator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    this->BlockLocator->CopyRegionLevelDifferences(block);
+    output->BlockLocator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -1007,7 +1206,8 @@ void vtkAMRDualContour::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + 1 + yInc + zInc;
           cornerOffsets[7] = xOffset + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(
+            block, blockId, x, y, z, cornerOffsets, volumeFractionArray, output);
         }
         xOffset += 1; // xInc
       }
@@ -1021,8 +1221,8 @@ void vtkAMRDualContour::ProcessBlock(
     // Copy point ids into neighbor locators.
     this->ShareBlockLocatorWithNeighbors(block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
+    delete output->BlockLocator;
+    output->BlockLocator = nullptr;
     block->UserData = nullptr;
     // Lets use this unused flag (owner of center region/block) to indicate
     // that the block is already processes.
@@ -1092,7 +1292,8 @@ static int vtkAMRDualLegacyIdToBitIdMap[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
 // a fast path for internal cells (with no degeneracies).
 // Corner offsets are absolute (relative to origin / 0).
 void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray,
+  vtkAMRDualContourOutput* output)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1329,7 +1530,7 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     // Only permanently keep locator for edges shared between two blocks.
     for (int ii = 0; ii < 3; ++ii, ++edge) // insert triangle
     {
-      vtkIdType* ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, *edge);
+      vtkIdType* ptIdPtr = output->BlockLocator->GetEdgePointer(x, y, z, *edge);
 
       if (*ptIdPtr == -1)
       {
@@ -1357,31 +1558,32 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
           cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
+        vtkIdType localId;
+        *ptIdPtr = output->InsertNextPoint(pt, localId);
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
         vtkIdType offset1 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][1]];
-        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, *ptIdPtr);
+        this->InterpolateAttributes(block->Image, offset0, offset1, k, output->Mesh, localId);
       }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr;
     }
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[1] != pointIds[2])
     {
-      this->Faces->InsertNextCell(3, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      output->InsertNextCell(3, pointIds, blockId);
     }
   }
 
   if (this->EnableCapping)
   {
     this->CapCell(x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, cornerOffsets,
-      blockId, block->Image);
+      blockId, block->Image, output);
   }
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId)
+void vtkAMRDualContour::AddCapPolygon(
+  int ptCount, vtkIdType* pointIds, int blockId, vtkAMRDualContourOutput* output)
 {
   if (this->TriangulateCap)
   {
@@ -1397,8 +1599,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->InsertNextCell(3, tri, blockId);
         }
       }
       else
@@ -1408,16 +1609,14 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->InsertNextCell(3, tri, blockId);
         }
         tri[0] = pointIds[high];
         tri[1] = pointIds[high + 1];
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->InsertNextCell(3, tri, blockId);
         }
       }
       ++low;
@@ -1427,8 +1626,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
   else
   {
     // Do not worry about degenerate polygons in this path.
-    this->Faces->InsertNextCell(ptCount, pointIds);
-    this->BlockIdCellArray->InsertNextValue(blockId);
+    output->InsertNextCell(ptCount, pointIds, blockId);
   }
 }
 
@@ -1455,8 +1653,11 @@ void vtkAMRDualContour::CapCell(
   // For block id array (for debugging).  I should just make this an ivar.
   int blockId,
   // For passing attributes to output mesh
-  vtkDataSet* inData)
+  vtkDataSet* inData,
+  // Piece of the surface generated by the calling thread.
+  vtkAMRDualContourOutput* output)
 {
+  vtkIdType localId;
   int cornerIdx;
   vtkIdType* ptIdPtr;
   vtkIdType pointIds[6];
@@ -1474,12 +1675,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = output->InsertNextPoint(cornerPoints + (cornerIdx << 2), localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1489,7 +1690,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1510,12 +1711,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = output->InsertNextPoint(cornerPoints + (cornerIdx << 2), localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1525,7 +1726,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1547,12 +1748,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = output->InsertNextPoint(cornerPoints + (cornerIdx << 2), localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1562,7 +1763,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1584,12 +1785,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = output->InsertNextPoint(cornerPoints + (cornerIdx << 2), localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1599,7 +1800,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1620,12 +1821,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = output->InsertNextPoint(cornerPoints + (cornerIdx << 2), localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1635,7 +1836,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1657,12 +1858,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = output->InsertNextPoint(cornerPoints + (cornerIdx << 2), localId);
             this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1672,7 +1873,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -21,6 +21,10 @@
  * a particle index as part of the cell data of the output.  It computes
  * the volume of each particle from the volume fraction.
  *
+ * Blocks that are not neighbors are processed concurrently using vtkSMPTools,
+ * each thread generating its own piece of the surface. The pieces are appended
+ * once all blocks are processed. Concurrent processing requires 64 bit ids.
+ *
  * This will turn on validation and debug i/o of the filter.
  * \code{.cpp}
  * #define vtkAMRDualContourDEBUG
@@ -52,6 +56,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourOutput;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
 {
@@ -152,12 +157,14 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName,
+    vtkAMRDualContourOutput* output);
 
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray,
+    vtkAMRDualContourOutput* output);
 
-  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId);
+  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId, vtkAMRDualContourOutput* output);
 
   // This method is getting too many arguments!
   // Capping was an after thought...
@@ -177,17 +184,15 @@ protected:
     // For block id array (for debugging).  I should just make this an ivar.
     int blockId,
     // For passing attributes to output mesh
-    vtkDataSet* inData);
+    vtkDataSet* inData,
+    // Piece of the surface generated by the calling thread.
+    vtkAMRDualContourOutput* output);
 
   // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
   vtkFloatArray* TemperatureArray;
 
   // Ivars used to reduce method parrameters.
   vtkAMRDualGridHelper* Helper;
-  vtkPolyData* Mesh;
-  vtkPoints* Points;
-  vtkCellArray* Faces;
 
   vtkMultiProcessController* Controller;
 
@@ -196,8 +201,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualContourEdgeLocator* BlockLocator;
-
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
@@ -33,7 +33,9 @@
 #include "vtkSmartPointer.h"
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
+#include <algorithm>
 #include <list>
+#include <utility>
 #include <vector>
 
 #include "vtksys/SystemTools.hxx"
@@ -719,6 +721,9 @@ vtkAMRDualGridHelper::vtkAMRDualGridHelper()
   this->ArrayName = nullptr;
   this->EnableDegenerateCells = 1;
   this->EnableAsynchronousCommunication = 1;
+  this->PendingSendList = nullptr;
+  this->PendingReceiveList = nullptr;
+  this->PendingHackLevelFlag = false;
   this->NumberOfBlocksInThisProcess = 0;
   for (ii = 0; ii < 3; ++ii)
   {
@@ -743,6 +748,9 @@ vtkAMRDualGridHelper::~vtkAMRDualGridHelper()
   int ii;
   int numberOfLevels = (int)(this->Levels.size());
 
+  // Do not leave requests behind.
+  this->FinishRegionRemoteCopyQueue();
+
   this->SetArrayName(nullptr);
 
   for (ii = 0; ii < numberOfLevels; ++ii)
@@ -1947,6 +1955,16 @@ void vtkAMRDualGridHelper::UnmarshalDegenerateRegionMessage(const void* messageP
 // step of initialization.
 void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueue(bool hackLevelFlag)
 {
+  this->BeginRegionRemoteCopyQueue(hackLevelFlag);
+  this->FinishRegionRemoteCopyQueue();
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::BeginRegionRemoteCopyQueue(bool hackLevelFlag)
+{
+  // Only one queue can be in flight.
+  this->FinishRegionRemoteCopyQueue();
+
   if (this->SkipGhostCopy)
   {
     return;
@@ -1955,7 +1973,7 @@ void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueue(bool hackLevelFlag)
 #ifdef VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
   if (this->EnableAsynchronousCommunication && this->Controller->IsA("vtkMPIController"))
   {
-    this->ProcessRegionRemoteCopyQueueMPIAsynchronous(hackLevelFlag);
+    this->StartRegionRemoteCopyQueueMPIAsynchronous(hackLevelFlag);
     return;
   }
 #endif // VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
@@ -1963,6 +1981,31 @@ void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueue(bool hackLevelFlag)
   this->ProcessRegionRemoteCopyQueueSynchronous(hackLevelFlag);
 }
 
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::FinishRegionRemoteCopyQueue()
+{
+#ifdef VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+  if (this->PendingReceiveList)
+  {
+    vtkTimerLogSmartMarkEvent markevent("FinishRegionRemoteCopyQueueMPIAsynchronous");
+    this->FinishDegenerateRegionsCommMPIAsynchronous(
+      this->PendingHackLevelFlag, *this->PendingSendList, *this->PendingReceiveList);
+    delete this->PendingSendList;
+    this->PendingSendList = nullptr;
+    delete this->PendingReceiveList;
+    this->PendingReceiveList = nullptr;
+  }
+#endif // VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
+  this->BlocksWaitingForRemoteRegions.clear();
+}
+
+//----------------------------------------------------------------------------
+bool vtkAMRDualGridHelper::IsBlockWaitingForRemoteRegions(vtkAMRDualGridHelperBlock* block)
+{
+  return std::binary_search(
+    this->BlocksWaitingForRemoteRegions.begin(), this->BlocksWaitingForRemoteRegions.end(), block);
+}
+
 void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueueSynchronous(bool hackLevelFlag)
 {
   vtkTimerLogSmartMarkEvent markevent("ProcessRegionRemoteCopyQueueSynchronous", this->Controller);
@@ -2080,10 +2123,12 @@ void vtkAMRDualGridHelper::ReceiveDegenerateRegionsFromQueueSynchronous(
 #ifdef VTK_AMR_DUAL_GRID_USE_MPI_ASYNCHRONOUS
 
 //-----------------------------------------------------------------------------
-void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueueMPIAsynchronous(bool hackLevelFlag)
+// Posts the communication of the queue, FinishRegionRemoteCopyQueue()
+// completes it.
+void vtkAMRDualGridHelper::StartRegionRemoteCopyQueueMPIAsynchronous(bool hackLevelFlag)
 {
   vtkTimerLogSmartMarkEvent markevent(
-    "ProcessRegionRemoteCopyQueueMPIAsynchronous", this->Controller);
+    "StartRegionRemoteCopyQueueMPIAsynchronous", this->Controller);
 
   vtkMPIController* controller = vtkMPIController::SafeDownCast(this->Controller);
   if (!controller)
@@ -2097,8 +2142,25 @@ void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueueMPIAsynchronous(bool hack
   int numProcs = controller->GetNumberOfProcesses();
   int myProc = controller->GetLocalProcessId();
 
-  vtkAMRDualGridHelperCommRequestList sendList;
-  vtkAMRDualGridHelperCommRequestList receiveList;
+  this->PendingSendList = new vtkAMRDualGridHelperCommRequestList;
+  this->PendingReceiveList = new vtkAMRDualGridHelperCommRequestList;
+  this->PendingHackLevelFlag = hackLevelFlag;
+  vtkAMRDualGridHelperCommRequestList& sendList = *this->PendingSendList;
+  vtkAMRDualGridHelperCommRequestList& receiveList = *this->PendingReceiveList;
+
+  // Local blocks cannot be used until their remote regions are received.
+  for (const auto& region : this->DegenerateRegionQueue)
+  {
+    if (region.ReceivingBlock->ProcessId == myProc && region.SourceBlock->ProcessId != myProc)
+    {
+      this->BlocksWaitingForRemoteRegions.push_back(region.ReceivingBlock);
+    }
+  }
+  std::sort(
+    this->BlocksWaitingForRemoteRegions.begin(), this->BlocksWaitingForRemoteRegions.end());
+  this->BlocksWaitingForRemoteRegions.erase(std::unique(this->BlocksWaitingForRemoteRegions.begin(),
+                                              this->BlocksWaitingForRemoteRegions.end()),
+    this->BlocksWaitingForRemoteRegions.end());
 
   VTK_CREATE(vtkIdTypeArray, srcProcs);
   srcProcs->SetNumberOfValues(numProcs);
@@ -2140,8 +2202,8 @@ void vtkAMRDualGridHelper::ProcessRegionRemoteCopyQueueMPIAsynchronous(bool hack
     }
   }
 
-  // Finally, finish all communications as they come in.
-  this->FinishDegenerateRegionsCommMPIAsynchronous(hackLevelFlag, sendList, receiveList);
+  // FinishRegionRemoteCopyQueue() will finish all communications as they
+  // come in.
 }
 
 void vtkAMRDualGridHelper::ReceiveDegenerateRegionsFromQueueMPIAsynchronous(
@@ -2329,6 +2391,14 @@ int vtkAMRDualGridHelper::Initialize(vtkNonOverlappingAMR* input)
 }
 
 int vtkAMRDualGridHelper::SetupData(vtkNonOverlappingAMR* input, const char* arrayName)
+{
+  int retVal = this->BeginSetupData(input, arrayName);
+  this->FinishSetupData();
+  return retVal;
+}
+
+//----------------------------------------------------------------------------
+int vtkAMRDualGridHelper::BeginSetupData(vtkNonOverlappingAMR* input, const char* arrayName)
 {
   vtkTimerLogSmartMarkEvent markevent("vtkAMRDualGridHelper::SetupData", this->Controller);
 
@@ -2378,13 +2448,50 @@ int vtkAMRDualGridHelper::SetupData(vtkNonOverlappingAMR* input, const char* arr
   this->AssignSharedRegions();
 
   // Copy regions on level boundaries between processes.
-  this->ProcessRegionRemoteCopyQueue(false);
+  this->BeginRegionRemoteCopyQueue(false);
 
   // Setup faces for seeding connectivity between blocks.
   // this->CreateFaces();
 
   return VTK_OK;
 }
+
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::FinishSetupData()
+{
+  this->FinishRegionRemoteCopyQueue();
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::GetIndependentBlockGroups(
+  int level, std::vector<std::vector<int>>& groups)
+{
+  // Blocks of a level whose grid indices have the same parities are at least
+  // two blocks apart along one axis. They are neither neighbors nor share
+  // neighbors in the same region since blocks have at least two cells.
+  std::vector<std::vector<int>> parityGroups(8);
+  int numBlocks = this->GetNumberOfBlocksInLevel(level);
+  for (int blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+  {
+    vtkAMRDualGridHelperBlock* block = this->GetBlock(level, blockIdx);
+    if (block->Image == nullptr)
+    { // Remote blocks are not processed.
+      continue;
+    }
+    int parity = (block->GridIndex[0] & 1) | ((block->GridIndex[1] & 1) << 1) |
+      ((block->GridIndex[2] & 1) << 2);
+    parityGroups[parity].push_back(blockIdx);
+  }
+
+  groups.clear();
+  for (auto& group : parityGroups)
+  {
+    if (!group.empty())
+    {
+      groups.push_back(std::move(group));
+    }
+  }
+}
 void vtkAMRDualGridHelper::ClearRegionRemoteCopyQueue()
 {
   this->DegenerateRegionQueue.clear();
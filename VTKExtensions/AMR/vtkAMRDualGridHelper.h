@@ -96,6 +96,28 @@ public:
 
   int Initialize(vtkNonOverlappingAMR* input);
   int SetupData(vtkNonOverlappingAMR* input, const char* arrayName);
+
+  //@{
+  /**
+   * Same as SetupData() but, when asynchronous communication is used, it does
+   * not wait for the ghost values sent by other processes. Local blocks for
+   * which IsBlockWaitingForRemoteRegions() returns false can be processed
+   * before FinishSetupData() is called, which overlaps the communication with
+   * local work. FinishSetupData() must be called on every process.
+   */
+  int BeginSetupData(vtkNonOverlappingAMR* input, const char* arrayName);
+  void FinishSetupData();
+  bool IsBlockWaitingForRemoteRegions(vtkAMRDualGridHelperBlock* block);
+  //@}
+
+  /**
+   * Splits the local blocks of a level into groups in which no two blocks are
+   * neighbors. Blocks of a group can be processed concurrently, even by
+   * filters that share point locators with the neighbors of a block. Groups
+   * hold block indices to use with GetBlock(level, blockIdx).
+   */
+  void GetIndependentBlockGroups(int level, std::vector<std::vector<int>>& groups);
+
   const double* GetGlobalOrigin() { return this->GlobalOrigin; }
   const double* GetRootSpacing() { return this->RootSpacing; }
   int GetNumberOfBlocks() { return this->NumberOfBlocksInThisProcess; }
@@ -197,8 +219,13 @@ private:
   void ReceiveDegenerateRegionsFromQueueSynchronous(
     int srcProc, vtkIdType messageLength, bool hackLevelFlag);
 
+  // Starts processing the queue, FinishRegionRemoteCopyQueue() completes
+  // the asynchronous communication if any.
+  void BeginRegionRemoteCopyQueue(bool hackLevelFlag);
+  void FinishRegionRemoteCopyQueue();
+
   // NOTE: These methods are NOT DEFINED if not compiled with MPI.
-  void ProcessRegionRemoteCopyQueueMPIAsynchronous(bool hackLevelFlag);
+  void StartRegionRemoteCopyQueueMPIAsynchronous(bool hackLevelFlag);
   void SendDegenerateRegionsFromQueueMPIAsynchronous(
     int recvProc, vtkIdType messageLength, vtkAMRDualGridHelperCommRequestList& sendList);
   void ReceiveDegenerateRegionsFromQueueMPIAsynchronous(
@@ -219,6 +246,13 @@ private:
   void UnmarshalDegenerateRegionMessage(
     const void* messagePtr, int messageLength, int srcProc, bool hackLevelFlag);
 
+  // Asynchronous communication of degenerate regions still in flight.
+  vtkAMRDualGridHelperCommRequestList* PendingSendList;
+  vtkAMRDualGridHelperCommRequestList* PendingReceiveList;
+  bool PendingHackLevelFlag;
+  // Sorted local blocks receiving degenerate regions still in flight.
+  std::vector<vtkAMRDualGridHelperBlock*> BlocksWaitingForRemoteRegions;
+
   int SkipGhostCopy;
 
   int EnableAsynchronousCommunication;
@@ -0,0 +1,115 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCellLocatorCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPVCellLocatorCache shares locators while they are in use and
+// rebuilds them once their dataset is modified.
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCellType.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVCellLocatorCache.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+// A unit hexahedron.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid()
+{
+  vtkNew<vtkPoints> points;
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    const int x = (cc == 1 || cc == 2 || cc == 5 || cc == 6) ? 1 : 0;
+    const int y = (cc == 2 || cc == 3 || cc == 6 || cc == 7) ? 1 : 0;
+    points->InsertNextPoint(x, y, cc / 4);
+  }
+  const vtkIdType ids[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+  return grid;
+}
+
+bool Locates(vtkAbstractCellLocator* locator)
+{
+  double center[3] = { 0.5, 0.5, 0.5 };
+  return locator && locator->FindCell(center) == 0;
+}
+}
+
+int TestCellLocatorCache(int, char*[])
+{
+  auto cache = vtkPVCellLocatorCache::GetInstance();
+  cache->Clear();
+
+  // locators are shared while in use, until their dataset is modified.
+  auto grid = MakeGrid();
+  auto locator = cache->GetCellLocator(grid);
+  if (!Locates(locator) || cache->GetCellLocator(grid) != locator)
+  {
+    vtkLogF(ERROR, "Locator not shared while in use.");
+    return EXIT_FAILURE;
+  }
+  grid->Modified();
+  auto rebuilt = cache->GetCellLocator(grid);
+  if (rebuilt == locator || !Locates(rebuilt))
+  {
+    vtkLogF(ERROR, "Locator not rebuilt after the dataset was modified.");
+    return EXIT_FAILURE;
+  }
+
+  // the cache does not keep locators, nor their datasets, alive.
+  locator = nullptr;
+  rebuilt = nullptr;
+  if (cache->GetNumberOfLocators() != 0 || grid->GetReferenceCount() != 1)
+  {
+    vtkLogF(ERROR, "Unused locators kept alive: %d locators, %d references to the dataset.",
+      cache->GetNumberOfLocators(), grid->GetReferenceCount());
+    return EXIT_FAILURE;
+  }
+
+  // a locator in use owns its dataset.
+  locator = cache->GetCellLocator(grid);
+  grid = nullptr;
+  if (!Locates(locator) || locator->GetDataSet() == nullptr)
+  {
+    vtkLogF(ERROR, "Locator unusable once its dataset was released by its owner.");
+    return EXIT_FAILURE;
+  }
+  locator = nullptr;
+
+  // locators for distinct datasets are distinct, and no longer shared once
+  // the cache is cleared.
+  auto first = MakeGrid();
+  auto second = MakeGrid();
+  auto firstLocator = cache->GetCellLocator(first);
+  auto secondLocator = cache->GetCellLocator(second);
+  if (firstLocator == secondLocator || cache->GetNumberOfLocators() != 2)
+  {
+    vtkLogF(ERROR, "Expected a locator per dataset.");
+    return EXIT_FAILURE;
+  }
+  cache->Clear();
+  if (cache->GetNumberOfLocators() != 0 || cache->GetCellLocator(first) == firstLocator ||
+    !Locates(secondLocator))
+  {
+    vtkLogF(ERROR, "Locators still shared after clearing the cache.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestDistributedUnionFind.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include <vtkDistributedUnionFind.h>
+#include <vtkLogger.h>
+#include <vtkMPIController.h>
+#include <vtkNew.h>
+#include <vtkTimerLog.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NumberOfClasses = 7;
+
+bool TestSparse()
+{
+  vtkDistributedUnionFind unionFind;
+  unionFind.Initialize();
+  unionFind.AddEquivalence(100, 5);
+  unionFind.AddEquivalence(5, 3000);
+  unionFind.AddEquivalence(42, 41);
+  if (unionFind.GetMinimumId(3000) != 5 || unionFind.GetMinimumId(100) != 5 ||
+    unionFind.GetMinimumId(42) != 41 || unionFind.GetMinimumId(7) != -1)
+  {
+    vtkLogF(ERROR, "incorrect sparse equivalences");
+    return false;
+  }
+  return true;
+}
+
+// Ids equal modulo NumberOfClasses are made equivalent through chains that
+// cross all processes, using all the ways equivalences can be added.
+bool TestDistributed(vtkMultiProcessController* controller, vtkIdType numberOfLocalIds)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  vtkDistributedUnionFind unionFind;
+  unionFind.Initialize(controller, numberOfLocalIds);
+  const vtkIdType begin = unionFind.GetGlobalOffset();
+  const vtkIdType total = unionFind.GetNumberOfGlobalIds();
+  if (total != numberOfLocalIds * numRanks || begin != numberOfLocalIds * rank)
+  {
+    vtkLogF(ERROR, "incorrect global id ranges");
+    return false;
+  }
+
+  // Equivalences crossing to the next process are added by the previous
+  // process for one id out of three, so that some equivalences are between
+  // ids owned by neither.
+  auto addedByPrevious = [&](vtkIdType id, vtkIdType next) {
+    return id % 3 == 0 && next / numberOfLocalIds != id / numberOfLocalIds;
+  };
+  for (vtkIdType id = begin; id < begin + numberOfLocalIds; ++id)
+  {
+    const vtkIdType next = id + NumberOfClasses;
+    if (next >= total || addedByPrevious(id, next))
+    {
+      continue;
+    }
+    if (id % 2 == 0)
+    {
+      unionFind.AddEquivalence(id, next);
+    }
+    else
+    {
+      unionFind.AddEquivalence(next, id);
+    }
+  }
+  const vtkIdType nextBegin = ((rank + 1) % numRanks) * numberOfLocalIds;
+  for (vtkIdType id = nextBegin; id < nextBegin + numberOfLocalIds; ++id)
+  {
+    const vtkIdType next = id + NumberOfClasses;
+    if (next < total && addedByPrevious(id, next))
+    {
+      unionFind.AddEquivalence(id, next);
+    }
+  }
+
+  // equivalences outside of the global range are ignored.
+  const auto verbosity = vtkLogger::GetCurrentVerbosityCutoff();
+  vtkLogger::SetStderrVerbosity(vtkLogger::VERBOSITY_OFF);
+  unionFind.AddEquivalence(begin, total + rank);
+  unionFind.AddEquivalence(total, begin);
+  vtkLogger::SetStderrVerbosity(static_cast<vtkLogger::Verbosity>(verbosity));
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  const vtkIdType numberOfSets = unionFind.Resolve();
+  timer->StopTimer();
+  if (rank == 0)
+  {
+    vtkLogF(INFO, "resolved %lld ids over %d processes in %d rounds: %fs",
+      static_cast<long long>(total), numRanks, unionFind.GetNumberOfRounds(),
+      timer->GetElapsedTime());
+  }
+
+  if (numberOfSets != std::min(total, NumberOfClasses))
+  {
+    vtkLogF(ERROR, "incorrect number of sets %lld", static_cast<long long>(numberOfSets));
+    return false;
+  }
+  for (vtkIdType id = begin; id < begin + numberOfLocalIds; ++id)
+  {
+    if (unionFind.GetSetId(id) != id % NumberOfClasses)
+    {
+      vtkLogF(ERROR, "incorrect set id for %lld", static_cast<long long>(id));
+      return false;
+    }
+  }
+
+  // Query a few ids owned by the next process.
+  std::vector<vtkIdType> remoteIds;
+  for (vtkIdType cc = 0; cc < std::min<vtkIdType>(numberOfLocalIds, 10); ++cc)
+  {
+    remoteIds.push_back(nextBegin + cc);
+  }
+  const auto setIds = unionFind.GetSetIds(remoteIds);
+  for (size_t cc = 0; cc < remoteIds.size(); ++cc)
+  {
+    if (setIds[cc] != remoteIds[cc] % NumberOfClasses)
+    {
+      vtkLogF(ERROR, "incorrect remote set id for %lld", static_cast<long long>(remoteIds[cc]));
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+// Also used as a scaling benchmark: `--ids <number of ids per process>`.
+int TestDistributedUnionFind(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  vtkIdType numberOfLocalIds = 1000;
+  for (int cc = 1; cc + 1 < argc; ++cc)
+  {
+    if (strcmp(argv[cc], "--ids") == 0)
+    {
+      numberOfLocalIds = static_cast<vtkIdType>(std::atoll(argv[cc + 1]));
+    }
+  }
+
+  int success = TestSparse() && TestDistributed(contr, numberOfLocalIds) ? 1 : 0;
+
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMemoryBudgetParallel.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include <vtkElevationFilter.h>
+#include <vtkInformation.h>
+#include <vtkLogger.h>
+#include <vtkMPIController.h>
+#include <vtkNew.h>
+#include <vtkPVCompositeDataPipeline.h>
+#include <vtkPointSource.h>
+#include <vtkPolyData.h>
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NumberOfPoints = 200000;
+
+vtkPVCompositeDataPipeline* GetExecutive(vtkAlgorithm* algorithm)
+{
+  return vtkPVCompositeDataPipeline::SafeDownCast(algorithm->GetExecutive());
+}
+
+// Only the first process has data, so it alone is over the budget. All
+// processes must still release the outputs of the same algorithms, and
+// produce them again together.
+bool TestImbalanced(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+
+  vtkNew<vtkPointSource> source;
+  source->SetNumberOfPoints(rank == 0 ? NumberOfPoints : 0);
+  std::vector<vtkAlgorithm*> algorithms{ source.Get() };
+  vtkNew<vtkElevationFilter> filters[3];
+  for (auto& filter : filters)
+  {
+    filter->SetInputConnection(algorithms.back()->GetOutputPort());
+    algorithms.push_back(filter.Get());
+  }
+  for (size_t cc = 0; cc < algorithms.size(); ++cc)
+  {
+    algorithms[cc]->SetExecutive(vtkNew<vtkPVCompositeDataPipeline>());
+    algorithms[cc]->GetInformation()->Set(
+      vtkPVCompositeDataPipeline::GLOBAL_ID(), static_cast<int>(cc + 1));
+  }
+
+  vtkPVCompositeDataPipeline::ResetMemoryBudgetStatistics();
+  vtkPVCompositeDataPipeline::SetMemoryBudget(1);
+  vtkAlgorithm* leaf = algorithms.back();
+  leaf->Update();
+  vtkPVCompositeDataPipeline::EnforceMemoryBudget(GetExecutive(leaf));
+
+  std::vector<int> released;
+  for (auto algorithm : algorithms)
+  {
+    released.push_back(GetExecutive(algorithm)->GetOutputsReleased() ? 1 : 0);
+  }
+  std::vector<int> minReleased(released.size());
+  std::vector<int> maxReleased(released.size());
+  controller->AllReduce(released.data(), minReleased.data(),
+    static_cast<vtkIdType>(released.size()), vtkCommunicator::MIN_OP);
+  controller->AllReduce(released.data(), maxReleased.data(),
+    static_cast<vtkIdType>(released.size()), vtkCommunicator::MAX_OP);
+  if (minReleased != maxReleased)
+  {
+    vtkLogF(ERROR, "processes released the outputs of different algorithms");
+    return false;
+  }
+  if (released.back() != 0)
+  {
+    vtkLogF(ERROR, "the output of the leaf was released");
+    return false;
+  }
+  if (released.front() == 0 || vtkPVCompositeDataPipeline::GetNumberOfReleasedOutputs() == 0)
+  {
+    vtkLogF(ERROR, "no output was released");
+    return false;
+  }
+
+  // an algorithm whose outputs were released executes again when updated.
+  GetExecutive(source)->Update(0);
+  auto output = vtkPolyData::SafeDownCast(source->GetOutputDataObject(0));
+  if (GetExecutive(source)->GetOutputsReleased() ||
+    vtkPVCompositeDataPipeline::GetNumberOfReexecutions() == 0 || !output ||
+    output->GetNumberOfPoints() != (rank == 0 ? NumberOfPoints : 0))
+  {
+    vtkLogF(ERROR, "released outputs were not produced again");
+    return false;
+  }
+
+  vtkPVCompositeDataPipeline::SetMemoryBudget(0);
+  return true;
+}
+}
+
+int TestMemoryBudgetParallel(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int success = TestImbalanced(contr) ? 1 : 0;
+
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,94 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestTraceEventLog.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include <vtkLogger.h>
+#include <vtkPVLogger.h>
+#include <vtkPVTraceEventLog.h>
+
+#include <string>
+#include <thread>
+
+namespace
+{
+int Count(const std::string& events, const std::string& pattern)
+{
+  int count = 0;
+  for (size_t pos = events.find(pattern); pos != std::string::npos;
+       pos = events.find(pattern, pos + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+
+void LogScopes(int count)
+{
+  for (int cc = 0; cc < count; ++cc)
+  {
+    vtkVLogScopeF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "scope-%d", cc);
+    vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "message");
+  }
+}
+}
+
+int TestTraceEventLog(int, char*[])
+{
+  vtkPVTraceEventLog::SetRecording(true);
+  std::thread worker(LogScopes, 10);
+  LogScopes(10);
+  worker.join();
+  vtkPVTraceEventLog::SetRecording(false);
+  // not recorded.
+  LogScopes(10);
+
+  std::string events = vtkPVTraceEventLog::GetEvents();
+  if (Count(events, R"("ph":"B")") != 20 || Count(events, R"("ph":"E")") != 20 ||
+    Count(events, R"("ph":"i")") != 20 || Count(events, R"("name":"thread_name")") != 2)
+  {
+    cerr << "ERROR: unexpected events:" << endl << events << endl;
+    return EXIT_FAILURE;
+  }
+
+  // buffers only keep the most recent events.
+  vtkPVTraceEventLog::SetBufferSize(6);
+  vtkPVTraceEventLog::ClearEvents();
+  vtkPVTraceEventLog::SetRecording(true);
+  LogScopes(10);
+  vtkPVTraceEventLog::SetRecording(false);
+  events = vtkPVTraceEventLog::GetEvents();
+  if (Count(events, R"("ph":"B")") != 2 || Count(events, R"("name":"scope-9")") != 1 ||
+    Count(events, R"("name":"scope-7")") != 0)
+  {
+    cerr << "ERROR: unexpected events after wrapping:" << endl << events << endl;
+    return EXIT_FAILURE;
+  }
+
+  // processes are identified by role and rank, not by OS pid.
+  vtkPVTraceEventLog::SetProcessRole(3);
+  events = vtkPVTraceEventLog::GetEvents();
+  if (Count(events, R"("pid":4000000,)") != Count(events, R"("pid":)") ||
+    Count(events, R"("os_pid":)") != 1)
+  {
+    cerr << "ERROR: unexpected process ids:" << endl << events << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkPVTraceEventLog::ClearEvents();
+  if (!vtkPVTraceEventLog::GetEvents().empty())
+  {
+    cerr << "ERROR: events were not cleared." << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,597 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDistributedUnionFind.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDistributedUnionFind.h"
+
+#include "vtkLogger.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessControllerHelper.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+// Tags used by the exchanges, each exchange uses two consecutive tags.
+constexpr int ROUTE_EDGES_TAG = 802450;
+constexpr int PROPAGATE_TAG = 802452;
+constexpr int QUERY_TAG = 802454;
+constexpr int REPLY_TAG = 802456;
+
+using BufferMap = std::map<int, std::vector<vtkIdType>>;
+}
+
+class vtkDistributedUnionFind::vtkInternals
+{
+public:
+  vtkMultiProcessController* Controller = nullptr;
+  int Rank = 0;
+  int NumberOfRanks = 1;
+  bool Sparse = false;
+  bool Resolved = false;
+  int NumberOfRounds = 0;
+
+  // Offsets[r] is the first global id owned by rank r. It has one more entry
+  // than the number of ranks holding the total number of ids.
+  std::vector<vtkIdType> Offsets = { 0, 0 };
+
+  // Parent of each owned id, indexed by local id, or by id when sparse.
+  std::vector<vtkIdType> Parents;
+  std::unordered_map<vtkIdType, vtkIdType> SparseParents;
+
+  // Equivalences (owned id, global id) where the second id is not owned.
+  std::vector<std::pair<vtkIdType, vtkIdType>> RemoteEquivalences;
+
+  // Set id of each owned id, filled by Resolve().
+  std::vector<vtkIdType> SetIds;
+
+  vtkIdType Begin() const { return this->Offsets[this->Rank]; }
+  vtkIdType End() const { return this->Offsets[this->Rank + 1]; }
+  bool IsOwned(vtkIdType id) const
+  {
+    return this->Sparse || (id >= this->Begin() && id < this->End());
+  }
+
+  int GetOwner(vtkIdType id) const
+  {
+    // upper_bound finds the first rank starting after id.
+    auto iter = std::upper_bound(this->Offsets.begin(), this->Offsets.end() - 1, id);
+    return static_cast<int>(iter - this->Offsets.begin()) - 1;
+  }
+
+  vtkIdType& Parent(vtkIdType id)
+  {
+    if (this->Sparse)
+    {
+      auto iter = this->SparseParents.find(id);
+      if (iter == this->SparseParents.end())
+      {
+        iter = this->SparseParents.emplace(id, id).first;
+      }
+      return iter->second;
+    }
+    return this->Parents[id - this->Begin()];
+  }
+
+  // Returns the smallest id of the set, compressing the path on the way.
+  vtkIdType Find(vtkIdType id)
+  {
+    vtkIdType root = id;
+    while (this->Parent(root) != root)
+    {
+      root = this->Parent(root);
+    }
+    while (id != root)
+    {
+      vtkIdType& parent = this->Parent(id);
+      id = parent;
+      parent = root;
+    }
+    return root;
+  }
+
+  void Union(vtkIdType id1, vtkIdType id2)
+  {
+    const vtkIdType root1 = this->Find(id1);
+    const vtkIdType root2 = this->Find(id2);
+    if (root1 < root2)
+    {
+      this->Parent(root2) = root1;
+    }
+    else if (root2 < root1)
+    {
+      this->Parent(root1) = root2;
+    }
+  }
+
+  void Exchange(const BufferMap& send, BufferMap& receive, int tag)
+  {
+    vtkMultiProcessControllerHelper::ExchangeSparse(this->Controller, send, receive, tag);
+  }
+
+  // Exchange between processes that know they share equivalences, with no
+  // collective operation.
+  void Exchange(
+    const std::vector<int>& neighbors, const BufferMap& send, BufferMap& receive, int tag)
+  {
+    vtkMultiProcessControllerHelper::ExchangeWithNeighbors(
+      this->Controller, neighbors, send, receive, tag);
+  }
+
+  // Reduces a single flag, which is the only collective operation of each
+  // propagation round once the neighbors are known.
+  bool AnyTrue(bool value)
+  {
+    if (this->NumberOfRanks <= 1)
+    {
+      return value;
+    }
+    int local = value ? 1 : 0;
+    int global = 0;
+    this->Controller->AllReduce(&local, &global, 1, vtkCommunicator::MAX_OP);
+    return global != 0;
+  }
+};
+
+//----------------------------------------------------------------------------
+vtkDistributedUnionFind::vtkDistributedUnionFind()
+  : Internals(new vtkDistributedUnionFind::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDistributedUnionFind::~vtkDistributedUnionFind() = default;
+
+//----------------------------------------------------------------------------
+void vtkDistributedUnionFind::Initialize()
+{
+  this->Internals.reset(new vtkDistributedUnionFind::vtkInternals());
+  this->Internals->Sparse = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkDistributedUnionFind::Initialize(
+  vtkMultiProcessController* controller, vtkIdType numberOfLocalIds)
+{
+  this->Internals.reset(new vtkDistributedUnionFind::vtkInternals());
+  auto& internals = *this->Internals;
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    internals.Controller = controller;
+    internals.Rank = controller->GetLocalProcessId();
+    internals.NumberOfRanks = controller->GetNumberOfProcesses();
+  }
+
+  std::vector<vtkIdType> counts(internals.NumberOfRanks, numberOfLocalIds);
+  if (internals.NumberOfRanks > 1)
+  {
+    controller->AllGather(&numberOfLocalIds, counts.data(), 1);
+  }
+  internals.Offsets.assign(internals.NumberOfRanks + 1, 0);
+  for (int cc = 0; cc < internals.NumberOfRanks; ++cc)
+  {
+    internals.Offsets[cc + 1] = internals.Offsets[cc] + counts[cc];
+  }
+
+  internals.Parents.resize(numberOfLocalIds);
+  for (vtkIdType cc = 0; cc < numberOfLocalIds; ++cc)
+  {
+    internals.Parents[cc] = internals.Begin() + cc;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDistributedUnionFind::GetGlobalOffset() const
+{
+  return this->Internals->Begin();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDistributedUnionFind::GetGlobalOffset(int rank) const
+{
+  return this->Internals->Offsets[rank];
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDistributedUnionFind::GetNumberOfLocalIds() const
+{
+  return this->GetNumberOfLocalIds(this->Internals->Rank);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDistributedUnionFind::GetNumberOfLocalIds(int rank) const
+{
+  return this->Internals->Offsets[rank + 1] - this->Internals->Offsets[rank];
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDistributedUnionFind::GetNumberOfGlobalIds() const
+{
+  return this->Internals->Offsets.back();
+}
+
+//----------------------------------------------------------------------------
+int vtkDistributedUnionFind::GetOwner(vtkIdType globalId) const
+{
+  return this->Internals->GetOwner(globalId);
+}
+
+//----------------------------------------------------------------------------
+void vtkDistributedUnionFind::AddEquivalence(vtkIdType id1, vtkIdType id2)
+{
+  auto& internals = *this->Internals;
+  if (internals.Resolved)
+  {
+    vtkLogF(ERROR, "Set already resolved, you cannot add more equivalences.");
+    return;
+  }
+  if (id1 < 0 || id2 < 0)
+  {
+    return;
+  }
+  if (!internals.Sparse &&
+    (id1 >= this->GetNumberOfGlobalIds() || id2 >= this->GetNumberOfGlobalIds()))
+  {
+    vtkLogF(ERROR, "Equivalence (%lld, %lld) is outside of the %lld global ids, ignoring.",
+      static_cast<long long>(id1), static_cast<long long>(id2),
+      static_cast<long long>(this->GetNumberOfGlobalIds()));
+    return;
+  }
+
+  const bool owned1 = internals.IsOwned(id1);
+  const bool owned2 = internals.IsOwned(id2);
+  if (id1 == id2 && !owned1)
+  {
+    return;
+  }
+  if (owned1 && owned2)
+  {
+    internals.Union(id1, id2);
+  }
+  else if (owned2)
+  {
+    internals.RemoteEquivalences.emplace_back(id2, id1);
+  }
+  else
+  {
+    // When neither id is owned, the equivalence is forwarded to the owner of
+    // the first one by Resolve().
+    internals.RemoteEquivalences.emplace_back(id1, id2);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDistributedUnionFind::GetMinimumId(vtkIdType id)
+{
+  auto& internals = *this->Internals;
+  if (internals.Sparse)
+  {
+    return internals.SparseParents.find(id) != internals.SparseParents.end() ? internals.Find(id)
+                                                                               : -1;
+  }
+  return internals.IsOwned(id) ? internals.Find(id) : -1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDistributedUnionFind::Resolve()
+{
+  auto& internals = *this->Internals;
+  if (internals.Sparse)
+  {
+    vtkLogF(ERROR, "Resolve() is not supported on sparse sets.");
+    return 0;
+  }
+
+  const vtkIdType begin = internals.Begin();
+  const vtkIdType numberOfLocalIds = internals.End() - begin;
+
+  // 1. Forward equivalences between ids we do not own to the owner of the
+  //    first id, so that each remote equivalence has an owned first id.
+  std::vector<std::pair<vtkIdType, vtkIdType>> crossEdges;
+  {
+    BufferMap send;
+    for (const auto& edge : internals.RemoteEquivalences)
+    {
+      if (internals.IsOwned(edge.first))
+      {
+        crossEdges.push_back(edge);
+      }
+      else
+      {
+        auto& buffer = send[internals.GetOwner(edge.first)];
+        buffer.push_back(edge.first);
+        buffer.push_back(edge.second);
+      }
+    }
+    decltype(internals.RemoteEquivalences)().swap(internals.RemoteEquivalences);
+
+    BufferMap received;
+    internals.Exchange(send, received, ROUTE_EDGES_TAG);
+    for (const auto& item : received)
+    {
+      const auto& buffer = item.second;
+      for (size_t cc = 0; cc + 1 < buffer.size(); cc += 2)
+      {
+        if (internals.IsOwned(buffer[cc + 1]))
+        {
+          internals.Union(buffer[cc], buffer[cc + 1]);
+        }
+        else
+        {
+          crossEdges.emplace_back(buffer[cc], buffer[cc + 1]);
+        }
+      }
+    }
+  }
+
+  // 2. No more local equivalences: flatten the local forest and express the
+  //    cross-process equivalences between local roots and remote ids.
+  for (vtkIdType cc = 0; cc < numberOfLocalIds; ++cc)
+  {
+    internals.Find(begin + cc);
+  }
+  for (auto& edge : crossEdges)
+  {
+    edge.first = internals.Parent(edge.first);
+  }
+
+  // Label of each local root: the smallest global id known to be in its set.
+  std::vector<vtkIdType> labels(numberOfLocalIds);
+  for (vtkIdType cc = 0; cc < numberOfLocalIds; ++cc)
+  {
+    labels[cc] = begin + cc;
+  }
+
+  // 3. Propagate labels along cross-process equivalences until no label
+  //    changes. Each message is (remote id, sender root, label); the receiver
+  //    records the reverse equivalence so that labels flow both ways.
+  //    The first round uses a sparse exchange, whose sources are unknown.
+  //    Afterwards, equivalences are known on both sides and each process only
+  //    talks to the owners of the ids it shares equivalences with.
+  std::vector<char> changed(numberOfLocalIds, 1);
+  std::vector<int> neighbors;
+  internals.NumberOfRounds = 0;
+  bool first = true;
+  while (true)
+  {
+    std::sort(crossEdges.begin(), crossEdges.end());
+    crossEdges.erase(std::unique(crossEdges.begin(), crossEdges.end()), crossEdges.end());
+
+    BufferMap send;
+    for (const auto& edge : crossEdges)
+    {
+      const vtkIdType rootIndex = edge.first - begin;
+      if (changed[rootIndex])
+      {
+        auto& buffer = send[internals.GetOwner(edge.second)];
+        buffer.push_back(edge.second);
+        buffer.push_back(edge.first);
+        buffer.push_back(labels[rootIndex]);
+      }
+    }
+    std::fill(changed.begin(), changed.end(), 0);
+
+    BufferMap received;
+    if (first)
+    {
+      internals.Exchange(send, received, PROPAGATE_TAG);
+    }
+    else
+    {
+      internals.Exchange(neighbors, send, received, PROPAGATE_TAG);
+    }
+    bool anyChanged = false;
+    for (const auto& item : received)
+    {
+      const auto& buffer = item.second;
+      for (size_t cc = 0; cc + 2 < buffer.size(); cc += 3)
+      {
+        const vtkIdType root = internals.Parent(buffer[cc]);
+        if (first)
+        {
+          crossEdges.emplace_back(root, buffer[cc + 1]);
+        }
+        const vtkIdType rootIndex = root - begin;
+        if (buffer[cc + 2] < labels[rootIndex])
+        {
+          labels[rootIndex] = buffer[cc + 2];
+          changed[rootIndex] = 1;
+          anyChanged = true;
+        }
+      }
+    }
+    ++internals.NumberOfRounds;
+
+    // After the first round, the reverse equivalences are known and every
+    // label must be sent once through them.
+    if (first)
+    {
+      first = false;
+      std::fill(changed.begin(), changed.end(), 1);
+      anyChanged = !crossEdges.empty();
+      for (const auto& edge : crossEdges)
+      {
+        neighbors.push_back(internals.GetOwner(edge.second));
+      }
+      std::sort(neighbors.begin(), neighbors.end());
+      neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+    if (!internals.AnyTrue(anyChanged))
+    {
+      break;
+    }
+  }
+  decltype(crossEdges)().swap(crossEdges);
+
+  // 4. Sets are numbered in the order of their smallest member. The roots
+  //    whose label is themselves hold the smallest member of their set.
+  std::vector<vtkIdType> setIds(numberOfLocalIds, -1);
+  vtkIdType numberOfLocalSets = 0;
+  for (vtkIdType cc = 0; cc < numberOfLocalIds; ++cc)
+  {
+    if (labels[cc] == begin + cc && internals.Parents[cc] == begin + cc)
+    {
+      setIds[cc] = numberOfLocalSets++;
+    }
+  }
+  std::vector<vtkIdType> numberOfSets(internals.NumberOfRanks, numberOfLocalSets);
+  if (internals.NumberOfRanks > 1)
+  {
+    internals.Controller->AllGather(&numberOfLocalSets, numberOfSets.data(), 1);
+  }
+  vtkIdType firstSetId = 0;
+  vtkIdType totalNumberOfSets = 0;
+  for (int cc = 0; cc < internals.NumberOfRanks; ++cc)
+  {
+    if (cc < internals.Rank)
+    {
+      firstSetId += numberOfSets[cc];
+    }
+    totalNumberOfSets += numberOfSets[cc];
+  }
+  for (auto& setId : setIds)
+  {
+    setId = setId >= 0 ? setId + firstSetId : -1;
+  }
+
+  // 5. Roots whose smallest member is owned by another process ask it for
+  //    the set id.
+  {
+    BufferMap queries;
+    for (vtkIdType cc = 0; cc < numberOfLocalIds; ++cc)
+    {
+      if (internals.Parents[cc] == begin + cc && !internals.IsOwned(labels[cc]))
+      {
+        queries[internals.GetOwner(labels[cc])].push_back(labels[cc]);
+      }
+    }
+    for (auto& item : queries)
+    {
+      std::sort(item.second.begin(), item.second.end());
+      item.second.erase(std::unique(item.second.begin(), item.second.end()), item.second.end());
+    }
+
+    BufferMap receivedQueries;
+    internals.Exchange(queries, receivedQueries, QUERY_TAG);
+    BufferMap replies;
+    for (const auto& item : receivedQueries)
+    {
+      auto& reply = replies[item.first];
+      reply.reserve(item.second.size());
+      for (const vtkIdType id : item.second)
+      {
+        reply.push_back(setIds[id - begin]);
+      }
+    }
+    BufferMap receivedReplies;
+    internals.Exchange(replies, receivedReplies, REPLY_TAG);
+
+    std::unordered_map<vtkIdType, vtkIdType> remoteSetIds;
+    for (const auto& item : queries)
+    {
+      const auto& reply = receivedReplies[item.first];
+      assert(reply.size() == item.second.size());
+      for (size_t cc = 0; cc < item.second.size(); ++cc)
+      {
+        remoteSetIds[item.second[cc]] = reply[cc];
+      }
+    }
+
+    for (vtkIdType cc = 0; cc < numberOfLocalIds; ++cc)
+    {
+      if (internals.Parents[cc] == begin + cc && setIds[cc] < 0)
+      {
+        setIds[cc] = internals.IsOwned(labels[cc]) ? setIds[labels[cc] - begin]
+                                                    : remoteSetIds[labels[cc]];
+      }
+    }
+  }
+
+  // Finally, non-root ids take the set id of their root.
+  for (vtkIdType cc = 0; cc < numberOfLocalIds; ++cc)
+  {
+    setIds[cc] = setIds[internals.Parents[cc] - begin];
+  }
+  internals.SetIds = std::move(setIds);
+  internals.Resolved = true;
+  return totalNumberOfSets;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkDistributedUnionFind::GetSetId(vtkIdType globalId) const
+{
+  const auto& internals = *this->Internals;
+  if (!internals.Resolved || !internals.IsOwned(globalId))
+  {
+    return -1;
+  }
+  return internals.SetIds[globalId - internals.Begin()];
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkIdType> vtkDistributedUnionFind::GetSetIds(const std::vector<vtkIdType>& globalIds)
+{
+  auto& internals = *this->Internals;
+  std::vector<vtkIdType> result(globalIds.size(), -1);
+
+  BufferMap queries;
+  for (size_t cc = 0; cc < globalIds.size(); ++cc)
+  {
+    if (internals.IsOwned(globalIds[cc]))
+    {
+      result[cc] = this->GetSetId(globalIds[cc]);
+    }
+    else if (globalIds[cc] >= 0 && globalIds[cc] < this->GetNumberOfGlobalIds())
+    {
+      queries[internals.GetOwner(globalIds[cc])].push_back(globalIds[cc]);
+    }
+  }
+
+  BufferMap receivedQueries;
+  internals.Exchange(queries, receivedQueries, QUERY_TAG);
+  BufferMap replies;
+  for (const auto& item : receivedQueries)
+  {
+    auto& reply = replies[item.first];
+    reply.reserve(item.second.size());
+    for (const vtkIdType id : item.second)
+    {
+      reply.push_back(this->GetSetId(id));
+    }
+  }
+  BufferMap receivedReplies;
+  internals.Exchange(replies, receivedReplies, REPLY_TAG);
+
+  // Replies come in the order of the queries.
+  std::map<int, size_t> next;
+  for (size_t cc = 0; cc < globalIds.size(); ++cc)
+  {
+    if (!internals.IsOwned(globalIds[cc]) && globalIds[cc] >= 0 &&
+      globalIds[cc] < this->GetNumberOfGlobalIds())
+    {
+      const int owner = internals.GetOwner(globalIds[cc]);
+      result[cc] = receivedReplies[owner][next[owner]++];
+    }
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkDistributedUnionFind::GetNumberOfRounds() const
+{
+  return this->Internals->NumberOfRounds;
+}
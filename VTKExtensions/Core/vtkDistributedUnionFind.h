@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDistributedUnionFind.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDistributedUnionFind
+ * @brief   disjoint-set forest whose members are spread across processes.
+ *
+ * vtkDistributedUnionFind records equivalences between integer ids and
+ * resolves them into sequential set ids. It is used to merge fragments that
+ * were identified independently by several processes or passes.
+ *
+ * After `Initialize(controller, numberOfLocalIds)`, each process owns a
+ * contiguous range of global ids, ranges being assigned in rank order.
+ * Equivalences between owned ids are resolved locally, using path compression
+ * and making the smallest id the representative of its set. Equivalences
+ * involving ids owned by other processes are resolved by `Resolve()` which
+ * propagates the smallest member of each set across processes. Only processes
+ * sharing equivalences exchange messages and no process ever holds more than
+ * its own ids and the equivalences it knows about.
+ *
+ * After `Initialize()`, all ids are local and can be any non-negative value.
+ * This is useful to track equivalences between sparse ids on a single
+ * process; `Resolve()` is not supported in that case.
+ *
+ * @sa vtkEquivalenceSet
+ */
+
+#ifndef vtkDistributedUnionFind_h
+#define vtkDistributedUnionFind_h
+
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+#include "vtkType.h"                      // needed for vtkIdType
+
+#include <memory> // needed for std::unique_ptr
+#include <vector> // needed for std::vector
+
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkDistributedUnionFind
+{
+public:
+  vtkDistributedUnionFind();
+  ~vtkDistributedUnionFind();
+
+  /**
+   * Initializes the structure for ids owned by this process only. Ids can be
+   * any non-negative value.
+   */
+  void Initialize();
+
+  /**
+   * Initializes the structure for `numberOfLocalIds` ids owned by this
+   * process. This is a collective operation over the controller's processes;
+   * the controller may be nullptr when running on a single process.
+   */
+  void Initialize(vtkMultiProcessController* controller, vtkIdType numberOfLocalIds);
+
+  //@{
+  /**
+   * Ownership of the global ids. `GetGlobalOffset()` is the first global id
+   * owned by this process.
+   */
+  vtkIdType GetGlobalOffset() const;
+  vtkIdType GetGlobalOffset(int rank) const;
+  vtkIdType GetNumberOfLocalIds() const;
+  vtkIdType GetNumberOfLocalIds(int rank) const;
+  vtkIdType GetNumberOfGlobalIds() const;
+  int GetOwner(vtkIdType globalId) const;
+  //@}
+
+  /**
+   * Makes two ids equivalent. Equivalences involving ids owned by other
+   * processes are only resolved by `Resolve()`. Negative ids are ignored, as
+   * are ids beyond the global range, which are reported as errors.
+   */
+  void AddEquivalence(vtkIdType id1, vtkIdType id2);
+
+  /**
+   * Returns the smallest id known to be equivalent to the given owned id,
+   * considering local equivalences only. Returns -1 for ids that are not owned
+   * or, after `Initialize()`, that were never part of an equivalence.
+   */
+  vtkIdType GetMinimumId(vtkIdType id);
+
+  /**
+   * Resolves all equivalences across processes and assigns sequential set ids
+   * ordered by the smallest member of each set. Returns the total number of
+   * sets. This is a collective operation.
+   */
+  vtkIdType Resolve();
+
+  /**
+   * Returns the set id of an owned id. Only valid after `Resolve()`.
+   */
+  vtkIdType GetSetId(vtkIdType globalId) const;
+
+  /**
+   * Returns the set ids of arbitrary global ids, querying the processes that
+   * own them. Only valid after `Resolve()`. This is a collective operation;
+   * processes that have nothing to query pass an empty vector.
+   */
+  std::vector<vtkIdType> GetSetIds(const std::vector<vtkIdType>& globalIds);
+
+  /**
+   * Number of label propagation rounds needed by the last `Resolve()`.
+   */
+  int GetNumberOfRounds() const;
+
+private:
+  vtkDistributedUnionFind(const vtkDistributedUnionFind&) = delete;
+  void operator=(const vtkDistributedUnionFind&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkDistributedUnionFind.h
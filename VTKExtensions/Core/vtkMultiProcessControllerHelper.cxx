@@ -32,8 +32,147 @@
 #include "vtkTrivialProducer.h"
 #include "vtkUnstructuredGrid.h"
 
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+#include "vtkMPIController.h"
+#endif
+
+#include <array>
+#include <map>
+#include <utility>
 #include <vector>
 
+namespace
+{
+// Size of the messages exchanged with each partner process, as
+// rank: (send size, receive size).
+using PartnerMap = std::map<int, std::pair<vtkIdType, vtkIdType>>;
+
+// Tells partners the size of the message they are going to receive. With MPI
+// controllers, the announcements are sent without blocking. Other controllers
+// connect two processes through sockets, which buffer these small messages.
+class SizeAnnouncements
+{
+public:
+  void Send(vtkMultiProcessController* controller, const PartnerMap& partners, int tag)
+  {
+    const int myRank = controller->GetLocalProcessId();
+    this->Headers.reserve(partners.size());
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+    auto mpiController = vtkMPIController::SafeDownCast(controller);
+#endif
+    for (const auto& partner : partners)
+    {
+      this->Headers.push_back({ { myRank, partner.second.first } });
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+      if (mpiController)
+      {
+        this->Requests.emplace_back();
+        mpiController->NoBlockSend(
+          this->Headers.back().data(), 2, partner.first, tag, this->Requests.back());
+        continue;
+      }
+#endif
+      controller->Send(this->Headers.back().data(), 2, partner.first, tag);
+    }
+  }
+
+  void Wait()
+  {
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+    for (auto& request : this->Requests)
+    {
+      request.Wait();
+    }
+#endif
+  }
+
+private:
+  std::vector<std::array<vtkIdType, 2>> Headers;
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  std::vector<vtkMPICommunicator::Request> Requests;
+#endif
+};
+
+// Exchanges values with partners once the sizes of the messages are known.
+void ExchangeValues(vtkMultiProcessController* controller, const PartnerMap& partners,
+  const std::map<int, std::vector<vtkIdType>>& sendBuffers,
+  std::map<int, std::vector<vtkIdType>>& receiveBuffers, int tag)
+{
+  const int myRank = controller->GetLocalProcessId();
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  if (auto mpiController = vtkMPIController::SafeDownCast(controller))
+  {
+    // Post all receives, then all sends, and wait for both, so that messages
+    // of any size cannot deadlock.
+    std::vector<vtkMPICommunicator::Request> requests;
+    requests.reserve(2 * partners.size());
+    for (const auto& partner : partners)
+    {
+      const vtkIdType receiveSize = partner.second.second;
+      if (receiveSize > 0)
+      {
+        auto& buffer = receiveBuffers[partner.first];
+        buffer.resize(receiveSize);
+        requests.emplace_back();
+        mpiController->NoBlockReceive(
+          buffer.data(), receiveSize, partner.first, tag, requests.back());
+      }
+    }
+    for (const auto& partner : partners)
+    {
+      const vtkIdType sendSize = partner.second.first;
+      if (sendSize > 0)
+      {
+        requests.emplace_back();
+        mpiController->NoBlockSend(
+          sendBuffers.at(partner.first).data(), sendSize, partner.first, tag, requests.back());
+      }
+    }
+    for (auto& request : requests)
+    {
+      request.Wait();
+    }
+    return;
+  }
+#endif
+
+  // Other controllers have no non-blocking communication. Values are
+  // exchanged pair-wise, in increasing rank order, the lower rank of each pair
+  // sending first. Since all processes visit their partners in the same
+  // order, this cannot deadlock.
+  for (const auto& partner : partners)
+  {
+    const int rank = partner.first;
+    const vtkIdType sendSize = partner.second.first;
+    const vtkIdType receiveSize = partner.second.second;
+    auto send = [&]() {
+      if (sendSize > 0)
+      {
+        controller->Send(sendBuffers.at(rank).data(), sendSize, rank, tag);
+      }
+    };
+    auto receive = [&]() {
+      if (receiveSize > 0)
+      {
+        auto& buffer = receiveBuffers[rank];
+        buffer.resize(receiveSize);
+        controller->Receive(buffer.data(), receiveSize, rank, tag);
+      }
+    };
+    if (myRank < rank)
+    {
+      send();
+      receive();
+    }
+    else
+    {
+      receive();
+      send();
+    }
+  }
+}
+}
+
 vtkStandardNewMacro(vtkMultiProcessControllerHelper);
 //----------------------------------------------------------------------------
 vtkMultiProcessControllerHelper::vtkMultiProcessControllerHelper() = default;
@@ -81,6 +220,99 @@ int vtkMultiProcessControllerHelper::ReduceToAll(vtkMultiProcessController* cont
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkMultiProcessControllerHelper::ExchangeSparse(vtkMultiProcessController* controller,
+  const std::map<int, std::vector<vtkIdType>>& sendBuffers,
+  std::map<int, std::vector<vtkIdType>>& receiveBuffers, int tag)
+{
+  receiveBuffers.clear();
+  const int numProcs = controller ? controller->GetNumberOfProcesses() : 1;
+  const int myRank = controller ? controller->GetLocalProcessId() : 0;
+
+  // Values sent to ourselves are simply copied.
+  auto selfIter = sendBuffers.find(myRank);
+  if (selfIter != sendBuffers.end() && !selfIter->second.empty())
+  {
+    receiveBuffers[myRank] = selfIter->second;
+  }
+  if (numProcs <= 1)
+  {
+    return;
+  }
+
+  // Count the messages each process is going to receive. The reduced vector
+  // has one entry per process, only ours is used.
+  std::vector<int> isDestination(numProcs, 0);
+  PartnerMap partners;
+  for (const auto& item : sendBuffers)
+  {
+    if (item.first != myRank && !item.second.empty())
+    {
+      isDestination[item.first] = 1;
+      partners[item.first].first = static_cast<vtkIdType>(item.second.size());
+    }
+  }
+  std::vector<int> numberOfSources(numProcs, 0);
+  controller->AllReduce(
+    isDestination.data(), numberOfSources.data(), numProcs, vtkCommunicator::SUM_OP);
+
+  // The sources are only known once their announcements are received.
+  SizeAnnouncements announcements;
+  announcements.Send(controller, partners, tag);
+  for (int cc = 0; cc < numberOfSources[myRank]; ++cc)
+  {
+    vtkIdType header[2];
+    controller->Receive(header, 2, vtkMultiProcessController::ANY_SOURCE, tag);
+    partners[static_cast<int>(header[0])].second = header[1];
+  }
+  ::ExchangeValues(controller, partners, sendBuffers, receiveBuffers, tag + 1);
+  announcements.Wait();
+}
+
+//----------------------------------------------------------------------------
+void vtkMultiProcessControllerHelper::ExchangeWithNeighbors(
+  vtkMultiProcessController* controller, const std::vector<int>& neighbors,
+  const std::map<int, std::vector<vtkIdType>>& sendBuffers,
+  std::map<int, std::vector<vtkIdType>>& receiveBuffers, int tag)
+{
+  receiveBuffers.clear();
+  const int myRank = controller ? controller->GetLocalProcessId() : 0;
+
+  auto selfIter = sendBuffers.find(myRank);
+  if (selfIter != sendBuffers.end() && !selfIter->second.empty())
+  {
+    receiveBuffers[myRank] = selfIter->second;
+  }
+
+  // Every neighbor is told the size of our message, even when empty, so
+  // each process knows how many announcements it receives.
+  PartnerMap partners;
+  for (const int neighbor : neighbors)
+  {
+    if (neighbor != myRank)
+    {
+      auto iter = sendBuffers.find(neighbor);
+      partners[neighbor].first =
+        iter != sendBuffers.end() ? static_cast<vtkIdType>(iter->second.size()) : 0;
+    }
+  }
+  if (partners.empty())
+  {
+    return;
+  }
+
+  SizeAnnouncements announcements;
+  announcements.Send(controller, partners, tag);
+  for (auto& partner : partners)
+  {
+    vtkIdType header[2];
+    controller->Receive(header, 2, partner.first, tag);
+    partner.second.second = header[1];
+  }
+  ::ExchangeValues(controller, partners, sendBuffers, receiveBuffers, tag + 1);
+  announcements.Wait();
+}
+
 //-----------------------------------------------------------------------------
 vtkDataObject* vtkMultiProcessControllerHelper::MergePieces(
   vtkDataObject** pieces, unsigned int num_pieces)
@@ -28,6 +28,7 @@
 #include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
 #include "vtkSmartPointer.h"              // needed for vtkSmartPointer.
 
+#include <map>    // needed for std::map
 #include <vector> // needed for std::vector
 
 class vtkDataObject;
@@ -63,6 +64,32 @@ public:
   static bool MergePieces(
     std::vector<vtkSmartPointer<vtkDataObject>>& pieces, vtkDataObject* result);
 
+  /**
+   * Sparse all-to-all exchange. `sendBuffers` maps destination ranks to the
+   * values to send to them. On return, `receiveBuffers` maps source ranks to
+   * the values received from them. Apart from a sum reduction, over all
+   * processes, of a vector holding one flag per process that tells each
+   * process how many messages it receives, only processes exchanging values
+   * communicate. With MPI controllers, receives are posted before the
+   * non-blocking sends so that messages of any size cannot deadlock. This is a
+   * collective operation; `tag` and `tag + 1` are used for the messages.
+   */
+  static void ExchangeSparse(vtkMultiProcessController* controller,
+    const std::map<int, std::vector<vtkIdType>>& sendBuffers,
+    std::map<int, std::vector<vtkIdType>>& receiveBuffers, int tag);
+
+  /**
+   * Same as `ExchangeSparse()` between processes that already know which
+   * processes they exchange values with, avoiding any collective operation.
+   * Each process announces the size of its message, possibly empty, to each of
+   * its `neighbors` and receives one announcement from each of them, so the
+   * neighbor relation must be symmetric. `tag` and `tag + 1` are used for the
+   * messages.
+   */
+  static void ExchangeWithNeighbors(vtkMultiProcessController* controller,
+    const std::vector<int>& neighbors, const std::map<int, std::vector<vtkIdType>>& sendBuffers,
+    std::map<int, std::vector<vtkIdType>>& receiveBuffers, int tag);
+
 protected:
   vtkMultiProcessControllerHelper();
   ~vtkMultiProcessControllerHelper() override;
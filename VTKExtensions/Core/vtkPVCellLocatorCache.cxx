@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVCellLocatorCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVCellLocatorCache.h"
+
+#include "vtkLogger.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkWeakPointer.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+class vtkPVCellLocatorCache::vtkInternals
+{
+public:
+  // Entries expire when the locator is no longer used. A locator owns its
+  // dataset, hence the dataset of a live entry is alive too.
+  struct Entry
+  {
+    vtkWeakPointer<vtkStaticCellLocator> Locator;
+    vtkMTimeType MTime;
+  };
+
+  std::mutex Mutex;
+  std::vector<Entry> Entries;
+
+  // Drops the entries whose locator was deleted. Must be called with the
+  // mutex locked.
+  void Purge()
+  {
+    this->Entries.erase(std::remove_if(this->Entries.begin(), this->Entries.end(),
+                          [](const Entry& entry) { return entry.Locator == nullptr; }),
+      this->Entries.end());
+  }
+};
+
+vtkStandardNewMacro(vtkPVCellLocatorCache);
+//----------------------------------------------------------------------------
+vtkPVCellLocatorCache::vtkPVCellLocatorCache()
+  : Internals(new vtkPVCellLocatorCache::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVCellLocatorCache::~vtkPVCellLocatorCache() = default;
+
+//----------------------------------------------------------------------------
+vtkPVCellLocatorCache* vtkPVCellLocatorCache::GetInstance()
+{
+  static auto Singleton = vtk::TakeSmartPointer(vtkPVCellLocatorCache::New());
+  return Singleton.GetPointer();
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkAbstractCellLocator> vtkPVCellLocatorCache::GetCellLocator(
+  vtkDataSet* dataset)
+{
+  if (vtkPointSet::SafeDownCast(dataset) == nullptr || dataset->GetNumberOfCells() == 0)
+  {
+    return nullptr;
+  }
+
+  auto& internals = (*this->Internals);
+  const vtkMTimeType mtime = dataset->GetMTime();
+  {
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    internals.Purge();
+    for (const auto& entry : internals.Entries)
+    {
+      if (entry.Locator->GetDataSet() == dataset && entry.MTime == mtime)
+      {
+        return entry.Locator.GetPointer();
+      }
+    }
+  }
+
+  // built without the lock, so that other datasets can be looked up
+  // meanwhile.
+  vtkLogScopeF(TRACE, "build cell locator for %s (%lld cells)", dataset->GetClassName(),
+    static_cast<long long>(dataset->GetNumberOfCells()));
+  auto locator = vtkSmartPointer<vtkStaticCellLocator>::New();
+  locator->SetDataSet(dataset);
+  locator->BuildLocator();
+
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  internals.Entries.push_back(vtkInternals::Entry{ locator, mtime });
+  return locator;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVCellLocatorCache::GetNumberOfLocators()
+{
+  auto& internals = (*this->Internals);
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  internals.Purge();
+  return static_cast<int>(internals.Entries.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCellLocatorCache::Clear()
+{
+  auto& internals = (*this->Internals);
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  internals.Entries.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCellLocatorCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfLocators: " << this->GetNumberOfLocators() << endl;
+}
@@ -0,0 +1,88 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVCellLocatorCache.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkPVCellLocatorCache
+ * @brief cache of cell locators shared by probing filters
+ *
+ * vtkPVCellLocatorCache is a singleton that keeps cell locators built for
+ * datasets, so that filters probing the same dataset, or the same filter
+ * executing again with a different probe location, do not rebuild them.
+ * Locators are `vtkStaticCellLocator` instances, which are built using
+ * multiple threads.
+ *
+ * Locators are looked up by dataset and are rebuilt when the dataset has
+ * been modified. The cache only references locators weakly: a locator is
+ * shared as long as some user holds it, and owns its dataset meanwhile. Users
+ * that want a locator to be reused by their next execution hence keep it
+ * until then, e.g. vtkHybridProbeFilter keeps those of its last execution.
+ *
+ * Locators are only built for point sets since other datasets can locate
+ * cells without one.
+ */
+
+#ifndef vtkPVCellLocatorCache_h
+#define vtkPVCellLocatorCache_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+#include "vtkSmartPointer.h"              // for vtkSmartPointer
+
+#include <memory> // for std::unique_ptr
+
+class vtkAbstractCellLocator;
+class vtkDataSet;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVCellLocatorCache : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkPVCellLocatorCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Provides access to the singleton.
+   */
+  static vtkPVCellLocatorCache* GetInstance();
+
+  /**
+   * Returns a cell locator built for `dataset`, building it if needed.
+   * Returns nullptr if `dataset` is not a point set or has no cells.
+   * This method can be called from multiple threads.
+   */
+  vtkSmartPointer<vtkAbstractCellLocator> GetCellLocator(vtkDataSet* dataset);
+
+  /**
+   * Returns the number of locators currently in use.
+   */
+  int GetNumberOfLocators();
+
+  /**
+   * Stops sharing the locators currently in use.
+   */
+  void Clear();
+
+protected:
+  vtkPVCellLocatorCache();
+  ~vtkPVCellLocatorCache() override;
+
+private:
+  vtkPVCellLocatorCache(const vtkPVCellLocatorCache&) = delete;
+  void operator=(const vtkPVCellLocatorCache&) = delete;
+  static vtkPVCellLocatorCache* New();
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
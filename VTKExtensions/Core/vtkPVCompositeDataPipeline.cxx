@@ -18,21 +18,134 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkAlgorithmOutput.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
+#include "vtkInformationExecutivePortVectorKey.h"
+#include "vtkInformationIntegerKey.h"
 #include "vtkInformationIntegerVectorKey.h"
 #include "vtkInformationKey.h"
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilterExecutive.h"
 
+#include <vtksys/SystemInformation.hxx>
+
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace
+{
+std::atomic<bool> MemoryTracking{ false };
+
+struct MemorySample
+{
+  vtkTypeInt64 Resident = 0;       // KiB
+  vtkTypeInt64 HighWaterMark = -1; // KiB, -1 when not available.
+};
+
+MemorySample SampleMemory()
+{
+  MemorySample sample;
+#if defined(__linux__)
+  // a single read of /proc/self/status provides both the resident memory and
+  // its high water mark.
+  if (FILE* file = std::fopen("/proc/self/status", "r"))
+  {
+    char line[256];
+    long long value;
+    while (std::fgets(line, sizeof(line), file))
+    {
+      if (std::sscanf(line, "VmRSS: %lld", &value) == 1)
+      {
+        sample.Resident = value;
+      }
+      else if (std::sscanf(line, "VmHWM: %lld", &value) == 1)
+      {
+        sample.HighWaterMark = value;
+      }
+    }
+    std::fclose(file);
+    return sample;
+  }
+#endif
+  sample.Resident = vtksys::SystemInformation().GetProcMemoryUsed();
+  return sample;
+}
+
+// Highest resident memory observed by each execution in progress on this
+// thread, innermost last. Lets an execution account for the peaks of the
+// executions nested in it, e.g. of internal pipelines.
+thread_local std::vector<vtkTypeInt64> ObservedPeaks;
+
+// Depth of REQUEST_DATA requests in progress on this thread. The budget is
+// only enforced once the outermost one completes, when no consumer is left
+// between updating its inputs and executing.
+thread_local int UpdateDepth = 0;
+
+// Clock ordering the uses of the outputs, for the least recently used policy.
+std::atomic<vtkTypeUInt64> UseClock{ 0 };
+
+struct MemoryBudgetState
+{
+  std::mutex Mutex;
+  std::set<vtkPVCompositeDataPipeline*> Executives;
+  std::atomic<int> Budget{ 0 }; // MiB
+  vtkTypeInt64 BudgetedMemorySize = 0;
+  vtkTypeInt64 MaximumBudgetedMemorySize = 0;
+  int NumberOfReleasedOutputs = 0;
+  vtkTypeInt64 ReleasedMemorySize = 0;
+  std::atomic<int> NumberOfReexecutions{ 0 };
+};
+
+MemoryBudgetState& GetBudgetState()
+{
+  static MemoryBudgetState state;
+  return state;
+}
+
+vtkMultiProcessController* GetParallelController()
+{
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  return controller && controller->GetNumberOfProcesses() > 1 ? controller : nullptr;
+}
+
+// Returns the executive of the algorithm producing the input of a post
+// filter, or nullptr if `executive` is not a post filter. Post filters are
+// released and accounted for along with that algorithm.
+vtkPVCompositeDataPipeline* GetPostFilterProducer(vtkExecutive* executive)
+{
+  auto postFilter = vtkPVPostFilterExecutive::SafeDownCast(executive);
+  return postFilter && postFilter->GetNumberOfInputConnections(0) > 0
+    ? vtkPVCompositeDataPipeline::SafeDownCast(postFilter->GetInputExecutive(0, 0))
+    : nullptr;
+}
+}
 
 vtkStandardNewMacro(vtkPVCompositeDataPipeline);
+vtkInformationKeyMacro(vtkPVCompositeDataPipeline, RETAIN_INPUTS, Integer);
+vtkInformationKeyMacro(vtkPVCompositeDataPipeline, GLOBAL_ID, Integer);
 //----------------------------------------------------------------------------
-vtkPVCompositeDataPipeline::vtkPVCompositeDataPipeline() = default;
+vtkPVCompositeDataPipeline::vtkPVCompositeDataPipeline()
+{
+  auto& state = ::GetBudgetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.Executives.insert(this);
+}
 
 //----------------------------------------------------------------------------
-vtkPVCompositeDataPipeline::~vtkPVCompositeDataPipeline() = default;
+vtkPVCompositeDataPipeline::~vtkPVCompositeDataPipeline()
+{
+  auto& state = ::GetBudgetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.Executives.erase(this);
+}
 
 //----------------------------------------------------------------------------
 void vtkPVCompositeDataPipeline::CopyDefaultInformation(vtkInformation* request, int direction,
@@ -84,8 +197,422 @@ void vtkPVCompositeDataPipeline::ResetPipelineInformation(int port, vtkInformati
   this->Superclass::ResetPipelineInformation(port, info);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::SetMemoryTracking(bool value)
+{
+  ::MemoryTracking = value;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVCompositeDataPipeline::GetMemoryTracking()
+{
+  return ::MemoryTracking;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::ResetMemoryStatistics()
+{
+  this->LastExecutionMemoryIncrease = 0;
+  this->LastExecutionPeakMemoryIncrease = 0;
+  this->MaximumPeakMemoryIncrease = 0;
+  this->NumberOfExecutions = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeBool vtkPVCompositeDataPipeline::ProcessRequest(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  if (!request->Has(REQUEST_DATA()))
+  {
+    return this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+  }
+
+  ++::UpdateDepth;
+  const vtkTypeBool result = this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+  // in parallel, the budget is enforced collectively by the callers.
+  if (--::UpdateDepth == 0 && ::GetBudgetState().Budget > 0 && !::GetParallelController())
+  {
+    vtkPVCompositeDataPipeline::EnforceMemoryBudget(this);
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  // the outputs of this algorithm and of the filters it consumes are used.
+  this->LastUsed = ++::UseClock;
+  for (int port = 0; port < this->GetNumberOfInputPorts(); ++port)
+  {
+    for (int cc = 0; cc < this->GetNumberOfInputConnections(port); ++cc)
+    {
+      if (auto input = vtkPVCompositeDataPipeline::SafeDownCast(this->GetInputExecutive(port, cc)))
+      {
+        input->LastUsed = this->LastUsed;
+        if (auto producer = ::GetPostFilterProducer(input))
+        {
+          producer->LastUsed = this->LastUsed;
+        }
+      }
+    }
+  }
+  if (this->OutputsReleased)
+  {
+    ++::GetBudgetState().NumberOfReexecutions;
+    this->OutputsReleased = false;
+  }
+
+  if (!::MemoryTracking)
+  {
+    return this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  }
+
+  const MemorySample before = ::SampleMemory();
+  ::ObservedPeaks.push_back(before.Resident);
+  const int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  const MemorySample after = ::SampleMemory();
+  const vtkTypeInt64 observed = std::max(::ObservedPeaks.back(), after.Resident);
+  ::ObservedPeaks.pop_back();
+
+  // the high water mark only tells about this execution when it rose meanwhile.
+  const vtkTypeInt64 peak =
+    (before.HighWaterMark >= 0 && after.HighWaterMark > before.HighWaterMark)
+    ? std::max(after.HighWaterMark, observed)
+    : observed;
+  if (!::ObservedPeaks.empty())
+  {
+    ::ObservedPeaks.back() = std::max(::ObservedPeaks.back(), peak);
+  }
+
+  this->LastExecutionMemoryIncrease = after.Resident - before.Resident;
+  this->LastExecutionPeakMemoryIncrease = peak - before.Resident;
+  this->MaximumPeakMemoryIncrease =
+    std::max(this->MaximumPeakMemoryIncrease, this->LastExecutionPeakMemoryIncrease);
+  ++this->NumberOfExecutions;
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVCompositeDataPipeline::GetOutputsMemorySize()
+{
+  vtkTypeInt64 size = 0;
+  for (int port = 0; port < this->GetNumberOfOutputPorts(); ++port)
+  {
+    if (auto output = this->GetOutputData(port))
+    {
+      size += output->GetActualMemorySize();
+    }
+  }
+  return size;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVCompositeDataPipeline::CanReleaseOutputs()
+{
+  bool consumedByFilter = false;
+  return !this->AreOutputsRetained(consumedByFilter) && consumedByFilter;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVCompositeDataPipeline::AreOutputsRetained(bool& consumedByFilter)
+{
+  for (int port = 0; port < this->GetNumberOfOutputPorts(); ++port)
+  {
+    vtkInformation* outInfo = this->GetOutputInformation(port);
+    const int count = outInfo->Length(CONSUMERS());
+    vtkExecutive** consumers = CONSUMERS()->GetExecutives(outInfo);
+    for (int cc = 0; cc < count; ++cc)
+    {
+      vtkAlgorithm* algorithm = consumers[cc] ? consumers[cc]->GetAlgorithm() : nullptr;
+      if (algorithm && algorithm->GetInformation()->Get(RETAIN_INPUTS()) != 0)
+      {
+        return true;
+      }
+      // the consumers of a post filter are those of the algorithm it
+      // converts the arrays of.
+      if (auto postFilter = vtkPVPostFilterExecutive::SafeDownCast(consumers[cc]))
+      {
+        if (postFilter->AreOutputsRetained(consumedByFilter))
+        {
+          return true;
+        }
+        continue;
+      }
+      consumedByFilter |= vtkPVCompositeDataPipeline::SafeDownCast(consumers[cc]) != nullptr;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::ReleaseOutputs()
+{
+  for (int port = 0; port < this->GetNumberOfOutputPorts(); ++port)
+  {
+    if (auto output = this->GetOutputData(port))
+    {
+      // the pipeline executes algorithms whose outputs were released when
+      // their data is needed again.
+      output->ReleaseData();
+    }
+
+    // post filters share the arrays of their input, which are only freed
+    // once released by both.
+    vtkInformation* outInfo = this->GetOutputInformation(port);
+    const int count = outInfo->Length(CONSUMERS());
+    vtkExecutive** consumers = CONSUMERS()->GetExecutives(outInfo);
+    for (int cc = 0; cc < count; ++cc)
+    {
+      auto postFilter = vtkPVPostFilterExecutive::SafeDownCast(consumers[cc]);
+      vtkDataObject* output = postFilter ? postFilter->GetOutputData(0) : nullptr;
+      if (output)
+      {
+        output->ReleaseData();
+      }
+    }
+  }
+  this->OutputsReleased = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::SetMemoryBudget(int mib)
+{
+  ::GetBudgetState().Budget = std::max(mib, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::GetMemoryBudget()
+{
+  return ::GetBudgetState().Budget;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::EnforceMemoryBudget()
+{
+  vtkPVCompositeDataPipeline::EnforceMemoryBudget(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::EnforceMemoryBudget(vtkExecutive* current)
+{
+  auto& state = ::GetBudgetState();
+  const vtkTypeInt64 budget = static_cast<vtkTypeInt64>(state.Budget) * 1024;
+  if (budget <= 0)
+  {
+    return;
+  }
+  if (auto producer = ::GetPostFilterProducer(current))
+  {
+    current = producer;
+  }
+
+  struct Candidate
+  {
+    vtkPVCompositeDataPipeline* Executive;
+    vtkTypeInt64 Size;
+  };
+  std::vector<Candidate> candidates;
+  auto release = [&state](const Candidate& candidate) {
+    vtkVLogF(vtkLogger::VERBOSITY_TRACE, "releasing %lld KiB of outputs of `%s`",
+      static_cast<long long>(candidate.Size),
+      vtkLogIdentifier(candidate.Executive->GetAlgorithm()).c_str());
+    candidate.Executive->ReleaseOutputs();
+    ++state.NumberOfReleasedOutputs;
+    state.ReleasedMemorySize += candidate.Size;
+  };
+
+  vtkMultiProcessController* controller = ::GetParallelController();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  vtkTypeInt64 total = 0;
+  for (auto executive : state.Executives)
+  {
+    if (::GetPostFilterProducer(executive))
+    {
+      continue;
+    }
+    const vtkTypeInt64 size = executive->GetOutputsMemorySize();
+    total += size;
+    // the output that was just requested is about to be used by its consumer.
+    if (executive == current || !executive->CanReleaseOutputs())
+    {
+      continue;
+    }
+    if (!controller && size > 0)
+    {
+      candidates.push_back(Candidate{ executive, size });
+    }
+    else if (controller && !executive->OutputsReleased &&
+      executive->GetAlgorithm()->GetInformation()->Has(GLOBAL_ID()))
+    {
+      // empty outputs are candidates too, all processes must release them.
+      candidates.push_back(Candidate{ executive, size });
+    }
+  }
+  state.BudgetedMemorySize = total;
+  state.MaximumBudgetedMemorySize = std::max(state.MaximumBudgetedMemorySize, total);
+
+  if (!controller)
+  {
+    if (total <= budget)
+    {
+      return;
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+      return a.Executive->LastUsed < b.Executive->LastUsed;
+    });
+    for (const auto& candidate : candidates)
+    {
+      if (total <= budget)
+      {
+        break;
+      }
+      release(candidate);
+      total -= candidate.Size;
+    }
+    return;
+  }
+
+  // Every process computes the same decision from the totals and the
+  // candidates of all processes.
+  const int numProcs = controller->GetNumberOfProcesses();
+  std::vector<long long> totals(numProcs);
+  long long localTotal = total;
+  controller->AllGather(&localTotal, totals.data(), 1);
+  if (std::none_of(totals.begin(), totals.end(), [budget](long long t) { return t > budget; }))
+  {
+    return;
+  }
+
+  // (global id, last use, size) for each candidate.
+  std::vector<long long> local;
+  std::map<int, Candidate> localCandidates;
+  for (const auto& candidate : candidates)
+  {
+    const int id = candidate.Executive->GetAlgorithm()->GetInformation()->Get(GLOBAL_ID());
+    if (!localCandidates.emplace(id, candidate).second)
+    {
+      continue;
+    }
+    local.push_back(id);
+    local.push_back(static_cast<long long>(candidate.Executive->LastUsed));
+    local.push_back(candidate.Size);
+  }
+  const vtkIdType localLength = static_cast<vtkIdType>(local.size());
+  std::vector<vtkIdType> lengths(numProcs);
+  controller->AllGather(&localLength, lengths.data(), 1);
+  std::vector<vtkIdType> offsets(numProcs, 0);
+  for (int rank = 1; rank < numProcs; ++rank)
+  {
+    offsets[rank] = offsets[rank - 1] + lengths[rank - 1];
+  }
+  std::vector<long long> all(std::max<vtkIdType>(offsets.back() + lengths.back(), 1));
+  controller->AllGatherV(
+    local.data(), all.data(), localLength, lengths.data(), offsets.data());
+
+  struct GlobalCandidate
+  {
+    int NumberOfProcesses = 0;
+    long long LastUsed = 0;
+    std::vector<long long> Sizes;
+  };
+  std::map<int, GlobalCandidate> globalCandidates;
+  for (int rank = 0; rank < numProcs; ++rank)
+  {
+    for (vtkIdType cc = offsets[rank]; cc < offsets[rank] + lengths[rank]; cc += 3)
+    {
+      auto& candidate = globalCandidates[static_cast<int>(all[cc])];
+      candidate.Sizes.resize(numProcs, 0);
+      ++candidate.NumberOfProcesses;
+      candidate.LastUsed = std::max(candidate.LastUsed, all[cc + 1]);
+      candidate.Sizes[rank] = all[cc + 2];
+    }
+  }
+
+  // only algorithms that can be released on all processes are, least
+  // recently used first, as seen by the process that used them last.
+  std::vector<std::pair<long long, int>> order;
+  for (const auto& item : globalCandidates)
+  {
+    if (item.second.NumberOfProcesses == numProcs)
+    {
+      order.emplace_back(item.second.LastUsed, item.first);
+    }
+  }
+  std::sort(order.begin(), order.end());
+  for (const auto& item : order)
+  {
+    if (std::none_of(totals.begin(), totals.end(), [budget](long long t) { return t > budget; }))
+    {
+      break;
+    }
+    const auto& sizes = globalCandidates[item.second].Sizes;
+    for (int rank = 0; rank < numProcs; ++rank)
+    {
+      totals[rank] -= sizes[rank];
+    }
+    release(localCandidates.at(item.second));
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVCompositeDataPipeline::GetBudgetedMemorySize()
+{
+  auto& state = ::GetBudgetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.BudgetedMemorySize;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVCompositeDataPipeline::GetMaximumBudgetedMemorySize()
+{
+  auto& state = ::GetBudgetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.MaximumBudgetedMemorySize;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::GetNumberOfReleasedOutputs()
+{
+  auto& state = ::GetBudgetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.NumberOfReleasedOutputs;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkPVCompositeDataPipeline::GetReleasedMemorySize()
+{
+  auto& state = ::GetBudgetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.ReleasedMemorySize;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVCompositeDataPipeline::GetNumberOfReexecutions()
+{
+  return ::GetBudgetState().NumberOfReexecutions;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCompositeDataPipeline::ResetMemoryBudgetStatistics()
+{
+  auto& state = ::GetBudgetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.BudgetedMemorySize = 0;
+  state.MaximumBudgetedMemorySize = 0;
+  state.NumberOfReleasedOutputs = 0;
+  state.ReleasedMemorySize = 0;
+  state.NumberOfReexecutions = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "LastExecutionMemoryIncrease: " << this->LastExecutionMemoryIncrease << endl;
+  os << indent << "LastExecutionPeakMemoryIncrease: " << this->LastExecutionPeakMemoryIncrease
+     << endl;
+  os << indent << "MaximumPeakMemoryIncrease: " << this->MaximumPeakMemoryIncrease << endl;
+  os << indent << "NumberOfExecutions: " << this->NumberOfExecutions << endl;
+  os << indent << "OutputsReleased: " << this->OutputsReleased << endl;
 }
@@ -23,6 +23,22 @@
  *     algorithms are passed along to the input vtkPVPostFilter, if one exists.
  *     vtkPVPostFilter is used to automatically extract components or generated
  *     derived arrays such as magnitude array for vectors.
+ * \li Memory accounting :- when enabled with `SetMemoryTracking()`, the
+ *     resident memory of the process is sampled around each execution of the
+ *     algorithm to record how much it grew and how high it peaked meanwhile.
+ *     vtkPVPipelineMemoryInformation reports these along with the size of the
+ *     outputs.
+ * \li Memory budget :- when a budget is set with `SetMemoryBudget()`, the
+ *     outputs of filters consumed only by other filters are released, least
+ *     recently used first, once the outputs of all filters of the process
+ *     exceed the budget at the end of a pipeline update. The vtkPVPostFilter
+ *     consuming the outputs of an algorithm shares their arrays, hence it is
+ *     accounted for and released along with that algorithm. Released outputs are
+ *     produced again when a downstream filter needs to execute. Consumers that
+ *     need their input to stay available, e.g. visible representations, set
+ *     `RETAIN_INPUTS()` in their information. When running in parallel, the
+ *     processes decide together which outputs to release, see
+ *     `EnforceMemoryBudget()`.
  */
 
 #ifndef vtkPVCompositeDataPipeline_h
@@ -30,6 +46,9 @@
 
 #include "vtkCompositeDataPipeline.h"
 #include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+#include "vtkType.h"                       // for vtkTypeInt64
+
+class vtkInformationIntegerKey;
 
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVCompositeDataPipeline : public vtkCompositeDataPipeline
 {
@@ -38,6 +57,112 @@ public:
   vtkTypeMacro(vtkPVCompositeDataPipeline, vtkCompositeDataPipeline);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  ///@{
+  /**
+   * Enable/disable sampling the process memory around executions for all
+   * vtkPVCompositeDataPipeline instances. Disabled by default.
+   */
+  static void SetMemoryTracking(bool);
+  static bool GetMemoryTracking();
+  ///@}
+
+  ///@{
+  /**
+   * Memory statistics of the algorithm's executions, in KiB. Only updated
+   * while memory tracking is enabled.
+   *
+   * `LastExecutionMemoryIncrease` is the change of the resident memory of the
+   * process over the last execution; it is negative when the execution freed
+   * more than it allocated. `LastExecutionPeakMemoryIncrease` is how far the
+   * resident memory rose above its value at the start of the last execution.
+   * On Linux, the peak is read from the process high water mark and is exact
+   * when the execution raised it; otherwise, and on other platforms, it is a
+   * lower bound derived from the memory at the start and the end of the
+   * execution. `MaximumPeakMemoryIncrease` is the largest peak over all
+   * executions since the last call to `ResetMemoryStatistics()`.
+   */
+  vtkGetMacro(LastExecutionMemoryIncrease, vtkTypeInt64);
+  vtkGetMacro(LastExecutionPeakMemoryIncrease, vtkTypeInt64);
+  vtkGetMacro(MaximumPeakMemoryIncrease, vtkTypeInt64);
+  vtkGetMacro(NumberOfExecutions, int);
+  void ResetMemoryStatistics();
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the budget, in MiB, for the outputs of all algorithms using
+   * vtkPVCompositeDataPipeline in the process. 0, the default, disables the
+   * budget. Sizes are those returned by `vtkDataObject::GetActualMemorySize`,
+   * hence arrays shared by several outputs are counted for each of them.
+   */
+  static void SetMemoryBudget(int mib);
+  static int GetMemoryBudget();
+  ///@}
+
+  ///@{
+  /**
+   * Releases outputs until the budget is met, except those of `current`.
+   *
+   * With a single process, this is done at the end of every pipeline update;
+   * call it to apply a lowered budget right away. When the global controller
+   * has several processes, releasing an output on some processes only would
+   * re-execute its algorithm on those only on the next update, and hang
+   * algorithms that communicate. This must then be called on all processes
+   * at once: the outputs of the same algorithms, identified by `GLOBAL_ID()`,
+   * are released on all of them until every process meets the budget.
+   * Algorithms without a global id are never released in parallel.
+   * vtkSISourceProxy::UpdatePipeline() and vtkPVView::Update() do that.
+   */
+  static void EnforceMemoryBudget();
+  static void EnforceMemoryBudget(vtkExecutive* current);
+  ///@}
+
+  ///@{
+  /**
+   * Statistics of the memory budget for the process. `BudgetedMemorySize` is
+   * the size, in KiB, of the outputs the last time the budget was enforced,
+   * before any release, and `MaximumBudgetedMemorySize` its largest value.
+   * `NumberOfReleasedOutputs` and `ReleasedMemorySize` count the algorithms
+   * whose outputs were released and their size, in KiB.
+   * `NumberOfReexecutions` counts the executions that produced released
+   * outputs again; a high count relative to the number of releases means the
+   * budget is too small for the pipeline.
+   */
+  static vtkTypeInt64 GetBudgetedMemorySize();
+  static vtkTypeInt64 GetMaximumBudgetedMemorySize();
+  static int GetNumberOfReleasedOutputs();
+  static vtkTypeInt64 GetReleasedMemorySize();
+  static int GetNumberOfReexecutions();
+  static void ResetMemoryBudgetStatistics();
+  ///@}
+
+  /**
+   * Key set to a non-zero value in the information of an algorithm, see
+   * `vtkAlgorithm::GetInformation()`, to prevent the outputs it consumes
+   * from being released to meet the memory budget.
+   */
+  static vtkInformationIntegerKey* RETAIN_INPUTS();
+
+  /**
+   * Key set in the information of an algorithm to an id identifying it on
+   * all processes, e.g. the global id of its proxy. Required for its outputs
+   * to be released to meet the memory budget when running in parallel.
+   */
+  static vtkInformationIntegerKey* GLOBAL_ID();
+
+  /**
+   * Returns true when the outputs were released to meet the memory budget
+   * and have not been produced again since.
+   */
+  vtkGetMacro(OutputsReleased, bool);
+
+  /**
+   * Overridden to enforce the memory budget at the end of pipeline updates
+   * when running with a single process.
+   */
+  vtkTypeBool ProcessRequest(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
 protected:
   vtkPVCompositeDataPipeline();
   ~vtkPVCompositeDataPipeline() override;
@@ -49,6 +174,30 @@ protected:
   // Remove update/whole extent when resetting pipeline information.
   void ResetPipelineInformation(int port, vtkInformation*) override;
 
+  // Sample the process memory around the execution of the algorithm.
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
+  vtkTypeInt64 LastExecutionMemoryIncrease = 0;
+  vtkTypeInt64 LastExecutionPeakMemoryIncrease = 0;
+  vtkTypeInt64 MaximumPeakMemoryIncrease = 0;
+  int NumberOfExecutions = 0;
+
+  // Returns the size of the outputs in KiB.
+  vtkTypeInt64 GetOutputsMemorySize();
+
+  // Returns true if the outputs are consumed by at least one filter and by
+  // no algorithm retaining its inputs. The consumers of a vtkPVPostFilter
+  // consuming the outputs are considered instead of the post filter itself.
+  bool CanReleaseOutputs();
+  bool AreOutputsRetained(bool& consumedByFilter);
+
+  // Also releases the outputs of the post filters consuming the outputs.
+  void ReleaseOutputs();
+
+  bool OutputsReleased = false;
+  vtkTypeUInt64 LastUsed = 0;
+
 private:
   vtkPVCompositeDataPipeline(const vtkPVCompositeDataPipeline&) = delete;
   void operator=(const vtkPVCompositeDataPipeline&) = delete;
@@ -0,0 +1,379 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceEventLog.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVTraceEventLog.h"
+
+#include "vtkLogger.h"
+#include "vtkMultiProcessController.h"
+#include "vtkObjectFactory.h"
+
+#include <vtksys/SystemInformation.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+constexpr const char* CALLBACK_ID = "paraview-trace-events";
+// trace pids are the rank plus a multiple of this per role.
+constexpr int ROLE_PID_STRIDE = 1000000;
+
+struct TraceEvent
+{
+  double Timestamp; // microseconds since epoch
+  char Phase;       // 'B', 'E' or 'i'
+  char Name[120];
+  char Category[64];
+};
+
+struct ThreadBuffer
+{
+  std::mutex Mutex; // only contended while events are exported or cleared.
+  std::vector<TraceEvent> Events;
+  size_t Next = 0;
+  bool Wrapped = false;
+  int ThreadId = 0;
+  std::string ThreadName;
+};
+
+struct TraceEventState
+{
+  std::mutex Mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> Buffers;
+  // incremented by ClearEvents() so that threads allocate new buffers.
+  std::atomic<int> Generation{ 0 };
+  int BufferSize = 65536;
+  bool Recording = false;
+  std::string ProcessName = "paraview";
+  int ProcessRole = 0;
+};
+
+TraceEventState& GetState()
+{
+  static TraceEventState state;
+  return state;
+}
+
+ThreadBuffer* GetThreadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  thread_local int generation = -1;
+
+  auto& state = GetState();
+  if (buffer && generation == state.Generation.load(std::memory_order_acquire))
+  {
+    return buffer.get();
+  }
+
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  if (!buffer || generation != state.Generation.load())
+  {
+    buffer = std::make_shared<ThreadBuffer>();
+    buffer->Events.resize(static_cast<size_t>(state.BufferSize));
+    buffer->ThreadId = static_cast<int>(state.Buffers.size());
+    buffer->ThreadName = vtkLogger::GetThreadName();
+    state.Buffers.push_back(buffer);
+    generation = state.Generation;
+  }
+  return buffer.get();
+}
+
+void CopyString(char* destination, size_t size, const char* source)
+{
+  std::strncpy(destination, source ? source : "", size - 1);
+  destination[size - 1] = '\0';
+}
+
+void Record(void*, const vtkLogger::Message& message)
+{
+  char phase = 'i';
+  const char* name = message.message;
+  if (message.prefix && message.prefix[0] == '{')
+  {
+    phase = 'B';
+  }
+  else if (message.prefix && message.prefix[0] == '}')
+  {
+    // the name of a closing scope follows its duration.
+    phase = 'E';
+  }
+
+  const double timestamp = std::chrono::duration<double, std::micro>(
+    std::chrono::system_clock::now().time_since_epoch())
+                             .count();
+
+  ThreadBuffer* buffer = ::GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(buffer->Mutex);
+  if (buffer->Events.empty())
+  {
+    return;
+  }
+  TraceEvent& event = buffer->Events[buffer->Next];
+  event.Timestamp = timestamp;
+  event.Phase = phase;
+  if (phase == 'E')
+  {
+    event.Name[0] = '\0';
+  }
+  else
+  {
+    CopyString(event.Name, sizeof(event.Name), name);
+  }
+  // use the name of the file the message was logged from as category.
+  const char* category = message.filename ? message.filename : "";
+  for (const char* cc = category; *cc != '\0'; ++cc)
+  {
+    if (*cc == '/' || *cc == '\\')
+    {
+      category = cc + 1;
+    }
+  }
+  CopyString(event.Category, sizeof(event.Category), category);
+
+  if (++buffer->Next == buffer->Events.size())
+  {
+    buffer->Next = 0;
+    buffer->Wrapped = true;
+  }
+}
+
+void WriteJSONString(std::ostream& os, const std::string& value)
+{
+  os << '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+          os << escaped;
+        }
+        else
+        {
+          os << c;
+        }
+        break;
+    }
+  }
+  os << '"';
+}
+}
+
+vtkStandardNewMacro(vtkPVTraceEventLog);
+//----------------------------------------------------------------------------
+vtkPVTraceEventLog::vtkPVTraceEventLog() = default;
+
+//----------------------------------------------------------------------------
+vtkPVTraceEventLog::~vtkPVTraceEventLog() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventLog::SetRecording(bool recording)
+{
+  auto& state = ::GetState();
+  {
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    if (state.Recording == recording)
+    {
+      return;
+    }
+    state.Recording = recording;
+  }
+  if (recording)
+  {
+    vtkLogger::AddCallback(CALLBACK_ID, &::Record, nullptr, vtkLogger::VERBOSITY_MAX);
+  }
+  else
+  {
+    vtkLogger::RemoveCallback(CALLBACK_ID);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTraceEventLog::GetRecording()
+{
+  auto& state = ::GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.Recording;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventLog::SetBufferSize(int size)
+{
+  auto& state = ::GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.BufferSize = std::max(size, 1);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVTraceEventLog::GetBufferSize()
+{
+  auto& state = ::GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.BufferSize;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventLog::SetProcessName(const char* name)
+{
+  auto& state = ::GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.ProcessName = name ? name : "";
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVTraceEventLog::GetProcessName()
+{
+  auto& state = ::GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.ProcessName;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventLog::SetProcessRole(int role)
+{
+  auto& state = ::GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  state.ProcessRole = std::max(role, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVTraceEventLog::GetProcessRole()
+{
+  auto& state = ::GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  return state.ProcessRole;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventLog::ClearEvents()
+{
+  auto& state = ::GetState();
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  // threads still holding a buffer keep it until they record their next event.
+  state.Buffers.clear();
+  ++state.Generation;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkPVTraceEventLog::GetEvents()
+{
+  auto& state = ::GetState();
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  std::string processName;
+  int role;
+  {
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    buffers = state.Buffers;
+    processName = state.ProcessName;
+    role = state.ProcessRole;
+  }
+
+  // OS pids of processes on different hosts may collide when traces of all
+  // ranks are concatenated, the role and rank may not.
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  const int rank = controller ? controller->GetLocalProcessId() : 0;
+  const long long pid = (role + 1LL) * ROLE_PID_STRIDE + rank;
+  const int osPid = vtksys::SystemInformation::GetProcessId();
+
+  std::ostringstream os;
+  os.precision(3);
+  os << std::fixed;
+  bool first = true;
+  auto separator = [&os, &first]() {
+    if (!first)
+    {
+      os << ",\n";
+    }
+    first = false;
+  };
+
+  for (const auto& buffer : buffers)
+  {
+    std::lock_guard<std::mutex> lock(buffer->Mutex);
+    const size_t count = buffer->Wrapped ? buffer->Events.size() : buffer->Next;
+    if (count == 0)
+    {
+      continue;
+    }
+    if (first)
+    {
+      separator();
+      os << R"({"ph":"M","name":"process_name","pid":)" << pid << R"(,"args":{"name":)";
+      ::WriteJSONString(os, processName + " " + std::to_string(rank));
+      os << R"(,"os_pid":)" << osPid << "}}";
+      separator();
+      os << R"({"ph":"M","name":"process_sort_index","pid":)" << pid
+         << R"(,"args":{"sort_index":)" << rank << "}}";
+    }
+    separator();
+    os << R"({"ph":"M","name":"thread_name","pid":)" << pid << R"(,"tid":)" << buffer->ThreadId
+       << R"(,"args":{"name":)";
+    ::WriteJSONString(os, buffer->ThreadName);
+    os << "}}";
+
+    const size_t start = buffer->Wrapped ? buffer->Next : 0;
+    for (size_t cc = 0; cc < count; ++cc)
+    {
+      const TraceEvent& event = buffer->Events[(start + cc) % buffer->Events.size()];
+      separator();
+      os << R"({"ph":")" << event.Phase << R"(","pid":)" << pid << R"(,"tid":)"
+         << buffer->ThreadId << R"(,"ts":)" << event.Timestamp;
+      if (event.Phase != 'E')
+      {
+        os << R"(,"name":)";
+        ::WriteJSONString(os, event.Name);
+        os << R"(,"cat":)";
+        ::WriteJSONString(os, event.Category);
+      }
+      if (event.Phase == 'i')
+      {
+        os << R"(,"s":"t")";
+      }
+      os << "}";
+    }
+  }
+  return os.str();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTraceEventLog::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Recording: " << vtkPVTraceEventLog::GetRecording() << endl;
+  os << indent << "BufferSize: " << vtkPVTraceEventLog::GetBufferSize() << endl;
+  os << indent << "ProcessName: " << vtkPVTraceEventLog::GetProcessName() << endl;
+  os << indent << "ProcessRole: " << vtkPVTraceEventLog::GetProcessRole() << endl;
+}
@@ -0,0 +1,117 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTraceEventLog.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkPVTraceEventLog
+ * @brief records log scopes as trace events.
+ *
+ * When recording, vtkPVTraceEventLog listens to all messages logged with
+ * vtkLogger, including those of every vtkPVLogger category regardless of
+ * their verbosity, and records scopes, such as the ones created with
+ * `vtkLogScopeF` or `vtkVLogScopeF`, as timestamped begin and end events.
+ * Other messages are recorded as instant events.
+ *
+ * Each thread records events in its own ring buffer of `BufferSize` events,
+ * hence recording does not synchronize threads and keeps the most recent
+ * events when a buffer is full.
+ *
+ * `GetEvents()` returns the recorded events of the process in the Trace Event
+ * Format used by Chrome's trace viewer and Perfetto. Events of several
+ * processes, e.g. gathered with vtkPVTraceEventInformation from the client
+ * and all ranks of the servers, can be concatenated into a single timeline.
+ *
+ * Like vtkTimerLog, the state is global to the process: all instances share
+ * it. Instances only exist to control recording through proxies.
+ *
+ * @sa vtkPVLogger, vtkPVTraceEventInformation
+ */
+
+#ifndef vtkPVTraceEventLog_h
+#define vtkPVTraceEventLog_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+
+#include <string> // for std::string
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVTraceEventLog : public vtkObject
+{
+public:
+  static vtkPVTraceEventLog* New();
+  vtkTypeMacro(vtkPVTraceEventLog, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Start or stop recording events.
+   */
+  static void SetRecording(bool recording);
+  static bool GetRecording();
+  //@}
+
+  //@{
+  /**
+   * Maximum number of events kept per thread. Changing it only affects
+   * threads that have not recorded any event since events were last
+   * cleared. 65536 by default.
+   */
+  static void SetBufferSize(int size);
+  static int GetBufferSize();
+  //@}
+
+  //@{
+  /**
+   * Name identifying the process in traces, e.g. "client" or "dataserver".
+   * The rank of the process is appended to it.
+   */
+  static void SetProcessName(const char* name);
+  static std::string GetProcessName();
+  //@}
+
+  //@{
+  /**
+   * Non-negative index of the role of the process, e.g. the
+   * vtkProcessModule::ProcessTypes value of client or data server processes.
+   * Together with the rank, it identifies the process in traces, since the
+   * operating system process ids of processes running on different hosts may
+   * collide: events are recorded with `(role + 1) * 1000000 + rank` as `pid`,
+   * the operating system process id being kept in the `os_pid` argument of
+   * the `process_name` metadata event. 0 by default.
+   */
+  static void SetProcessRole(int role);
+  static int GetProcessRole();
+  //@}
+
+  /**
+   * Discard all recorded events.
+   */
+  static void ClearEvents();
+
+  /**
+   * Returns the recorded events as comma separated Trace Event Format
+   * objects, suitable for the `traceEvents` array of a trace. Returns an empty
+   * string when no event was recorded.
+   */
+  static std::string GetEvents();
+
+protected:
+  vtkPVTraceEventLog();
+  ~vtkPVTraceEventLog() override;
+
+private:
+  vtkPVTraceEventLog(const vtkPVTraceEventLog&) = delete;
+  void operator=(const vtkPVTraceEventLog&) = delete;
+};
+
+#endif
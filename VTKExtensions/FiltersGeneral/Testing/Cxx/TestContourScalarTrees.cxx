@@ -0,0 +1,211 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestContourScalarTrees.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPVContourFilter keeps a scalar tree per block of a composite
+// input across executions, rebuilds it only when its block is modified,
+// releases the trees of blocks that left the input and reports progress.
+
+#include "vtkCallbackCommand.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVContourFilter.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSpanSpace.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+// Counts the trees alive and how many times they were actually built.
+class CountingSpanSpace : public vtkSpanSpace
+{
+public:
+  static CountingSpanSpace* New();
+  vtkTypeMacro(CountingSpanSpace, vtkSpanSpace);
+
+  static int NumberOfTrees;
+  static int NumberOfBuilds;
+
+  void BuildTree() override
+  {
+    const vtkMTimeType before = this->BuildTime.GetMTime();
+    this->Superclass::BuildTree();
+    if (this->BuildTime.GetMTime() != before)
+    {
+      ++NumberOfBuilds;
+    }
+  }
+
+protected:
+  CountingSpanSpace() { ++NumberOfTrees; }
+  ~CountingSpanSpace() override { --NumberOfTrees; }
+
+private:
+  CountingSpanSpace(const CountingSpanSpace&) = delete;
+  void operator=(const CountingSpanSpace&) = delete;
+};
+vtkStandardNewMacro(CountingSpanSpace);
+int CountingSpanSpace::NumberOfTrees = 0;
+int CountingSpanSpace::NumberOfBuilds = 0;
+
+// Tetrahedra with the distance to the center of the block as scalars.
+vtkSmartPointer<vtkUnstructuredGrid> MakeBlock(double origin)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(11, 11, 11);
+  image->SetOrigin(origin, 0, 0);
+  vtkNew<vtkDoubleArray> distance;
+  distance->SetName("distance");
+  distance->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    double point[3];
+    image->GetPoint(cc, point);
+    const double x = point[0] - origin - 5, y = point[1] - 5, z = point[2] - 5;
+    distance->SetValue(cc, std::sqrt(x * x + y * y + z * z));
+  }
+  image->GetPointData()->SetScalars(distance);
+
+  vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+  tetrahedralize->SetInputData(image);
+  tetrahedralize->Update();
+  return tetrahedralize->GetOutput();
+}
+
+vtkIdType CountPoints(vtkPVContourFilter* contour)
+{
+  vtkIdType count = 0;
+  auto output = vtkMultiBlockDataSet::SafeDownCast(contour->GetOutputDataObject(0));
+  for (unsigned int cc = 0; output && cc < output->GetNumberOfBlocks(); ++cc)
+  {
+    if (auto block = vtkPolyData::SafeDownCast(output->GetBlock(cc)))
+    {
+      count += block->GetNumberOfPoints();
+    }
+  }
+  return count;
+}
+
+void RecordProgress(vtkObject*, unsigned long, void* clientData, void* callData)
+{
+  static_cast<std::vector<double>*>(clientData)->push_back(*static_cast<double*>(callData));
+}
+}
+
+int TestContourScalarTrees(int, char*[])
+{
+  vtkNew<vtkMultiBlockDataSet> input;
+  for (unsigned int cc = 0; cc < 3; ++cc)
+  {
+    input->SetBlock(cc, MakeBlock(20.0 * cc));
+  }
+
+  vtkNew<CountingSpanSpace> prototype;
+  vtkNew<vtkPVContourFilter> contour;
+  contour->SetInputDataObject(input);
+  contour->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "distance");
+  contour->SetUseScalarTree(true);
+  contour->SetScalarTree(prototype);
+  contour->SetValue(0, 3.0);
+
+  // the same contours are expected without scalar trees.
+  vtkNew<vtkPVContourFilter> reference;
+  reference->SetInputDataObject(input);
+  reference->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "distance");
+  reference->SetValue(0, 3.0);
+
+  std::vector<double> progress;
+  vtkNew<vtkCallbackCommand> progressObserver;
+  progressObserver->SetCallback(&RecordProgress);
+  progressObserver->SetClientData(&progress);
+  contour->AddObserver(vtkCommand::ProgressEvent, progressObserver);
+
+  contour->Update();
+  reference->Update();
+  if (CountPoints(contour) == 0 || CountPoints(contour) != CountPoints(reference))
+  {
+    vtkLogF(ERROR, "Contours differ from those computed without scalar trees.");
+    return EXIT_FAILURE;
+  }
+  if (CountingSpanSpace::NumberOfBuilds != 3 || CountingSpanSpace::NumberOfTrees != 4)
+  {
+    vtkLogF(ERROR, "Expected 3 trees to be built, got %d builds and %d trees.",
+      CountingSpanSpace::NumberOfBuilds, CountingSpanSpace::NumberOfTrees - 1);
+    return EXIT_FAILURE;
+  }
+
+  // progress goes from the first block to the last one.
+  if (progress.empty() || progress.back() != 1.0 ||
+    std::none_of(progress.begin(), progress.end(),
+      [](double value) { return value > 0.0 && value < 1.0; }) ||
+    !std::is_sorted(progress.begin(), progress.end()))
+  {
+    vtkLogF(ERROR, "Progress was not reported while contouring the blocks.");
+    return EXIT_FAILURE;
+  }
+
+  // new contour values reuse the trees of all blocks.
+  contour->SetValue(0, 4.0);
+  reference->SetValue(0, 4.0);
+  contour->Update();
+  reference->Update();
+  if (CountPoints(contour) == 0 || CountPoints(contour) != CountPoints(reference) ||
+    CountingSpanSpace::NumberOfBuilds != 3)
+  {
+    vtkLogF(ERROR, "Trees were not reused for new contour values.");
+    return EXIT_FAILURE;
+  }
+
+  // only the tree of a modified block is rebuilt.
+  input->GetBlock(1)->Modified();
+  contour->Modified();
+  contour->Update();
+  if (CountingSpanSpace::NumberOfBuilds != 4)
+  {
+    vtkLogF(ERROR, "Expected the tree of the modified block only to be rebuilt.");
+    return EXIT_FAILURE;
+  }
+
+  // the trees of blocks that left the input are released.
+  vtkNew<vtkMultiBlockDataSet> smaller;
+  smaller->SetBlock(0, input->GetBlock(0));
+  contour->SetInputDataObject(smaller);
+  contour->Update();
+  contour->SetValue(0, 3.0);
+  contour->Update();
+  if (CountingSpanSpace::NumberOfBuilds != 4 || CountingSpanSpace::NumberOfTrees != 2)
+  {
+    vtkLogF(ERROR, "Trees of removed blocks were not released.");
+    return EXIT_FAILURE;
+  }
+
+  contour->SetUseScalarTree(false);
+  contour->Update();
+  if (CountingSpanSpace::NumberOfTrees != 1)
+  {
+    vtkLogF(ERROR, "Trees were not released once scalar trees were disabled.");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
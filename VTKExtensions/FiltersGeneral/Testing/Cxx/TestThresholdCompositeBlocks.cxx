@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestThresholdCompositeBlocks.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkPVThreshold gives the same cells as vtkThreshold on every
+// block of a multiblock dataset, passes blocks entirely within the interval
+// through, and does not pass blocks holding NaN values or unused points
+// through.
+
+#include "vtkAppendFilter.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPVThreshold.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+#include <limits>
+
+namespace
+{
+// Unstructured grid whose cell values go linearly from `first` to `last`.
+vtkSmartPointer<vtkUnstructuredGrid> MakeBlock(
+  double first, double last, bool withNaN, bool withUnusedPoint = false)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 21, 21);
+  const vtkIdType numberOfCells = image->GetNumberOfCells();
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  values->SetNumberOfTuples(numberOfCells);
+  for (vtkIdType cc = 0; cc < numberOfCells; ++cc)
+  {
+    values->SetValue(cc, first + (last - first) * cc / (numberOfCells - 1));
+  }
+  if (withNaN)
+  {
+    values->SetValue(numberOfCells / 2, std::numeric_limits<double>::quiet_NaN());
+  }
+  image->GetCellData()->SetScalars(values);
+
+  vtkNew<vtkAppendFilter> toUnstructured;
+  toUnstructured->SetInputData(image);
+  toUnstructured->Update();
+  vtkSmartPointer<vtkUnstructuredGrid> block = toUnstructured->GetOutput();
+  if (withUnusedPoint)
+  {
+    block->GetPoints()->InsertNextPoint(100, 100, 100);
+  }
+  return block;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> Reference(vtkDataObject* block, bool invert)
+{
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputData(block);
+  threshold->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "values");
+  threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+  threshold->SetLowerThreshold(1.0);
+  threshold->SetUpperThreshold(5.0);
+  threshold->SetInvert(invert);
+  threshold->Update();
+  return threshold->GetOutput();
+}
+}
+
+int TestThresholdCompositeBlocks(int, char*[])
+{
+  enum
+  {
+    ALL_IN,
+    ALL_OUT,
+    ALL_IN_WITH_NAN,
+    ALL_OUT_WITH_NAN,
+    ALL_IN_WITH_UNUSED_POINT,
+    PARTIAL,
+    NUMBER_OF_BLOCKS
+  };
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetBlock(ALL_IN, MakeBlock(2.0, 4.0, false));
+  input->SetBlock(ALL_OUT, MakeBlock(6.0, 8.0, false));
+  input->SetBlock(ALL_IN_WITH_NAN, MakeBlock(2.0, 4.0, true));
+  input->SetBlock(ALL_OUT_WITH_NAN, MakeBlock(6.0, 8.0, true));
+  input->SetBlock(ALL_IN_WITH_UNUSED_POINT, MakeBlock(2.0, 4.0, false, true));
+  input->SetBlock(PARTIAL, MakeBlock(0.0, 10.0, false));
+
+  vtkNew<vtkPVThreshold> threshold;
+  threshold->SetInputDataObject(input);
+  threshold->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "values");
+  threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+  threshold->SetLowerThreshold(1.0);
+  threshold->SetUpperThreshold(5.0);
+
+  for (bool invert : { false, true })
+  {
+    threshold->SetInvert(invert);
+    threshold->Update();
+    auto output = vtkMultiBlockDataSet::SafeDownCast(threshold->GetOutputDataObject(0));
+    if (!output || output->GetNumberOfBlocks() != NUMBER_OF_BLOCKS)
+    {
+      vtkLogF(ERROR, "Expected a multiblock dataset with %d blocks.", NUMBER_OF_BLOCKS);
+      return EXIT_FAILURE;
+    }
+
+    // every block matches the output of vtkThreshold, which does not keep
+    // entirely a block holding NaN values, nor remove it entirely once the
+    // criterion is inverted, and drops unused points.
+    for (unsigned int cc = 0; cc < NUMBER_OF_BLOCKS; ++cc)
+    {
+      auto block = vtkUnstructuredGrid::SafeDownCast(output->GetBlock(cc));
+      auto reference = Reference(input->GetBlock(cc), invert);
+      if (!block || block->GetNumberOfCells() != reference->GetNumberOfCells() ||
+        block->GetNumberOfPoints() != reference->GetNumberOfPoints())
+      {
+        vtkLogF(ERROR, "Block %u (invert=%d) differs from vtkThreshold's output.", cc,
+          static_cast<int>(invert));
+        return EXIT_FAILURE;
+      }
+    }
+
+    // blocks known to be kept entirely share the points of the input.
+    auto passed = vtkUnstructuredGrid::SafeDownCast(output->GetBlock(invert ? ALL_OUT : ALL_IN));
+    auto passedInput =
+      vtkUnstructuredGrid::SafeDownCast(input->GetBlock(invert ? ALL_OUT : ALL_IN));
+    if (passed->GetPoints() != passedInput->GetPoints())
+    {
+      vtkLogF(ERROR, "Block kept entirely was not passed through (invert=%d).",
+        static_cast<int>(invert));
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -14,7 +14,10 @@
 =========================================================================*/
 #include "vtkHybridProbeFilter.h"
 
+#include "vtkAbstractCellLocator.h"
+#include "vtkCellLocatorStrategy.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
 #include "vtkExtractSelection.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -22,11 +25,15 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPProbeFilter.h"
+#include "vtkPVCellLocatorCache.h"
 #include "vtkPointSource.h"
 #include "vtkSelectionNode.h"
 #include "vtkSelectionSource.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <map>
+#include <vector>
+
 vtkStandardNewMacro(vtkHybridProbeFilter);
 //----------------------------------------------------------------------------
 vtkHybridProbeFilter::vtkHybridProbeFilter()
@@ -84,7 +91,45 @@ bool vtkHybridProbeFilter::InterpolateAtLocation(vtkDataObject* input, vtkUnstru
   vtkNew<vtkPProbeFilter> probe;
   probe->SetInputConnection(0, pointSource->GetOutputPort());
   probe->SetInputDataObject(1, input);
+
+  // use the shared cell locators so that moving the location does not rebuild
+  // them.
+  std::vector<vtkDataSet*> datasets;
+  if (auto ds = vtkDataSet::SafeDownCast(input))
+  {
+    datasets.push_back(ds);
+  }
+  else
+  {
+    datasets = vtkCompositeDataSet::GetDataSets<vtkDataSet>(input);
+  }
+  std::vector<vtkSmartPointer<vtkCellLocatorStrategy>> strategies;
+  std::map<vtkDataSet*, vtkFindCellStrategy*> strategyMap;
+  auto cache = vtkPVCellLocatorCache::GetInstance();
+  std::vector<vtkSmartPointer<vtkAbstractCellLocator>> locators;
+  for (auto ds : datasets)
+  {
+    if (auto locator = cache->GetCellLocator(ds))
+    {
+      locators.push_back(locator);
+      auto strategy = vtkSmartPointer<vtkCellLocatorStrategy>::New();
+      strategy->SetCellLocator(locator);
+      strategyMap[ds] = strategy;
+      strategies.push_back(strategy);
+    }
+  }
+  if (vtkCompositeDataSet::SafeDownCast(input))
+  {
+    probe->SetFindCellStrategyMap(strategyMap);
+  }
+  else if (!strategies.empty())
+  {
+    probe->SetFindCellStrategy(strategies.front());
+  }
   probe->Update();
+  // keep the locators for the next execution, releasing those of the
+  // previous one.
+  this->CellLocators.swap(locators);
 
   output->ShallowCopy(probe->GetOutputDataObject(0));
   return true;
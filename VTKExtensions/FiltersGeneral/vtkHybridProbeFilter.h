@@ -25,7 +25,10 @@
  * exactly what he/she is looking for -- interpolate at point location (probe)
  * or extract cell containing the point (extract selection).
  *
- * Internally this filter uses vtkPProbeFilter and vtkExtractSelection.
+ * Internally this filter uses vtkPProbeFilter and vtkExtractSelection. Cell
+ * locators used for probing are shared through vtkPVCellLocatorCache, and
+ * kept until the next execution so that moving the location does not rebuild
+ * them.
  */
 
 #ifndef vtkHybridProbeFilter_h
@@ -33,7 +36,11 @@
 
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
+#include "vtkSmartPointer.h"                         // for vtkSmartPointer
 
+#include <vector> // for std::vector
+
+class vtkAbstractCellLocator;
 class vtkUnstructuredGrid;
 
 class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkHybridProbeFilter : public vtkDataObjectAlgorithm
@@ -76,6 +83,9 @@ protected:
   double Location[3];
   int Mode;
 
+  // Locators used by the last execution.
+  std::vector<vtkSmartPointer<vtkAbstractCellLocator>> CellLocators;
+
 private:
   vtkHybridProbeFilter(const vtkHybridProbeFilter&) = delete;
   void operator=(const vtkHybridProbeFilter&) = delete;
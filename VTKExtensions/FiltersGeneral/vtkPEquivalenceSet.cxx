@@ -13,10 +13,14 @@
 
 =========================================================================*/
 #include "vtkPEquivalenceSet.h"
+#include "vtkDistributedUnionFind.h"
 #include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 
+#include <numeric>
+#include <vector>
+
 vtkStandardNewMacro(vtkPEquivalenceSet);
 
 vtkPEquivalenceSet::vtkPEquivalenceSet() = default;
@@ -31,52 +35,45 @@ void vtkPEquivalenceSet::PrintSelf(ostream& os, vtkIndent indent)
 int vtkPEquivalenceSet::ResolveEquivalences()
 {
   vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
-  int myProc = controller->GetLocalProcessId();
-  int numProcs = controller->GetNumberOfProcesses();
+  if (!controller || controller->GetNumberOfProcesses() <= 1)
+  {
+    return this->Superclass::ResolveEquivalences();
+  }
+  const int myProc = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
 
-  vtkIntArray* workingSet = vtkIntArray::New();
-  workingSet->SetNumberOfComponents(1);
+  // Every process records equivalences in the same id space, possibly with
+  // arrays of different lengths. Instead of reducing the full arrays onto
+  // process 0, split the id space evenly and let a distributed union-find
+  // merge the equivalences.
+  const int localSize = this->GetNumberOfMembers();
+  int numMembers = 0;
+  controller->AllReduce(&localSize, &numMembers, 1, vtkCommunicator::MAX_OP);
 
-  int tag = 475893745;
-  int pivot = (numProcs + 1) / 2;
-  while (pivot > 0 && myProc < (pivot * 2))
+  vtkDistributedUnionFind unionFind;
+  unionFind.Initialize(
+    controller, numMembers / numProcs + (myProc < numMembers % numProcs ? 1 : 0));
+  for (int ii = 0; ii < localSize; ++ii)
   {
-    int tuples;
-    if (myProc >= pivot)
+    const int ref = this->EquivalenceArray->GetValue(ii);
+    if (ref != ii)
     {
-      tuples = this->EquivalenceArray->GetNumberOfTuples();
-      controller->Send(&tuples, 1, myProc - pivot, tag + pivot + 0);
-      controller->Send(this->EquivalenceArray, myProc - pivot, tag + pivot + 1);
+      unionFind.AddEquivalence(ii, ref);
     }
-    else if ((myProc + pivot) < numProcs)
-    {
-      controller->Receive(&tuples, 1, myProc + pivot, tag + pivot + 0);
-      workingSet->SetNumberOfTuples(tuples);
+  }
+  const int count = static_cast<int>(unionFind.Resolve());
 
-      controller->Receive(workingSet, myProc + pivot, tag + pivot + 1);
-      while (workingSet->GetNumberOfTuples() > this->EquivalenceArray->GetNumberOfTuples())
-      {
-        this->EquivalenceArray->InsertNextTuple1(0);
-      }
-      for (int i = 0; i < workingSet->GetNumberOfTuples(); i++)
-      {
-        int workingVal = workingSet->GetValue(i);
-        if (workingVal == 0)
-        {
-          continue;
-        }
-        int existingVal = this->EquivalenceArray->GetValue(i);
-        this->EquivalenceArray->SetValue(i, workingVal);
-        if (existingVal != 0 && existingVal < workingVal)
-        {
-          this->EquateInternal(existingVal, workingVal);
-        }
-      }
-    }
-    pivot /= 2;
+  // All processes expect the full map.
+  std::vector<vtkIdType> ids(numMembers);
+  std::iota(ids.begin(), ids.end(), 0);
+  const std::vector<vtkIdType> setIds = unionFind.GetSetIds(ids);
+  this->EquivalenceArray->SetNumberOfTuples(numMembers);
+  for (int ii = 0; ii < numMembers; ++ii)
+  {
+    this->EquivalenceArray->SetValue(ii, static_cast<int>(setIds[ii]));
   }
-  controller->Broadcast(this->EquivalenceArray, 0);
 
-  this->Superclass::ResolveEquivalences();
-  return 1;
+  this->Resolved = 1;
+  this->NumberOfResolvedSets = count;
+  return count;
 }
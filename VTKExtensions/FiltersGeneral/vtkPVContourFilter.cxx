@@ -20,6 +20,7 @@
 #include "vtkArrayDispatch.h"
 #include "vtkAssume.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
 #include "vtkContour3DLinearGrid.h"
 #include "vtkDataArray.h"
 #include "vtkDataArrayAccessor.h"
@@ -36,18 +37,85 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
 #include "vtkSMPTools.h"
+#include "vtkScalarTree.h"
 #include "vtkSmartPointer.h"
+#include "vtkSpanSpace.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUniformGridAMR.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <cmath>
+#include <map>
 #include <set>
 
+//-----------------------------------------------------------------------------
+class vtkPVContourFilter::vtkInternals
+{
+public:
+  // Scalar tree of each input block. The executive contours the blocks of
+  // composite inputs one at a time, hence trees are kept across calls and
+  // only released when their block was not contoured during the previous
+  // execution. The block is held so that its address is not reused by
+  // another dataset while the tree exists. Trees rebuild themselves when the
+  // block or its scalars are modified.
+  struct ScalarTreeEntry
+  {
+    vtkSmartPointer<vtkDataSet> Block;
+    vtkSmartPointer<vtkScalarTree> Tree;
+    bool Used = false;
+  };
+  std::map<vtkDataSet*, ScalarTreeEntry> ScalarTrees;
+
+  void ReleaseUnusedScalarTrees()
+  {
+    for (auto iter = this->ScalarTrees.begin(); iter != this->ScalarTrees.end();)
+    {
+      if (iter->second.Used)
+      {
+        iter->second.Used = false;
+        ++iter;
+      }
+      else
+      {
+        iter = this->ScalarTrees.erase(iter);
+      }
+    }
+  }
+};
+
+namespace
+{
+//-----------------------------------------------------------------------------
+void CopyContourParameters(vtkContourFilter* source, vtkContourFilter* target)
+{
+  target->SetNumberOfContours(source->GetNumberOfContours());
+  for (int i = 0; i < source->GetNumberOfContours(); ++i)
+  {
+    target->SetValue(i, source->GetValue(i));
+  }
+  target->SetComputeNormals(source->GetComputeNormals());
+  target->SetComputeGradients(source->GetComputeGradients());
+  target->SetComputeScalars(source->GetComputeScalars());
+  target->SetUseScalarTree(source->GetUseScalarTree());
+  target->SetScalarTree(source->GetScalarTree());
+  target->SetLocator(source->GetLocator());
+  target->SetArrayComponent(source->GetArrayComponent());
+  target->SetGenerateTriangles(source->GetGenerateTriangles());
+  target->SetOutputPointsPrecision(source->GetOutputPointsPrecision());
+  target->SetInputArrayToProcess(0, source->GetInputArrayInformation(0));
+}
+}
+
 vtkStandardNewMacro(vtkPVContourFilter);
 
 //-----------------------------------------------------------------------------
-vtkPVContourFilter::vtkPVContourFilter() = default;
+vtkPVContourFilter::vtkPVContourFilter()
+  : Internals(new vtkInternals())
+{
+}
 
 //-----------------------------------------------------------------------------
 vtkPVContourFilter::~vtkPVContourFilter() = default;
@@ -68,6 +136,12 @@ int vtkPVContourFilter::ProcessRequest(
     return this->RequestDataObject(request, inputVector, outputVector);
   }
 
+  // requested once per execution, unlike the data of each block.
+  if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+  {
+    this->Internals->ReleaseUnusedScalarTrees();
+  }
+
   return this->Superclass::ProcessRequest(request, inputVector, outputVector);
 }
 
@@ -179,6 +253,12 @@ int vtkPVContourFilter::RequestData(
     return 1;
   }
 
+  if (this->UseScalarTree)
+  {
+    return this->ContourUsingScalarTrees(inDataObj, outDataObj);
+  }
+  this->Internals->ScalarTrees.clear();
+
   // See if we can delegate to the faster vtkContour3DLinearGrid for this dataset and settings
   // Note: vtkContour3DLinearGrid does not support the ComputeScalars option.
   bool useLinear3DContour = this->ComputeScalars == 0 &&
@@ -257,21 +337,7 @@ int vtkPVContourFilter::ContourUsingSuperclass(
 {
   // instantiate the superclass so as to use the object factory
   vtkNew<Superclass> instance;
-  instance->SetNumberOfContours(this->GetNumberOfContours());
-  for (int i = 0; i < this->GetNumberOfContours(); ++i)
-  {
-    instance->SetValue(i, this->GetValue(i));
-  }
-  instance->SetComputeNormals(this->GetComputeNormals());
-  instance->SetComputeGradients(this->GetComputeGradients());
-  instance->SetComputeScalars(this->GetComputeScalars());
-  instance->SetUseScalarTree(this->GetUseScalarTree());
-  instance->SetScalarTree(this->GetScalarTree());
-  instance->SetLocator(this->GetLocator());
-  instance->SetArrayComponent(this->GetArrayComponent());
-  instance->SetGenerateTriangles(this->GetGenerateTriangles());
-  instance->SetOutputPointsPrecision(this->GetOutputPointsPrecision());
-  instance->SetInputArrayToProcess(0, this->GetInputArrayInformation(0));
+  CopyContourParameters(this, instance);
 
   vtkNew<vtkEventForwarderCommand> progressForwarder;
   progressForwarder->SetTarget(this);
@@ -310,6 +376,130 @@ int vtkPVContourFilter::ContourUsingSuperclass(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+int vtkPVContourFilter::ContourUsingScalarTrees(vtkDataObject* inputDO, vtkDataObject* outputDO)
+{
+  auto getScalarTree = [this](vtkDataSet* block) {
+    auto& entry = this->Internals->ScalarTrees[block];
+    if (!entry.Tree || (this->ScalarTree && !entry.Tree->IsA(this->ScalarTree->GetClassName())))
+    {
+      entry.Block = block;
+      if (this->ScalarTree)
+      {
+        entry.Tree = vtkSmartPointer<vtkScalarTree>::Take(this->ScalarTree->NewInstance());
+      }
+      else
+      {
+        entry.Tree = vtkSmartPointer<vtkSpanSpace>::New();
+      }
+    }
+    entry.Used = true;
+    return entry.Tree.GetPointer();
+  };
+
+  vtkCompositeDataSet* inputCD = vtkCompositeDataSet::SafeDownCast(inputDO);
+  if (!inputCD)
+  {
+    if (auto input = vtkDataSet::SafeDownCast(inputDO))
+    {
+      outputDO->ShallowCopy(this->ContourWithScalarTree(input, getScalarTree(input), 0.0, 1.0));
+    }
+    this->UpdateProgress(1.0);
+    return 1;
+  }
+
+  vtkCompositeDataSet* outputCD = vtkCompositeDataSet::SafeDownCast(outputDO);
+  outputCD->CopyStructure(inputCD);
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(inputCD->NewIterator());
+  int numberOfBlocks = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    numberOfBlocks += vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()) ? 1 : 0;
+  }
+
+  // each block accounts for the same share of the progress.
+  int index = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (auto block = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+    {
+      const double progressShift = static_cast<double>(index++) / numberOfBlocks;
+      this->UpdateProgress(progressShift);
+      outputCD->SetDataSet(iter,
+        this->ContourWithScalarTree(
+          block, getScalarTree(block), progressShift, 1.0 / numberOfBlocks));
+    }
+  }
+  this->UpdateProgress(1.0);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> vtkPVContourFilter::ContourWithScalarTree(
+  vtkDataSet* input, vtkScalarTree* tree, double progressShift, double progressScale)
+{
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+  vtkDataArray* scalars = this->GetInputArrayToProcess(0, input);
+  if (!scalars || input->GetNumberOfCells() == 0)
+  {
+    return output;
+  }
+
+  // Skip blocks that cannot contain any of the contour values.
+  if (scalars->GetNumberOfComponents() == 1)
+  {
+    double range[2];
+    scalars->GetRange(range, 0);
+    const double* values = this->GetValues();
+    if (std::none_of(values, values + this->GetNumberOfContours(),
+          [&range](double value) { return value >= range[0] && value <= range[1]; }))
+    {
+      return output;
+    }
+  }
+
+  vtkNew<vtkEventForwarderCommand> progressForwarder;
+  progressForwarder->SetTarget(this);
+
+  if (this->ComputeScalars == 0 &&
+    vtkContour3DLinearGrid::CanFullyProcessDataObject(input, scalars->GetName()))
+  {
+    vtkNew<vtkContour3DLinearGrid> linear3DContour;
+    linear3DContour->SetNumberOfContours(this->GetNumberOfContours());
+    for (int i = 0; i < this->GetNumberOfContours(); ++i)
+    {
+      linear3DContour->SetValue(i, this->GetValue(i));
+    }
+    linear3DContour->SetMergePoints(this->GetLocator() != nullptr);
+    linear3DContour->SetInterpolateAttributes(true);
+    linear3DContour->SetComputeNormals(this->GetComputeNormals());
+    linear3DContour->SetOutputPointsPrecision(this->GetOutputPointsPrecision());
+    linear3DContour->SetUseScalarTree(true);
+    linear3DContour->SetScalarTree(tree);
+    linear3DContour->SetInputArrayToProcess(0, this->GetInputArrayInformation(0));
+    linear3DContour->SetInputDataObject(input);
+    linear3DContour->SetProgressShiftScale(progressShift, progressScale);
+    linear3DContour->AddObserver(vtkCommand::ProgressEvent, progressForwarder);
+    linear3DContour->Update();
+    output->ShallowCopy(linear3DContour->GetOutputDataObject(0));
+    return output;
+  }
+
+  vtkNew<Superclass> instance;
+  CopyContourParameters(this, instance);
+  instance->SetScalarTree(tree);
+  instance->SetInputDataObject(input);
+  instance->SetProgressShiftScale(progressShift, progressScale);
+  instance->AddObserver(vtkCommand::ProgressEvent, progressForwarder);
+  instance->Update();
+  auto polydata = instance->GetOutput();
+  this->CleanOutputScalars(polydata->GetPointData()->GetScalars());
+  output->ShallowCopy(polydata);
+  return output;
+}
+
 //-----------------------------------------------------------------------------
 int vtkPVContourFilter::FillOutputPortInformation(int vtkNotUsed(port), vtkInformation* info)
 {
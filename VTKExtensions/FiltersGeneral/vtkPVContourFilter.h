@@ -33,6 +33,14 @@
  * - the contour array is one of the types supported by the vtkContour3DLinearGrid
  * - the ComputeScalars option is off
  *
+ * When `UseScalarTree` is on, the filter keeps a scalar tree (vtkSpanSpace by
+ * default, or instances of the type of the tree given to `SetScalarTree`) for
+ * each input block. Trees are only rebuilt when the block or its scalars are
+ * modified, so changing contour values only visits the cells that may
+ * contain them. Trees of blocks that are not contoured during an execution
+ * are released at the next one. Blocks whose scalar range contains none of
+ * the contour values are skipped altogether.
+ *
  * @warning
  * Certain flags in vtkAMRDualContour are assumed to be ON.
  *
@@ -45,6 +53,13 @@
 
 #include "vtkContourFilter.h"
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
+#include "vtkSmartPointer.h"                        // for vtkSmartPointer
+
+#include <memory> // for std::unique_ptr
+
+class vtkDataSet;
+class vtkPolyData;
+class vtkScalarTree;
 
 class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkPVContourFilter : public vtkContourFilter
 {
@@ -77,6 +92,20 @@ protected:
   int ContourUsingSuperclass(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector);
 
+  /**
+   * Contours each block of the input using the scalar tree kept for it.
+   * Called when `UseScalarTree` is on.
+   */
+  int ContourUsingScalarTrees(vtkDataObject* input, vtkDataObject* output);
+
+  /**
+   * Contours a single dataset using the given scalar tree. The progress of
+   * the internal filter is reported as this filter's progress, shifted and
+   * scaled by `progressShift` and `progressScale`.
+   */
+  vtkSmartPointer<vtkPolyData> ContourWithScalarTree(
+    vtkDataSet* input, vtkScalarTree* tree, double progressShift, double progressScale);
+
   /**
    * When `ComputeScalars` is true, the filter computes scalars for the
    * contours. However, due to interpolation errors, there's a small difference
@@ -90,6 +119,9 @@ protected:
 private:
   vtkPVContourFilter(const vtkPVContourFilter&) = delete;
   void operator=(const vtkPVContourFilter&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 #endif // vtkPVContourFilter_h
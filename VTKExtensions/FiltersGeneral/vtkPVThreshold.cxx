@@ -16,17 +16,115 @@
 #include "vtkPVThreshold.h"
 
 #include "vtkAppendFilter.h"
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridThreshold.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPartitionedDataSetCollection.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <limits>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Ranges ignore NaN values, which never satisfy the threshold criterion. The
+// values are scanned concurrently and the scan stops at the first NaN found.
+struct HasNaNWorker
+{
+  std::atomic<bool> Result{ false };
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    const vtkIdType numberOfValues = array->GetNumberOfValues();
+    vtkSMPTools::For(0, numberOfValues, [&](vtkIdType begin, vtkIdType end) {
+      if (this->Result.load(std::memory_order_relaxed))
+      {
+        return;
+      }
+      const auto values = vtk::DataArrayValueRange(array, begin, end);
+      if (std::any_of(
+            values.cbegin(), values.cend(), [](double value) { return std::isnan(value); }))
+      {
+        this->Result.store(true, std::memory_order_relaxed);
+      }
+    });
+  }
+};
+
+//----------------------------------------------------------------------------
+bool HasNaN(vtkDataArray* array)
+{
+  if (array->GetDataType() != VTK_FLOAT && array->GetDataType() != VTK_DOUBLE)
+  {
+    return false;
+  }
+  HasNaNWorker worker;
+  if (!vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::Reals>::Execute(array, worker))
+  {
+    worker(array);
+  }
+  return worker.Result.load();
+}
+
+//----------------------------------------------------------------------------
+// vtkThreshold drops the points no kept cell uses, so a grid can only be
+// passed through when all its points are used by some cell.
+template <typename ArrayT>
+bool UsesAllPoints(ArrayT* connectivity, vtkIdType numberOfPoints)
+{
+  std::vector<bool> used(numberOfPoints, false);
+  vtkIdType numberOfUsedPoints = 0;
+  for (const auto ptId : vtk::DataArrayValueRange<1>(connectivity))
+  {
+    if (ptId >= 0 && ptId < numberOfPoints && !used[ptId])
+    {
+      used[ptId] = true;
+      ++numberOfUsedPoints;
+    }
+  }
+  return numberOfUsedPoints == numberOfPoints;
+}
+
+bool UsesAllPoints(vtkUnstructuredGrid* grid)
+{
+  const vtkIdType numberOfPoints = grid->GetNumberOfPoints();
+  vtkCellArray* cells = grid->GetCells();
+  if (!cells || cells->GetNumberOfConnectivityIds() < numberOfPoints)
+  {
+    return numberOfPoints == 0;
+  }
+  return cells->IsStorage64Bit() ? UsesAllPoints(cells->GetConnectivityArray64(), numberOfPoints)
+                                 : UsesAllPoints(cells->GetConnectivityArray32(), numberOfPoints);
+}
+
+//----------------------------------------------------------------------------
+bool IsSupportedCompositeDataSet(vtkDataObject* dataObject)
+{
+  return vtkMultiBlockDataSet::SafeDownCast(dataObject) ||
+    vtkPartitionedDataSet::SafeDownCast(dataObject) ||
+    vtkPartitionedDataSetCollection::SafeDownCast(dataObject);
+}
+}
 
 vtkStandardNewMacro(vtkPVThreshold);
 
@@ -68,41 +166,245 @@ int vtkPVThreshold::RequestData(
     vtkErrorMacro(<< "Failed to get output data object.");
   }
 
-  if (vtkHyperTreeGrid::SafeDownCast(inDataObj))
+  if (auto htg = vtkHyperTreeGrid::SafeDownCast(inDataObj))
+  {
+    this->ThresholdHyperTreeGrid(htg, this->GetInputArrayInformation(0), outDataObj);
+    return 1;
+  }
+
+  auto inComposite = vtkCompositeDataSet::SafeDownCast(inDataObj);
+  auto outComposite = vtkCompositeDataSet::SafeDownCast(outDataObj);
+  if (inComposite && outComposite)
+  {
+    return this->ThresholdCompositeDataSet(inComposite, outComposite);
+  }
+
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVThreshold::ThresholdHyperTreeGrid(
+  vtkHyperTreeGrid* input, vtkInformation* arrayInfo, vtkDataObject* output)
+{
+  // Match behavior from vtkThreshold
+  vtkNew<vtkHyperTreeGridThreshold> thresholdFilter;
+  if (this->ThresholdFunction == &vtkThreshold::Lower)
+  {
+    thresholdFilter->ThresholdBetween(
+      -std::numeric_limits<double>::infinity(), this->LowerThreshold);
+  }
+  else if (this->ThresholdFunction == &vtkThreshold::Upper)
+  {
+    thresholdFilter->ThresholdBetween(this->UpperThreshold, std::numeric_limits<double>::infinity());
+  }
+  else if (this->ThresholdFunction == &vtkThreshold::Between)
+  {
+    thresholdFilter->ThresholdBetween(this->LowerThreshold, this->UpperThreshold);
+  }
+  else
+  {
+    vtkErrorMacro("Threshold function not found");
+  }
+
+  vtkDataObject* inputClone = input->NewInstance();
+  inputClone->ShallowCopy(input);
+  thresholdFilter->SetInputData(0, inputClone);
+  inputClone->FastDelete();
+
+  thresholdFilter->SetInputArrayToProcess(0, arrayInfo);
+  thresholdFilter->Update();
+  output->ShallowCopy(thresholdFilter->GetOutput(0));
+}
+
+//----------------------------------------------------------------------------
+int vtkPVThreshold::ThresholdCompositeDataSet(
+  vtkCompositeDataSet* input, vtkCompositeDataSet* output)
+{
+  output->CopyStructure(input);
+  vtkInformation* arrayInfo = this->GetInputArrayInformation(0);
+
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(input->NewIterator());
+  std::vector<vtkDataObject*> inputBlocks;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
   {
-    // Match behavior from vtkThreshold
-    vtkNew<vtkHyperTreeGridThreshold> thresholdFilter;
-    if (this->ThresholdFunction == &vtkThreshold::Lower)
+    inputBlocks.push_back(iter->GetCurrentDataObject());
+  }
+
+  // Resolve the blocks whose result is known from the range of their array.
+  // This is done serially since ranges are cached in the arrays, which can be
+  // shared between blocks.
+  std::vector<vtkSmartPointer<vtkDataObject>> outputBlocks(inputBlocks.size());
+  std::vector<size_t> blocksToThreshold;
+  for (size_t cc = 0; cc < inputBlocks.size(); ++cc)
+  {
+    auto dataSet = vtkDataSet::SafeDownCast(inputBlocks[cc]);
+    const int result = dataSet ? this->ClassifyBlock(dataSet, arrayInfo) : BLOCK_PARTIAL;
+    if (result == BLOCK_ALL_IN)
     {
-      thresholdFilter->ThresholdBetween(
-        -std::numeric_limits<double>::infinity(), this->LowerThreshold);
+      outputBlocks[cc] = vtkSmartPointer<vtkDataObject>::Take(dataSet->NewInstance());
+      outputBlocks[cc]->ShallowCopy(dataSet);
     }
-    else if (this->ThresholdFunction == &vtkThreshold::Upper)
+    else if (result == BLOCK_ALL_OUT)
     {
-      thresholdFilter->ThresholdBetween(
-        this->UpperThreshold, std::numeric_limits<double>::infinity());
+      auto empty = vtkSmartPointer<vtkUnstructuredGrid>::New();
+      empty->GetPointData()->CopyAllocate(dataSet->GetPointData(), 0);
+      empty->GetCellData()->CopyAllocate(dataSet->GetCellData(), 0);
+      outputBlocks[cc] = empty;
     }
-    else if (this->ThresholdFunction == &vtkThreshold::Between)
+    else if (dataSet || vtkHyperTreeGrid::SafeDownCast(inputBlocks[cc]))
     {
-      thresholdFilter->ThresholdBetween(this->LowerThreshold, this->UpperThreshold);
+      blocksToThreshold.push_back(cc);
     }
-    else
+  }
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocksToThreshold.size()),
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        const size_t index = blocksToThreshold[cc];
+        outputBlocks[index] = this->ThresholdBlock(inputBlocks[index], arrayInfo);
+      }
+    });
+
+  size_t index = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++index)
+  {
+    output->SetDataSet(iter, outputBlocks[index]);
+  }
+  this->UpdateProgress(1.0);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVThreshold::ThresholdBlock(
+  vtkDataObject* block, vtkInformation* arrayInfo)
+{
+  if (auto htg = vtkHyperTreeGrid::SafeDownCast(block))
+  {
+    auto output = vtkSmartPointer<vtkHyperTreeGrid>::New();
+    this->ThresholdHyperTreeGrid(htg, arrayInfo, output);
+    return output;
+  }
+
+  vtkNew<vtkThreshold> thresholdFilter;
+  thresholdFilter->SetInputArrayToProcess(0, arrayInfo);
+  thresholdFilter->SetLowerThreshold(this->LowerThreshold);
+  thresholdFilter->SetUpperThreshold(this->UpperThreshold);
+  thresholdFilter->SetThresholdFunction(this->GetThresholdFunction());
+  thresholdFilter->SetAllScalars(this->AllScalars);
+  thresholdFilter->SetUseContinuousCellRange(this->UseContinuousCellRange);
+  thresholdFilter->SetInvert(this->Invert);
+  thresholdFilter->SetComponentMode(this->ComponentMode);
+  thresholdFilter->SetSelectedComponent(this->SelectedComponent);
+  thresholdFilter->SetOutputPointsPrecision(this->OutputPointsPrecision);
+
+  vtkDataObject* inputClone = block->NewInstance();
+  inputClone->ShallowCopy(block);
+  thresholdFilter->SetInputData(0, inputClone);
+  inputClone->FastDelete();
+
+  thresholdFilter->Update();
+  return thresholdFilter->GetOutputDataObject(0);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVThreshold::ClassifyBlock(vtkDataSet* dataSet, vtkInformation* arrayInfo)
+{
+  // Passing a block through is only equivalent to thresholding it when the
+  // output would be an unstructured grid with the same points.
+  if (!arrayInfo || !arrayInfo->Has(vtkDataObject::FIELD_NAME()) ||
+    !vtkUnstructuredGrid::SafeDownCast(dataSet) ||
+    this->OutputPointsPrecision != vtkAlgorithm::DEFAULT_PRECISION ||
+    dataSet->GetNumberOfCells() == 0)
+  {
+    return BLOCK_PARTIAL;
+  }
+
+  const char* name = arrayInfo->Get(vtkDataObject::FIELD_NAME());
+  const int association = arrayInfo->Get(vtkDataObject::FIELD_ASSOCIATION());
+  vtkDataArray* array = nullptr;
+  bool usePointScalars = false;
+  if (association == vtkDataObject::FIELD_ASSOCIATION_POINTS ||
+    association == vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS)
+  {
+    array = dataSet->GetPointData()->GetArray(name);
+    usePointScalars = array != nullptr;
+  }
+  if (!array &&
+    (association == vtkDataObject::FIELD_ASSOCIATION_CELLS ||
+      association == vtkDataObject::FIELD_ASSOCIATION_POINTS_THEN_CELLS))
+  {
+    array = dataSet->GetCellData()->GetArray(name);
+  }
+  if (!array || array->GetNumberOfTuples() == 0 ||
+    (this->Invert && usePointScalars && this->UseContinuousCellRange))
+  {
+    return BLOCK_PARTIAL;
+  }
+
+  std::vector<int> components;
+  const int numberOfComponents = array->GetNumberOfComponents();
+  if (this->ComponentMode == vtkThreshold::COMPONENT_MODE_USE_SELECTED)
+  {
+    if (numberOfComponents > 1 && this->SelectedComponent >= numberOfComponents)
     {
-      vtkErrorMacro("Threshold function not found");
+      return BLOCK_PARTIAL;
     }
+    components.push_back(numberOfComponents > 1 ? this->SelectedComponent : 0);
+  }
+  else
+  {
+    for (int comp = 0; comp < numberOfComponents; ++comp)
+    {
+      components.push_back(comp);
+    }
+  }
 
-    vtkDataObject* inputClone = inDataObj->NewInstance();
-    inputClone->ShallowCopy(inDataObj);
-    thresholdFilter->SetInputData(0, inputClone);
-    inputClone->FastDelete();
-
-    thresholdFilter->SetInputArrayToProcess(0, this->GetInputArrayInformation(0));
-    thresholdFilter->Update();
-    outDataObj->ShallowCopy(thresholdFilter->GetOutput(0));
+  bool allIn = true;
+  bool allOut = true;
+  for (int comp : components)
+  {
+    double range[2];
+    array->GetRange(range, comp);
+    if (range[0] > range[1])
+    {
+      return BLOCK_PARTIAL;
+    }
+    switch (this->GetThresholdFunction())
+    {
+      case vtkThreshold::THRESHOLD_BETWEEN:
+        allIn &= range[0] >= this->LowerThreshold && range[1] <= this->UpperThreshold;
+        allOut &= range[1] < this->LowerThreshold || range[0] > this->UpperThreshold;
+        break;
+      case vtkThreshold::THRESHOLD_LOWER:
+        allIn &= range[1] <= this->LowerThreshold;
+        allOut &= range[0] > this->LowerThreshold;
+        break;
+      case vtkThreshold::THRESHOLD_UPPER:
+        allIn &= range[0] >= this->UpperThreshold;
+        allOut &= range[1] < this->UpperThreshold;
+        break;
+      default:
+        return BLOCK_PARTIAL;
+    }
+  }
 
-    return 1;
+  // NaN values are outside of any interval: they only matter when the range
+  // says every value is inside, so the array is scanned for them only then.
+  if ((!allIn && !allOut) || (allIn && HasNaN(array)))
+  {
+    return BLOCK_PARTIAL;
   }
-  return this->Superclass::RequestData(request, inputVector, outputVector);
+  if (this->Invert)
+  {
+    std::swap(allIn, allOut);
+  }
+  if (allIn && !UsesAllPoints(vtkUnstructuredGrid::SafeDownCast(dataSet)))
+  {
+    return BLOCK_PARTIAL;
+  }
+  return allIn ? BLOCK_ALL_IN : BLOCK_ALL_OUT;
 }
 
 //----------------------------------------------------------------------------
@@ -131,7 +433,19 @@ int vtkPVThreshold::RequestDataObject(vtkInformation* vtkNotUsed(request),
 
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
 
-  if (vtkHyperTreeGrid::GetData(inInfo))
+  vtkDataObject* input = vtkDataObject::GetData(inInfo);
+  if (IsSupportedCompositeDataSet(input))
+  {
+    vtkDataObject* output = vtkDataObject::GetData(outInfo);
+    if (!output || !output->IsA(input->GetClassName()))
+    {
+      output = input->NewInstance();
+      outInfo->Set(vtkDataObject::DATA_OBJECT(), output);
+      output->FastDelete();
+    }
+    return 1;
+  }
+  else if (vtkHyperTreeGrid::GetData(inInfo))
   {
     vtkHyperTreeGrid* output = vtkHyperTreeGrid::GetData(outInfo);
     if (!output)
@@ -165,6 +479,10 @@ int vtkPVThreshold::FillInputPortInformation(int port, vtkInformation* info)
 {
   this->Superclass::FillInputPortInformation(port, info);
   info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkHyperTreeGrid");
+  // Other composite datasets, such as AMR, are iterated over by the pipeline.
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkMultiBlockDataSet");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPartitionedDataSet");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPartitionedDataSetCollection");
   return 1;
 }
 
@@ -18,14 +18,26 @@
  *
  * This is a subclass of vtkThreshold that allows to apply threshold filters
  * to either vtkDataSet or vtkHyperTreeGrid.
+ *
+ * Multiblock and partitioned datasets are processed as a whole rather than
+ * block by block. The range of the thresholded array, which vtkDataArray
+ * caches until the array is modified, is first used to pass blocks entirely
+ * within the threshold interval and to skip blocks entirely outside of it
+ * without visiting their cells. The remaining blocks are thresholded
+ * concurrently using vtkSMPTools.
  */
 
 #ifndef vtkPVThreshold_h
 #define vtkPVThreshold_h
 
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
+#include "vtkSmartPointer.h"                        // for vtkSmartPointer
 #include "vtkThreshold.h"
 
+class vtkCompositeDataSet;
+class vtkDataSet;
+class vtkHyperTreeGrid;
+
 class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkPVThreshold : public vtkThreshold
 {
 public:
@@ -45,6 +57,41 @@ protected:
 
   virtual int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*);
 
+  /**
+   * Outcome of the threshold of a whole block, as predicted from the range of
+   * its array.
+   */
+  enum BlockThresholdResult
+  {
+    BLOCK_PARTIAL,
+    BLOCK_ALL_IN,
+    BLOCK_ALL_OUT
+  };
+
+  /**
+   * Predicts the result of the threshold of `dataSet` from the range of the
+   * array described by `arrayInfo`. Returns `BLOCK_PARTIAL` whenever cells
+   * have to be visited, including when the whole block would be kept but has
+   * points no cell uses, which thresholding drops.
+   */
+  virtual int ClassifyBlock(vtkDataSet* dataSet, vtkInformation* arrayInfo);
+
+  /**
+   * Thresholds every leaf of a composite dataset into `output`, which must
+   * have the same type as `input`.
+   */
+  int ThresholdCompositeDataSet(vtkCompositeDataSet* input, vtkCompositeDataSet* output);
+
+  /**
+   * Thresholds a single dataset or hyper tree grid and returns the result.
+   * This does not modify the state of the filter and can be called
+   * concurrently for different blocks.
+   */
+  vtkSmartPointer<vtkDataObject> ThresholdBlock(vtkDataObject* block, vtkInformation* arrayInfo);
+
+  void ThresholdHyperTreeGrid(
+    vtkHyperTreeGrid* input, vtkInformation* arrayInfo, vtkDataObject* output);
+
 private:
   vtkPVThreshold(const vtkPVThreshold&) = delete;
   void operator=(const vtkPVThreshold&) = delete;
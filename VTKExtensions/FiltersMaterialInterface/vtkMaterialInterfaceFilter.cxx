@@ -18,6 +18,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessControllerHelper.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -66,11 +67,13 @@
 #include "vtkClipPolyData.h"
 #include "vtkContourFilter.h"
 #include "vtkDataSetSurfaceFilter.h"
+#include "vtkDistributedUnionFind.h"
 #include "vtkMarchingCubesTriangleCases.h"
 #include "vtkOBBTree.h"
 #include "vtkTriangleFilter.h"
 // STL
 #include <fstream>
+#include <map>
 using std::ofstream;
 #include <sstream>
 using std::ostringstream;
@@ -266,6 +269,10 @@ public:
   // You cannot add anymore equivalences after this is called.
   int ResolveEquivalences();
 
+  // Replaces the set with already resolved set ids of the members
+  // [offset, offset + ids.size()).
+  void SetResolvedIds(int offset, const std::vector<vtkIdType>& ids);
+
   void DeepCopy(vtkMaterialInterfaceEquivalenceSet* in);
 
   // Needed for sending the set over MPI.
@@ -282,6 +289,9 @@ public:
   int Resolved;
 
 private:
+  // Id of the first member stored in the array.
+  int MemberOffset;
+
   // To merge connected framgments that have different ids because they were
   // traversed by different processes or passes.
   vtkIntArray* EquivalenceArray;
@@ -295,6 +305,7 @@ private:
 vtkMaterialInterfaceEquivalenceSet::vtkMaterialInterfaceEquivalenceSet()
 {
   this->Resolved = 0;
+  this->MemberOffset = 0;
   this->EquivalenceArray = vtkIntArray::New();
 }
 
@@ -313,6 +324,7 @@ vtkMaterialInterfaceEquivalenceSet::~vtkMaterialInterfaceEquivalenceSet()
 void vtkMaterialInterfaceEquivalenceSet::Initialize()
 {
   this->Resolved = 0;
+  this->MemberOffset = 0;
   this->EquivalenceArray->Initialize();
 }
 
@@ -320,9 +332,24 @@ void vtkMaterialInterfaceEquivalenceSet::Initialize()
 void vtkMaterialInterfaceEquivalenceSet::DeepCopy(vtkMaterialInterfaceEquivalenceSet* in)
 {
   this->Resolved = in->Resolved;
+  this->MemberOffset = in->MemberOffset;
   this->EquivalenceArray->DeepCopy(in->EquivalenceArray);
 }
 
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceEquivalenceSet::SetResolvedIds(
+  int offset, const std::vector<vtkIdType>& ids)
+{
+  const int numIds = static_cast<int>(ids.size());
+  this->EquivalenceArray->SetNumberOfTuples(numIds);
+  for (int ii = 0; ii < numIds; ++ii)
+  {
+    this->EquivalenceArray->SetValue(ii, static_cast<int>(ids[ii]));
+  }
+  this->MemberOffset = offset;
+  this->Resolved = 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceEquivalenceSet::Print()
 {
@@ -355,11 +382,12 @@ int vtkMaterialInterfaceEquivalenceSet::GetEquivalentSetId(int memberId)
 // Return the id of the equivalent set.
 int vtkMaterialInterfaceEquivalenceSet::GetReference(int memberId)
 {
-  if (memberId >= this->EquivalenceArray->GetNumberOfTuples())
+  const int index = memberId - this->MemberOffset;
+  if (index < 0 || index >= this->EquivalenceArray->GetNumberOfTuples())
   { // We might consider this an error ...
     return memberId;
   }
-  return this->EquivalenceArray->GetValue(memberId);
+  return this->EquivalenceArray->GetValue(index);
 }
 
 //----------------------------------------------------------------------------
@@ -8248,6 +8276,12 @@ void vtkMaterialInterfaceFilter::ResolveEquivalences()
 //----------------------------------------------------------------------------
 // This also fills in the arrays NumberOfRawFragments and LocalToGlobalOffsets
 // as a side effect. (also NumberOfResolvedFragments).
+//
+// Fragment ids are resolved with a distributed union-find: each process owns
+// the global ids of its own fragments and only exchanges messages with the
+// processes it shares ghost blocks with. Afterwards, the set holds the
+// resolved ids of the local fragments, and of all fragments on process 0
+// which resolves the integrated attributes.
 void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* set)
 {
 #ifdef vtkMaterialInterfaceFilterDEBUG
@@ -8264,246 +8298,127 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   const int numLocalMembers = set->GetNumberOfMembers();
 
   // Find a mapping between local fragment id and the global fragment ids.
-  if (myProcId == 0)
-  {
-    this->NumberOfRawFragmentsInProcess[0] = numLocalMembers;
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Receive(this->NumberOfRawFragmentsInProcess + ii, 1, ii, 875034);
-    }
-    // Now send the results back to all processes.
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Send(this->NumberOfRawFragmentsInProcess, numProcs, ii, 875035);
-    }
-  }
-  else
-  {
-    this->Controller->Send(&numLocalMembers, 1, 0, 875034);
-    this->Controller->Receive(this->NumberOfRawFragmentsInProcess, numProcs, 0, 875035);
-  }
-  // Compute offsets.
-  int totalNumberOfIds = 0;
+  vtkDistributedUnionFind unionFind;
+  unionFind.Initialize(this->Controller, numLocalMembers);
   for (int ii = 0; ii < numProcs; ++ii)
   {
-    int numIds = this->NumberOfRawFragmentsInProcess[ii];
-    this->LocalToGlobalOffsets[ii] = totalNumberOfIds;
-    totalNumberOfIds += numIds;
+    this->NumberOfRawFragmentsInProcess[ii] = static_cast<int>(unionFind.GetNumberOfLocalIds(ii));
+    this->LocalToGlobalOffsets[ii] = static_cast<int>(unionFind.GetGlobalOffset(ii));
   }
-  this->TotalNumberOfRawFragments = totalNumberOfIds;
+  this->TotalNumberOfRawFragments = static_cast<int>(unionFind.GetNumberOfGlobalIds());
 
-  // Change the set to a global set.
-  vtkMaterialInterfaceEquivalenceSet* globalSet = new vtkMaterialInterfaceEquivalenceSet;
-  // This just initializes the set so that every set has one member.
-  //  Every id is equivalent to itself and no others.
-  if (totalNumberOfIds > 0)
-  { // This crashes if there no fragemnts extracted.
-    globalSet->AddEquivalence(totalNumberOfIds - 1, totalNumberOfIds - 1);
-  }
   // Add the equivalences from our process.
-  int myOffset = this->LocalToGlobalOffsets[myProcId];
-  int memberSetId;
+  const int myOffset = this->LocalToGlobalOffsets[myProcId];
   for (int ii = 0; ii < numLocalMembers; ++ii)
   {
-    memberSetId = set->GetEquivalentSetId(ii);
-    // This will be inefficient until I make the scheduled improvemnt to the
-    // add method (Ordered multilevel tree instead of a one level tree).
-    globalSet->AddEquivalence(ii + myOffset, memberSetId + myOffset);
+    const int memberSetId = set->GetEquivalentSetId(ii);
+    if (memberSetId != ii)
+    {
+      unionFind.AddEquivalence(ii + myOffset, memberSetId + myOffset);
+    }
   }
 
-  // cerr << myProcId << " Input set: " << endl;
-  // set->Print();
-  // cerr << myProcId << " global set: " << endl;
-  // globalSet->Print();
-
   // Now add equivalents between processes.
   // Send all the ghost blocks to the process that owns the block.
   // Compare ids and add the equivalences.
-  this->ShareGhostEquivalences(globalSet, this->LocalToGlobalOffsets);
-
-  // cerr << "Global after ghost: " << myProcId << endl;
-  // globalSet->Print();
-
-  // Merge all of the processes global sets.
-  // Clean the global set so that the resulting set ids are sequential.
-  this->MergeGhostEquivalenceSets(globalSet);
+  this->ShareGhostEquivalences(&unionFind);
 
-  // cerr << "Global after merge: " << myProcId << endl;
-  // globalSet->Print();
+  // Merge the equivalences across processes.
+  // The resulting set ids are sequential.
+  this->NumberOfResolvedFragments = static_cast<int>(unionFind.Resolve());
 
-  // free what do not need
-  globalSet->Squeeze();
-
-  // Copy the equivalences to the local set for returning our results.
+  // Copy the resolved ids to the local set for returning our results.
   // The ids will be the global ids so the GetId method will work.
-  set->DeepCopy(globalSet);
-
-  delete globalSet;
-}
-
-//----------------------------------------------------------------------------
-void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
-  vtkMaterialInterfaceEquivalenceSet* globalSet)
-{
-  const int myProcId = this->Controller->GetLocalProcessId();
-  int* buf = globalSet->GetPointer();
-  const int numIds = globalSet->GetNumberOfMembers();
-
-  // At this point all the sets are global and have the same number of ids.
-  // Send all the sets to process 0 to be merged.
-  if (myProcId > 0)
-  {
-    this->Controller->Send(buf, numIds, 0, 342320);
-    // Now receive the final equivalences.
-    this->Controller->Receive(&this->NumberOfResolvedFragments, 1, 0, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Receive(buf, numIds, 0, 342322);
-    // We have to mark the set as resolved because the set being
-    // received has been resolved.  If we do not do this then
-    // We cannot get the proper set id.  Using the pointer
-    // here is a bad api.  TODO: Fix the API and make "Resolved" private.
-    globalSet->Resolved = 1;
-    return;
+  // Each process resolves its own ids, which are sent to process 0 since it
+  // resolves the integrated attributes of all fragments.
+  std::vector<vtkIdType> ids(numLocalMembers);
+  for (int ii = 0; ii < numLocalMembers; ++ii)
+  {
+    ids[ii] = unionFind.GetSetId(ii + myOffset);
   }
-
-  // Only process 0 from here out.
-
-  int numProcs = this->Controller->GetNumberOfProcesses();
-  int* tmp;
-  tmp = new int[numIds];
-  for (int ii = 1; ii < numProcs; ++ii)
+  if (myProcId != 0)
   {
-    this->Controller->Receive(tmp, numIds, ii, 342320);
-    // Merge the values.
-    for (int jj = 0; jj < numIds; ++jj)
+    if (numLocalMembers > 0)
     {
-      if (tmp[jj] != jj)
-      { // TODO: Make sure this is efficient.  Avoid n^2.
-        globalSet->AddEquivalence(jj, tmp[jj]);
-      }
+      this->Controller->Send(ids.data(), numLocalMembers, 0, 722267);
     }
+    set->SetResolvedIds(myOffset, ids);
+    return;
   }
-  delete[] tmp;
-
-  // Make the set ids sequential.
-  this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
 
-  // The pointers should still be valid.
-  // The array should not resize here.
-  // Number of resolved fragemnts will be smaller
-  // than TotalNumberOfRawFragments
+  ids.resize(this->TotalNumberOfRawFragments);
   for (int ii = 1; ii < numProcs; ++ii)
   {
-    this->Controller->Send(&this->NumberOfResolvedFragments, 1, ii, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Send(buf, numIds, ii, 342322);
+    if (this->NumberOfRawFragmentsInProcess[ii] > 0)
+    {
+      this->Controller->Receive(ids.data() + this->LocalToGlobalOffsets[ii],
+        this->NumberOfRawFragmentsInProcess[ii], ii, 722267);
+    }
   }
+  set->SetResolvedIds(0, ids);
 }
 
 //----------------------------------------------------------------------------
-void vtkMaterialInterfaceFilter::ShareGhostEquivalences(
-  vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets)
+// Send all the ghost blocks to the process that owns the block and
+// find the equivalences. Only processes sharing ghost blocks communicate.
+void vtkMaterialInterfaceFilter::ShareGhostEquivalences(vtkDistributedUnionFind* unionFind)
 {
-  const int numProcs = this->Controller->GetNumberOfProcesses();
   const int myProcId = this->Controller->GetLocalProcessId();
-  int sendMsg[8];
 
-  // Loop through the other processes.
-  for (int otherProc = 0; otherProc < numProcs; ++otherProc)
+  // Each record is the remote block id, the ghost cell extent followed by
+  // the fragment ids of the ghost block.
+  std::map<int, std::vector<vtkIdType>> sendBuffers;
+  int num = static_cast<int>(this->GhostBlocks.size());
+  for (int blockId = 0; blockId < num; ++blockId)
   {
-    if (otherProc == myProcId)
+    vtkMaterialInterfaceFilterBlock* block = this->GhostBlocks[blockId];
+    if (block && block->GetGhostFlag() && block->GetOwnerProcessId() != myProcId)
     {
-      this->ReceiveGhostFragmentIds(globalSet, procOffsets);
+      std::vector<vtkIdType>& buffer = sendBuffers[block->GetOwnerProcessId()];
+      // Since this is a ghost block, the remote block id
+      // will be different than the id we use.
+      // We just want to make it easy for the process that owns this block
+      // to match the ghost block with the original.
+      buffer.push_back(block->GetBlockId());
+      int ext[6];
+      block->GetCellExtent(ext);
+      buffer.insert(buffer.end(), ext, ext + 6);
+      const int* fragmentIds = block->GetFragmentIdPointer();
+      buffer.insert(buffer.end(), fragmentIds,
+        fragmentIds + (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1));
     }
-    else
-    {
-      // Loop through our ghost blocks sending the
-      // ones that are owned by otherProc.
-      int num = static_cast<int>(this->GhostBlocks.size());
-      for (int blockId = 0; blockId < num; ++blockId)
-      {
-        vtkMaterialInterfaceFilterBlock* block = this->GhostBlocks[blockId];
-        if (block && block->GetOwnerProcessId() == otherProc && block->GetGhostFlag())
-        {
-          sendMsg[0] = myProcId;
-          // Since this is a ghost block, the remote block id
-          // will be different than the id we use.
-          // We just want to make it easy for the process that owns this block
-          // to match the ghost block with the aoriginal.
-          sendMsg[1] = block->GetBlockId();
-          int* ext = sendMsg + 2;
-          block->GetCellExtent(ext);
-          this->Controller->Send(sendMsg, 8, otherProc, 722265);
-          // Now send the fragment id array.
-          int* framentIds = block->GetFragmentIdPointer();
-          this->Controller->Send(framentIds,
-            (ext[1] - ext[0] + 1) * (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1), otherProc,
-            722266);
-        } // End if ghost  block owned by other process.
-      }   // End loop over all blocks.
-      // Send the message that indicates we have nothing more to send.
-      sendMsg[0] = myProcId;
-      sendMsg[1] = -1;
-      this->Controller->Send(sendMsg, 8, otherProc, 722265);
-    } // End if we should send or receive.
-  }   // End loop over all processes.
-}
+  }
 
-//----------------------------------------------------------------------------
-// Receive all the gost blocks from remote processes and
-// find the equivalences.
-void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
-  vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets)
-{
-  int msg[8];
-  int otherProc;
-  int blockId;
-  vtkMaterialInterfaceFilterBlock* block;
-  int bufSize = 0;
-  int* buf = nullptr;
-  int dataSize;
-  int* remoteExt;
-  int localId, remoteId;
-  const int myProcId = this->Controller->GetLocalProcessId();
-  int localOffset = procOffsets[myProcId];
-  int remoteOffset;
+  std::map<int, std::vector<vtkIdType>> receiveBuffers;
+  vtkMultiProcessControllerHelper::ExchangeSparse(
+    this->Controller, sendBuffers, receiveBuffers, 722265);
 
-  // We do not receive requests from our own process.
-  int remainingProcs = this->Controller->GetNumberOfProcesses() - 1;
-  while (remainingProcs != 0)
+  const int localOffset = this->LocalToGlobalOffsets[myProcId];
+  for (const auto& item : receiveBuffers)
   {
-    this->Controller->Receive(msg, 8, vtkMultiProcessController::ANY_SOURCE, 722265);
-    otherProc = msg[0];
-    blockId = msg[1];
-    if (blockId == -1)
-    {
-      --remainingProcs;
-    }
-    else
+    const int remoteOffset = this->LocalToGlobalOffsets[item.first];
+    const vtkIdType* record = item.second.data();
+    const vtkIdType* end = record + item.second.size();
+    while (record < end)
     {
       // Find the block.
-      block = this->InputBlocks[blockId];
+      vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[record[0]];
+      int remoteExt[6];
+      std::copy(record + 1, record + 7, remoteExt);
+      record += 7;
+      const vtkIdType dataSize = static_cast<vtkIdType>(remoteExt[1] - remoteExt[0] + 1) *
+        (remoteExt[3] - remoteExt[2] + 1) * (remoteExt[5] - remoteExt[4] + 1);
+      const vtkIdType* remoteFragmentIds = record;
+      record += dataSize;
       if (block == nullptr)
-      { // Sanity check. This will lock up!
-        vtkErrorMacro("Missing block request.");
-        return;
-      }
-      // Receive the ghost fragment ids.
-      remoteExt = msg + 2;
-      dataSize = (remoteExt[1] - remoteExt[0] + 1) * (remoteExt[3] - remoteExt[2] + 1) *
-        (remoteExt[5] - remoteExt[4] + 1);
-      if (bufSize < dataSize)
       {
-        delete[] buf;
-        buf = new int[dataSize];
-        bufSize = dataSize;
+        vtkErrorMacro("Missing block request.");
+        continue;
       }
-      remoteOffset = procOffsets[otherProc];
-      this->Controller->Receive(buf, dataSize, otherProc, 722266);
+
       // We have our block, and the remote fragmentIds.
       // Now for the equivalences.
       // Loop through all of the voxels.
-      int* remoteFragmentIds = buf;
       int* localFragmentIds = block->GetFragmentIdPointer();
       int localExt[6];
       int localIncs[3];
@@ -8522,11 +8437,11 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
           for (int ix = remoteExt[0]; ix <= remoteExt[1]; ++ix)
           {
             // Convert local fragment ids to global ids.
-            localId = *px;
-            remoteId = *remoteFragmentIds;
+            const int localId = *px;
+            const vtkIdType remoteId = *remoteFragmentIds;
             if (localId >= 0 && remoteId >= 0)
             {
-              globalSet->AddEquivalence(localId + localOffset, remoteId + remoteOffset);
+              unionFind->AddEquivalence(localId + localOffset, remoteId + remoteOffset);
             }
             ++remoteFragmentIds;
             ++px;
@@ -8537,7 +8452,6 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
       }
     }
   }
-  delete[] buf;
 }
 
 //----------------------------------------------------------------------------
@@ -62,6 +62,7 @@ class vtkMaterialInterfaceLevel;
 class vtkMaterialInterfaceFilterBlock;
 class vtkMaterialInterfaceFilterIterator;
 class vtkMaterialInterfaceEquivalenceSet;
+class vtkDistributedUnionFind;
 class vtkMaterialInterfaceFilterRingBuffer;
 class vtkMaterialInterfacePieceLoading;
 class vtkMaterialInterfaceCommBuffer;
@@ -393,9 +394,7 @@ protected:
   //
   void ResolveEquivalences();
   void GatherEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* set);
-  void ShareGhostEquivalences(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets);
-  void ReceiveGhostFragmentIds(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffset);
-  void MergeGhostEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* globalSet);
+  void ShareGhostEquivalences(vtkDistributedUnionFind* unionFind);
 
   // Sum/finalize attribute's contribution for those
   // which are split over multiple processes.
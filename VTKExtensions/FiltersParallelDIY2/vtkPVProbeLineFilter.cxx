@@ -15,23 +15,152 @@
 
 #include "vtkPVProbeLineFilter.h"
 
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
 #include "vtkDemandDrivenPipeline.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLineSource.h"
+#include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProbeLineFilter.h"
 
+#include <algorithm>
+
+//----------------------------------------------------------------------------
+struct vtkPVProbeLineFilter::vtkInternals
+{
+  /**
+   * Everything the result of a probe depends on.
+   */
+  struct ProbeParameters
+  {
+    vtkDataObject* Input = nullptr;
+    vtkMTimeType InputMTime = 0;
+    double Point1[3] = { 0, 0, 0 };
+    double Point2[3] = { 0, 0, 0 };
+    int SamplingPattern = -1;
+    int LineResolution = 0;
+    bool PassPartialArrays = false;
+    bool PassCellArrays = false;
+    bool PassPointArrays = false;
+    bool PassFieldArrays = false;
+    bool ComputeTolerance = false;
+    double Tolerance = 0.0;
+
+    /**
+     * Returns true when both probes traverse the same cells, i.e. when all
+     * parameters but the resolution match.
+     */
+    bool HasSameTraversal(const ProbeParameters& other) const
+    {
+      return this->Input == other.Input && this->InputMTime == other.InputMTime &&
+        std::equal(this->Point1, this->Point1 + 3, other.Point1) &&
+        std::equal(this->Point2, this->Point2 + 3, other.Point2) &&
+        this->SamplingPattern == other.SamplingPattern &&
+        this->PassPartialArrays == other.PassPartialArrays &&
+        this->PassCellArrays == other.PassCellArrays &&
+        this->PassPointArrays == other.PassPointArrays &&
+        this->PassFieldArrays == other.PassFieldArrays &&
+        this->ComputeTolerance == other.ComputeTolerance && this->Tolerance == other.Tolerance;
+    }
+  };
+
+  ProbeParameters Previous;
+  vtkNew<vtkPolyData> PreviousOutput;
+
+  /**
+   * Returns the stride to apply to the previous output to obtain the result of
+   * a probe with the given parameters, or 0 if the input must be probed again.
+   */
+  vtkIdType GetReuseStride(const ProbeParameters& params) const
+  {
+    if (!params.HasSameTraversal(this->Previous))
+    {
+      return 0;
+    }
+    if (params.SamplingPattern != vtkProbeLineFilter::SAMPLE_LINE_UNIFORMLY ||
+      params.LineResolution == this->Previous.LineResolution)
+    {
+      return 1;
+    }
+    if (params.LineResolution <= 0 || this->Previous.LineResolution % params.LineResolution != 0)
+    {
+      return 0;
+    }
+    // Uniform samples of the coarser line are a subset of the previous ones.
+    // Processes may hold no part of the result, otherwise it must be a single
+    // polyline with one point per sample.
+    const vtkIdType numberOfPoints = this->PreviousOutput->GetNumberOfPoints();
+    if (numberOfPoints != 0 &&
+      (numberOfPoints != this->Previous.LineResolution + 1 ||
+        this->PreviousOutput->GetNumberOfCells() != 1))
+    {
+      return 0;
+    }
+    return this->Previous.LineResolution / params.LineResolution;
+  }
+
+  /**
+   * Fills `output` with every `stride`-th sample of the previous output.
+   */
+  void Subsample(vtkIdType stride, vtkPolyData* output) const
+  {
+    vtkPolyData* input = this->PreviousOutput;
+    if (stride == 1 || input->GetNumberOfPoints() == 0)
+    {
+      output->ShallowCopy(input);
+      return;
+    }
+
+    const vtkIdType numberOfPoints = (input->GetNumberOfPoints() - 1) / stride + 1;
+    vtkNew<vtkIdList> sourceIds;
+    vtkNew<vtkIdList> destinationIds;
+    sourceIds->SetNumberOfIds(numberOfPoints);
+    destinationIds->SetNumberOfIds(numberOfPoints);
+    vtkNew<vtkPoints> points;
+    points->SetDataType(input->GetPoints()->GetDataType());
+    points->SetNumberOfPoints(numberOfPoints);
+    vtkNew<vtkCellArray> lines;
+    lines->InsertNextCell(numberOfPoints);
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      sourceIds->SetId(i, i * stride);
+      destinationIds->SetId(i, i);
+      points->SetPoint(i, input->GetPoint(i * stride));
+      lines->InsertCellPoint(i);
+    }
+
+    output->Initialize();
+    output->SetPoints(points);
+    output->SetLines(lines);
+    output->GetPointData()->CopyAllocate(input->GetPointData(), numberOfPoints);
+    output->GetPointData()->CopyData(input->GetPointData(), sourceIds, destinationIds);
+    output->GetCellData()->ShallowCopy(input->GetCellData());
+    output->GetFieldData()->ShallowCopy(input->GetFieldData());
+  }
+};
+
 vtkStandardNewMacro(vtkPVProbeLineFilter);
 
 //----------------------------------------------------------------------------
 vtkPVProbeLineFilter::vtkPVProbeLineFilter()
+  : Internals(new vtkInternals())
 {
   this->LineSource->SetResolution(1);
   this->Prober->SetAggregateAsPolyData(true);
   this->Prober->SetSourceConnection(this->LineSource->GetOutputPort());
 }
 
+//----------------------------------------------------------------------------
+vtkPVProbeLineFilter::~vtkPVProbeLineFilter() = default;
+
 //----------------------------------------------------------------------------
 int vtkPVProbeLineFilter::RequestData(
   vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -53,21 +182,65 @@ int vtkPVProbeLineFilter::RequestData(
     return 0;
   }
 
-  this->LineSource->SetPoint1(this->Point1);
-  this->LineSource->SetPoint2(this->Point2);
-  this->Prober->SetLineResolution(this->LineResolution);
-  this->Prober->SetPassCellArrays(this->PassCellArrays);
-  this->Prober->SetPassPointArrays(this->PassPointArrays);
-  this->Prober->SetPassFieldArrays(this->PassFieldArrays);
-  this->Prober->SetPassPartialArrays(this->PassPartialArrays);
-  this->Prober->SetTolerance(this->Tolerance);
-  this->Prober->SetComputeTolerance(this->ComputeTolerance);
-  this->Prober->SetSamplingPattern(this->SamplingPattern);
+  vtkInternals::ProbeParameters params;
+  params.Input = input;
+  params.InputMTime = input->GetMTime();
+  std::copy(this->Point1, this->Point1 + 3, params.Point1);
+  std::copy(this->Point2, this->Point2 + 3, params.Point2);
+  params.SamplingPattern = this->SamplingPattern;
+  params.LineResolution = this->LineResolution;
+  params.PassPartialArrays = this->PassPartialArrays;
+  params.PassCellArrays = this->PassCellArrays;
+  params.PassPointArrays = this->PassPointArrays;
+  params.PassFieldArrays = this->PassFieldArrays;
+  params.ComputeTolerance = this->ComputeTolerance;
+  params.Tolerance = this->Tolerance;
+  if (this->Interacting)
+  {
+    std::copy(this->PreviewPoint1, this->PreviewPoint1 + 3, params.Point1);
+    std::copy(this->PreviewPoint2, this->PreviewPoint2 + 3, params.Point2);
+    if (this->InteractiveLineResolution > 0)
+    {
+      params.SamplingPattern = vtkProbeLineFilter::SAMPLE_LINE_UNIFORMLY;
+      params.LineResolution = std::min(this->LineResolution, this->InteractiveLineResolution);
+    }
+  }
+
+  // Probing is collective, so the previous result is only reused if all
+  // processes can reuse theirs.
+  int stride = static_cast<int>(this->Internals->GetReuseStride(params));
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    int localStride = stride;
+    controller->AllReduce(&localStride, &stride, 1, vtkCommunicator::MIN_OP);
+  }
+
+  if (stride > 0)
+  {
+    vtkDebugMacro("Reusing previous probe with a stride of " << stride);
+    this->Internals->Subsample(stride, output);
+    return 1;
+  }
+
+  this->LineSource->SetPoint1(params.Point1);
+  this->LineSource->SetPoint2(params.Point2);
+  this->Prober->SetLineResolution(params.LineResolution);
+  this->Prober->SetPassCellArrays(params.PassCellArrays);
+  this->Prober->SetPassPointArrays(params.PassPointArrays);
+  this->Prober->SetPassFieldArrays(params.PassFieldArrays);
+  this->Prober->SetPassPartialArrays(params.PassPartialArrays);
+  this->Prober->SetTolerance(params.Tolerance);
+  this->Prober->SetComputeTolerance(params.ComputeTolerance);
+  this->Prober->SetSamplingPattern(params.SamplingPattern);
 
   this->Prober->SetInputData(input);
   this->Prober->Update();
   output->ShallowCopy(this->Prober->GetOutputDataObject(0));
 
+  this->Internals->Previous = params;
+  this->Internals->PreviousOutput->ShallowCopy(output);
+
   return 1;
 }
 
@@ -111,4 +284,10 @@ void vtkPVProbeLineFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PassFieldArrays: " << this->PassFieldArrays << endl;
   os << indent << "ComputeTolerance: " << this->ComputeTolerance << endl;
   os << indent << "Tolerance: " << this->Tolerance << endl;
+  os << indent << "PreviewPoint1: " << this->PreviewPoint1[0] << " " << this->PreviewPoint1[1]
+     << " " << this->PreviewPoint1[2] << endl;
+  os << indent << "PreviewPoint2: " << this->PreviewPoint2[0] << " " << this->PreviewPoint2[1]
+     << " " << this->PreviewPoint2[2] << endl;
+  os << indent << "Interacting: " << this->Interacting << endl;
+  os << indent << "InteractiveLineResolution: " << this->InteractiveLineResolution << endl;
 }
@@ -19,6 +19,16 @@
  * Internal Paraview filters for API backward compatibilty and ease of use.
  * Internally build a line source as well as a vtkProbeLineFilter and exposes
  * their properties.
+ *
+ * The result of the last probe is kept so that changing only the
+ * `LineResolution` does not traverse the input again: sampling patterns other
+ * than `SAMPLE_LINE_UNIFORMLY` do not depend on the resolution, and a uniform
+ * sampling can be extracted from a previous one when the previous resolution
+ * is a multiple of the new one. While `Interacting` is set, the line from
+ * `PreviewPoint1` to `PreviewPoint2` is sampled uniformly at the coarser
+ * `InteractiveLineResolution` instead, which keeps dragging the line widget
+ * responsive on large meshes without changing `Point1` and `Point2`; the full
+ * sampling of the applied line is computed once `Interacting` is cleared.
  */
 
 #ifndef vtkPVProbeLineFilter_h
@@ -28,6 +38,8 @@
 #include "vtkPVVTKExtensionsFiltersParallelDIY2Module.h" //needed for exports
 #include "vtkPolyDataAlgorithm.h"
 
+#include <memory> // for std::unique_ptr
+
 class vtkLineSource;
 class vtkProbeLineFilter;
 
@@ -127,6 +139,28 @@ public:
   vtkSetMacro(LineResolution, int);
   ///@}
 
+  ///@{
+  /**
+   * When set, the line from `PreviewPoint1` to `PreviewPoint2` is sampled
+   * uniformly using at most `InteractiveLineResolution` points whatever the
+   * `SamplingPattern`. This is meant to be set while the line is being
+   * modified interactively. Off by default.
+   */
+  vtkSetMacro(Interacting, bool);
+  vtkBooleanMacro(Interacting, bool);
+  vtkGetMacro(Interacting, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Setter and getter for `InteractiveLineResolution`, the resolution used
+   * while `Interacting` is set. A value of 0 disables the coarse sampling.
+   * 100 by default.
+   */
+  vtkSetClampMacro(InteractiveLineResolution, int, 0, VTK_INT_MAX);
+  vtkGetMacro(InteractiveLineResolution, int);
+  ///@}
+
   ///@{
   /**
    * Get/Set the begin and end points for the line to probe against.
@@ -137,9 +171,19 @@ public:
   vtkSetVector3Macro(Point2, double);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the end points of the line probed while `Interacting` is set.
+   */
+  vtkGetVector3Macro(PreviewPoint1, double);
+  vtkSetVector3Macro(PreviewPoint1, double);
+  vtkGetVector3Macro(PreviewPoint2, double);
+  vtkSetVector3Macro(PreviewPoint2, double);
+  ///@}
+
 protected:
   vtkPVProbeLineFilter();
-  ~vtkPVProbeLineFilter() = default;
+  ~vtkPVProbeLineFilter() override;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int, vtkInformation*) override;
@@ -154,6 +198,10 @@ protected:
   double Tolerance = 1.0;
   double Point1[3] = { 0, 0, 0 };
   double Point2[3] = { 1, 1, 1 };
+  double PreviewPoint1[3] = { 0, 0, 0 };
+  double PreviewPoint2[3] = { 1, 1, 1 };
+  bool Interacting = false;
+  int InteractiveLineResolution = 100;
 
   vtkNew<vtkLineSource> LineSource;
   vtkNew<vtkProbeLineFilter> Prober;
@@ -161,6 +209,9 @@ protected:
 private:
   vtkPVProbeLineFilter(const vtkPVProbeLineFilter&) = delete;
   void operator=(const vtkPVProbeLineFilter&) = delete;
+
+  struct vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 #endif // vtkPVProbeLineFilter_h
@@ -250,4 +250,6 @@ int vtkPythonCalculator::FillInputPortInformation(int port, vtkInformation* info
 void vtkPythonCalculator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "ChunkSize: " << this->ChunkSize << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
 }
@@ -71,6 +71,31 @@ public:
   vtkGetStringMacro(ArrayName);
   //@}
 
+  //@{
+  /**
+   * Set the number of tuples to evaluate the expression on at once. When
+   * greater than 0, expressions made only of arrays, constants and element-wise
+   * functions (e.g. `mag(Velocity)*Pressure`) are evaluated over slices of the
+   * input arrays and written into a preallocated output array, which bounds the
+   * size of the temporaries created for sub-expressions. Other expressions, as
+   * well as composite inputs, are evaluated over whole arrays. The default is
+   * 0, which disables chunked evaluation.
+   */
+  vtkSetClampMacro(ChunkSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(ChunkSize, int);
+  //@}
+
+  //@{
+  /**
+   * Set the number of threads used to evaluate chunks concurrently when
+   * ChunkSize is greater than 0. numpy releases the GIL while operating on
+   * arrays, so chunks can be processed in parallel. Set to 0 to use as many
+   * threads as available. The default is 1.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  //@}
+
   /**
    * For internal use only.
    */
@@ -101,6 +126,8 @@ protected:
   char* Expression;
   char* ArrayName;
   int ArrayAssociation;
+  int ChunkSize = 0;
+  int NumberOfThreads = 1;
 
 private:
   vtkPythonCalculator(const vtkPythonCalculator&) = delete;
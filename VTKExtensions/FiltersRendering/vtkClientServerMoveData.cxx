@@ -25,6 +25,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVSession.h"
+#include "vtkPVStripedSocketCommunicator.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkSelection.h"
@@ -188,6 +189,8 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
   // This is a server root node.
   // If it is a selection, use the XML serializer.
   // Otherwise, use the communicator.
+  vtkPVStripedSocketCommunicator::StripeTag(
+    controller->GetCommunicator(), vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
   if (this->OutputDataType == VTK_SELECTION)
   {
     // Convert to XML.
@@ -218,6 +221,8 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
 vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* controller)
 {
   vtkDataObject* data = nullptr;
+  vtkPVStripedSocketCommunicator::StripeTag(
+    controller->GetCommunicator(), vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
   if (this->OutputDataType == VTK_SELECTION)
   {
     // Get the size of the string.
@@ -32,6 +32,7 @@
 #include "vtkOutlineFilter.h"
 #include "vtkPVLogger.h"
 #include "vtkPVSession.h"
+#include "vtkPVStripedSocketCommunicator.h"
 #include "vtkPointData.h"
 #include "vtkProcessModule.h"
 #include "vtkSmartPointer.h"
@@ -708,6 +709,7 @@ void vtkMPIMoveData::DataServerSendToRenderServer(vtkDataObject* output)
 
   com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
   com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
+  vtkPVStripedSocketCommunicator::StripeTag(com, 23482);
   com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
 }
 
@@ -737,6 +739,7 @@ void vtkMPIMoveData::RenderServerReceiveFromDataServer(vtkDataObject* output)
     this->BufferTotalLength += this->BufferLengths[idx];
   }
   this->Buffers = new char[this->BufferTotalLength];
+  vtkPVStripedSocketCommunicator::StripeTag(com, 23482);
   com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
 
   // int fixme;  // Can we avoid this?
@@ -768,6 +771,7 @@ void vtkMPIMoveData::DataServerZeroSendToRenderServerZero(vtkDataObject* data)
     this->MarshalDataToBuffer(data);
     com->Send(&(this->NumberOfBuffers), 1, 1, 23480);
     com->Send(this->BufferLengths, this->NumberOfBuffers, 1, 23481);
+    vtkPVStripedSocketCommunicator::StripeTag(com, 23482);
     com->Send(this->Buffers, this->BufferTotalLength, 1, 23482);
     this->ClearBuffer();
   }
@@ -803,6 +807,7 @@ void vtkMPIMoveData::RenderServerZeroReceiveFromDataServerZero(vtkDataObject* da
       this->BufferTotalLength += this->BufferLengths[idx];
     }
     this->Buffers = new char[this->BufferTotalLength];
+    vtkPVStripedSocketCommunicator::StripeTag(com, 23482);
     com->Receive(this->Buffers, this->BufferTotalLength, 1, 23482);
 
     // int fixme;  // Can we avoid this?
@@ -830,6 +835,8 @@ void vtkMPIMoveData::DataServerSendToClient(vtkDataObject* output)
     this->ClientDataServerSocketController->Send(&(this->NumberOfBuffers), 1, 1, 23490);
     this->ClientDataServerSocketController->Send(
       this->BufferLengths, this->NumberOfBuffers, 1, 23491);
+    vtkPVStripedSocketCommunicator::StripeTag(
+      this->ClientDataServerSocketController->GetCommunicator(), 23492);
     this->ClientDataServerSocketController->Send(this->Buffers, this->BufferTotalLength, 1, 23492);
     this->ClearBuffer();
     vtkTimerLog::MarkEndEvent("Dataserver sending to client");
@@ -862,6 +869,7 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
     this->BufferTotalLength += this->BufferLengths[idx];
   }
   this->Buffers = new char[this->BufferTotalLength];
+  vtkPVStripedSocketCommunicator::StripeTag(com, 23492);
   com->Receive(this->Buffers, this->BufferTotalLength, 1, 23492);
   this->ReconstructDataFromBuffer(output);
   this->ClearBuffer();
@@ -28,7 +28,7 @@ namespace
 
 // ensure that the writer works when the columns are not in the same order on all ranks.
 // also ensures partial arrays don't mess things up.
-bool WriteCSV(const std::string& fname, int rank)
+bool WriteCSV(const std::string& fname, int rank, bool inParallel)
 {
   vtkNew<vtkTable> table;
   vtkNew<vtkDoubleArray> col1;
@@ -66,6 +66,7 @@ bool WriteCSV(const std::string& fname, int rank)
   vtkNew<vtkCSVWriter> writer;
   writer->SetFileName(fname.c_str());
   writer->SetInputDataObject(table);
+  writer->SetWriteInParallel(inParallel);
   writer->Update();
   return true;
 }
@@ -133,8 +134,10 @@ int TestCSVWriter(int argc, char* argv[])
   }
 
   std::string tname{ testing->GetTempDirectory() };
-  int success = WriteCSV(tname + "/TestCSVWriter.csv", myRank) &&
-      ReadAndVerifyCSV(tname + "/TestCSVWriter.csv", myRank, numRanks)
+  int success = WriteCSV(tname + "/TestCSVWriter.csv", myRank, false) &&
+      ReadAndVerifyCSV(tname + "/TestCSVWriter.csv", myRank, numRanks) &&
+      WriteCSV(tname + "/TestCSVWriterInParallel.csv", myRank, true) &&
+      ReadAndVerifyCSV(tname + "/TestCSVWriterInParallel.csv", myRank, numRanks)
     ? 1
     : 0;
 
@@ -0,0 +1,44 @@
+# Writes the blocks of a multiblock dataset over all its timesteps with the
+# parallel serial writer, with and without writing in the background, and
+# checks that the same files are written.
+from paraview.simple import *
+from paraview import servermanager, smtesting
+import filecmp
+import os
+import shutil
+import sys
+
+smtesting.ProcessCommandLineArguments()
+canex2 = ExodusIIReader(FileName=smtesting.DataDir+'/Testing/Data/can.ex2')
+canex2.NodeSetArrayStatus = []
+canex2.SideSetArrayStatus = []
+canex2.ElementBlocks = ['Unnamed block ID: 1 Type: HEX', 'Unnamed block ID: 2 Type: HEX']
+canex2.PointVariables = ['DISPL', 'VEL', 'ACCL']
+
+def write(name, background):
+    path = os.path.join(smtesting.TempDir, 'ParallelSerialWriterBackground', name)
+    if os.path.exists(path):
+        shutil.rmtree(path)
+    os.makedirs(path)
+    writer = servermanager.writers.PDataSetWriterUnstructuredGrid(Input=canex2,
+        FileName=os.path.join(path, 'can.vtk'), FileType='Binary', WriteTimeSteps=1,
+        WriteInBackground=background)
+    writer.UpdatePipeline()
+    Delete(writer)
+    return path
+
+serial = write('serial', 0)
+background = write('background', 1)
+
+files = sorted(os.listdir(serial))
+expected = 2 * len(canex2.TimestepValues)
+if len(files) != expected:
+    print("Expected %d files, got %d" % (expected, len(files)))
+    sys.exit(1)
+
+match, mismatch, errors = filecmp.cmpfiles(serial, background, files, shallow=False)
+if mismatch or errors or sorted(os.listdir(background)) != files:
+    print("Files written in the background differ: %s" % (mismatch + errors))
+    sys.exit(1)
+
+print("success")
@@ -24,11 +24,13 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
@@ -36,6 +38,14 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <vtk_fmt.h> // needed for `fmt`
+// clang-format off
+#include VTK_FMT(fmt/format.h)
+// clang-format on
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
 #include <sstream>
 #include <vector>
 
@@ -59,6 +69,8 @@ vtkCSVWriter::vtkCSVWriter()
   this->FileNameSuffix = nullptr;
   this->Precision = 5;
   this->UseScientificNotation = true;
+  this->UseShortestRoundTrip = false;
+  this->WriteInParallel = false;
   this->FieldAssociation = 0;
   this->AddMetaData = false;
   this->AddTimeStep = false;
@@ -199,93 +211,94 @@ int vtkCSVWriter::ProcessRequest(
 namespace
 {
 //-----------------------------------------------------------------------------
-template <class iterT>
-void vtkCSVWriterGetDataString(
-  iterT* iter, vtkIdType tupleIndex, ostream& stream, vtkCSVWriter* writer, bool& first)
+// Formats values into a buffer. This is much faster than using an ostream
+// for each value and can be used by several threads at once.
+class vtkCSVWriterFormatter
 {
-  int numComps = iter->GetNumberOfComponents();
-  vtkIdType index = tupleIndex * numComps;
-  for (int cc = 0; cc < numComps; cc++)
+public:
+  vtkCSVWriterFormatter(vtkCSVWriter* writer)
+    : FieldDelimiter(writer->GetFieldDelimiter() ? writer->GetFieldDelimiter() : "")
+    , StringDelimiter(writer->GetUseStringDelimiter() && writer->GetStringDelimiter()
+          ? writer->GetStringDelimiter()
+          : "")
+    , Precision(writer->GetPrecision())
+    , UseScientificNotation(writer->GetUseScientificNotation())
+    , UseShortestRoundTrip(writer->GetUseShortestRoundTrip())
   {
-    if (!first)
-    {
-      stream << writer->GetFieldDelimiter();
-    }
-    first = false;
-    if ((index + cc) < iter->GetNumberOfValues())
-    {
-      stream << iter->GetValue(index + cc);
-    }
   }
-}
 
-//-----------------------------------------------------------------------------
-template <>
-void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<vtkStdString>* iter, vtkIdType tupleIndex,
-  ostream& stream, vtkCSVWriter* writer, bool& first)
-{
-  int numComps = iter->GetNumberOfComponents();
-  vtkIdType index = tupleIndex * numComps;
-  for (int cc = 0; cc < numComps; cc++)
+  std::string FieldDelimiter;
+
+  template <typename T>
+  void Append(std::string& buffer, T value) const
   {
-    if (!first)
-    {
-      stream << writer->GetFieldDelimiter();
-    }
-    first = false;
-    if ((index + cc) < iter->GetNumberOfValues())
-    {
-      stream << writer->GetString(iter->GetValue(index + cc));
-    }
+    fmt::format_to(std::back_inserter(buffer), "{}", value);
   }
-}
 
-//-----------------------------------------------------------------------------
-template <>
-void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<char>* iter, vtkIdType tupleIndex,
-  ostream& stream, vtkCSVWriter* writer, bool& first)
-{
-  int numComps = iter->GetNumberOfComponents();
-  vtkIdType index = tupleIndex * numComps;
-  for (int cc = 0; cc < numComps; cc++)
+  void Append(std::string& buffer, char value) const { this->Append(buffer, int(value)); }
+  void Append(std::string& buffer, signed char value) const { this->Append(buffer, int(value)); }
+  void Append(std::string& buffer, unsigned char value) const { this->Append(buffer, int(value)); }
+  void Append(std::string& buffer, float value) const { this->AppendReal(buffer, value); }
+  void Append(std::string& buffer, double value) const { this->AppendReal(buffer, value); }
+
+  void Append(std::string& buffer, const vtkStdString& value) const
   {
-    if (!first)
+    buffer += this->StringDelimiter;
+    buffer += value;
+    buffer += this->StringDelimiter;
+  }
+
+  void Append(std::string& buffer, const vtkVariant& value) const
+  {
+    std::ostringstream stream;
+    stream << value;
+    buffer += stream.str();
+  }
+
+private:
+  // Same output as an ostream using the precision and notation of the
+  // writer, unless the shortest representation that reads back to the same
+  // value is requested.
+  template <typename T>
+  void AppendReal(std::string& buffer, T value) const
+  {
+    if (this->UseShortestRoundTrip)
     {
-      stream << writer->GetFieldDelimiter();
+      fmt::format_to(std::back_inserter(buffer), "{}", value);
     }
-    first = false;
-    if ((index + cc) < iter->GetNumberOfValues())
+    else if (this->UseScientificNotation)
+    {
+      fmt::format_to(std::back_inserter(buffer), "{:.{}e}", value, this->Precision);
+    }
+    else
     {
-      stream << static_cast<int>(iter->GetValue(index + cc));
+      fmt::format_to(std::back_inserter(buffer), "{:.{}g}", value, this->Precision);
     }
   }
-}
+
+  std::string StringDelimiter;
+  int Precision;
+  bool UseScientificNotation;
+  bool UseShortestRoundTrip;
+};
 
 //-----------------------------------------------------------------------------
-template <>
-void vtkCSVWriterGetDataString(vtkArrayIteratorTemplate<unsigned char>* iter, vtkIdType tupleIndex,
-  ostream& stream, vtkCSVWriter* writer, bool& first)
+template <class iterT>
+void vtkCSVWriterGetDataString(iterT* iter, vtkIdType tupleIndex,
+  const vtkCSVWriterFormatter& formatter, std::string& buffer, bool& first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex * numComps;
   for (int cc = 0; cc < numComps; cc++)
   {
-    if ((index + cc) < iter->GetNumberOfValues())
+    if (!first)
     {
-      if (!first)
-      {
-        stream << writer->GetFieldDelimiter();
-      }
-      first = false;
-      stream << static_cast<int>(iter->GetValue(index + cc));
+      buffer += formatter.FieldDelimiter;
     }
-    else
+    first = false;
+    if ((index + cc) < iter->GetNumberOfValues())
     {
-      if (!first)
-      {
-        stream << writer->GetFieldDelimiter();
-      }
-      first = false;
+      formatter.Append(buffer, iter->GetValue(index + cc));
     }
   }
 }
@@ -333,6 +346,8 @@ public:
     return vtkErrorCode::NoError;
   }
 
+  void Close() { this->Stream.close(); }
+
   void WriteHeader(vtkTable* table, vtkCSVWriter* self, OpenMode mode)
   {
     this->WriteHeader(table->GetRowData(), self, mode);
@@ -340,12 +355,22 @@ public:
 
   void WriteHeader(vtkDataSetAttributes* dsa, vtkCSVWriter* self, OpenMode mode)
   {
+    this->Stream << this->FormatHeader(dsa, self, mode);
+  }
+
+  /**
+   * Determines the columns to write. Returns the header line, which is empty
+   * when appending to an existing file.
+   */
+  std::string FormatHeader(vtkDataSetAttributes* dsa, vtkCSVWriter* self, OpenMode mode)
+  {
+    std::string header;
     if (OpenMode::Write == mode)
     {
       bool add_delimiter = false;
       if (this->TimeStep >= 0)
       {
-        this->Stream << "TimeStep";
+        header += "TimeStep";
         add_delimiter = true;
       }
       if (!vtkMath::IsNan(this->Time))
@@ -353,10 +378,10 @@ public:
         if (add_delimiter)
         {
           // add separator for all but the very first column
-          this->Stream << self->GetFieldDelimiter();
+          header += self->GetFieldDelimiter();
         }
         // add a time column.
-        this->Stream << "Time";
+        header += "Time";
         add_delimiter = true;
       }
       for (int cc = 0, numArrays = dsa->GetNumberOfArrays(); cc < numArrays; ++cc)
@@ -372,7 +397,7 @@ public:
           if (add_delimiter)
           {
             // add separator for all but the very first column
-            this->Stream << self->GetFieldDelimiter();
+            header += self->GetFieldDelimiter();
           }
           add_delimiter = true;
 
@@ -382,10 +407,10 @@ public:
           {
             array_name << ":" << comp;
           }
-          this->Stream << self->GetString(array_name.str());
+          header += self->GetString(array_name.str());
         }
       }
-      this->Stream << "\n";
+      header += "\n";
     }
     else // (OpenMode::Append == mode)
     {
@@ -398,12 +423,7 @@ public:
         this->ColumnInfo.push_back(std::make_pair(std::string(array->GetName()), num_comps));
       }
     }
-    // push the floating point precision/notation type.
-    if (self->GetUseScientificNotation())
-    {
-      this->Stream << std::scientific;
-    }
-    this->Stream << std::setprecision(self->GetPrecision());
+    return header;
   }
 
   void WriteData(vtkTable* table, vtkCSVWriter* self)
@@ -412,6 +432,16 @@ public:
   }
 
   void WriteData(vtkDataSetAttributes* dsa, vtkCSVWriter* self)
+  {
+    this->FormatData(dsa, self, [this](std::string& chunk) { this->Stream << chunk; });
+  }
+
+  /**
+   * Formats the rows in chunks, several chunks being formatted concurrently.
+   * `sink` is called with each formatted chunk, in order.
+   */
+  template <typename Sink>
+  void FormatData(vtkDataSetAttributes* dsa, vtkCSVWriter* self, Sink&& sink)
   {
     std::vector<vtkSmartPointer<vtkArrayIterator>> columnsIters;
     for (const auto& cinfo : this->ColumnInfo)
@@ -426,39 +456,117 @@ public:
       iter->FastDelete();
     }
 
-    const auto num_tuples = dsa->GetNumberOfTuples();
-    for (vtkIdType cc = 0; cc < num_tuples; ++cc)
+    const vtkCSVWriterFormatter formatter(self);
+    const vtkIdType num_tuples = dsa->GetNumberOfTuples();
+    const vtkIdType chunk_size = 16384;
+    const vtkIdType num_chunks = (num_tuples + chunk_size - 1) / chunk_size;
+    // Only a few chunks per thread are formatted before being handed over
+    // to limit the memory used.
+    const vtkIdType batch_size =
+      std::max<vtkIdType>(1, 4 * vtkSMPTools::GetEstimatedNumberOfThreads());
+    std::vector<std::string> chunks;
+    for (vtkIdType batch_begin = 0; batch_begin < num_chunks; batch_begin += batch_size)
+    {
+      const vtkIdType batch_end = std::min(num_chunks, batch_begin + batch_size);
+      chunks.resize(batch_end - batch_begin);
+      vtkSMPTools::For(batch_begin, batch_end, 1, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType chunk = begin; chunk < end; ++chunk)
+        {
+          std::string& buffer = chunks[chunk - batch_begin];
+          buffer.clear();
+          const vtkIdType row_end = std::min(num_tuples, (chunk + 1) * chunk_size);
+          for (vtkIdType row = chunk * chunk_size; row < row_end; ++row)
+          {
+            this->FormatRow(columnsIters, row, formatter, buffer);
+          }
+        }
+      });
+      for (auto& chunk : chunks)
+      {
+        sink(chunk);
+      }
+    }
+  }
+
+  /**
+   * Sends the columns determined by the root to all ranks.
+   */
+  void BroadcastColumns(vtkMultiProcessController* controller)
+  {
+    vtkMultiProcessStream stream;
+    if (controller->GetLocalProcessId() == 0)
     {
-      bool first_column = true;
-      if (this->TimeStep >= 0)
+      stream << static_cast<int>(this->ColumnInfo.size());
+      for (const auto& cinfo : this->ColumnInfo)
       {
-        this->Stream << this->TimeStep;
-        first_column = false;
+        stream << cinfo.first << cinfo.second;
       }
-      if (!vtkMath::IsNan(this->Time))
+    }
+    controller->Broadcast(stream, 0);
+    if (controller->GetLocalProcessId() != 0)
+    {
+      int count;
+      stream >> count;
+      this->ColumnInfo.resize(count);
+      for (auto& cinfo : this->ColumnInfo)
       {
-        if (!first_column)
-        {
-          this->Stream << self->GetFieldDelimiter();
-        }
-        // add a time column.
-        this->Stream << this->Time;
-        first_column = false;
+        stream >> cinfo.first >> cinfo.second;
       }
+    }
+  }
+
+  /**
+   * Writes the chunks in an existing file, starting at the given offset.
+   */
+  static int WriteAt(
+    const char* filename, vtkTypeInt64 offset, const std::vector<std::string>& chunks)
+  {
+    vtksys::ofstream stream(filename, ios::in | ios::out | ios::binary);
+    if (stream.fail())
+    {
+      return vtkErrorCode::CannotOpenFileError;
+    }
+    stream.seekp(offset);
+    for (const auto& chunk : chunks)
+    {
+      stream.write(chunk.data(), chunk.size());
+    }
+    stream.flush();
+    return stream.fail() ? vtkErrorCode::OutOfDiskSpaceError : vtkErrorCode::NoError;
+  }
 
-      for (auto& iter : columnsIters)
+private:
+  void FormatRow(std::vector<vtkSmartPointer<vtkArrayIterator>>& columnsIters, vtkIdType row,
+    const vtkCSVWriterFormatter& formatter, std::string& buffer) const
+  {
+    bool first_column = true;
+    if (this->TimeStep >= 0)
+    {
+      formatter.Append(buffer, this->TimeStep);
+      first_column = false;
+    }
+    if (!vtkMath::IsNan(this->Time))
+    {
+      if (!first_column)
       {
-        switch (iter->GetDataType())
-        {
-          vtkArrayIteratorTemplateMacro(vtkCSVWriterGetDataString(
-            static_cast<VTK_TT*>(iter.GetPointer()), cc, this->Stream, self, first_column));
-        }
+        buffer += formatter.FieldDelimiter;
       }
-      this->Stream << "\n";
+      // add a time column.
+      formatter.Append(buffer, this->Time);
+      first_column = false;
     }
+
+    for (auto& iter : columnsIters)
+    {
+      switch (iter->GetDataType())
+      {
+        vtkArrayIteratorTemplateMacro(vtkCSVWriterGetDataString(
+          static_cast<VTK_TT*>(iter.GetPointer()), row, formatter, buffer, first_column));
+      }
+    }
+    buffer += '\n';
   }
 
-private:
   CSVFile(const CSVFile&) = delete;
   void operator=(const CSVFile&) = delete;
 };
@@ -611,9 +719,11 @@ void vtkCSVWriter::WriteData()
     return;
   }
 
-  const int myRank = controller->GetLocalProcessId();
-  const int numRanks = controller->GetNumberOfProcesses();
-  if (myRank > 0)
+  if (this->WriteInParallel)
+  {
+    this->WriteDataInParallel(table, filename.str(), timeStep, time);
+  }
+  else if (controller->GetLocalProcessId() > 0)
   {
     int error_code{ vtkErrorCode::NoError };
     controller->Broadcast(&error_code, 1, 0);
@@ -650,6 +760,7 @@ void vtkCSVWriter::WriteData()
   }
   else
   {
+    const int numRanks = controller->GetNumberOfProcesses();
     vtkCSVWriter::CSVFile file(timeStep, time);
     CSVFile::OpenMode openMode =
       this->WriteAllTimeSteps && !this->WriteAllTimeStepsSeparately && this->CurrentTimeIndex > 0
@@ -730,6 +841,106 @@ void vtkCSVWriter::WriteData()
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkCSVWriter::WriteDataInParallel(
+  vtkTable* table, const std::string& filename, int timeStep, double time)
+{
+  auto controller = this->Controller;
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  vtkCSVWriter::CSVFile file(timeStep, time);
+  CSVFile::OpenMode openMode =
+    this->WriteAllTimeSteps && !this->WriteAllTimeStepsSeparately && this->CurrentTimeIndex > 0
+    ? CSVFile::OpenMode::Append
+    : CSVFile::OpenMode::Write;
+
+  const vtkIdType row_count = table->GetNumberOfRows();
+  std::vector<vtkIdType> global_row_counts(numRanks, 0);
+  controller->AllGather(&row_count, global_row_counts.data(), 1);
+
+  // The root determines the columns to write, like in the serial path, and
+  // creates the file with the header.
+  int error_code = vtkErrorCode::NoError;
+  vtkIdType base_offset = 0;
+  if (myRank > 0)
+  {
+    if (row_count > 0)
+    {
+      vtkNew<vtkTable> clone;
+      auto cloneRD = clone->GetRowData();
+      cloneRD->CopyAllOn();
+      cloneRD->CopyAllocate(table->GetRowData(), /*sze=*/1);
+      cloneRD->CopyData(table->GetRowData(), 0, 1, 0);
+      controller->Send(clone, 0, 88022);
+    }
+  }
+  else
+  {
+    vtkDataSetAttributes::FieldList columns;
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+      if (global_row_counts[rank] > 0)
+      {
+        if (rank == 0)
+        {
+          columns.IntersectFieldList(table->GetRowData());
+        }
+        else
+        {
+          vtkNew<vtkTable> emptytable;
+          controller->Receive(emptytable, vtkMultiProcessController::ANY_SOURCE, 88022);
+          columns.IntersectFieldList(emptytable->GetRowData());
+        }
+      }
+    }
+    vtkNew<vtkDataSetAttributes> tmp;
+    tmp->CopyAllOn();
+    columns.CopyAllocate(tmp, vtkDataSetAttributes::PASSDATA, /*sz=*/1, 0);
+
+    error_code = file.Open(filename.c_str(), openMode);
+    if (error_code == vtkErrorCode::NoError)
+    {
+      file.WriteHeader(tmp, this, openMode);
+      file.Close();
+      base_offset = static_cast<vtkIdType>(vtksys::SystemTools::FileLength(filename));
+    }
+  }
+  vtkIdType root_status[2] = { error_code, base_offset };
+  controller->Broadcast(root_status, 2, 0);
+  if (root_status[0] != vtkErrorCode::NoError)
+  {
+    this->SetErrorCode(static_cast<unsigned long>(root_status[0]));
+    return;
+  }
+  base_offset = root_status[1];
+  file.BroadcastColumns(controller);
+
+  // Each rank formats its rows and writes them right after the rows of the
+  // previous ranks.
+  std::vector<std::string> chunks;
+  vtkIdType local_size = 0;
+  if (row_count > 0)
+  {
+    file.FormatData(table->GetRowData(), this, [&](std::string& chunk) {
+      local_size += static_cast<vtkIdType>(chunk.size());
+      chunks.push_back(std::move(chunk));
+    });
+  }
+  std::vector<vtkIdType> global_sizes(numRanks, 0);
+  controller->AllGather(&local_size, global_sizes.data(), 1);
+  const vtkIdType offset =
+    std::accumulate(global_sizes.begin(), global_sizes.begin() + myRank, base_offset);
+
+  if (local_size > 0)
+  {
+    error_code = CSVFile::WriteAt(filename.c_str(), offset, chunks);
+  }
+  int global_error_code = error_code;
+  controller->AllReduce(&error_code, &global_error_code, 1, vtkCommunicator::MAX_OP);
+  this->SetErrorCode(global_error_code);
+}
+
 //-----------------------------------------------------------------------------
 void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -746,6 +957,8 @@ void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "FileNameSuffix: " << (this->FileNameSuffix ? this->FileNameSuffix : "(none)")
      << endl;
   os << indent << "UseScientificNotation: " << this->UseScientificNotation << endl;
+  os << indent << "UseShortestRoundTrip: " << this->UseShortestRoundTrip << endl;
+  os << indent << "WriteInParallel: " << this->WriteInParallel << endl;
   os << indent << "Precision: " << this->Precision << endl;
   os << indent << "FieldAssociation: " << this->FieldAssociation << endl;
   os << indent << "AddMetaData: " << (this->AddMetaData ? "Yes" : "No") << endl;
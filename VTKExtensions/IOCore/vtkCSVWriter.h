@@ -16,6 +16,10 @@
  * @class   vtkCSVWriter
  * @brief   CSV writer for vtkTable/vtkDataSet/vtkCompositeDataSet
  * Writes a vtkTable/vtkDataSet/vtkCompositeDataSet as a delimited text file (such as CSV).
+ *
+ * Rows are formatted in chunks using vtkSMPTools. In parallel, ranks send
+ * their rows to the root which writes them in order, unless WriteInParallel
+ * is on.
  */
 
 #ifndef vtkCSVWriter_h
@@ -138,6 +142,29 @@ public:
   vtkBooleanMacro(UseScientificNotation, bool);
   //@}
 
+  //@{
+  /**
+   * When set to true (default is false), floating point values are written
+   * with the shortest representation that reads back to the same value.
+   * Precision and UseScientificNotation are then ignored.
+   */
+  vtkSetMacro(UseShortestRoundTrip, bool);
+  vtkGetMacro(UseShortestRoundTrip, bool);
+  vtkBooleanMacro(UseShortestRoundTrip, bool);
+  //@}
+
+  //@{
+  /**
+   * When set to true (default is false), each rank writes its rows directly
+   * into the file, after the rows of the previous ranks, instead of sending
+   * them to the root rank. The file must be on a file system shared by all
+   * ranks.
+   */
+  vtkSetMacro(WriteInParallel, bool);
+  vtkGetMacro(WriteInParallel, bool);
+  vtkBooleanMacro(WriteInParallel, bool);
+  //@}
+
   //@{
   /**
    * Get/set the attribute data to write if the input is either
@@ -219,6 +246,8 @@ protected:
   bool UseStringDelimiter;
   int Precision;
   bool UseScientificNotation;
+  bool UseShortestRoundTrip;
+  bool WriteInParallel;
   int FieldAssociation;
   bool AddMetaData;
   bool AddTimeStep;
@@ -235,6 +264,8 @@ private:
   void operator=(const vtkCSVWriter&) = delete;
 
   class CSVFile;
+
+  void WriteDataInParallel(vtkTable* table, const std::string& filename, int timeStep, double time);
 };
 
 #endif
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkParallelSerialWriter.h"
 
+#include "vtkCallbackCommand.h"
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
@@ -21,9 +22,12 @@
 #include "vtkCompositeDataSet.h"
 #include "vtkConvertToPartitionedDataSetCollection.h"
 #include "vtkDataSet.h"
+#include "vtkErrorCode.h"
+#include "vtkFieldData.h"
 #include "vtkFileSeriesWriter.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLogger.h"
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
@@ -36,9 +40,18 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <future>
 #include <string>
 #include <vtksys/SystemTools.hxx>
 
+#if defined(__linux__)
+#include <sys/vfs.h>
+#include <sys/xattr.h>
+#endif
+
 // clang-format off
 #include <vtk_fmt.h> // needed for `fmt`
 #include VTK_FMT(fmt/core.h)
@@ -57,6 +70,15 @@ bool vtkIsEmpty(vtkDataObject* dobj)
   }
   return true;
 }
+
+#if defined(__linux__)
+// Values from Lustre's `lustre_user.h`.
+constexpr long VTK_LUSTRE_SUPER_MAGIC = 0x0BD00BD0;
+constexpr std::uint32_t VTK_LUSTRE_LOV_USER_MAGIC_V1 = 0x0BD10BD0;
+constexpr std::uint32_t VTK_LUSTRE_LOV_USER_MAGIC_V3 = 0x0BD30BD0;
+// offset of `lmm_stripe_count` in `lov_user_md`.
+constexpr std::size_t VTK_LUSTRE_STRIPE_COUNT_OFFSET = 28;
+#endif
 }
 
 vtkStandardNewMacro(vtkParallelSerialWriter);
@@ -98,6 +120,7 @@ vtkParallelSerialWriter::vtkParallelSerialWriter()
 //-----------------------------------------------------------------------------
 vtkParallelSerialWriter::~vtkParallelSerialWriter()
 {
+  this->WaitForPendingWrite();
   this->SetWriter(nullptr);
   this->SetFileNameMethod(nullptr);
   this->SetFileName(nullptr);
@@ -191,16 +214,18 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
     {
       // Tell the pipeline to start looping.
       request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+      this->SetErrorCode(vtkErrorCode::NoError);
     }
   }
   else
   {
     request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
     this->CurrentTimeIndex = 0;
+    this->SetErrorCode(vtkErrorCode::NoError);
   }
 
   const int num_ranks = this->Controller->GetNumberOfProcesses();
-  int num_io_ranks = std::min(this->NumberOfIORanks, num_ranks);
+  int num_io_ranks = std::min(this->GetNumberOfIORanksToUse(num_ranks), num_ranks);
   num_io_ranks = num_io_ranks <= 0 ? num_ranks : num_io_ranks;
   if (num_io_ranks == 1)
   {
@@ -281,6 +306,13 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
     }
   }
 
+  // when looping over timesteps, the last write is left pending so that it
+  // overlaps with the execution of the next timestep.
+  if (!request->Has(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING()))
+  {
+    this->WaitForPendingWrite();
+  }
+
   this->SubController = nullptr;
 
   // A barrier at end to just sync up. This just makes it easier to write tests
@@ -381,10 +413,175 @@ void vtkParallelSerialWriter::WriteAFile(const std::string& filename_arg, vtkDat
     }
   }
 
-  this->Writer->SetInputDataObject(input);
+  // the writer is not reused before the previous write is done.
+  this->WaitForPendingWrite();
+
   this->SetWriterFileName(filename.c_str());
-  this->WriteInternal();
+  if (!this->WriteInBackground || !this->FileNameMethod)
+  {
+    this->Writer->SetInputDataObject(input);
+    this->WriteInternal();
+    this->Writer->RemoveAllInputConnections(0);
+    return;
+  }
+
+  // progress and messages are reported to the client from the main thread
+  // only, hence mute them while writing in the background.
+  vtkNew<vtkCallbackCommand> mute;
+  mute->SetAbortFlagOnExecute(1);
+  this->PendingWriteObservers[0] =
+    this->Writer->AddObserver(vtkCommand::ProgressEvent, mute, VTK_FLOAT_MAX);
+  this->PendingWriteObservers[1] =
+    this->Writer->AddObserver(vtkCommand::MessageEvent, mute, VTK_FLOAT_MAX);
+
+  // the helpers reuse their outputs for the next timestep, which is produced
+  // while this one is written, hence the writer is given its own copy.
+  this->Writer->SetInputDataObject(vtkParallelSerialWriter::ShallowCopyForWriting(input));
+
+  // the interpreter is not thread safe, hence the writer is executed directly,
+  // which is what the `Write` methods of writers do. The writer is only
+  // modified on this thread once the write is done, see WaitForPendingWrite().
+  // Its error code is read by the writing thread and reported on this one.
+  vtkAlgorithm* writer = this->Writer;
+  writer->Modified();
+  this->PendingWriteFileName = filename;
+  this->PendingWrite = std::async(std::launch::async, [writer]() {
+    writer->Update();
+    return writer->GetErrorCode();
+  });
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkParallelSerialWriter::ShallowCopyForWriting(vtkDataObject* input)
+{
+  auto copy = vtkSmartPointer<vtkDataObject>::Take(input->NewInstance());
+  auto compositeInput = vtkCompositeDataSet::SafeDownCast(input);
+  if (!compositeInput)
+  {
+    copy->ShallowCopy(input);
+    return copy;
+  }
+
+  // the leaves are copied too since composite datasets share them when
+  // shallow copied.
+  auto compositeCopy = vtkCompositeDataSet::SafeDownCast(copy);
+  compositeCopy->CopyStructure(compositeInput);
+  compositeCopy->GetFieldData()->ShallowCopy(compositeInput->GetFieldData());
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(compositeInput->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataObject* leaf = iter->GetCurrentDataObject();
+    auto leafCopy = vtkSmartPointer<vtkDataObject>::Take(leaf->NewInstance());
+    leafCopy->ShallowCopy(leaf);
+    compositeCopy->SetDataSet(iter, leafCopy);
+  }
+  return copy;
+}
+
+//----------------------------------------------------------------------------
+void vtkParallelSerialWriter::WaitForPendingWrite()
+{
+  if (!this->PendingWrite.valid())
+  {
+    return;
+  }
+
+  unsigned long errorCode = vtkErrorCode::NoError;
+  std::string exceptionMessage;
+  try
+  {
+    errorCode = this->PendingWrite.get();
+  }
+  catch (const std::exception& e)
+  {
+    errorCode = vtkErrorCode::UnknownError;
+    exceptionMessage = e.what();
+  }
   this->Writer->RemoveAllInputConnections(0);
+  this->Writer->RemoveObserver(this->PendingWriteObservers[0]);
+  this->Writer->RemoveObserver(this->PendingWriteObservers[1]);
+
+  if (!exceptionMessage.empty())
+  {
+    vtkErrorMacro("Failed to write '" << this->PendingWriteFileName
+                                      << "' in the background: " << exceptionMessage);
+  }
+  else if (errorCode != vtkErrorCode::NoError)
+  {
+    vtkErrorMacro("Failed to write '" << this->PendingWriteFileName << "' in the background: "
+                                      << vtkErrorCode::GetStringFromErrorCode(errorCode));
+  }
+  if (errorCode != vtkErrorCode::NoError)
+  {
+    this->SetErrorCode(errorCode);
+  }
+  this->PendingWriteFileName.clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkParallelSerialWriter::GetNumberOfIORanksToUse(int numRanks)
+{
+  if (this->NumberOfIORanks != AUTOMATIC_NUMBER_OF_IO_RANKS)
+  {
+    return this->NumberOfIORanks;
+  }
+
+  // the file system is only queried on the root rank.
+  int count = 0;
+  if (this->Controller->GetLocalProcessId() == 0)
+  {
+    count = vtkParallelSerialWriter::GetStripeCount(this->FileName);
+    if (count <= 0)
+    {
+      count = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(numRanks))));
+    }
+    vtkLogF(TRACE, "Using %d I/O ranks for '%s'", count, this->FileName);
+  }
+  this->Controller->Broadcast(&count, 1, 0);
+  return std::max(count, 1);
+}
+
+//----------------------------------------------------------------------------
+int vtkParallelSerialWriter::GetStripeCount(const std::string& fname)
+{
+#if defined(__linux__)
+  std::string dir = vtksys::SystemTools::GetFilenamePath(fname);
+  dir = dir.empty() ? "." : dir;
+
+  struct statfs fsinfo;
+  if (statfs(dir.c_str(), &fsinfo) != 0 ||
+    static_cast<long>(fsinfo.f_type) != VTK_LUSTRE_SUPER_MAGIC)
+  {
+    return 0;
+  }
+
+  // the default layout of the directory is exposed as the `lov_user_md`
+  // structure through an extended attribute.
+  char buffer[256];
+  const auto size = getxattr(dir.c_str(), "lustre.lov", buffer, sizeof(buffer));
+  if (size < static_cast<ssize_t>(VTK_LUSTRE_STRIPE_COUNT_OFFSET + sizeof(std::uint16_t)))
+  {
+    return 0;
+  }
+
+  std::uint32_t magic;
+  std::memcpy(&magic, buffer, sizeof(magic));
+  if (magic != VTK_LUSTRE_LOV_USER_MAGIC_V1 && magic != VTK_LUSTRE_LOV_USER_MAGIC_V3)
+  {
+    // composite layouts are not supported.
+    return 0;
+  }
+
+  std::uint16_t count;
+  std::memcpy(&count, buffer + VTK_LUSTRE_STRIPE_COUNT_OFFSET, sizeof(count));
+  // 0 means the file system default and -1 all storage targets, neither of
+  // which are known here.
+  return (count == 0 || count == 0xffff) ? 0 : static_cast<int>(count);
+#else
+  (void)fname;
+  return 0;
+#endif
 }
 
 //----------------------------------------------------------------------------
@@ -447,4 +644,7 @@ void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 void vtkParallelSerialWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfIORanks: " << this->NumberOfIORanks << endl;
+  os << indent << "RankAssignmentMode: " << this->RankAssignmentMode << endl;
+  os << indent << "WriteInBackground: " << this->WriteInBackground << endl;
 }
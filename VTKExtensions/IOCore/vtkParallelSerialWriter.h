@@ -25,6 +25,11 @@
  *
  * This also makes it possible to write time-series for temporal datasets using
  * simple non-time-aware writers.
+ *
+ * When writing from many ranks to a parallel file system, set NumberOfIORanks
+ * to `AUTOMATIC_NUMBER_OF_IO_RANKS` to use as many I/O ranks as the output
+ * directory has stripes, and turn on WriteInBackground so that a timestep is
+ * written while the next one is being produced and gathered.
  */
 
 #ifndef vtkParallelSerialWriter_h
@@ -33,6 +38,7 @@
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsIOCoreModule.h" //needed for exports
 #include "vtkSmartPointer.h"                // needed for vtkSmartPointer
+#include <future>                           // for std::future
 #include <string>                           // for std::string
 
 class vtkClientServerInterpreter;
@@ -153,6 +159,11 @@ public:
   vtkSetStringMacro(FileNameSuffix);
   //@}
 
+  enum
+  {
+    AUTOMATIC_NUMBER_OF_IO_RANKS = -1
+  };
+
   //@{
   /**
    * In parallel runs, this writer can consolidate output from multiple ranks to
@@ -160,11 +171,36 @@ public:
    * to disk. If NumberOfIORanks is 0, then all ranks will save the local data.
    * If set to 1 (default), the root node alone will write to disk. All data from all ranks will
    * be gathered to the root node before being written out.
+   *
+   * If set to `AUTOMATIC_NUMBER_OF_IO_RANKS`, the number of ranks is the
+   * stripe count of the directory the files are written to, when it is on a
+   * Lustre file system, so that each I/O rank writes to its own storage target.
+   * Otherwise, the square root of the number of ranks is used.
    */
-  vtkSetClampMacro(NumberOfIORanks, int, 0, VTK_INT_MAX);
+  vtkSetClampMacro(NumberOfIORanks, int, AUTOMATIC_NUMBER_OF_IO_RANKS, VTK_INT_MAX);
   vtkGetMacro(NumberOfIORanks, int);
   //@}
 
+  //@{
+  /**
+   * When set, the internal writer is executed on a separate thread so that,
+   * when writing all timesteps, a timestep is written while the next one is
+   * produced and gathered on the I/O ranks. Progress and messages of the
+   * internal writer are not reported while writing in the background, but
+   * its error code and any exception are reported as errors once the write
+   * is done and are available from `GetErrorCode()`. Off by default.
+   */
+  vtkSetMacro(WriteInBackground, bool);
+  vtkGetMacro(WriteInBackground, bool);
+  vtkBooleanMacro(WriteInBackground, bool);
+  //@}
+
+  /**
+   * Returns the stripe count of the directory containing `fname`, or 0 if it
+   * is unknown or if the file system is not striped.
+   */
+  static int GetStripeCount(const std::string& fname);
+
   enum
   {
     ASSIGNMENT_MODE_CONTIGUOUS,
@@ -221,6 +257,9 @@ private:
 
   void SetWriterFileName(const char* fname);
   void WriteInternal();
+  void WaitForPendingWrite();
+  static vtkSmartPointer<vtkDataObject> ShallowCopyForWriting(vtkDataObject* input);
+  int GetNumberOfIORanksToUse(int numRanks);
 
   std::string GetPartitionFileName(const std::string& fname);
 
@@ -245,6 +284,10 @@ private:
 
   int NumberOfIORanks;
   int RankAssignmentMode;
+  bool WriteInBackground = false;
+  std::future<unsigned long> PendingWrite;
+  std::string PendingWriteFileName;
+  unsigned long PendingWriteObservers[2] = { 0, 0 };
 
   vtkMultiProcessController* Controller;
   vtkSmartPointer<vtkMultiProcessController> SubController;
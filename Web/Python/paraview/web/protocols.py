@@ -10,6 +10,7 @@ import os
 import re
 import sys
 import time
+from collections import OrderedDict
 
 # import paraview modules.
 import paraview
@@ -419,7 +420,14 @@ class ParaViewWebViewPortImageDelivery(ParaViewWebProtocol):
             localTime = options["localTime"]
         reply = {}
         app = self.getApplication()
-        reply["image"] = app.StillRenderToString(view.SMProxy, t, quality)
+        tiles = options.get("tiles", False)
+        if tiles:
+            # Only the tiles changed since the client frame 't' are sent, as a
+            # binary attachment. Encoded tiles are shared between clients.
+            stillRender = app.StillRenderToTiles
+        else:
+            stillRender = app.StillRenderToString
+        reply["image"] = stillRender(view.SMProxy, t, quality)
 
         # Check that we are getting image size we have set if not wait until we
         # do.
@@ -431,7 +439,7 @@ class ParaViewWebViewPortImageDelivery(ParaViewWebProtocol):
             and tries > 0
         ):
             app.InvalidateCache(view.SMProxy)
-            reply["image"] = app.StillRenderToString(view.SMProxy, t, quality)
+            reply["image"] = stillRender(view.SMProxy, t, quality)
             tries -= 1
 
         if (
@@ -441,12 +449,20 @@ class ParaViewWebViewPortImageDelivery(ParaViewWebProtocol):
             and options["clearCache"]
         ):
             app.InvalidateCache(view.SMProxy)
-            reply["image"] = app.StillRenderToString(view.SMProxy, t, quality)
-
-        reply["stale"] = app.GetHasImagesBeingProcessed(view.SMProxy)
+            reply["image"] = stillRender(view.SMProxy, t, quality)
+
+        if tiles:
+            reply["stale"] = False
+            reply["format"] = "jpeg-tiles"
+            if reply["image"]:
+                reply["image"] = self.addAttachment(
+                    memoryview(reply["image"]).tobytes()
+                )
+        else:
+            reply["stale"] = app.GetHasImagesBeingProcessed(view.SMProxy)
+            reply["format"] = "jpeg;base64"
         reply["mtime"] = app.GetLastStillRenderToMTime()
         reply["size"] = view.ViewSize[0:2]
-        reply["format"] = "jpeg;base64"
         reply["global_id"] = view.GetGlobalIDAsString()
         reply["localTime"] = localTime
 
@@ -483,8 +499,21 @@ def _pushCameraLink(viewSrc, viewDstList):
 
 
 class ParaViewWebPublishImageDelivery(ParaViewWebProtocol):
-    def __init__(self, decode=True, **kwargs):
+    """
+    Publish rendered images of the views clients subscribed to. A single image
+    is encoded per view and frame, and published to all its subscribers.
+
+    When 'tiles' is True, frames are published as binary "jpeg-tiles"
+    attachments holding only the tiles that changed since the previously
+    published frame (see vtkPVWebApplication::StillRenderToTiles). A frame
+    with all the tiles is published whenever a client subscribes or requests
+    an image push.
+    """
+
+    def __init__(self, decode=True, tiles=False, tileSize=64, **kwargs):
         ParaViewWebProtocol.__init__(self)
+        self.tiles = tiles
+        self.tileSize = tileSize
         self.trackingViews = {}
         self.lastStaleTime = {}
         self.staleHandlerCount = {}
@@ -545,11 +574,11 @@ class ParaViewWebPublishImageDelivery(ParaViewWebProtocol):
         stale = reply["stale"]
         if reply["image"]:
             # depending on whether the app has encoding enabled:
-            if self.decode:
+            if self.decode and not self.tiles:
                 reply["image"] = base64.standard_b64decode(reply["image"])
 
             reply["image"] = self.addAttachment(reply["image"])
-            reply["format"] = "jpeg"
+            reply["format"] = "jpeg-tiles" if self.tiles else "jpeg"
             # save mtime for next call.
             self.trackingViews[vId]["mtime"] = reply["mtime"]
             # echo back real ID, instead of -1 for 'active'
@@ -677,6 +706,9 @@ class ParaViewWebPublishImageDelivery(ParaViewWebProtocol):
 
         # Make sure an image is pushed
         self.getApplication().InvalidateCache(view.SMProxy)
+        if self.tiles and viewId in self.trackingViews:
+            # the requesting client may have missed previous frames
+            self.trackingViews[viewId]["mtime"] = 0
 
         self.pushRender(viewId)
 
@@ -741,7 +773,10 @@ class ParaViewWebPublishImageDelivery(ParaViewWebProtocol):
         app = self.getApplication()
         if t == 0:
             app.InvalidateCache(view.SMProxy)
-        if self.decode:
+        if self.tiles:
+            app.SetTileSize(self.tileSize)
+            stillRender = app.StillRenderToTiles
+        elif self.decode:
             stillRender = app.StillRenderToString
         else:
             stillRender = app.StillRenderToBuffer
@@ -770,14 +805,19 @@ class ParaViewWebPublishImageDelivery(ParaViewWebProtocol):
             reply_image = stillRender(view.SMProxy, t, quality)
 
         # Pack the result
-        reply["stale"] = app.GetHasImagesBeingProcessed(view.SMProxy)
+        reply["stale"] = (
+            False if self.tiles else app.GetHasImagesBeingProcessed(view.SMProxy)
+        )
         reply["mtime"] = app.GetLastStillRenderToMTime()
         reply["size"] = view.ViewSize[0:2]
         reply["memsize"] = reply_image.GetDataSize() if reply_image else 0
-        reply["format"] = "jpeg;base64" if self.decode else "jpeg"
+        if self.tiles:
+            reply["format"] = "jpeg-tiles"
+        else:
+            reply["format"] = "jpeg;base64" if self.decode else "jpeg"
         reply["global_id"] = view.GetGlobalIDAsString()
         reply["localTime"] = localTime
-        if self.decode:
+        if self.decode and not self.tiles:
             reply["image"] = reply_image
         else:
             # Convert the vtkUnsignedCharArray into a bytes object, required by Autobahn websockets
@@ -820,6 +860,9 @@ class ParaViewWebPublishImageDelivery(ParaViewWebProtocol):
         else:
             # There is an observer on this view already
             self.trackingViews[realViewId]["observerCount"] += 1
+            if self.tiles:
+                # the new subscriber needs all the tiles
+                self.trackingViews[realViewId]["mtime"] = 0
 
         self.pushRender(realViewId)
         return {"success": True, "viewId": realViewId}
@@ -1149,7 +1192,7 @@ class ParaViewWebViewPortGeometryDelivery(ParaViewWebProtocol):
 
     # RpcName: getSceneMetaDataAllTimesteps => viewport.webgl.metadata.alltimesteps
     @exportRpc("viewport.webgl.metadata.alltimesteps")
-    def getSceneMetaDataAllTimesteps(self, view_id=-1):
+    def getSceneMetaDataAllTimesteps(self, view_id=-1, knownShas=None):
         animationScene = simple.GetAnimationScene()
         timeKeeper = animationScene.TimeKeeper
         tsVals = timeKeeper.TimestepValues.GetData()
@@ -1158,6 +1201,8 @@ class ParaViewWebViewPortGeometryDelivery(ParaViewWebProtocol):
         oldCache = self.dataCache
         self.dataCache = {}
         returnToClient = {}
+        # Objects the client already holds need no binary data.
+        known = set(knownShas or [])
 
         view = self.getView(view_id)
         animationScene.GoToFirst()
@@ -1176,7 +1221,7 @@ class ParaViewWebViewPortGeometryDelivery(ParaViewWebProtocol):
                 objId = obj["id"]
                 numParts = obj["parts"]
 
-                if sha not in self.dataCache:
+                if sha not in self.dataCache and sha not in known:
                     if sha in oldCache:
                         self.dataCache[sha] = oldCache[sha]
                     else:
@@ -1223,20 +1268,89 @@ class ParaViewWebViewPortGeometryDelivery(ParaViewWebProtocol):
 # =============================================================================
 
 
+def _collectArrayHashes(instance, hashes):
+    """
+    Append to 'hashes' the content hashes of the data arrays referenced by a
+    serialized vtk.js instance, in order of appearance and without duplicates.
+    """
+    if isinstance(instance, dict):
+        if "hash" in instance and "dataType" in instance:
+            if instance["hash"] not in hashes:
+                hashes.append(instance["hash"])
+            return hashes
+        for value in instance.values():
+            _collectArrayHashes(value, hashes)
+    elif isinstance(instance, list):
+        for value in instance:
+            _collectArrayHashes(value, hashes)
+    return hashes
+
+
 class ParaViewWebLocalRendering(ParaViewWebProtocol):
-    def __init__(self, **kwargs):
+    """
+    Deliver the scene of a view to vtk.js for local rendering.
+
+    Data arrays are identified by the hash of their content. Each view state
+    lists the hashes it references under extra.hashes, and clients only fetch the
+    arrays they do not hold yet. Encoded arrays are kept in a cache of at most
+    'arrayCacheSize' bytes, so that arrays shared between time steps or
+    requested again by a reconnecting client are not encoded again.
+    """
+
+    def __init__(self, arrayCacheSize=512 * 1024 * 1024, **kwargs):
         super(ParaViewWebLocalRendering, self).__init__()
         initializeSerializers()
         self.context = SynchronizationContext()
         self.trackingViews = {}
         self.mtime = 0
+        self.arrayCache = OrderedDict()
+        self.arrayCacheBytes = 0
+        self.arrayCacheSize = arrayCacheSize
+
+    def cacheArray(self, dataHash):
+        """
+        Keep the binary content of the array with the given hash, as long as
+        the serializer still knows it. Returns the content or None.
+        """
+        if dataHash in self.arrayCache:
+            self.arrayCache.move_to_end(dataHash)
+            return self.arrayCache[dataHash]
+
+        try:
+            data = bytes(self.context.getCachedDataArray(dataHash, True))
+        except KeyError:
+            return None
+
+        self.arrayCache[dataHash] = data
+        self.arrayCacheBytes += len(data)
+        while self.arrayCacheBytes > self.arrayCacheSize and len(self.arrayCache) > 1:
+            _, released = self.arrayCache.popitem(last=False)
+            self.arrayCacheBytes -= len(released)
+        return data
 
     # RpcName: getArray => viewport.geometry.array.get
     @exportRpc("viewport.geometry.array.get")
     def getArray(self, dataHash, binary=False):
+        data = self.cacheArray(dataHash)
+        if data is None:
+            return None
         if binary:
-            return self.addAttachment(self.context.getCachedDataArray(dataHash, binary))
-        return self.context.getCachedDataArray(dataHash, binary)
+            return self.addAttachment(data)
+        return base64.b64encode(data).decode("ascii")
+
+    # RpcName: getArrays => viewport.geometry.array.get.list
+    @exportRpc("viewport.geometry.array.get.list")
+    def getArrays(self, dataHashes, binary=False):
+        """
+        Fetch several arrays in a single round trip. Returns a dictionary
+        mapping each known hash to its content.
+        """
+        result = {}
+        for dataHash in dataHashes:
+            data = self.getArray(dataHash, binary)
+            if data is not None:
+                result[dataHash] = data
+        return result
 
     # RpcName: addViewObserver => viewport.geometry.view.observer.add
     @exportRpc("viewport.geometry.view.observer.add")
@@ -1317,10 +1431,51 @@ class ParaViewWebLocalRendering(ParaViewWebProtocol):
         self.context.checkForArraysToRelease()
 
         if viewInstance:
+            viewInstance["extra"]["hashes"] = _collectArrayHashes(viewInstance, [])
             return viewInstance
 
         return None
 
+    # RpcName: getViewStateAllTimesteps => viewport.geometry.view.get.state.alltimesteps
+    @exportRpc("viewport.geometry.view.get.state.alltimesteps")
+    def getViewStateAllTimesteps(self, viewId, knownHashes=None):
+        """
+        Serialize the view for every time step. Arrays are cached as each time
+        step is serialized, so that they can be fetched afterwards. The reply
+        lists under "hashes" the arrays referenced by any time step that are
+        not in 'knownHashes', which lets a client holding arrays from a
+        previous session fetch only the missing ones.
+        """
+        sView = self.getView(viewId)
+        if not sView:
+            return {"error": "Unable to get view with id %s" % viewId}
+
+        animationScene = simple.GetAnimationScene()
+        timeKeeper = animationScene.TimeKeeper
+        currentTime = timeKeeper.Time
+        known = set(knownHashes or [])
+
+        states = []
+        hashes = []
+        for t in timeKeeper.TimestepValues:
+            timeKeeper.Time = t
+            simple.Render(sView)
+            state = self.getViewState(viewId, True)
+            if not state:
+                continue
+            for dataHash in state["extra"]["hashes"]:
+                # Pipelines may reuse array instances between time steps, so
+                # the content has to be captured now.
+                self.cacheArray(dataHash)
+                if dataHash not in known and dataHash not in hashes:
+                    hashes.append(dataHash)
+            states.append({"time": t, "state": state})
+
+        timeKeeper.Time = currentTime
+        simple.Render(sView)
+
+        return {"success": True, "states": states, "hashes": hashes}
+
 
 # =============================================================================
 #
@@ -5,6 +5,14 @@ logbase contains core routines for collecting and gathering timing logs from
 all nodes.
 logparser contains additional routines for parsing the raw logs and
 calculating statistics across ranks and frames.
+suite is a benchmark suite timing readers, key filters, data delivery,
+rendering and state loading on synthetic data. It saves results as JSON and
+compares them to a baseline to detect performance regressions.
+memory reports, for every source, filter and representation, the memory of
+its outputs and of the data cached for rendering it, summed over all ranks,
+along with the growth of the memory while it executed.
+traceevents records log scopes of all processes as trace events and saves
+them as a single Chrome trace / Perfetto timeline.
 
 manyspheres is a geometry rendering benchmark that generates a large number
 of spheres and moves the camera around the scene.  To run the benchmark,
@@ -21,5 +29,8 @@ from __future__ import absolute_import
 
 from . import logbase
 from . import logparser
+from . import memory
+from . import suite
+from . import traceevents
 
-__all__ = ['logbase', 'logparser']
+__all__ = ['logbase', 'logparser', 'memory', 'suite', 'traceevents']
@@ -0,0 +1,147 @@
+"""
+This module reports the memory held and used by each pipeline object.
+
+For every source, filter and representation of the session, the memory of its
+outputs, of the data its view keeps for rendering it and the growth of the
+resident memory while it executed are gathered from all ranks and aggregated.
+All sizes are in KiB. Do that like so::
+
+    from paraview.benchmark import memory
+    memory.print_pipeline_memory()
+
+The size of the outputs and of the data kept for rendering is always
+reported. Sampling the memory around executions is disabled by default since
+it reads the memory of the process twice per execution; turn it on for all
+processes with set_tracking(True) before executing the pipelines to also
+gather the memory growth and peak of each execution.
+
+set_budget() limits the memory of filter outputs on each process. Outputs of
+hidden filters consumed by other filters are then released, least recently
+used first, and produced again when needed. get_budget_statistics() tells how
+often that happened, to tune the budget.
+"""
+
+from __future__ import print_function
+from paraview import servermanager
+
+_FIELDS = [
+    ("ranks", "GetNumberOfProcesses"),
+    ("output", "GetOutputMemorySize"),
+    ("cached", "GetCachedMemorySize"),
+    ("delivered", "GetDeliveredMemorySize"),
+    ("max_rank", "GetMaximumRankMemorySize"),
+    ("last_increase", "GetLastExecutionMemoryIncrease"),
+    ("last_peak", "GetLastExecutionPeakMemoryIncrease"),
+    ("max_peak", "GetMaximumPeakMemoryIncrease"),
+    ("executions", "GetNumberOfExecutions"),
+]
+
+_BUDGET_FIELDS = [
+    ("ranks", "GetNumberOfProcesses"),
+    ("budget", "GetMemoryBudget"),
+    ("budgeted", "GetBudgetedMemorySize"),
+    ("max_budgeted", "GetMaximumBudgetedMemorySize"),
+    ("releases", "GetNumberOfReleasedOutputs"),
+    ("released", "GetReleasedMemorySize"),
+    ("reexecutions", "GetNumberOfReexecutions"),
+]
+
+_tracking = None
+
+def _get_tracking():
+    global _tracking
+    if _tracking is None:
+        _tracking = servermanager.ProxyManager().NewProxy("misc", "PipelineMemoryTracking")
+    return _tracking
+
+def set_tracking(enabled):
+    """
+    Enable or disable sampling the process memory around the executions of
+    algorithms on all processes.
+    """
+    tracking = _get_tracking()
+    tracking.GetProperty("MemoryTracking").SetElements1(1 if enabled else 0)
+    tracking.UpdateVTKObjects()
+
+def set_budget(mib, enforce=True):
+    """
+    Set the budget, in MiB, for the outputs of filters on each process, 0 to
+    disable it. Unless enforce is False, outputs are released right away to
+    meet the new budget instead of at the end of the next update.
+    """
+    tracking = _get_tracking()
+    tracking.GetProperty("MemoryBudget").SetElements1(mib)
+    tracking.UpdateVTKObjects()
+    if enforce:
+        tracking.InvokeCommand("EnforceMemoryBudget")
+
+def get_budget_statistics(reset=False):
+    """
+    Gather the statistics of the memory budget from all processes. Returns a
+    dictionary with the budget in MiB, the largest size of the outputs on a
+    rank in KiB ('budgeted' and 'max_budgeted'), the number of outputs
+    released, their size in KiB and the number of executions producing them
+    again, summed over all ranks. If reset is True, the statistics are reset
+    once gathered.
+    """
+    info = servermanager.vtkPVMemoryBudgetInformation()
+    _get_tracking().GatherInformation(info)
+    if reset:
+        _get_tracking().InvokeCommand("ResetMemoryBudgetStatistics")
+    return dict((key, getattr(info, getter)()) for key, getter in _BUDGET_FIELDS)
+
+def get_memory_information(proxy):
+    """
+    Gather the memory information of a source or representation proxy from
+    all processes it exists on. Returns a dictionary of the aggregated values.
+    """
+    info = servermanager.vtkPVPipelineMemoryInformation()
+    smproxy = proxy.SMProxy if hasattr(proxy, "SMProxy") else proxy
+    smproxy.GatherInformation(info)
+    return dict((key, getattr(info, getter)()) for key, getter in _FIELDS)
+
+def get_pipeline_memory():
+    """
+    Returns a list with a dictionary per source and representation of the
+    session, holding its name, its kind ('source' or 'representation') and the
+    values returned by get_memory_information(). The name of a representation
+    is the name of its input followed by the name of its view.
+    """
+    pxm = servermanager.ProxyManager()
+    result = []
+    sourceNames = {}
+    for (name, _), proxy in pxm.GetProxiesInGroup("sources").items():
+        sourceNames[proxy.SMProxy] = name
+        entry = {"name": name, "kind": "source"}
+        entry.update(get_memory_information(proxy))
+        result.append(entry)
+
+    for (viewName, _), view in pxm.GetProxiesInGroup("views").items():
+        for representation in view.Representations:
+            prop = representation.SMProxy.GetProperty("Input")
+            if not prop or prop.GetNumberOfProxies() == 0:
+                continue
+            source = prop.GetProxy(0)
+            if source not in sourceNames:
+                continue
+            entry = {"name": "%s (%s)" % (sourceNames[source], viewName),
+                     "kind": "representation"}
+            entry.update(get_memory_information(representation))
+            result.append(entry)
+    return result
+
+def print_pipeline_memory(entries=None):
+    """
+    Print the entries returned by get_pipeline_memory(), the largest
+    consumers first.
+    """
+    if entries is None:
+        entries = get_pipeline_memory()
+    entries = sorted(entries,
+                     key=lambda e: e["output"] + e["cached"] + e["delivered"], reverse=True)
+    print("%-40s %12s %12s %12s %12s %12s" % (
+        "object", "output KiB", "cached KiB", "deliv. KiB", "max rank KiB", "peak KiB"))
+    for entry in entries:
+        print("%-40s %12d %12d %12d %12d %12d" % (
+            entry["name"][:40], entry["output"], entry["cached"], entry["delivered"],
+            entry["max_rank"], entry["max_peak"]))
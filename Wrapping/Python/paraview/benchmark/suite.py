@@ -0,0 +1,272 @@
+"""
+This module is a benchmark suite covering the main stages of a ParaView
+session on synthetic data of configurable size:
+
+* reader: reading a partitioned image data file.
+* contour, clip, threshold, extract_surface, calculator: executing key filters.
+* delivery: delivering geometry to the view on the first render.
+* render: rendering (and compositing, when run in parallel) frames.
+* state: loading a state file.
+
+Every case is run several times and the timings are reported as a JSON
+document that also records the parameters and the environment the suite ran
+in. The results can be compared to a baseline saved by a previous run to
+catch performance regressions. Run this file with pvbatch, optionally with
+MPI; the exit code is 1 when a regression is found::
+
+    mpiexec -n 4 pvbatch suite.py --scale 200 --output results.json \\
+        --baseline baseline.json
+
+or from Python::
+
+    from paraview.benchmark import suite
+    results = suite.run(scale=100)
+    regressions = suite.compare(results, suite.load("baseline.json"))
+"""
+
+from __future__ import print_function
+
+import json
+import os
+import platform
+import shutil
+import socket
+import sys
+import tempfile
+import time
+
+from paraview import servermanager, simple
+
+def _wavelet(scale):
+    wavelet = simple.Wavelet()
+    half = scale // 2
+    wavelet.WholeExtent = [-half, half - 1, -half, half - 1, -half, half - 1]
+    return wavelet
+
+def _timed(function):
+    start = time.perf_counter()
+    function()
+    return time.perf_counter() - start
+
+def _number_of_cells(proxy):
+    return proxy.GetDataInformation().GetNumberOfCells()
+
+def _filter_case(create):
+    """Returns a case timing the execution of the filter returned by
+    create(input) on a wavelet. The filter is created anew for every sample
+    so that it executes each time, while its input is only computed once."""
+    def case(context):
+        source = context["source"]
+        proxy = create(source)
+        seconds = _timed(proxy.UpdatePipeline)
+        cells = _number_of_cells(proxy)
+        simple.Delete(proxy)
+        return seconds, {"cells": cells}
+    return case
+
+def _reader_case(context):
+    reader = simple.XMLPartitionedImageDataReader(FileName=[context["image_file"]])
+    seconds = _timed(reader.UpdatePipeline)
+    size = reader.GetDataInformation().GetMemorySize() / 1024.0
+    simple.Delete(reader)
+    return seconds, {"MiB/s": size / seconds if seconds > 0 else 0}
+
+def _delivery_case(context):
+    view = context["view"]
+    contour = simple.Contour(Input=context["source"], ContourBy=["POINTS", "RTData"],
+                             Isosurfaces=[100.0, 150.0, 200.0])
+    contour.UpdatePipeline()
+    display = simple.Show(contour, view)
+    seconds = _timed(lambda: simple.Render(view))
+    simple.Delete(display)
+    simple.Delete(contour)
+    return seconds, {}
+
+def _render_case(context):
+    view = context["view"]
+    camera = view.GetActiveCamera()
+    frames = context["frames"]
+    def render_frames():
+        for _ in range(frames):
+            camera.Azimuth(360.0 / frames)
+            simple.Render(view)
+    seconds = _timed(render_frames)
+    return seconds, {"fps": frames / seconds if seconds > 0 else 0}
+
+def _state_case(context):
+    # loading a state replaces the current one, the view of the suite
+    # is created again afterwards.
+    seconds = _timed(lambda: simple.LoadState(context["state_file"]))
+    simple.ResetSession()
+    _setup_view(context)
+    return seconds, {}
+
+def _setup_view(context):
+    view = simple.CreateRenderView(ViewSize=context["view_size"])
+    context["source"] = _wavelet(context["scale"])
+    context["source"].UpdatePipeline()
+    contour = simple.Contour(Input=context["source"], ContourBy=["POINTS", "RTData"],
+                             Isosurfaces=[100.0, 150.0, 200.0])
+    simple.Show(contour, view)
+    view.ResetCamera()
+    simple.Render(view)
+    context["view"] = view
+
+CASES = {
+    "reader": _reader_case,
+    "contour": _filter_case(lambda source: simple.Contour(
+        Input=source, ContourBy=["POINTS", "RTData"],
+        Isosurfaces=[float(v) for v in range(60, 260, 20)])),
+    "clip": _filter_case(lambda source: simple.Clip(
+        Input=source, ClipType="Plane", Scalars=["POINTS", "RTData"])),
+    "threshold": _filter_case(lambda source: simple.Threshold(
+        Input=source, Scalars=["POINTS", "RTData"], LowerThreshold=100.0,
+        UpperThreshold=200.0)),
+    "extract_surface": _filter_case(lambda source: simple.ExtractSurface(Input=source)),
+    "calculator": _filter_case(lambda source: simple.Calculator(
+        Input=source, ResultArrayName="result",
+        Function="sqrt(coordsX^2+coordsY^2+coordsZ^2)*RTData")),
+    "delivery": _delivery_case,
+    "render": _render_case,
+    "state": _state_case,
+}
+
+def get_environment():
+    """Returns a dictionary describing the environment the suite runs in."""
+    session = servermanager.ActiveConnection.Session
+    return {
+        "paraview_version": servermanager.vtkSMProxyManager.GetParaViewSourceVersion(),
+        "python_version": platform.python_version(),
+        "platform": platform.platform(),
+        "processor": platform.processor(),
+        "hostname": socket.gethostname(),
+        "cpu_count": os.cpu_count(),
+        "ranks": session.GetNumberOfProcesses(session.DATA_SERVER),
+        "render_server_ranks": session.GetNumberOfProcesses(session.RENDER_SERVER),
+        "date": time.strftime("%Y-%m-%dT%H:%M:%S%z"),
+    }
+
+def _summarize(samples, extra):
+    ordered = sorted(samples)
+    count = len(ordered)
+    median = ordered[count // 2] if count % 2 else 0.5 * (ordered[count // 2 - 1] + ordered[count // 2])
+    result = {"median": median, "min": ordered[0], "max": ordered[-1], "samples": samples}
+    result.update(extra)
+    return result
+
+def run(scale=100, repeat=5, cases=None, view_size=(800, 600), frames=20, verbose=True,
+        workdir=None):
+    """
+    Run the benchmark cases named in 'cases', or all of them, on a wavelet of
+    'scale'^3 points. Each case runs 'repeat' times. Files used by the cases
+    are written to a temporary directory in 'workdir', which must be
+    accessible by all server ranks. Returns a dictionary with
+    the environment, the parameters and, for each case, the median, minimum
+    and maximum times in seconds along with case specific metrics.
+    """
+    names = list(cases) if cases else list(CASES.keys())
+    unknown = [name for name in names if name not in CASES]
+    if unknown:
+        raise ValueError("Unknown benchmark cases: %s" % ", ".join(unknown))
+
+    workdir = tempfile.mkdtemp(prefix="pvbenchmark", dir=workdir)
+    context = {"scale": scale, "view_size": list(view_size), "frames": frames}
+    results = {}
+    try:
+        servermanager.SetProgressPrintingEnabled(0)
+
+        # inputs of the reader and state cases.
+        context["image_file"] = os.path.join(workdir, "wavelet.pvti")
+        source = _wavelet(scale)
+        simple.SaveData(context["image_file"], proxy=source)
+        simple.Delete(source)
+        _setup_view(context)
+        context["state_file"] = os.path.join(workdir, "state.pvsm")
+        simple.SaveState(context["state_file"])
+
+        for name in names:
+            samples = []
+            extra = {}
+            for _ in range(repeat):
+                seconds, extra = CASES[name](context)
+                samples.append(seconds)
+            results[name] = _summarize(samples, extra)
+            if verbose:
+                print("%-16s median %.4f s  min %.4f s  max %.4f s" % (
+                    name, results[name]["median"], results[name]["min"], results[name]["max"]))
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+    return {
+        "environment": get_environment(),
+        "parameters": {"scale": scale, "repeat": repeat, "view_size": list(view_size),
+                       "frames": frames, "cases": names},
+        "results": results,
+    }
+
+def save(results, filename):
+    """Save results returned by run() as JSON."""
+    with open(filename, "w") as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+
+def load(filename):
+    """Load results saved with save()."""
+    with open(filename, "r") as f:
+        return json.load(f)
+
+def compare(results, baseline, tolerance=0.1):
+    """
+    Compare the median times of 'results' to those of 'baseline'. Returns a
+    list of (case, baseline median, median) for the cases slower than the
+    baseline by more than 'tolerance', a fraction of the baseline time.
+    Cases missing from either side are ignored.
+    """
+    regressions = []
+    for name, result in sorted(results["results"].items()):
+        reference = baseline.get("results", {}).get(name)
+        if not reference:
+            continue
+        if result["median"] > reference["median"] * (1.0 + tolerance):
+            regressions.append((name, reference["median"], result["median"]))
+    return regressions
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(description="ParaView benchmark suite")
+    parser.add_argument("-s", "--scale", default=100, type=int,
+                        help="Number of points of the synthetic data along each axis")
+    parser.add_argument("-r", "--repeat", default=5, type=int,
+                        help="Number of times each case is run")
+    parser.add_argument("-c", "--cases", default=None,
+                        type=lambda s: s.split(","),
+                        help="Comma separated cases to run, among: %s" % ", ".join(CASES.keys()))
+    parser.add_argument("-v", "--view-size", default=[800, 600],
+                        type=lambda s: [int(x) for x in s.split(",")],
+                        help="View size used to render")
+    parser.add_argument("-f", "--frames", default=20, type=int,
+                        help="Number of frames rendered by the render case")
+    parser.add_argument("-w", "--workdir", default=None, type=str,
+                        help="Directory, shared by all ranks, for temporary files")
+    parser.add_argument("-o", "--output", default=None, type=str,
+                        help="JSON file to save the results to")
+    parser.add_argument("-b", "--baseline", default=None, type=str,
+                        help="JSON file of results to compare to")
+    parser.add_argument("-t", "--tolerance", default=0.1, type=float,
+                        help="Slowdown, as a fraction of the baseline, reported as a regression")
+    args = parser.parse_args(argv)
+
+    results = run(scale=args.scale, repeat=args.repeat, cases=args.cases,
+                  view_size=args.view_size, frames=args.frames, workdir=args.workdir)
+    if args.output:
+        save(results, args.output)
+    if args.baseline:
+        regressions = compare(results, load(args.baseline), args.tolerance)
+        for name, reference, median in regressions:
+            print("REGRESSION %s: %.4f s -> %.4f s (%+.1f%%)" % (
+                name, reference, median, 100.0 * (median - reference) / reference))
+        if regressions:
+            return 1
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,81 @@
+"""
+This module records ParaView's log scopes as trace events.
+
+While recording, every log scope on the client and on all ranks of the
+servers, e.g. filter executions, data movement, compositing and rendering, is
+recorded with its begin and end time. The events can then be saved as a
+single trace that can be loaded in Chrome's trace viewer (chrome://tracing) or
+in Perfetto (https://ui.perfetto.dev). Do that like so:
+
+1. Call start()
+2. Setup and run your visualization pipeline (via GUI or script as you prefer)
+3. Call stop(), then save(filename)
+"""
+
+from __future__ import print_function
+import paraview
+from paraview import servermanager
+
+_recorder = None
+
+def _get_recorder():
+    global _recorder
+    if _recorder is None:
+        pxm = servermanager.ProxyManager()
+        _recorder = pxm.NewProxy("misc", "TraceEventLog")
+    return _recorder
+
+def _get_components():
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    session = servermanager.ActiveConnection.Session
+    if pm.GetProcessTypeAsInt() == pm.PROCESS_BATCH or \
+        not servermanager.ActiveConnection.IsRemote():
+        # the client and the servers are the same processes, gather once.
+        return [session.CLIENT_AND_SERVERS]
+    if session.GetRenderClientMode() == session.RENDERING_UNIFIED:
+        return [session.CLIENT, session.SERVERS]
+    return [session.CLIENT, session.RENDER_SERVER, session.DATA_SERVER]
+
+def start(buffer_size=65536):
+    """
+    Discard previously recorded events and start recording on all processes.
+    buffer_size is the maximum number of events kept per thread; the most
+    recent events are kept.
+    """
+    recorder = _get_recorder()
+    recorder.GetProperty("BufferSize").SetElements1(buffer_size)
+    recorder.GetProperty("Recording").SetElements1(0)
+    recorder.UpdateVTKObjects()
+    recorder.InvokeCommand("ClearEvents")
+    recorder.GetProperty("Recording").SetElements1(1)
+    recorder.UpdateVTKObjects()
+
+def stop():
+    """
+    Stop recording on all processes. Recorded events are kept until the next
+    call to start().
+    """
+    recorder = _get_recorder()
+    recorder.GetProperty("Recording").SetElements1(0)
+    recorder.UpdateVTKObjects()
+
+def get_trace():
+    """
+    Gather the events recorded by all processes and return them as a
+    JSON trace.
+    """
+    session = servermanager.ActiveConnection.Session
+    trace = servermanager.vtkPVTraceEventInformation()
+    for component in _get_components():
+        info = servermanager.vtkPVTraceEventInformation()
+        session.GatherInformation(component, info, 0)
+        trace.AddInformation(info)
+    return trace.GetTrace()
+
+def save(filename):
+    """
+    Gather the events recorded by all processes and save them as a JSON
+    trace.
+    """
+    with open(filename, "w") as f:
+        f.write(get_trace())
@@ -140,10 +140,11 @@ def compute(inputs, expression, ns=None):
     if ns:
         mylocals.update(ns)
     mylocals["inputs"] = inputs
-    try:
-        mylocals["points"] = inputs[0].Points
-    except AttributeError:
-        pass
+    if "points" not in mylocals:
+        try:
+            mylocals["points"] = inputs[0].Points
+        except AttributeError:
+            pass
 
     finalRet = None
     for subEx in expression.split(' and '):
@@ -156,6 +157,117 @@ def compute(inputs, expression, ns=None):
     return finalRet
 
 
+# Functions from numpy_interface.algorithms that compute each output tuple
+# from the matching input tuples only. Expressions combining them with arrays
+# and constants can be evaluated over slices of the arrays.
+_elementwise_functions = frozenset([
+    "abs", "absolute", "arccos", "arccosh", "arcsin", "arcsinh", "arctan",
+    "arctan2", "arctanh", "ceil", "cos", "cosh", "cross", "det",
+    "determinant", "dot", "eigenvalue", "eigenvector", "exp", "floor", "inv",
+    "inverse", "ln", "log", "log10", "mag", "make_vector", "negative", "norm",
+    "reciprocal", "rint", "sin", "sinh", "sqrt", "square", "tan", "tanh",
+    "trace"])
+
+
+def get_chunkable_arrays(expression, variables):
+    """Returns the names of the arrays in `variables` referenced by
+    `expression` if the expression only combines these arrays, other
+    variables, constants and element-wise functions. Evaluating such an
+    expression over slices of the arrays gives the same result as evaluating
+    it over the whole arrays. Returns None otherwise.
+    """
+    import ast
+    try:
+        tree = ast.parse(expression, mode="eval")
+    except SyntaxError:
+        return None
+
+    arraynames = set()
+    for node in ast.walk(tree):
+        if isinstance(node, ast.Name):
+            value = variables.get(node.id)
+            if isinstance(value, dsa.VTKArray):
+                arraynames.add(node.id)
+            elif node.id in variables:
+                if hasattr(value, "__len__"):
+                    # composite or missing arrays, for instance.
+                    return None
+            elif node.id not in _elementwise_functions:
+                return None
+        elif isinstance(node, ast.Subscript):
+            # only component access, i.e. `Velocity[:, 0]`, keeps tuples
+            # independent from one another.
+            index = node.slice
+            if isinstance(index, getattr(ast, "Index", ())):
+                # Python < 3.9 wraps the index expression.
+                index = index.value
+            if not isinstance(index, ast.Tuple) or not index.elts:
+                return None
+            first = index.elts[0]
+            if not isinstance(first, ast.Slice) or first.lower or first.upper or first.step:
+                return None
+        elif isinstance(node, (ast.Attribute, ast.Lambda, ast.ListComp, ast.SetComp,
+                               ast.DictComp, ast.GeneratorExp, ast.Starred)):
+            return None
+    return arraynames
+
+
+def compute_chunked(inputs, expression, variables, association, chunk_size,
+                    number_of_threads=1):
+    """Evaluates `expression` over slices of `chunk_size` tuples of the arrays
+    it references, writing each slice of the result into a preallocated
+    array. This avoids creating temporaries as large as the input arrays
+    for every sub-expression. Slices are evaluated on `number_of_threads`
+    threads, or as many as available if 0, since numpy releases the GIL while
+    operating on arrays.
+
+    Returns None if the expression cannot be evaluated in chunks, in which
+    case `compute` should be used instead.
+    """
+    arraynames = get_chunkable_arrays(expression, variables)
+    if not arraynames:
+        return None
+    lengths = set(variables[name].shape[0] for name in arraynames)
+    if len(lengths) != 1:
+        return None
+    numberOfTuples = lengths.pop()
+    if numberOfTuples <= chunk_size:
+        return None
+
+    def evaluate(start):
+        end = min(start + chunk_size, numberOfTuples)
+        ns = dict(variables)
+        for name in arraynames:
+            ns[name] = variables[name][start:end]
+        return compute(inputs, expression, ns=ns), end
+
+    # The first chunk tells us the type and shape of the result.
+    first, end = evaluate(0)
+    if not isinstance(first, np.ndarray) or first.ndim == 0 or first.shape[0] != end:
+        return None
+    result = np.empty((numberOfTuples,) + first.shape[1:], dtype=first.dtype)
+    result[0:end] = first
+    del first
+
+    def evaluate_into_result(start):
+        value, end = evaluate(start)
+        result[start:end] = value
+
+    starts = range(chunk_size, numberOfTuples, chunk_size)
+    if number_of_threads == 1:
+        for start in starts:
+            evaluate_into_result(start)
+    else:
+        from concurrent.futures import ThreadPoolExecutor
+        with ThreadPoolExecutor(max_workers=number_of_threads or None) as executor:
+            # consume the iterator to propagate exceptions raised by workers.
+            list(executor.map(evaluate_into_result, starts))
+
+    retVal = dsa.VTKArray(result)
+    retVal.Association = association
+    return retVal
+
+
 def get_data_time(self, do, ininfo):
     dinfo = do.GetInformation()
     if dinfo and dinfo.Has(do.DATA_TIME_STEP()):
@@ -209,7 +321,18 @@ def execute(self, expression):
                       "t_value": inputs[0].t_value,
                       "time_index": inputs[0].time_index,
                       "t_index": inputs[0].t_index})
-    retVal = compute(inputs, expression, ns=variables)
+    retVal = None
+    if self.GetChunkSize() > 0:
+        if self.GetArrayAssociation() == vtkDataObject.FIELD_ASSOCIATION_POINTS:
+            try:
+                variables["points"] = inputs[0].Points
+            except AttributeError:
+                pass
+        retVal = compute_chunked(inputs, expression, variables,
+                                 self.GetArrayAssociation(), self.GetChunkSize(),
+                                 self.GetNumberOfThreads())
+    if retVal is None:
+        retVal = compute(inputs, expression, ns=variables)
 
     if retVal is not None:
         if hasattr(retVal, "Association"):
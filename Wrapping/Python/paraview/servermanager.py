@@ -2516,6 +2516,19 @@ def AnimateReader(reader, view):
 def GetProgressPrintingIsEnabled():
     return progressObserverTag is not None
 
+def GetNumberOfTimeCompartments():
+    """Returns the number of groups pvbatch processes were split into with the
+    ``--time-compartments`` option, 1 otherwise."""
+    return vtkProcessModule.GetProcessModule().GetNumberOfTimeCompartments()
+
+def GetTimeCompartmentIndex():
+    """Returns the index of the time compartment this process belongs to, 0
+    without time compartments. Each compartment runs the whole script, and
+    saves its share of the frames of animations. Other outputs are only written
+    by compartment 0 when using the functions of `paraview.simple`; scripts
+    writing files by other means can compare this index to 0 to do the same."""
+    return vtkProcessModule.GetProcessModule().GetTimeCompartmentIndex()
+
 def SetProgressPrintingEnabled(value):
     """Turn on/off printing of progress (by default, it is on). You can
     always turn progress off and add your own observer to the process
@@ -2683,7 +2696,25 @@ class ProxyNamespace:
         assert name
         return _make_name_valid(name)
 
-    def _findProxy(self, name=None, xmlname=None):
+    @staticmethod
+    def _getDelayedProxies(group):
+        """Returns the (name, pyname) pairs of the proxies of the group listed
+        by the manifests of delay-loaded plugins that are not loaded yet."""
+        names = vtkStringList()
+        labels = vtkStringList()
+        vtkPVPluginTracker.GetInstance().GetDelayedProxies(group, names, labels)
+        proxies = []
+        for i in range(names.GetNumberOfStrings()):
+            name = names.GetString(i)
+            label = labels.GetString(i) if paraview.compatibility.GetVersion() >= 3.5 else name
+            proxies.append((name, ProxyNamespace._getPyName(proxyname=label)))
+        return proxies
+
+    def _findProxy(self, name=None, xmlname=None, load=True):
+        """Returns the definition of a proxy as a dictionary with "group", "key"
+        and "xml" items. The definition of a proxy provided by a delay-loaded
+        plugin loads that plugin, unless `load` is False in which case "xml" is
+        None."""
         assert name or xmlname
         pdm = self.session.GetProxyDefinitionManager()
         for group in self.xmlGroups:
@@ -2697,6 +2728,16 @@ class ProxyNamespace:
                     return item
                 elif xmlname and xmlname == item["key"]:
                     return item
+        # Requesting the definition of a proxy provided by a delay-loaded
+        # plugin loads that plugin only.
+        for group in self.xmlGroups:
+            for key, pname in self._getDelayedProxies(group):
+                if (name and pname == name) or (xmlname and xmlname == key):
+                    if not load:
+                        return {"group" : group, "key" : key, "xml" : None}
+                    xml = pdm.GetProxyDefinition(group, key)
+                    if xml:
+                        return {"group" : group, "key" : key, "xml" : xml}
         return None
 
     def __dir__(self):
@@ -2709,6 +2750,7 @@ class ProxyNamespace:
                     s.add(self._getPyName(xml=item["xml"]))
                 else:
                     s.add(self._getPyName(proxyname=pditer.GetProxyName()))
+            s.update(pname for key, pname in self._getDelayedProxies(group))
         return s
 
     def __getattr__(self, name):
@@ -2724,10 +2766,13 @@ class ProxyNamespace:
         return cls
 
     def getDocumentation(self, name):
-        ptype = self._findProxy(name=name)
+        # documenting all proxies must not load delay-loaded plugins.
+        ptype = self._findProxy(name=name, load=False)
         if not ptype:
             raise RuntimeError("Invalid proxy '%s'" % name)
         xml = ptype["xml"]
+        if not xml:
+            return ""
         doc = xml.FindNestedElementByName("Documentation")
         return doc.GetCharacterData() if doc and doc.GetCharacterData() else ""
 
@@ -594,7 +594,7 @@ def UpdateSteerableParameters(steerable_proxy, steerable_source_name):
 #==============================================================================
 
 def LoadState(statefile, data_directory = None, restrict_to_data_directory = False,
-        filenames = None, *args, **kwargs):
+        filenames = None, defer_pipeline_updates = False, *args, **kwargs):
     """
     Load PVSM state file.
 
@@ -627,6 +627,14 @@ def LoadState(statefile, data_directory = None, restrict_to_data_directory = Fal
             ...
         ]
 
+    If `defer_pipeline_updates` is True, all proxies in the state are created
+    before any pipeline information is updated and, once the state is loaded,
+    only the pipelines shown in views are updated, upstream first.
+
+    Returns the time spent on each proxy while loading the state, as a list of
+    `(proxy name, stage, seconds)` tuples where stage is one of "create",
+    "information" or, with `defer_pipeline_updates`, "update".
+
     Presence of other positional or keyword arguments is used to indicate that this
     invocation uses the legacy signature of this function and forwards to
     `_LoadStateLegacy`.
@@ -657,12 +665,21 @@ def LoadState(statefile, data_directory = None, restrict_to_data_directory = Fal
                             raise RuntimeError("Invalid item specified in 'filenames': %s", item)
                         prop = servermanager._wrap_property(pyproxy, smprop)
                         prop.SetData(item[pname])
+        pyproxy.DeferPipelineUpdates = 1 if defer_pipeline_updates else 0
         pyproxy.Load()
 
     # Try to set the new view active
     if len(GetRenderViews()) > 0:
         SetActiveView(GetRenderViews()[0])
 
+    timings = []
+    loader = pyproxy.SMProxy.GetStateLoader()
+    if loader:
+        for index in range(loader.GetNumberOfTimings()):
+            timings.append((loader.GetTimingProxyName(index), loader.GetTimingStage(index),
+                loader.GetTimingDuration(index)))
+    return timings
+
 def _LoadStateLegacy(filename, connection=None, **extraArgs):
     """Python scripts from version < 5.9 used a different signature. This
     function supports that.
@@ -691,6 +708,10 @@ def _LoadStateLegacy(filename, connection=None, **extraArgs):
 # -----------------------------------------------------------------------------
 
 def SaveState(filename):
+    """Saves the state in a file. With time compartments, only the first
+    compartment writes it, see `servermanager.GetTimeCompartmentIndex`."""
+    if not _IsFirstTimeCompartment():
+        return
     servermanager.SaveState(filename)
 
 #==============================================================================
@@ -1278,7 +1299,12 @@ def SaveData(filename, proxy=None, **extraArgs):
 
         SaveData("sample.pvtp", source0)
         SaveData("sample.csv", FieldAssociation="Points")
+
+    With time compartments, only the first compartment writes the file, see
+    `servermanager.GetTimeCompartmentIndex`.
     """
+    if not _IsFirstTimeCompartment():
+        return
     writer = CreateWriter(filename, proxy, **extraArgs)
     if not writer:
         raise RuntimeError ("Could not create writer for specified file or data type")
@@ -1288,6 +1314,14 @@ def SaveData(filename, proxy=None, **extraArgs):
 
 # -----------------------------------------------------------------------------
 
+def _IsFirstTimeCompartment():
+    """Each time compartment runs the whole script. Outputs other than
+    animations are only written by the first one, since the compartments would
+    otherwise write the same files concurrently."""
+    return servermanager.GetTimeCompartmentIndex() == 0
+
+# -----------------------------------------------------------------------------
+
 def WriteImage(filename, view=None, **params):
     """::deprecated:: 4.2
     Use :func:`SaveScreenshot` instead.
@@ -1435,7 +1469,13 @@ def SaveScreenshot(filename, viewOrLayout=None, **params):
             For ParaView 5.4, the following parameters were available, however
             it is ignored starting with ParaView 5.5. Instead, it is recommended
             to use format-specific quality parameters based on the file format being used.
+
+    With time compartments, only the first compartment saves the screenshot,
+    see `servermanager.GetTimeCompartmentIndex`.
     """
+    if not _IsFirstTimeCompartment():
+        return True
+
     # Let's handle backwards compatibility.
     # Previous API for this method took the following arguments:
     # SaveScreenshot(filename, view=None, layout=None, magnification=None, quality=None)